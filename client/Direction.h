@@ -1,19 +1,19 @@
-#pragma once
-
-/**
- * @enum Direction
- * @brief Enumera le direzioni cardinali.
- *
- * Questa enumerazione rappresenta quattro possibili direzioni:
- * - UP: Su
- * - DOWN: Gi
- * - LEFT: Sinistra
- * - RIGHT: Destra
- */
-enum class Direction
-{
-    UP,    ///< Direzione verso l'alto.
-    DOWN,  ///< Direzione verso il basso.
-    LEFT,  ///< Direzione verso sinistra.
-    RIGHT  ///< Direzione verso destra.
-};
+#pragma once
+
+/**
+ * @enum Direction
+ * @brief Enumera le direzioni cardinali.
+ *
+ * Questa enumerazione rappresenta quattro possibili direzioni:
+ * - UP: Su
+ * - DOWN: Giù
+ * - LEFT: Sinistra
+ * - RIGHT: Destra
+ */
+enum class Direction
+{
+    UP,    ///< Direzione verso l'alto.
+    DOWN,  ///< Direzione verso il basso.
+    LEFT,  ///< Direzione verso sinistra.
+    RIGHT  ///< Direzione verso destra.
+};
@@ -0,0 +1,138 @@
+#include "AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+size_t AllocationTracker::lastAllocations = 0;
+size_t AllocationTracker::lastBytes = 0;
+size_t AllocationTracker::frameAllocations = 0;
+size_t AllocationTracker::frameBytes = 0;
+
+// Contatori del thread: nessuna sincronizzazione nel percorso di allocazione.
+static thread_local size_t threadAllocations = 0;
+static thread_local size_t threadBytes = 0;
+
+// Totale di tutti i thread.
+static std::atomic<size_t> totalAllocations{ 0 };
+static std::atomic<size_t> totalBytes{ 0 };
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+
+/**
+ * @brief Alloca con `malloc` e aggiorna i contatori.
+ */
+static void* trackedAllocate(std::size_t size) noexcept
+{
+    threadAllocations++;
+    threadBytes += size;
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(size, std::memory_order_relaxed);
+
+    return std::malloc(size != 0 ? size : 1);
+}
+
+void* operator new(std::size_t size)
+{
+    void* pointer = trackedAllocate(size);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size)
+{
+    void* pointer = trackedAllocate(size);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
+
+#endif
+
+bool LIB_API AllocationTracker::isEnabled()
+{
+#ifdef ENGINE_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void LIB_API AllocationTracker::markFrame()
+{
+    AllocationTracker::frameAllocations = threadAllocations - AllocationTracker::lastAllocations;
+    AllocationTracker::frameBytes = threadBytes - AllocationTracker::lastBytes;
+    AllocationTracker::lastAllocations = threadAllocations;
+    AllocationTracker::lastBytes = threadBytes;
+}
+
+size_t LIB_API AllocationTracker::getFrameAllocations()
+{
+    return AllocationTracker::frameAllocations;
+}
+
+size_t LIB_API AllocationTracker::getFrameBytes()
+{
+    return AllocationTracker::frameBytes;
+}
+
+size_t LIB_API AllocationTracker::getThreadAllocations()
+{
+    return threadAllocations;
+}
+
+size_t LIB_API AllocationTracker::getThreadBytes()
+{
+    return threadBytes;
+}
+
+size_t LIB_API AllocationTracker::getTotalAllocations()
+{
+    return totalAllocations.load(std::memory_order_relaxed);
+}
+
+size_t LIB_API AllocationTracker::getTotalBytes()
+{
+    return totalBytes.load(std::memory_order_relaxed);
+}
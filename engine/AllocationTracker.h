@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Common.h"
+
+/**
+ * @file AllocationTracker.h
+ * @brief Dichiarazione del conteggio delle allocazioni dinamiche per frame.
+ */
+
+ /**
+  * @class AllocationTracker
+  * @brief Conta le allocazioni sull'heap e i byte richiesti, in totale e per frame.
+  *
+  * Con la macro `ENGINE_TRACK_ALLOCATIONS` (definita nella configurazione Debug) l'engine
+  * sostituisce gli `operator new`/`operator delete` globali con versioni che incrementano
+  * contatori propri di ogni thread. Senza la macro nessun operatore viene sostituito e tutti
+  * i contatori restano a zero.
+  *
+  * `Engine::render` chiama `markFrame` a ogni frame: `getFrameAllocations` e `getFrameBytes`
+  * riportano le allocazioni del thread di rendering tra gli ultimi due frame. Su Windows gli
+  * operatori sostituiti valgono solo per il codice della DLL dell'engine.
+  */
+class LIB_API AllocationTracker
+{
+public:
+
+    /**
+     * @brief Verifica se il conteggio e' stato compilato nell'engine.
+     * @return `true` se `ENGINE_TRACK_ALLOCATIONS` era definita.
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief Chiude il frame del thread corrente: memorizza le allocazioni dall'ultima chiamata.
+     */
+    static void markFrame();
+
+    /**
+     * @brief Restituisce le allocazioni dell'ultimo frame chiuso da `markFrame`.
+     * @return Il numero di allocazioni.
+     */
+    static size_t getFrameAllocations();
+
+    /**
+     * @brief Restituisce i byte allocati nell'ultimo frame chiuso da `markFrame`.
+     * @return I byte richiesti.
+     */
+    static size_t getFrameBytes();
+
+    /**
+     * @brief Restituisce le allocazioni eseguite finora dal thread corrente.
+     * @return Il numero di allocazioni.
+     */
+    static size_t getThreadAllocations();
+
+    /**
+     * @brief Restituisce i byte allocati finora dal thread corrente.
+     * @return I byte richiesti.
+     */
+    static size_t getThreadBytes();
+
+    /**
+     * @brief Restituisce le allocazioni eseguite finora da tutti i thread.
+     * @return Il numero di allocazioni.
+     */
+    static size_t getTotalAllocations();
+
+    /**
+     * @brief Restituisce i byte allocati finora da tutti i thread.
+     * @return I byte richiesti.
+     */
+    static size_t getTotalBytes();
+
+private:
+    static size_t lastAllocations;  ///< Allocazioni del thread alla chiamata precedente di `markFrame`.
+    static size_t lastBytes;        ///< Byte del thread alla chiamata precedente di `markFrame`.
+    static size_t frameAllocations; ///< Allocazioni dell'ultimo frame.
+    static size_t frameBytes;       ///< Byte dell'ultimo frame.
+};
@@ -0,0 +1,303 @@
+#include "Animator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+
+std::vector<Animator::Animation> Animator::animations;
+int Animator::nextAnimationId = 0;
+
+/**
+ * @brief Avvia un'animazione a keyframe su un canale di un nodo.
+ *
+ * I canali del materiale richiedono una mesh, verificata una sola volta qui,
+ * cosi' l'aggiornamento per frame non esegue cast dinamici ne' ricerche.
+ */
+int LIB_API Animator::play(const std::shared_ptr<Node>& target, const AnimationChannel channel, const std::vector<Keyframe>& keyframes, const AnimationLoop loop)
+{
+    if (target == nullptr || keyframes.empty())
+    {
+        WARNING("Animator: invalid target or empty keyframe list.");
+        return -1;
+    }
+
+    Animation animation;
+    animation.id = Animator::nextAnimationId++;
+    animation.target = target;
+    animation.channel = channel;
+    animation.loop = loop;
+    animation.keyframes = keyframes;
+    animation.time = 0.0f;
+
+    if (channel == AnimationChannel::Emission || channel == AnimationChannel::Diffuse)
+    {
+        const std::shared_ptr<Mesh> mesh = std::dynamic_pointer_cast<Mesh>(target);
+
+        if (mesh == nullptr)
+        {
+            WARNING("Animator: material channels require a mesh (\"" << target->getName() << "\").");
+            return -1;
+        }
+    }
+
+    // Una sola animazione per nodo e canale: quella nuova sostituisce la precedente.
+    Animator::stop(target, channel);
+
+    Animator::animations.push_back(std::move(animation));
+
+    return Animator::animations.back().id;
+}
+
+/**
+ * @brief Sposta un nodo dalla posizione corrente a quella indicata.
+ */
+int LIB_API Animator::moveTo(const std::shared_ptr<Node>& target, const glm::vec3 destination, const float duration, const Easing easing)
+{
+    if (target == nullptr)
+        return -1;
+
+    const std::vector<Keyframe> keyframes = {
+        { 0.0f, target->getPosition(), Easing::Linear },
+        { std::max(duration, 0.0f), destination, easing }
+    };
+
+    return Animator::play(target, AnimationChannel::Position, keyframes);
+}
+
+/**
+ * @brief Interrompe l'animazione con l'identificatore indicato.
+ */
+void LIB_API Animator::stop(const int animationId)
+{
+    std::erase_if(Animator::animations, [animationId](const Animation& animation) {
+        return animation.id == animationId;
+        });
+}
+
+/**
+ * @brief Interrompe tutte le animazioni di un nodo.
+ */
+void LIB_API Animator::stop(const std::shared_ptr<Node>& target)
+{
+    std::erase_if(Animator::animations, [&target](const Animation& animation) {
+        return animation.target.lock() == target;
+        });
+}
+
+/**
+ * @brief Interrompe l'animazione di un canale di un nodo.
+ */
+void LIB_API Animator::stop(const std::shared_ptr<Node>& target, const AnimationChannel channel)
+{
+    std::erase_if(Animator::animations, [&target, channel](const Animation& animation) {
+        return animation.channel == channel && animation.target.lock() == target;
+        });
+}
+
+/**
+ * @brief Porta al valore finale le animazioni non cicliche di un nodo.
+ *
+ * Le animazioni cicliche vengono semplicemente interrotte.
+ */
+void LIB_API Animator::finish(const std::shared_ptr<Node>& target)
+{
+    for (Animation& animation : Animator::animations)
+    {
+        if (animation.loop == AnimationLoop::Once && animation.target.lock() == target)
+            Animator::apply(animation, animation.keyframes.back().value);
+    }
+
+    Animator::stop(target);
+}
+
+/**
+ * @brief Verifica se un nodo ha animazioni attive.
+ */
+bool LIB_API Animator::isAnimating(const std::shared_ptr<Node>& target)
+{
+    return std::any_of(Animator::animations.begin(), Animator::animations.end(), [&target](const Animation& animation) {
+        return animation.target.lock() == target;
+        });
+}
+
+size_t LIB_API Animator::getActiveCount()
+{
+    return Animator::animations.size();
+}
+
+/**
+ * @brief Avanza e applica tutte le animazioni attive.
+ *
+ * Il vettore viene percorso una sola volta: le animazioni terminate o il cui nodo
+ * e' stato distrutto vengono rimosse scambiandole con l'ultimo elemento.
+ */
+void LIB_API Animator::update(const float deltaTime)
+{
+    size_t i = 0;
+
+    while (i < Animator::animations.size())
+    {
+        Animation& animation = Animator::animations[i];
+        animation.time += deltaTime;
+
+        const float duration = animation.keyframes.back().time;
+        bool finished = false;
+        float time = animation.time;
+
+        if (duration <= 0.0f)
+        {
+            time = 0.0f;
+            finished = true;
+        }
+        else if (animation.loop == AnimationLoop::Once)
+        {
+            finished = time >= duration;
+            time = std::min(time, duration);
+        }
+        else if (animation.loop == AnimationLoop::Repeat)
+        {
+            time = std::fmod(time, duration);
+        }
+        else // PingPong
+        {
+            time = std::fmod(time, 2.0f * duration);
+            if (time > duration)
+                time = 2.0f * duration - time;
+        }
+
+        if (animation.target.expired())
+        {
+            finished = true;
+        }
+        else
+        {
+            Animator::apply(animation, Animator::sample(animation, time));
+        }
+
+        if (finished)
+        {
+            Animator::animations[i] = std::move(Animator::animations.back());
+            Animator::animations.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+/**
+ * @brief Rimuove tutte le animazioni.
+ */
+void LIB_API Animator::clear()
+{
+    Animator::animations.clear();
+}
+
+/**
+ * @brief Applica una curva di interpolazione al parametro normalizzato `t`.
+ */
+float LIB_API Animator::ease(const Easing easing, const float t)
+{
+    switch (easing)
+    {
+    case Easing::EaseInQuad:
+        return t * t;
+    case Easing::EaseOutQuad:
+        return t * (2.0f - t);
+    case Easing::EaseInOutQuad:
+        return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * (1.0f - t) * (1.0f - t);
+    case Easing::EaseInCubic:
+        return t * t * t;
+    case Easing::EaseOutCubic:
+    {
+        const float f = 1.0f - t;
+        return 1.0f - f * f * f;
+    }
+    case Easing::EaseInOutCubic:
+    {
+        if (t < 0.5f)
+            return 4.0f * t * t * t;
+        const float f = -2.0f * t + 2.0f;
+        return 1.0f - f * f * f / 2.0f;
+    }
+    case Easing::EaseInOutSine:
+        return 0.5f - 0.5f * std::cos(glm::pi<float>() * t);
+    case Easing::EaseOutBack:
+    {
+        const float c1 = 1.70158f;
+        const float c3 = c1 + 1.0f;
+        const float f = t - 1.0f;
+        return 1.0f + c3 * f * f * f + c1 * f * f;
+    }
+    case Easing::Linear:
+    default:
+        return t;
+    }
+}
+
+/**
+ * @brief Calcola il valore del canale all'istante indicato.
+ */
+glm::vec3 Animator::sample(const Animation& animation, const float time)
+{
+    const std::vector<Keyframe>& keys = animation.keyframes;
+
+    if (time <= keys.front().time)
+        return keys.front().value;
+
+    // Le animazioni hanno pochi keyframe: una ricerca lineare e' sufficiente.
+    for (size_t k = 1; k < keys.size(); ++k)
+    {
+        if (time <= keys[k].time)
+        {
+            const float span = keys[k].time - keys[k - 1].time;
+            const float t = span > 0.0f ? (time - keys[k - 1].time) / span : 1.0f;
+            return glm::mix(keys[k - 1].value, keys[k].value, Animator::ease(keys[k].easing, t));
+        }
+    }
+
+    return keys.back().value;
+}
+
+/**
+ * @brief Scrive il valore calcolato sul nodo animato.
+ *
+ * I setter di `Node` marcano il nodo come da ricalcolare: solo i nodi animati vengono toccati.
+ * I canali del materiale scrivono l'override della mesh, quindi il materiale condiviso
+ * con le altre mesh non viene modificato.
+ */
+void Animator::apply(Animation& animation, const glm::vec3 value)
+{
+    const std::shared_ptr<Node> target = animation.target.lock();
+
+    if (target == nullptr)
+        return;
+
+    switch (animation.channel)
+    {
+    case AnimationChannel::Position:
+        target->setPosition(value);
+        break;
+    case AnimationChannel::Rotation:
+        target->setRotation(value);
+        break;
+    case AnimationChannel::Scale:
+        target->setScale(value);
+        break;
+    case AnimationChannel::Emission:
+    case AnimationChannel::Diffuse:
+    {
+        Mesh* mesh = static_cast<Mesh*>(target.get());
+        MaterialOverride materialOverride = mesh->getMaterialOverride();
+
+        if (animation.channel == AnimationChannel::Emission)
+            materialOverride.emission = value;
+        else
+            materialOverride.diffuseTint = value;
+
+        mesh->setMaterialOverride(materialOverride);
+        break;
+    }
+    }
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Node.h"
+#include "Mesh.h"
+#include "Common.h"
+
+/**
+ * @file Animator.h
+ * @brief Dichiarazione del sottosistema di animazione (tween a keyframe) dell'engine.
+ *
+ * Le animazioni attive sono conservate in un unico vettore e valutate in blocco
+ * ad ogni frame da `Engine::update`. Ogni animazione mantiene un riferimento diretto
+ * al nodo animato, quindi non sono necessarie ricerche per nome durante l'esecuzione.
+ */
+
+ /**
+  * @brief Curve di interpolazione applicabili ad un segmento tra due keyframe.
+  */
+enum class Easing
+{
+    Linear,
+    EaseInQuad,
+    EaseOutQuad,
+    EaseInOutQuad,
+    EaseInCubic,
+    EaseOutCubic,
+    EaseInOutCubic,
+    EaseInOutSine,
+    EaseOutBack
+};
+
+/**
+ * @brief Proprieta' animabili.
+ *
+ * I canali `Position`, `Rotation` e `Scale` agiscono sulla trasformazione del nodo,
+ * `Emission` e `Diffuse` sull'override del materiale della mesh animata
+ * (emissione aggiunta e tinta diffusa, vedi `MaterialOverride`).
+ */
+enum class AnimationChannel
+{
+    Position,
+    Rotation,
+    Scale,
+    Emission,
+    Diffuse
+};
+
+/**
+ * @brief Comportamento dell'animazione al termine dell'ultimo keyframe.
+ */
+enum class AnimationLoop
+{
+    Once,     ///< L'animazione termina e viene rimossa.
+    Repeat,   ///< L'animazione ricomincia dal primo keyframe.
+    PingPong  ///< L'animazione viene ripetuta alternando avanti e indietro.
+};
+
+/**
+ * @struct Keyframe
+ * @brief Valore di un canale in un istante dell'animazione.
+ */
+struct LIB_API Keyframe
+{
+    float time;       ///< Istante del keyframe in secondi dall'inizio dell'animazione.
+    glm::vec3 value;  ///< Valore del canale in questo istante.
+    Easing easing;    ///< Curva usata per il segmento che termina in questo keyframe.
+};
+
+/**
+ * @class Animator
+ * @brief Gestisce e valuta tutte le animazioni attive della scena.
+ *
+ * Esempio di utilizzo:
+ * @code
+ * Animator::moveTo(pieceNode, newPosition, 0.35f, Easing::EaseInOutCubic);
+ * @endcode
+ */
+class LIB_API Animator
+{
+public:
+
+    /**
+     * @brief Avvia un'animazione a keyframe su un canale di un nodo.
+     *
+     * Un'animazione gia' attiva sullo stesso nodo e canale viene sostituita.
+     *
+     * @param target Il nodo da animare (deve essere una `Mesh` per i canali del materiale).
+     * @param channel Il canale da animare.
+     * @param keyframes I keyframe, ordinati per tempo crescente.
+     * @param loop Il comportamento al termine dell'animazione.
+     * @return L'identificatore dell'animazione, oppure -1 se i parametri non sono validi.
+     */
+    static int play(const std::shared_ptr<Node>& target, const AnimationChannel channel, const std::vector<Keyframe>& keyframes, const AnimationLoop loop = AnimationLoop::Once);
+
+    /**
+     * @brief Sposta un nodo dalla posizione corrente a quella indicata.
+     * @param target Il nodo da spostare.
+     * @param destination La posizione finale.
+     * @param duration La durata in secondi.
+     * @param easing La curva di interpolazione.
+     * @return L'identificatore dell'animazione.
+     */
+    static int moveTo(const std::shared_ptr<Node>& target, const glm::vec3 destination, const float duration, const Easing easing = Easing::EaseInOutCubic);
+
+    /**
+     * @brief Interrompe l'animazione con l'identificatore indicato, lasciando il valore corrente.
+     * @param animationId L'identificatore restituito da `play`.
+     */
+    static void stop(const int animationId);
+
+    /**
+     * @brief Interrompe tutte le animazioni di un nodo, lasciando i valori correnti.
+     * @param target Il nodo animato.
+     */
+    static void stop(const std::shared_ptr<Node>& target);
+
+    /**
+     * @brief Interrompe l'animazione di un canale di un nodo, lasciando il valore corrente.
+     * @param target Il nodo animato.
+     * @param channel Il canale da interrompere.
+     */
+    static void stop(const std::shared_ptr<Node>& target, const AnimationChannel channel);
+
+    /**
+     * @brief Porta immediatamente al valore finale le animazioni non cicliche di un nodo e le rimuove.
+     * @param target Il nodo animato.
+     */
+    static void finish(const std::shared_ptr<Node>& target);
+
+    /**
+     * @brief Verifica se un nodo ha animazioni attive.
+     * @param target Il nodo da verificare.
+     * @return `true` se almeno un'animazione agisce sul nodo.
+     */
+    static bool isAnimating(const std::shared_ptr<Node>& target);
+
+    /**
+     * @brief Restituisce il numero di animazioni attive.
+     * @return Il numero di animazioni attive.
+     */
+    static size_t getActiveCount();
+
+    /**
+     * @brief Avanza e applica tutte le animazioni attive.
+     *
+     * Viene chiamata automaticamente da `Engine::update`.
+     *
+     * @param deltaTime Il tempo trascorso dall'ultimo aggiornamento, in secondi.
+     */
+    static void update(const float deltaTime);
+
+    /**
+     * @brief Rimuove tutte le animazioni senza modificare i valori correnti.
+     */
+    static void clear();
+
+    /**
+     * @brief Applica una curva di interpolazione.
+     * @param easing La curva da applicare.
+     * @param t Il parametro normalizzato in [0, 1].
+     * @return Il parametro trasformato.
+     */
+    static float ease(const Easing easing, const float t);
+
+private:
+
+    /**
+     * @struct Animation
+     * @brief Stato di un'animazione attiva.
+     */
+    struct Animation
+    {
+        int id;                              ///< Identificatore dell'animazione.
+        std::weak_ptr<Node> target;          ///< Nodo animato.
+        AnimationChannel channel;            ///< Canale animato.
+        AnimationLoop loop;                  ///< Comportamento al termine.
+        std::vector<Keyframe> keyframes;     ///< Keyframe dell'animazione.
+        float time;                          ///< Tempo trascorso dall'inizio.
+    };
+
+    static glm::vec3 sample(const Animation& animation, const float time);
+    static void apply(Animation& animation, const glm::vec3 value);
+
+    static std::vector<Animation> animations; ///< Animazioni attive, valutate in blocco.
+    static int nextAnimationId;               ///< Prossimo identificatore da assegnare.
+};
@@ -0,0 +1,217 @@
+#include "ChunkCompressor.h"
+
+#include <cstring>
+
+// Parametri del formato a blocchi di LZ4.
+static constexpr size_t MIN_MATCH = 4;        // Lunghezza minima di una ripetizione.
+static constexpr size_t LAST_LITERALS = 5;    // Gli ultimi byte sono sempre letterali.
+static constexpr size_t MF_LIMIT = 12;        // Una ripetizione inizia almeno 12 byte prima della fine.
+static constexpr size_t MAX_OFFSET = 65535;   // Distanza massima di una ripetizione.
+static constexpr uint32_t HASH_BITS = 16;
+
+static uint32_t read32(const uint8_t* data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(uint32_t));
+    return value;
+}
+
+static uint32_t hash32(const uint32_t sequence)
+{
+    // Hash moltiplicativo di Knuth sui 4 byte della sequenza.
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/**
+ * @brief Scrive la parte di una lunghezza che non sta nei 4 bit del token: byte da 255 e il resto.
+ */
+static void putLength(std::vector<uint8_t>& output, size_t length)
+{
+    while (length >= 255)
+    {
+        output.push_back(255);
+        length -= 255;
+    }
+    output.push_back((uint8_t)length);
+}
+
+/**
+ * @brief Scrive una sequenza: letterali e, se `matchLength` non e' zero, una ripetizione.
+ */
+static void putSequence(std::vector<uint8_t>& output, const uint8_t* literals, const size_t literalLength, const size_t offset, const size_t matchLength)
+{
+    const size_t matchCode = matchLength > 0 ? matchLength - MIN_MATCH : 0;
+    output.push_back((uint8_t)((literalLength < 15 ? literalLength : 15) << 4 | (matchCode < 15 ? matchCode : 15)));
+
+    if (literalLength >= 15)
+        putLength(output, literalLength - 15);
+    output.insert(output.end(), literals, literals + literalLength);
+
+    if (matchLength == 0)
+        return;
+
+    output.push_back((uint8_t)(offset & 0xFF));
+    output.push_back((uint8_t)(offset >> 8));
+
+    if (matchCode >= 15)
+        putLength(output, matchCode - 15);
+}
+
+/**
+ * @brief Legge la parte estesa di una lunghezza; `false` se i dati finiscono o la lunghezza supera `limit`.
+ */
+static bool readLength(const uint8_t* data, const size_t size, size_t& pointer, size_t& length, const size_t limit)
+{
+    uint8_t byte;
+    do
+    {
+        if (pointer >= size)
+            return false;
+        byte = data[pointer++];
+        length += byte;
+        if (length > limit)
+            return false;
+    } while (byte == 255);
+
+    return true;
+}
+
+size_t LIB_API ChunkCompressor::getMaxCompressedSize(const size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+/**
+ * @brief Un letterale produce un byte e una ripetizione al massimo 19 byte per i suoi 3 byte
+ * (token e distanza); ogni byte di lunghezza estesa ne aggiunge al massimo 255.
+ */
+size_t LIB_API ChunkCompressor::getMaxDecompressedSize(const size_t size)
+{
+    return size * 255;
+}
+
+/**
+ * @brief Comprime in modo greedy: per ogni posizione cerca nella tabella hash l'ultima
+ * occorrenza degli stessi 4 byte e, se trovata, la estende in avanti e all'indietro.
+ */
+void LIB_API ChunkCompressor::compress(const uint8_t* data, const size_t size, std::vector<uint8_t>& output)
+{
+    output.clear();
+    output.reserve(ChunkCompressor::getMaxCompressedSize(size));
+
+    size_t anchor = 0;
+
+    if (size > MF_LIMIT)
+    {
+        std::vector<uint32_t> table((size_t)1 << HASH_BITS, 0);
+
+        const size_t matchLimit = size - LAST_LITERALS;
+        const size_t searchLimit = size - MF_LIMIT;
+        size_t position = 1;
+
+        while (position < searchLimit)
+        {
+            const uint32_t sequence = read32(data + position);
+            const uint32_t hash = hash32(sequence);
+            size_t candidate = table[hash];
+            table[hash] = (uint32_t)position;
+
+            if (position - candidate > MAX_OFFSET || read32(data + candidate) != sequence)
+            {
+                // Sui dati incomprimibili il passo cresce: 1 byte ogni 64 letterali consecutivi.
+                position += 1 + ((position - anchor) >> 6);
+                continue;
+            }
+
+            // Estende la ripetizione all'indietro sui letterali non ancora scritti.
+            while (position > anchor && candidate > 0 && data[position - 1] == data[candidate - 1])
+            {
+                position--;
+                candidate--;
+            }
+
+            size_t length = MIN_MATCH;
+            while (position + length < matchLimit && data[candidate + length] == data[position + length])
+                length++;
+
+            putSequence(output, data + anchor, position - anchor, position - candidate, length);
+
+            position += length;
+            anchor = position;
+
+            // La posizione appena prima della fine della ripetizione aiuta a trovare la successiva.
+            if (position - 2 < searchLimit)
+                table[hash32(read32(data + position - 2))] = (uint32_t)(position - 2);
+        }
+    }
+
+    // Ultima sequenza: solo letterali.
+    putSequence(output, data + anchor, size - anchor, 0, 0);
+}
+
+bool LIB_API ChunkCompressor::decompress(const uint8_t* data, const size_t size, uint8_t* output, const size_t outputSize)
+{
+    size_t input = 0;
+    size_t written = 0;
+
+    while (input < size)
+    {
+        const uint8_t token = data[input++];
+
+        // Letterali
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(data, size, input, literalLength, outputSize))
+            return false;
+
+        if (literalLength > size - input || literalLength > outputSize - written)
+            return false;
+
+        memcpy(output + written, data + input, literalLength);
+        input += literalLength;
+        written += literalLength;
+
+        // L'ultima sequenza non ha ripetizione.
+        if (input == size)
+            break;
+
+        // Ripetizione
+        if (size - input < 2)
+            return false;
+
+        const size_t offset = (size_t)data[input] | (size_t)data[input + 1] << 8;
+        input += 2;
+
+        if (offset == 0 || offset > written)
+            return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(data, size, input, matchLength, outputSize))
+            return false;
+        matchLength += MIN_MATCH;
+
+        if (matchLength > outputSize - written)
+            return false;
+
+        // Copia byte per byte: la ripetizione puo' sovrapporsi ai byte che sta scrivendo.
+        const uint8_t* source = output + written - offset;
+        for (size_t i = 0; i < matchLength; i++)
+            output[written + i] = source[i];
+        written += matchLength;
+    }
+
+    return written == outputSize;
+}
+
+void LIB_API ChunkCompressor::shuffle(const uint8_t* data, const size_t count, const size_t stride, uint8_t* output)
+{
+    for (size_t b = 0; b < stride; b++)
+        for (size_t i = 0; i < count; i++)
+            output[b * count + i] = data[i * stride + b];
+}
+
+void LIB_API ChunkCompressor::unshuffle(const uint8_t* data, const size_t count, const size_t stride, uint8_t* output)
+{
+    for (size_t b = 0; b < stride; b++)
+        for (size_t i = 0; i < count; i++)
+            output[i * stride + b] = data[b * count + i];
+}
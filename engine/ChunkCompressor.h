@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Common.h"
+
+/**
+ * @file ChunkCompressor.h
+ * @brief Dichiarazione della compressione dei chunk OVO estesi.
+ */
+
+ /**
+  * @class ChunkCompressor
+  * @brief Comprime e decomprime blocchi di byte nel formato a blocchi di LZ4.
+  *
+  * I dati compressi sono sequenze di letterali e ripetizioni (distanza fino a 64 KB, lunghezza
+  * minima 4), compatibili con `LZ4_decompress_safe`. La compressione e' greedy con una tabella
+  * hash da 64K posizioni: non raggiunge i livelli alti di LZ4 ma e' veloce e senza dipendenze.
+  * La decompressione controlla tutti i limiti e rifiuta i dati corrotti invece di leggere o
+  * scrivere fuori dai buffer.
+  *
+  * `shuffle` raggruppa i byte di elementi a dimensione fissa per posizione nell'elemento
+  * (prima tutti i primi byte, poi tutti i secondi, ...): su vertici e indici i byte alti,
+  * quasi costanti, diventano lunghe ripetizioni e la compressione migliora molto.
+  */
+class LIB_API ChunkCompressor
+{
+public:
+
+    /**
+     * @brief Restituisce la dimensione massima dei dati compressi.
+     * @param size La dimensione dei dati da comprimere.
+     * @return I byte da riservare nel caso peggiore (dati incomprimibili).
+     */
+    static size_t getMaxCompressedSize(const size_t size);
+
+    /**
+     * @brief Restituisce la dimensione massima che dei dati compressi possono produrre.
+     * @param size La dimensione dei dati compressi.
+     * @return I byte oltre i quali una dimensione decompressa dichiarata e' sicuramente errata.
+     */
+    static size_t getMaxDecompressedSize(const size_t size);
+
+    /**
+     * @brief Comprime un blocco di byte.
+     * @param data I dati da comprimere.
+     * @param size La dimensione dei dati.
+     * @param output Riceve i dati compressi (il contenuto precedente viene sostituito).
+     */
+    static void compress(const uint8_t* data, const size_t size, std::vector<uint8_t>& output);
+
+    /**
+     * @brief Decomprime un blocco di byte.
+     * @param data I dati compressi.
+     * @param size La dimensione dei dati compressi.
+     * @param output Il buffer che riceve i dati decompressi.
+     * @param outputSize La dimensione esatta dei dati decompressi.
+     * @return `false` se i dati sono corrotti o non producono esattamente `outputSize` byte.
+     */
+    static bool decompress(const uint8_t* data, const size_t size, uint8_t* output, const size_t outputSize);
+
+    /**
+     * @brief Raggruppa i byte di `count` elementi di `stride` byte per posizione nell'elemento.
+     * @param data Gli elementi.
+     * @param count Il numero di elementi.
+     * @param stride La dimensione di un elemento.
+     * @param output Il buffer di `count * stride` byte che riceve i byte riordinati.
+     */
+    static void shuffle(const uint8_t* data, const size_t count, const size_t stride, uint8_t* output);
+
+    /**
+     * @brief Ripristina l'ordine dei byte prodotto da `shuffle`.
+     * @param data I byte riordinati.
+     * @param count Il numero di elementi.
+     * @param stride La dimensione di un elemento.
+     * @param output Il buffer di `count * stride` byte che riceve gli elementi.
+     */
+    static void unshuffle(const uint8_t* data, const size_t count, const size_t stride, uint8_t* output);
+};
@@ -1,41 +1,74 @@
-#pragma once
-
-#include <iostream>
-
-/**
- * @brief Definisce la macro LIB_API per gestire l'esportazione/importazione di simboli in DLL.
- */
-#ifdef _WINDOWS
-#ifdef SIMPLEDYNLIB_EXPORTS
-#define LIB_API __declspec(dllexport)
-#else
-#define LIB_API __declspec(dllimport)
-#endif
-#else
-#define LIB_API
-#endif
-
- /**
-  * @brief Abilita o disabilita i messaggi di debug.
-  */
-#ifndef _DEBUG
-#define _DEBUG
-#endif
-#ifdef _DEBUG
-#define DEBUG(message) \
-    std::cout << "[DEBUG] " << message << std::endl;
-#else
-#define DEBUG(message)
-#endif
-
-  /**
-   * @brief Macro per stampare messaggi di avviso.
-   */
-#define WARNING(message) \
-    std::cout << "[WARNING] " << message << std::endl;
-
-   /**
-    * @brief Macro per stampare messaggi di errore.
-    */
-#define ERROR(message) \
-    std::cerr << "[ERROR] " << message << std::endl;
+#pragma once
+
+#include <iostream>
+
+/**
+ * @brief Definisce la macro LIB_API per gestire l'esportazione/importazione di simboli in DLL.
+ */
+#ifdef _WINDOWS
+#ifdef SIMPLEDYNLIB_EXPORTS
+#define LIB_API __declspec(dllexport)
+#else
+#define LIB_API __declspec(dllimport)
+#endif
+#else
+#define LIB_API
+#endif
+
+ /**
+  * @brief Livello minimo dei messaggi compilati: 0 debug, 1 info, 2 avvisi, 3 errori, 4 nessuno.
+  *
+  * Le macro dei livelli inferiori non generano codice. Per default i messaggi di debug
+  * vengono compilati solo nella configurazione Debug.
+  */
+#ifndef ENGINE_LOG_LEVEL
+#ifdef _DEBUG
+#define ENGINE_LOG_LEVEL 0
+#else
+#define ENGINE_LOG_LEVEL 1
+#endif
+#endif
+
+#include "Logger.h"
+
+ /**
+  * @brief Accoda un messaggio al `Logger` se il suo livello e' abilitato.
+  */
+#define ENGINE_LOG(level, message) \
+    do { if (Logger::isEnabled(level)) { Logger::stream() << message; Logger::submit(level); } } while (0)
+
+ /**
+  * @brief Macro per i messaggi di debug.
+  */
+#if ENGINE_LOG_LEVEL <= 0
+#define DEBUG(message) ENGINE_LOG(LogLevel::Debug, message)
+#else
+#define DEBUG(message) do { } while (0)
+#endif
+
+ /**
+  * @brief Macro per i messaggi informativi.
+  */
+#if ENGINE_LOG_LEVEL <= 1
+#define INFO(message) ENGINE_LOG(LogLevel::Info, message)
+#else
+#define INFO(message) do { } while (0)
+#endif
+
+  /**
+   * @brief Macro per stampare messaggi di avviso.
+   */
+#if ENGINE_LOG_LEVEL <= 2
+#define WARNING(message) ENGINE_LOG(LogLevel::Warning, message)
+#else
+#define WARNING(message) do { } while (0)
+#endif
+
+   /**
+    * @brief Macro per stampare messaggi di errore.
+    */
+#if ENGINE_LOG_LEVEL <= 3
+#define ERROR(message) ENGINE_LOG(LogLevel::Error, message)
+#else
+#define ERROR(message) do { } while (0)
+#endif
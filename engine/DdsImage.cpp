@@ -0,0 +1,275 @@
+#include "DdsImage.h"
+#include "GLExtensions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+// Campi dell'intestazione DDS (posizioni dall'inizio del file, dopo il magic "DDS ").
+static constexpr size_t DDS_HEADER_SIZE = 128;
+static constexpr size_t DDS_DX10_HEADER_SIZE = 20;
+static constexpr size_t DDS_HEIGHT = 12;
+static constexpr size_t DDS_WIDTH = 16;
+static constexpr size_t DDS_MIPMAP_COUNT = 28;
+static constexpr size_t DDS_PIXEL_FORMAT_FLAGS = 80;
+static constexpr size_t DDS_FOURCC = 84;
+static constexpr size_t DDS_CAPS2 = 112;
+static constexpr size_t DDS_FLAGS = 8;
+
+static constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+static constexpr uint32_t DDPF_FOURCC = 0x4;
+static constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+static constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+
+static uint32_t readUint32(const uint8_t* data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(uint32_t));
+    return value;
+}
+
+static constexpr uint32_t makeFourCC(const char a, const char b, const char c, const char d)
+{
+    return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+}
+
+/**
+ * @brief Legge e analizza un file DDS.
+ */
+bool LIB_API DdsImage::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if (!file.is_open())
+        return false;
+
+    const std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    std::vector<uint8_t> content((size_t)std::max<std::streamsize>(size, 0));
+
+    if (!file.read((char*)content.data(), size))
+        return false;
+
+    return this->parse(content.data(), content.size());
+}
+
+/**
+ * @brief Analizza il contenuto di un file DDS gia' in memoria.
+ */
+bool LIB_API DdsImage::parse(const uint8_t* data, const size_t size)
+{
+    this->_format = 0;
+    this->_blockSize = 0;
+    this->_levels.clear();
+    this->_data.clear();
+
+    if (data == nullptr || size < DDS_HEADER_SIZE || memcmp(data, "DDS ", 4) != 0)
+        return false;
+
+    if ((readUint32(data + DDS_CAPS2) & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)) != 0)
+        return false;
+
+    if ((readUint32(data + DDS_PIXEL_FORMAT_FLAGS) & DDPF_FOURCC) == 0)
+        return false;
+
+    const int width = (int)readUint32(data + DDS_WIDTH);
+    const int height = (int)readUint32(data + DDS_HEIGHT);
+    const uint32_t fourCC = readUint32(data + DDS_FOURCC);
+    size_t dataOffset = DDS_HEADER_SIZE;
+
+    if (width <= 0 || height <= 0)
+        return false;
+
+    switch (fourCC)
+    {
+    case makeFourCC('D', 'X', 'T', '1'):
+        this->_format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        break;
+    case makeFourCC('D', 'X', 'T', '3'):
+        this->_format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        break;
+    case makeFourCC('D', 'X', 'T', '5'):
+        this->_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        break;
+    case makeFourCC('D', 'X', '1', '0'):
+    {
+        if (size < DDS_HEADER_SIZE + DDS_DX10_HEADER_SIZE)
+            return false;
+
+        // Formati DXGI: BC1, BC2 e BC3 (anche nelle varianti sRGB, trattate come lineari).
+        const uint32_t dxgiFormat = readUint32(data + DDS_HEADER_SIZE);
+        const uint32_t arraySize = readUint32(data + DDS_HEADER_SIZE + 12);
+
+        if (arraySize > 1)
+            return false;
+
+        if (dxgiFormat == 71 || dxgiFormat == 72)
+            this->_format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        else if (dxgiFormat == 74 || dxgiFormat == 75)
+            this->_format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        else if (dxgiFormat == 77 || dxgiFormat == 78)
+            this->_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+
+        dataOffset += DDS_DX10_HEADER_SIZE;
+        break;
+    }
+    default:
+        break;
+    }
+
+    if (this->_format == 0)
+        return false;
+
+    this->_blockSize = this->_format == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT ? 8 : 16;
+
+    int levelCount = 1;
+    if ((readUint32(data + DDS_FLAGS) & DDSD_MIPMAPCOUNT) != 0)
+        levelCount = std::max(1, (int)readUint32(data + DDS_MIPMAP_COUNT));
+
+    // Conserva solo i livelli interamente contenuti nel file.
+    int levelWidth = width;
+    int levelHeight = height;
+    size_t levelOffset = 0;
+
+    for (int i = 0; i < levelCount; i++)
+    {
+        const size_t levelSize = DdsImage::getLevelSize(levelWidth, levelHeight, this->_blockSize);
+
+        if (dataOffset + levelOffset + levelSize > size)
+            break;
+
+        this->_levels.push_back({ levelWidth, levelHeight, levelOffset, levelSize });
+        levelOffset += levelSize;
+
+        if (levelWidth == 1 && levelHeight == 1)
+            break;
+
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+    }
+
+    if (this->_levels.empty())
+    {
+        this->_format = 0;
+        this->_blockSize = 0;
+        return false;
+    }
+
+    this->_data.assign(data + dataOffset, data + dataOffset + levelOffset);
+    return true;
+}
+
+/**
+ * @brief Capovolge verticalmente tutti i livelli.
+ */
+void LIB_API DdsImage::flipVertically()
+{
+    std::vector<uint8_t> rowBuffer;
+
+    for (const Level& level : this->_levels)
+    {
+        const int blocksX = std::max(1, (level.width + 3) / 4);
+        const int blocksY = std::max(1, (level.height + 3) / 4);
+        const size_t rowSize = (size_t)blocksX * this->_blockSize;
+        const int rows = std::min(4, level.height);
+        uint8_t* levelData = this->_data.data() + level.offset;
+
+        // Inverte le righe di pixel dentro ogni blocco.
+        for (size_t offset = 0; offset < level.size; offset += this->_blockSize)
+            this->flipBlock(levelData + offset, rows);
+
+        // Inverte l'ordine delle righe di blocchi.
+        rowBuffer.resize(rowSize);
+        for (int y = 0; y < blocksY / 2; y++)
+        {
+            uint8_t* top = levelData + (size_t)y * rowSize;
+            uint8_t* bottom = levelData + (size_t)(blocksY - 1 - y) * rowSize;
+            memcpy(rowBuffer.data(), top, rowSize);
+            memcpy(top, bottom, rowSize);
+            memcpy(bottom, rowBuffer.data(), rowSize);
+        }
+    }
+}
+
+/**
+ * @brief Inverte le prime `rows` righe di pixel di un blocco compresso.
+ */
+void DdsImage::flipBlock(uint8_t* block, const int rows) const
+{
+    uint8_t* colorBlock = block;
+
+    if (this->_format == GL_COMPRESSED_RGBA_S3TC_DXT3_EXT)
+    {
+        // Alpha esplicito: 2 byte per riga.
+        for (int row = 0; row < rows / 2; row++)
+        {
+            std::swap(block[2 * row], block[2 * (rows - 1 - row)]);
+            std::swap(block[2 * row + 1], block[2 * (rows - 1 - row) + 1]);
+        }
+        colorBlock = block + 8;
+    }
+    else if (this->_format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+    {
+        // Alpha interpolato: 2 estremi seguiti da 48 bit di indici, 12 bit per riga.
+        uint64_t indices = 0;
+        memcpy(&indices, block + 2, 6);
+
+        uint64_t flipped = indices;
+        for (int row = 0; row < rows; row++)
+        {
+            const uint64_t mask = (uint64_t)0xFFF << (12 * (rows - 1 - row));
+            flipped &= ~((uint64_t)0xFFF << (12 * row));
+            flipped |= ((indices & mask) >> (12 * (rows - 1 - row))) << (12 * row);
+        }
+
+        memcpy(block + 2, &flipped, 6);
+        colorBlock = block + 8;
+    }
+
+    // Colore: 2 colori a 16 bit seguiti da un byte di indici per riga.
+    for (int row = 0; row < rows / 2; row++)
+        std::swap(colorBlock[4 + row], colorBlock[4 + rows - 1 - row]);
+}
+
+void LIB_API DdsImage::release()
+{
+    this->_data.clear();
+    this->_data.shrink_to_fit();
+}
+
+bool LIB_API DdsImage::isValid() const
+{
+    return this->_format != 0 && !this->_levels.empty();
+}
+
+unsigned int LIB_API DdsImage::getFormat() const
+{
+    return this->_format;
+}
+
+int LIB_API DdsImage::getBlockSize() const
+{
+    return this->_blockSize;
+}
+
+const std::vector<DdsImage::Level>& LIB_API DdsImage::getLevels() const
+{
+    return this->_levels;
+}
+
+const uint8_t* LIB_API DdsImage::getData() const
+{
+    return this->_data.data();
+}
+
+size_t LIB_API DdsImage::getDataSize() const
+{
+    return this->_data.size();
+}
+
+size_t LIB_API DdsImage::getLevelSize(const int width, const int height, const int blockSize)
+{
+    return (size_t)std::max(1, (width + 3) / 4) * (size_t)std::max(1, (height + 3) / 4) * blockSize;
+}
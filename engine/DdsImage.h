@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+
+/**
+ * @file DdsImage.h
+ * @brief Dichiarazione del lettore di file DDS con compressione a blocchi (DXT1/DXT3/DXT5).
+ */
+
+ /**
+  * @class DdsImage
+  * @brief Legge un file DDS compresso e ne conserva i livelli di mipmap pronti per `glCompressedTexImage2D`.
+  *
+  * Sono supportati i formati DXT1, DXT3 e DXT5 (BC1-BC3), anche con intestazione DX10.
+  * Le texture cubiche, i volumi e i formati non compressi non sono supportati: in questi casi
+  * `parse` restituisce `false` e il chiamante puo' ripiegare su FreeImage.
+  */
+class LIB_API DdsImage
+{
+public:
+
+    /**
+     * @struct Level
+     * @brief Un livello di mipmap all'interno dei dati compressi.
+     */
+    struct Level
+    {
+        int width;       ///< Larghezza in pixel.
+        int height;      ///< Altezza in pixel.
+        size_t offset;   ///< Posizione dei dati del livello in `getData`.
+        size_t size;     ///< Dimensione in byte dei dati del livello.
+    };
+
+    /**
+     * @brief Legge e analizza un file DDS.
+     * @param path Il percorso del file.
+     * @return `true` se il file contiene un formato compresso supportato.
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Analizza il contenuto di un file DDS gia' in memoria.
+     *
+     * Se la catena di mipmap e' troncata vengono conservati solo i livelli completi.
+     *
+     * @param data Il contenuto del file.
+     * @param size La dimensione del contenuto in byte.
+     * @return `true` se il contenuto e' un DDS compresso supportato.
+     */
+    bool parse(const uint8_t* data, const size_t size);
+
+    /**
+     * @brief Capovolge verticalmente tutti i livelli.
+     *
+     * I DDS memorizzano le righe dall'alto verso il basso, OpenGL dal basso verso l'alto:
+     * vengono invertite le righe di blocchi e le righe di pixel dentro ogni blocco, senza
+     * decomprimere. Con altezze non multiple di 4 l'ultima riga di blocchi resta approssimata.
+     */
+    void flipVertically();
+
+    /**
+     * @brief Libera i dati compressi mantenendo le informazioni sul formato.
+     */
+    void release();
+
+    /**
+     * @brief Verifica se l'immagine contiene dati validi.
+     * @return `true` dopo una chiamata a `load` o `parse` riuscita.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Restituisce il formato interno OpenGL (`GL_COMPRESSED_RGBA_S3TC_DXT*_EXT`).
+     * @return Il formato, 0 se l'immagine non e' valida.
+     */
+    unsigned int getFormat() const;
+
+    /**
+     * @brief Restituisce la dimensione in byte di un blocco 4x4.
+     * @return 8 per DXT1, 16 per DXT3 e DXT5.
+     */
+    int getBlockSize() const;
+
+    /**
+     * @brief Restituisce i livelli di mipmap, dal piu' grande al piu' piccolo.
+     * @return I livelli letti.
+     */
+    const std::vector<Level>& getLevels() const;
+
+    /**
+     * @brief Restituisce i dati compressi di tutti i livelli.
+     * @return Il puntatore all'inizio dei dati.
+     */
+    const uint8_t* getData() const;
+
+    /**
+     * @brief Restituisce la dimensione complessiva dei dati compressi.
+     * @return La dimensione in byte.
+     */
+    size_t getDataSize() const;
+
+    /**
+     * @brief Calcola la dimensione in byte di un livello compresso.
+     * @param width La larghezza in pixel.
+     * @param height L'altezza in pixel.
+     * @param blockSize La dimensione di un blocco 4x4.
+     * @return La dimensione del livello.
+     */
+    static size_t getLevelSize(const int width, const int height, const int blockSize);
+
+private:
+    void flipBlock(uint8_t* block, const int rows) const;
+
+    unsigned int _format = 0;        ///< Formato interno OpenGL.
+    int _blockSize = 0;              ///< Byte per blocco 4x4.
+    std::vector<Level> _levels;      ///< Livelli di mipmap.
+    std::vector<uint8_t> _data;      ///< Dati compressi di tutti i livelli.
+};
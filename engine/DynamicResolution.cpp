@@ -0,0 +1,239 @@
+#include "DynamicResolution.h"
+#include "GLExtensions.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// Peso della misura piu' recente nella media mobile del tempo per frame.
+static constexpr float FRAME_TIME_SMOOTHING = 0.1f;
+
+/// Variazione massima della scala in un frame.
+static constexpr float MAX_SCALE_STEP = 0.05f;
+
+/// Sopra questa frazione del budget la scala scende.
+static constexpr float OVER_BUDGET = 1.05f;
+
+/// Sotto questa frazione del budget la scala sale.
+static constexpr float UNDER_BUDGET = 0.85f;
+
+DynamicResolution::DynamicResolution(const float targetFrameTime, const float minScale, const float maxScale)
+    : _targetFrameTime{ targetFrameTime }, _minScale{ minScale }, _maxScale{ maxScale }, _scale{ maxScale }
+{
+    this->setScaleRange(minScale, maxScale);
+}
+
+void LIB_API DynamicResolution::setTargetFrameTime(const float milliseconds)
+{
+    this->_targetFrameTime = std::max(milliseconds, 1.0f);
+}
+
+float LIB_API DynamicResolution::getTargetFrameTime() const
+{
+    return this->_targetFrameTime;
+}
+
+void LIB_API DynamicResolution::setScaleRange(const float minScale, const float maxScale)
+{
+    this->_maxScale = std::clamp(maxScale, 0.1f, 1.0f);
+    this->_minScale = std::clamp(minScale, 0.1f, this->_maxScale);
+    this->_scale = std::clamp(this->_scale, this->_minScale, this->_maxScale);
+}
+
+float LIB_API DynamicResolution::getScale() const
+{
+    return this->_scale;
+}
+
+float LIB_API DynamicResolution::getAverageFrameTime() const
+{
+    return this->_averageFrameTime;
+}
+
+/**
+ * @brief Aggiorna la scala con il tempo di un frame.
+ *
+ * Fuori dalla banda [0.85, 1.05] del budget la scala viene portata verso quella che, con costo
+ * proporzionale ai pixel, darebbe esattamente il budget: `scala * sqrt(budget / tempo)`.
+ * Il passo per frame e' limitato e la scala e' arrotondata al centesimo, cosi' che piccole
+ * oscillazioni del tempo non la facciano cambiare a ogni frame.
+ */
+float LIB_API DynamicResolution::update(const float frameTime)
+{
+    if (frameTime <= 0.0f)
+        return this->_scale;
+
+    if (this->_averageFrameTime <= 0.0f)
+        this->_averageFrameTime = frameTime;
+    else
+        this->_averageFrameTime += (frameTime - this->_averageFrameTime) * FRAME_TIME_SMOOTHING;
+
+    if (this->_averageFrameTime > this->_targetFrameTime * OVER_BUDGET || this->_averageFrameTime < this->_targetFrameTime * UNDER_BUDGET)
+    {
+        float desired = this->_scale * std::sqrt(this->_targetFrameTime / this->_averageFrameTime);
+        desired = std::clamp(desired, this->_scale - MAX_SCALE_STEP, this->_scale + MAX_SCALE_STEP);
+        this->_scale = std::clamp(std::round(desired * 100.0f) / 100.0f, this->_minScale, this->_maxScale);
+    }
+
+    return this->_scale;
+}
+
+int LIB_API DynamicResolution::getRenderWidth(const int windowWidth) const
+{
+    return std::max(1, (int)std::lround(windowWidth * this->_scale));
+}
+
+int LIB_API DynamicResolution::getRenderHeight(const int windowHeight) const
+{
+    return std::max(1, (int)std::lround(windowHeight * this->_scale));
+}
+
+/**
+ * @brief Redirige il rendering nel framebuffer ridotto.
+ *
+ * Prima di avviare la timer query del frame legge le misure gia' pronte dei frame precedenti.
+ */
+bool LIB_API DynamicResolution::begin(const int windowWidth, const int windowHeight)
+{
+    if (!GLExtensions::isFramebufferSupported() || windowWidth <= 0 || windowHeight <= 0)
+        return false;
+
+    // Un framebuffer non valido viene ricreato solo quando cambia la finestra.
+    if (windowWidth != this->_width || windowHeight != this->_height)
+        this->createFramebuffer(windowWidth, windowHeight);
+
+    if (this->_framebuffer == 0)
+        return false;
+
+    if (GLExtensions::isTimerQuerySupported())
+    {
+        if (this->_queries[0] == 0)
+            GLExtensions::genQueries(QUERY_COUNT, this->_queries);
+
+        for (int i = 0; i < QUERY_COUNT; i++)
+        {
+            if (!this->_queryPending[i])
+                continue;
+
+            // La query da riusare viene letta in ogni caso, le altre solo se pronte.
+            GLint available = GL_TRUE;
+            if (i != this->_nextQuery)
+                GLExtensions::getQueryObjectiv(this->_queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+
+            if (available)
+            {
+                uint64_t nanoseconds = 0;
+                GLExtensions::getQueryObjectui64v(this->_queries[i], GL_QUERY_RESULT, &nanoseconds);
+                this->_gpuFrameTime = (float)(nanoseconds / 1.0e6);
+                this->_queryPending[i] = false;
+            }
+        }
+
+        GLExtensions::beginQuery(GL_TIME_ELAPSED, this->_queries[this->_nextQuery]);
+    }
+
+    this->_renderWidth = this->getRenderWidth(windowWidth);
+    this->_renderHeight = this->getRenderHeight(windowHeight);
+
+    GLExtensions::bindFramebuffer(GL_FRAMEBUFFER, this->_framebuffer);
+    glViewport(0, 0, this->_renderWidth, this->_renderHeight);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    this->_cpuStart = std::chrono::steady_clock::now();
+    return true;
+}
+
+/**
+ * @brief Copia il rettangolo disegnato nella finestra e aggiorna la scala.
+ */
+void LIB_API DynamicResolution::end()
+{
+    GLExtensions::bindFramebuffer(GL_READ_FRAMEBUFFER, this->_framebuffer);
+    GLExtensions::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    GLExtensions::blitFramebuffer(0, 0, this->_renderWidth, this->_renderHeight, 0, 0, this->_width, this->_height,
+        GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    GLExtensions::bindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, this->_width, this->_height);
+
+    if (GLExtensions::isTimerQuerySupported())
+    {
+        GLExtensions::endQuery(GL_TIME_ELAPSED);
+        this->_queryPending[this->_nextQuery] = true;
+        this->_nextQuery = (this->_nextQuery + 1) % QUERY_COUNT;
+    }
+
+    const float cpuFrameTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - this->_cpuStart).count();
+    this->update(std::max(cpuFrameTime, this->_gpuFrameTime));
+}
+
+/**
+ * @brief Crea il framebuffer con un renderbuffer del colore e uno di profondita' e stencil.
+ * @return `false` se il driver non accetta il framebuffer.
+ */
+bool DynamicResolution::createFramebuffer(const int width, const int height)
+{
+    this->releaseFramebuffer();
+
+    this->_width = width;
+    this->_height = height;
+
+    GLExtensions::genRenderbuffers(1, &this->_colorBuffer);
+    GLExtensions::bindRenderbuffer(GL_RENDERBUFFER, this->_colorBuffer);
+    GLExtensions::renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    GLExtensions::genRenderbuffers(1, &this->_depthBuffer);
+    GLExtensions::bindRenderbuffer(GL_RENDERBUFFER, this->_depthBuffer);
+    GLExtensions::renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    GLExtensions::bindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    GLExtensions::genFramebuffers(1, &this->_framebuffer);
+    GLExtensions::bindFramebuffer(GL_FRAMEBUFFER, this->_framebuffer);
+    GLExtensions::framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, this->_colorBuffer);
+    GLExtensions::framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, this->_depthBuffer);
+
+    const bool complete = GLExtensions::checkFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    GLExtensions::bindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (!complete)
+    {
+        ERROR("DynamicResolution: incomplete framebuffer (" << width << "x" << height << ").");
+
+        // Le dimensioni restano: il framebuffer verra' ritentato solo al prossimo ridimensionamento.
+        this->releaseFramebuffer();
+        this->_width = width;
+        this->_height = height;
+        return false;
+    }
+
+    return true;
+}
+
+void LIB_API DynamicResolution::release()
+{
+    this->releaseFramebuffer();
+
+    if (this->_queries[0] != 0)
+        GLExtensions::deleteQueries(QUERY_COUNT, this->_queries);
+
+    for (int i = 0; i < QUERY_COUNT; i++)
+    {
+        this->_queries[i] = 0;
+        this->_queryPending[i] = false;
+    }
+    this->_nextQuery = 0;
+}
+
+void DynamicResolution::releaseFramebuffer()
+{
+    if (this->_framebuffer != 0)
+        GLExtensions::deleteFramebuffers(1, &this->_framebuffer);
+    if (this->_colorBuffer != 0)
+        GLExtensions::deleteRenderbuffers(1, &this->_colorBuffer);
+    if (this->_depthBuffer != 0)
+        GLExtensions::deleteRenderbuffers(1, &this->_depthBuffer);
+
+    this->_framebuffer = 0;
+    this->_colorBuffer = 0;
+    this->_depthBuffer = 0;
+    this->_width = 0;
+    this->_height = 0;
+}
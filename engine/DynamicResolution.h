@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "Common.h"
+
+/**
+ * @file DynamicResolution.h
+ * @brief Dichiarazione del controllo della risoluzione di rendering in base al tempo per frame.
+ */
+
+ /**
+  * @class DynamicResolution
+  * @brief Disegna la scena 3D in un framebuffer ridotto, scalato per rispettare un budget di tempo per frame.
+  *
+  * Tra `begin` ed `end` la scena viene disegnata in un framebuffer object grande quanto la finestra,
+  * usandone solo il rettangolo `getRenderWidth` x `getRenderHeight`; `end` lo copia ingrandito
+  * nella finestra con un filtro lineare. Cambiare scala non rialloca il framebuffer.
+  *
+  * Il tempo del frame e' il maggiore tra il tempo della CPU tra `begin` ed `end` e, se disponibile,
+  * il tempo della GPU misurato con una timer query (letta con qualche frame di ritardo per non
+  * fermare la pipeline). `update` ne mantiene una media mobile e corregge la scala: il costo
+  * cresce con il numero di pixel, quindi con il quadrato della scala.
+  */
+class LIB_API DynamicResolution
+{
+public:
+
+    /**
+     * @brief Crea il controllo con un budget e un intervallo di scale.
+     * @param targetFrameTime Il budget per frame in millisecondi.
+     * @param minScale La scala minima.
+     * @param maxScale La scala massima.
+     */
+    DynamicResolution(const float targetFrameTime = 16.6f, const float minScale = 0.5f, const float maxScale = 1.0f);
+
+    DynamicResolution(const DynamicResolution&) = delete;
+    DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+    /**
+     * @brief Imposta il budget di tempo per frame.
+     * @param milliseconds Il budget in millisecondi.
+     */
+    void setTargetFrameTime(const float milliseconds);
+
+    /**
+     * @brief Restituisce il budget di tempo per frame.
+     * @return Il budget in millisecondi.
+     */
+    float getTargetFrameTime() const;
+
+    /**
+     * @brief Imposta l'intervallo in cui puo' variare la scala.
+     * @param minScale La scala minima (almeno 0.1).
+     * @param maxScale La scala massima (al piu' 1).
+     */
+    void setScaleRange(const float minScale, const float maxScale);
+
+    /**
+     * @brief Restituisce la scala corrente.
+     * @return La frazione della risoluzione della finestra usata per la scena, per lato.
+     */
+    float getScale() const;
+
+    /**
+     * @brief Restituisce la media mobile del tempo per frame.
+     * @return Il tempo in millisecondi, 0 prima della prima misura.
+     */
+    float getAverageFrameTime() const;
+
+    /**
+     * @brief Aggiorna la scala con il tempo di un frame.
+     *
+     * Non usa OpenGL: `end` la chiama con il tempo misurato.
+     *
+     * @param frameTime Il tempo del frame in millisecondi.
+     * @return La nuova scala.
+     */
+    float update(const float frameTime);
+
+    /**
+     * @brief Restituisce la larghezza del rettangolo disegnato per una finestra.
+     * @param windowWidth La larghezza della finestra.
+     * @return La larghezza scalata, almeno 1.
+     */
+    int getRenderWidth(const int windowWidth) const;
+
+    /**
+     * @brief Restituisce l'altezza del rettangolo disegnato per una finestra.
+     * @param windowHeight L'altezza della finestra.
+     * @return L'altezza scalata, almeno 1.
+     */
+    int getRenderHeight(const int windowHeight) const;
+
+    /**
+     * @brief Redirige il rendering nel framebuffer ridotto e lo pulisce.
+     *
+     * Crea (o ridimensiona) il framebuffer se necessario e imposta la viewport al rettangolo scalato.
+     *
+     * @param windowWidth La larghezza della finestra.
+     * @param windowHeight L'altezza della finestra.
+     * @return `false` se i framebuffer object non sono disponibili: il rendering resta sulla finestra.
+     */
+    bool begin(const int windowWidth, const int windowHeight);
+
+    /**
+     * @brief Copia il framebuffer ridotto nella finestra, ripristina la viewport e aggiorna la scala.
+     *
+     * Va chiamata solo dopo un `begin` riuscito.
+     */
+    void end();
+
+    /**
+     * @brief Libera il framebuffer e le query. Va chiamata sul thread del contesto, prima di distruggerlo.
+     */
+    void release();
+
+private:
+    bool createFramebuffer(const int width, const int height);
+    void releaseFramebuffer();
+
+    float _targetFrameTime;          ///< Budget per frame in millisecondi.
+    float _minScale;                 ///< Scala minima.
+    float _maxScale;                 ///< Scala massima.
+    float _scale;                    ///< Scala corrente.
+    float _averageFrameTime = 0.0f;  ///< Media mobile del tempo per frame.
+
+    unsigned int _framebuffer = 0;   ///< Framebuffer object della scena.
+    unsigned int _colorBuffer = 0;   ///< Renderbuffer del colore.
+    unsigned int _depthBuffer = 0;   ///< Renderbuffer di profondita' e stencil.
+    int _width = 0;                  ///< Larghezza allocata (quella della finestra).
+    int _height = 0;                 ///< Altezza allocata (quella della finestra).
+    int _renderWidth = 0;            ///< Larghezza disegnata nel frame corrente.
+    int _renderHeight = 0;           ///< Altezza disegnata nel frame corrente.
+
+    static constexpr int QUERY_COUNT = 4; ///< Query in volo: la piu' vecchia e' quasi sempre pronta.
+    unsigned int _queries[QUERY_COUNT] = {}; ///< Timer query della GPU, usate a turno.
+    bool _queryPending[QUERY_COUNT] = {};    ///< La query contiene una misura non ancora letta.
+    int _nextQuery = 0;                      ///< Prossima query da usare.
+    float _gpuFrameTime = 0.0f;              ///< Ultimo tempo della GPU letto, in millisecondi.
+
+    std::chrono::steady_clock::time_point _cpuStart; ///< Istante dell'ultimo `begin`.
+};
@@ -0,0 +1,289 @@
+#include "GLExtensions.h"
+
+#include <cstdio>
+#include <cstring>
+
+bool GLExtensions::shaderSupported = false;
+bool GLExtensions::textureBufferSupported = false;
+bool GLExtensions::textureCompressionSupported = false;
+bool GLExtensions::packedVertexSupported = false;
+bool GLExtensions::pixelBufferSupported = false;
+bool GLExtensions::framebufferSupported = false;
+bool GLExtensions::timerQuerySupported = false;
+
+std::thread::id GLExtensions::contextThread;
+std::mutex GLExtensions::releaseMutex;
+std::vector<unsigned int> GLExtensions::pendingBuffers;
+std::vector<unsigned int> GLExtensions::pendingTextures;
+
+PFNENGINECREATESHADERPROC GLExtensions::createShader = nullptr;
+PFNENGINESHADERSOURCEPROC GLExtensions::shaderSource = nullptr;
+PFNENGINECOMPILESHADERPROC GLExtensions::compileShader = nullptr;
+PFNENGINEGETSHADERIVPROC GLExtensions::getShaderiv = nullptr;
+PFNENGINEGETSHADERINFOLOGPROC GLExtensions::getShaderInfoLog = nullptr;
+PFNENGINEDELETESHADERPROC GLExtensions::deleteShader = nullptr;
+PFNENGINECREATEPROGRAMPROC GLExtensions::createProgram = nullptr;
+PFNENGINEATTACHSHADERPROC GLExtensions::attachShader = nullptr;
+PFNENGINELINKPROGRAMPROC GLExtensions::linkProgram = nullptr;
+PFNENGINEGETPROGRAMIVPROC GLExtensions::getProgramiv = nullptr;
+PFNENGINEGETPROGRAMINFOLOGPROC GLExtensions::getProgramInfoLog = nullptr;
+PFNENGINEDELETEPROGRAMPROC GLExtensions::deleteProgram = nullptr;
+PFNENGINEUSEPROGRAMPROC GLExtensions::useProgram = nullptr;
+PFNENGINEGETUNIFORMLOCATIONPROC GLExtensions::getUniformLocation = nullptr;
+PFNENGINEUNIFORM1IPROC GLExtensions::uniform1i = nullptr;
+PFNENGINEUNIFORM1IVPROC GLExtensions::uniform1iv = nullptr;
+PFNENGINEUNIFORM1FPROC GLExtensions::uniform1f = nullptr;
+PFNENGINEGETUNIFORMBLOCKINDEXPROC GLExtensions::getUniformBlockIndex = nullptr;
+PFNENGINEUNIFORMBLOCKBINDINGPROC GLExtensions::uniformBlockBinding = nullptr;
+PFNENGINEGENBUFFERSPROC GLExtensions::genBuffers = nullptr;
+PFNENGINEDELETEBUFFERSPROC GLExtensions::deleteBuffers = nullptr;
+PFNENGINEBINDBUFFERPROC GLExtensions::bindBuffer = nullptr;
+PFNENGINEBUFFERDATAPROC GLExtensions::bufferData = nullptr;
+PFNENGINEBUFFERSUBDATAPROC GLExtensions::bufferSubData = nullptr;
+PFNENGINEBINDBUFFERBASEPROC GLExtensions::bindBufferBase = nullptr;
+PFNENGINEUNIFORM2FPROC GLExtensions::uniform2f = nullptr;
+PFNENGINEACTIVETEXTUREPROC GLExtensions::activeTexture = nullptr;
+PFNENGINETEXBUFFERPROC GLExtensions::texBuffer = nullptr;
+PFNENGINECOMPRESSEDTEXIMAGE2DPROC GLExtensions::compressedTexImage2D = nullptr;
+PFNENGINEMAPBUFFERPROC GLExtensions::mapBuffer = nullptr;
+PFNENGINEUNMAPBUFFERPROC GLExtensions::unmapBuffer = nullptr;
+PFNENGINEGENFRAMEBUFFERSPROC GLExtensions::genFramebuffers = nullptr;
+PFNENGINEDELETEFRAMEBUFFERSPROC GLExtensions::deleteFramebuffers = nullptr;
+PFNENGINEBINDFRAMEBUFFERPROC GLExtensions::bindFramebuffer = nullptr;
+PFNENGINECHECKFRAMEBUFFERSTATUSPROC GLExtensions::checkFramebufferStatus = nullptr;
+PFNENGINEGENRENDERBUFFERSPROC GLExtensions::genRenderbuffers = nullptr;
+PFNENGINEDELETERENDERBUFFERSPROC GLExtensions::deleteRenderbuffers = nullptr;
+PFNENGINEBINDRENDERBUFFERPROC GLExtensions::bindRenderbuffer = nullptr;
+PFNENGINERENDERBUFFERSTORAGEPROC GLExtensions::renderbufferStorage = nullptr;
+PFNENGINEFRAMEBUFFERRENDERBUFFERPROC GLExtensions::framebufferRenderbuffer = nullptr;
+PFNENGINEBLITFRAMEBUFFERPROC GLExtensions::blitFramebuffer = nullptr;
+PFNENGINEGENQUERIESPROC GLExtensions::genQueries = nullptr;
+PFNENGINEDELETEQUERIESPROC GLExtensions::deleteQueries = nullptr;
+PFNENGINEBEGINQUERYPROC GLExtensions::beginQuery = nullptr;
+PFNENGINEENDQUERYPROC GLExtensions::endQuery = nullptr;
+PFNENGINEGETQUERYOBJECTIVPROC GLExtensions::getQueryObjectiv = nullptr;
+PFNENGINEGETQUERYOBJECTUI64VPROC GLExtensions::getQueryObjectui64v = nullptr;
+
+// Carica una funzione e ne converte il puntatore al tipo del membro di destinazione.
+#define LOAD_GL_FUNCTION(member, name) \
+    GLExtensions::member = (decltype(GLExtensions::member))glutGetProcAddress(name);
+
+/**
+ * @brief Carica le funzioni OpenGL dal contesto corrente.
+ *
+ * Deve essere chiamata dopo `glutCreateWindow`: prima non esiste un contesto
+ * e `glutGetProcAddress` restituisce sempre `nullptr`.
+ */
+bool LIB_API GLExtensions::load()
+{
+    LOAD_GL_FUNCTION(createShader, "glCreateShader");
+    LOAD_GL_FUNCTION(shaderSource, "glShaderSource");
+    LOAD_GL_FUNCTION(compileShader, "glCompileShader");
+    LOAD_GL_FUNCTION(getShaderiv, "glGetShaderiv");
+    LOAD_GL_FUNCTION(getShaderInfoLog, "glGetShaderInfoLog");
+    LOAD_GL_FUNCTION(deleteShader, "glDeleteShader");
+    LOAD_GL_FUNCTION(createProgram, "glCreateProgram");
+    LOAD_GL_FUNCTION(attachShader, "glAttachShader");
+    LOAD_GL_FUNCTION(linkProgram, "glLinkProgram");
+    LOAD_GL_FUNCTION(getProgramiv, "glGetProgramiv");
+    LOAD_GL_FUNCTION(getProgramInfoLog, "glGetProgramInfoLog");
+    LOAD_GL_FUNCTION(deleteProgram, "glDeleteProgram");
+    LOAD_GL_FUNCTION(useProgram, "glUseProgram");
+    LOAD_GL_FUNCTION(getUniformLocation, "glGetUniformLocation");
+    LOAD_GL_FUNCTION(uniform1i, "glUniform1i");
+    LOAD_GL_FUNCTION(uniform1iv, "glUniform1iv");
+    LOAD_GL_FUNCTION(uniform1f, "glUniform1f");
+    LOAD_GL_FUNCTION(getUniformBlockIndex, "glGetUniformBlockIndex");
+    LOAD_GL_FUNCTION(uniformBlockBinding, "glUniformBlockBinding");
+    LOAD_GL_FUNCTION(genBuffers, "glGenBuffers");
+    LOAD_GL_FUNCTION(deleteBuffers, "glDeleteBuffers");
+    LOAD_GL_FUNCTION(bindBuffer, "glBindBuffer");
+    LOAD_GL_FUNCTION(bufferData, "glBufferData");
+    LOAD_GL_FUNCTION(bufferSubData, "glBufferSubData");
+    LOAD_GL_FUNCTION(bindBufferBase, "glBindBufferBase");
+    LOAD_GL_FUNCTION(uniform2f, "glUniform2f");
+    LOAD_GL_FUNCTION(activeTexture, "glActiveTexture");
+    LOAD_GL_FUNCTION(texBuffer, "glTexBuffer");
+    LOAD_GL_FUNCTION(compressedTexImage2D, "glCompressedTexImage2D");
+    LOAD_GL_FUNCTION(mapBuffer, "glMapBuffer");
+    LOAD_GL_FUNCTION(unmapBuffer, "glUnmapBuffer");
+    LOAD_GL_FUNCTION(genFramebuffers, "glGenFramebuffers");
+    LOAD_GL_FUNCTION(deleteFramebuffers, "glDeleteFramebuffers");
+    LOAD_GL_FUNCTION(bindFramebuffer, "glBindFramebuffer");
+    LOAD_GL_FUNCTION(checkFramebufferStatus, "glCheckFramebufferStatus");
+    LOAD_GL_FUNCTION(genRenderbuffers, "glGenRenderbuffers");
+    LOAD_GL_FUNCTION(deleteRenderbuffers, "glDeleteRenderbuffers");
+    LOAD_GL_FUNCTION(bindRenderbuffer, "glBindRenderbuffer");
+    LOAD_GL_FUNCTION(renderbufferStorage, "glRenderbufferStorage");
+    LOAD_GL_FUNCTION(framebufferRenderbuffer, "glFramebufferRenderbuffer");
+    LOAD_GL_FUNCTION(blitFramebuffer, "glBlitFramebuffer");
+    LOAD_GL_FUNCTION(genQueries, "glGenQueries");
+    LOAD_GL_FUNCTION(deleteQueries, "glDeleteQueries");
+    LOAD_GL_FUNCTION(beginQuery, "glBeginQuery");
+    LOAD_GL_FUNCTION(endQuery, "glEndQuery");
+    LOAD_GL_FUNCTION(getQueryObjectiv, "glGetQueryObjectiv");
+    LOAD_GL_FUNCTION(getQueryObjectui64v, "glGetQueryObjectui64v");
+
+    GLExtensions::shaderSupported =
+        GLExtensions::createShader != nullptr && GLExtensions::shaderSource != nullptr &&
+        GLExtensions::compileShader != nullptr && GLExtensions::getShaderiv != nullptr &&
+        GLExtensions::getShaderInfoLog != nullptr && GLExtensions::deleteShader != nullptr &&
+        GLExtensions::createProgram != nullptr && GLExtensions::attachShader != nullptr &&
+        GLExtensions::linkProgram != nullptr && GLExtensions::getProgramiv != nullptr &&
+        GLExtensions::getProgramInfoLog != nullptr && GLExtensions::deleteProgram != nullptr &&
+        GLExtensions::useProgram != nullptr && GLExtensions::getUniformLocation != nullptr &&
+        GLExtensions::uniform1i != nullptr && GLExtensions::uniform1iv != nullptr &&
+        GLExtensions::uniform1f != nullptr && GLExtensions::getUniformBlockIndex != nullptr &&
+        GLExtensions::uniformBlockBinding != nullptr && GLExtensions::genBuffers != nullptr &&
+        GLExtensions::deleteBuffers != nullptr && GLExtensions::bindBuffer != nullptr &&
+        GLExtensions::bufferData != nullptr && GLExtensions::bufferSubData != nullptr &&
+        GLExtensions::bindBufferBase != nullptr && GLExtensions::uniform2f != nullptr;
+
+    GLExtensions::textureBufferSupported = GLExtensions::shaderSupported &&
+        GLExtensions::activeTexture != nullptr && GLExtensions::texBuffer != nullptr;
+
+    // S3TC e' un'estensione: la funzione da sola non basta.
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    GLExtensions::textureCompressionSupported = GLExtensions::compressedTexImage2D != nullptr &&
+        extensions != nullptr && strstr(extensions, "GL_EXT_texture_compression_s3tc") != nullptr;
+
+    // Coordinate half float negli array dei vertici (OpenGL 3.0).
+    int major = 0;
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (version != nullptr)
+        sscanf(version, "%d", &major);
+
+    const bool packedFormats = major >= 3 || (extensions != nullptr && strstr(extensions, "GL_ARB_half_float_vertex") != nullptr);
+
+    GLExtensions::packedVertexSupported = packedFormats && GLExtensions::genBuffers != nullptr &&
+        GLExtensions::deleteBuffers != nullptr && GLExtensions::bindBuffer != nullptr && GLExtensions::bufferData != nullptr;
+
+    // GL_PIXEL_UNPACK_BUFFER e' un target dei buffer di OpenGL 2.1 (o di GL_ARB_pixel_buffer_object).
+    int minor = 0;
+    if (version != nullptr)
+        sscanf(version, "%d.%d", &major, &minor);
+
+    const bool pixelBuffers = major > 2 || (major == 2 && minor >= 1) ||
+        (extensions != nullptr && strstr(extensions, "GL_ARB_pixel_buffer_object") != nullptr);
+
+    GLExtensions::pixelBufferSupported = pixelBuffers && GLExtensions::genBuffers != nullptr &&
+        GLExtensions::deleteBuffers != nullptr && GLExtensions::bindBuffer != nullptr && GLExtensions::bufferData != nullptr &&
+        GLExtensions::mapBuffer != nullptr && GLExtensions::unmapBuffer != nullptr;
+
+    GLExtensions::framebufferSupported = GLExtensions::genFramebuffers != nullptr && GLExtensions::deleteFramebuffers != nullptr &&
+        GLExtensions::bindFramebuffer != nullptr && GLExtensions::checkFramebufferStatus != nullptr &&
+        GLExtensions::genRenderbuffers != nullptr && GLExtensions::deleteRenderbuffers != nullptr &&
+        GLExtensions::bindRenderbuffer != nullptr && GLExtensions::renderbufferStorage != nullptr &&
+        GLExtensions::framebufferRenderbuffer != nullptr && GLExtensions::blitFramebuffer != nullptr;
+
+    // GL_TIME_ELAPSED richiede OpenGL 3.3 o GL_ARB_timer_query, anche se le funzioni delle query esistono dalla 1.5.
+    const bool timerQueries = major > 3 || (major == 3 && minor >= 3) ||
+        (extensions != nullptr && strstr(extensions, "GL_ARB_timer_query") != nullptr);
+
+    GLExtensions::timerQuerySupported = timerQueries && GLExtensions::genQueries != nullptr && GLExtensions::deleteQueries != nullptr &&
+        GLExtensions::beginQuery != nullptr && GLExtensions::endQuery != nullptr &&
+        GLExtensions::getQueryObjectiv != nullptr && GLExtensions::getQueryObjectui64v != nullptr;
+
+    return GLExtensions::shaderSupported;
+}
+
+bool LIB_API GLExtensions::isShaderSupported()
+{
+    return GLExtensions::shaderSupported;
+}
+
+bool LIB_API GLExtensions::isTextureBufferSupported()
+{
+    return GLExtensions::textureBufferSupported;
+}
+
+bool LIB_API GLExtensions::isTextureCompressionSupported()
+{
+    return GLExtensions::textureCompressionSupported;
+}
+
+bool LIB_API GLExtensions::isPackedVertexSupported()
+{
+    return GLExtensions::packedVertexSupported;
+}
+
+bool LIB_API GLExtensions::isPixelBufferSupported()
+{
+    return GLExtensions::pixelBufferSupported;
+}
+
+bool LIB_API GLExtensions::isFramebufferSupported()
+{
+    return GLExtensions::framebufferSupported;
+}
+
+bool LIB_API GLExtensions::isTimerQuerySupported()
+{
+    return GLExtensions::timerQuerySupported;
+}
+
+void LIB_API GLExtensions::setContextThread()
+{
+    GLExtensions::contextThread = std::this_thread::get_id();
+}
+
+bool LIB_API GLExtensions::isContextThread()
+{
+    return GLExtensions::contextThread == std::thread::id() || GLExtensions::contextThread == std::this_thread::get_id();
+}
+
+/**
+ * @brief Elimina un buffer o lo accoda per il thread del contesto.
+ *
+ * Con il thread di simulazione l'ultimo riferimento a una mesh puo' essere rilasciato
+ * lontano dal contesto OpenGL, dove `glDeleteBuffers` non avrebbe effetto.
+ */
+void LIB_API GLExtensions::releaseBuffer(const unsigned int buffer)
+{
+    if (buffer == 0)
+        return;
+
+    if (GLExtensions::isContextThread())
+    {
+        if (GLExtensions::deleteBuffers != nullptr)
+            GLExtensions::deleteBuffers(1, &buffer);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GLExtensions::releaseMutex);
+    GLExtensions::pendingBuffers.push_back(buffer);
+}
+
+void LIB_API GLExtensions::releaseTexture(const unsigned int texture)
+{
+    if (texture == 0)
+        return;
+
+    if (GLExtensions::isContextThread())
+    {
+        glDeleteTextures(1, &texture);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GLExtensions::releaseMutex);
+    GLExtensions::pendingTextures.push_back(texture);
+}
+
+void LIB_API GLExtensions::flushReleases()
+{
+    std::vector<unsigned int> buffers;
+    std::vector<unsigned int> textures;
+    {
+        std::lock_guard<std::mutex> lock(GLExtensions::releaseMutex);
+        buffers.swap(GLExtensions::pendingBuffers);
+        textures.swap(GLExtensions::pendingTextures);
+    }
+
+    if (!buffers.empty() && GLExtensions::deleteBuffers != nullptr)
+        GLExtensions::deleteBuffers((GLsizei)buffers.size(), buffers.data());
+
+    if (!textures.empty())
+        glDeleteTextures((GLsizei)textures.size(), textures.data());
+}
+
+#undef LOAD_GL_FUNCTION
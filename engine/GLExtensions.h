@@ -0,0 +1,350 @@
+#pragma once
+
+#include <GL/freeglut.h>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common.h"
+
+/**
+ * @file GLExtensions.h
+ * @brief Caricamento delle funzioni OpenGL successive alla 1.1 (shader, buffer e framebuffer).
+ *
+ * Le intestazioni OpenGL di Windows espongono solo la versione 1.1: le costanti necessarie
+ * vengono definite qui (come in `Texture.h` per l'anisotropia) e le funzioni vengono
+ * caricate a runtime con `glutGetProcAddress`. I tipi dei puntatori hanno nomi propri
+ * dell'engine per non entrare in conflitto con quelli di `glext.h`.
+ */
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// Shader
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER                0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER                  0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS                 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS                    0x8B82
+#endif
+#ifndef GL_INFO_LOG_LENGTH
+#define GL_INFO_LOG_LENGTH                0x8B84
+#endif
+
+// Buffer
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW                    0x88E0
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW                   0x88E8
+#endif
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER                   0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER           0x8893
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW                    0x88E4
+#endif
+#ifndef GL_UNIFORM_BUFFER
+#define GL_UNIFORM_BUFFER                 0x8A11
+#endif
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER            0x88EC
+#endif
+#ifndef GL_WRITE_ONLY
+#define GL_WRITE_ONLY                     0x88B9
+#endif
+#ifndef GL_MAX_UNIFORM_BLOCK_SIZE
+#define GL_MAX_UNIFORM_BLOCK_SIZE         0x8A30
+#endif
+#ifndef GL_INVALID_INDEX
+#define GL_INVALID_INDEX                  0xFFFFFFFFu
+#endif
+
+// Formati dei vertici compatti
+#ifndef GL_HALF_FLOAT
+#define GL_HALF_FLOAT                     0x140B
+#endif
+
+// Texture
+#ifndef GL_TEXTURE0
+#define GL_TEXTURE0                       0x84C0
+#endif
+#ifndef GL_TEXTURE_BUFFER
+#define GL_TEXTURE_BUFFER                 0x8C2A
+#endif
+#ifndef GL_R16UI
+#define GL_R16UI                          0x8234
+#endif
+#ifndef GL_RG32UI
+#define GL_RG32UI                         0x823C
+#endif
+#ifndef GL_TEXTURE_MAX_LEVEL
+#define GL_TEXTURE_MAX_LEVEL              0x813D
+#endif
+#ifndef GL_GENERATE_MIPMAP
+#define GL_GENERATE_MIPMAP                0x8191
+#endif
+
+// Texture compresse (EXT_texture_compression_s3tc)
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT  0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT  0x83F2
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT  0x83F3
+#endif
+
+// Framebuffer object (OpenGL 3.0 o GL_ARB_framebuffer_object)
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER                    0x8D40
+#endif
+#ifndef GL_READ_FRAMEBUFFER
+#define GL_READ_FRAMEBUFFER               0x8CA8
+#endif
+#ifndef GL_DRAW_FRAMEBUFFER
+#define GL_DRAW_FRAMEBUFFER               0x8CA9
+#endif
+#ifndef GL_RENDERBUFFER
+#define GL_RENDERBUFFER                   0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0              0x8CE0
+#endif
+#ifndef GL_DEPTH_STENCIL_ATTACHMENT
+#define GL_DEPTH_STENCIL_ATTACHMENT       0x821A
+#endif
+#ifndef GL_DEPTH24_STENCIL8
+#define GL_DEPTH24_STENCIL8               0x88F0
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE           0x8CD5
+#endif
+
+// Timer query (OpenGL 3.3 o GL_ARB_timer_query)
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED                   0x88BF
+#endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT                   0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE         0x8867
+#endif
+
+typedef ptrdiff_t EngineGLsizeiptr;
+typedef ptrdiff_t EngineGLintptr;
+
+typedef GLuint(APIENTRY* PFNENGINECREATESHADERPROC)(GLenum type);
+typedef void (APIENTRY* PFNENGINESHADERSOURCEPROC)(GLuint shader, GLsizei count, const char* const* string, const GLint* length);
+typedef void (APIENTRY* PFNENGINECOMPILESHADERPROC)(GLuint shader);
+typedef void (APIENTRY* PFNENGINEGETSHADERIVPROC)(GLuint shader, GLenum pname, GLint* params);
+typedef void (APIENTRY* PFNENGINEGETSHADERINFOLOGPROC)(GLuint shader, GLsizei bufSize, GLsizei* length, char* infoLog);
+typedef void (APIENTRY* PFNENGINEDELETESHADERPROC)(GLuint shader);
+typedef GLuint(APIENTRY* PFNENGINECREATEPROGRAMPROC)();
+typedef void (APIENTRY* PFNENGINEATTACHSHADERPROC)(GLuint program, GLuint shader);
+typedef void (APIENTRY* PFNENGINELINKPROGRAMPROC)(GLuint program);
+typedef void (APIENTRY* PFNENGINEGETPROGRAMIVPROC)(GLuint program, GLenum pname, GLint* params);
+typedef void (APIENTRY* PFNENGINEGETPROGRAMINFOLOGPROC)(GLuint program, GLsizei bufSize, GLsizei* length, char* infoLog);
+typedef void (APIENTRY* PFNENGINEDELETEPROGRAMPROC)(GLuint program);
+typedef void (APIENTRY* PFNENGINEUSEPROGRAMPROC)(GLuint program);
+typedef GLint(APIENTRY* PFNENGINEGETUNIFORMLOCATIONPROC)(GLuint program, const char* name);
+typedef void (APIENTRY* PFNENGINEUNIFORM1IPROC)(GLint location, GLint v0);
+typedef void (APIENTRY* PFNENGINEUNIFORM1IVPROC)(GLint location, GLsizei count, const GLint* value);
+typedef void (APIENTRY* PFNENGINEUNIFORM1FPROC)(GLint location, GLfloat v0);
+typedef GLuint(APIENTRY* PFNENGINEGETUNIFORMBLOCKINDEXPROC)(GLuint program, const char* uniformBlockName);
+typedef void (APIENTRY* PFNENGINEUNIFORMBLOCKBINDINGPROC)(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
+typedef void (APIENTRY* PFNENGINEGENBUFFERSPROC)(GLsizei n, GLuint* buffers);
+typedef void (APIENTRY* PFNENGINEDELETEBUFFERSPROC)(GLsizei n, const GLuint* buffers);
+typedef void (APIENTRY* PFNENGINEBINDBUFFERPROC)(GLenum target, GLuint buffer);
+typedef void (APIENTRY* PFNENGINEBUFFERDATAPROC)(GLenum target, EngineGLsizeiptr size, const void* data, GLenum usage);
+typedef void (APIENTRY* PFNENGINEBUFFERSUBDATAPROC)(GLenum target, EngineGLintptr offset, EngineGLsizeiptr size, const void* data);
+typedef void (APIENTRY* PFNENGINEBINDBUFFERBASEPROC)(GLenum target, GLuint index, GLuint buffer);
+typedef void (APIENTRY* PFNENGINEUNIFORM2FPROC)(GLint location, GLfloat v0, GLfloat v1);
+typedef void (APIENTRY* PFNENGINEACTIVETEXTUREPROC)(GLenum texture);
+typedef void (APIENTRY* PFNENGINETEXBUFFERPROC)(GLenum target, GLenum internalformat, GLuint buffer);
+typedef void* (APIENTRY* PFNENGINEMAPBUFFERPROC)(GLenum target, GLenum access);
+typedef GLboolean(APIENTRY* PFNENGINEUNMAPBUFFERPROC)(GLenum target);
+typedef void (APIENTRY* PFNENGINEGENFRAMEBUFFERSPROC)(GLsizei n, GLuint* framebuffers);
+typedef void (APIENTRY* PFNENGINEDELETEFRAMEBUFFERSPROC)(GLsizei n, const GLuint* framebuffers);
+typedef void (APIENTRY* PFNENGINEBINDFRAMEBUFFERPROC)(GLenum target, GLuint framebuffer);
+typedef GLenum(APIENTRY* PFNENGINECHECKFRAMEBUFFERSTATUSPROC)(GLenum target);
+typedef void (APIENTRY* PFNENGINEGENRENDERBUFFERSPROC)(GLsizei n, GLuint* renderbuffers);
+typedef void (APIENTRY* PFNENGINEDELETERENDERBUFFERSPROC)(GLsizei n, const GLuint* renderbuffers);
+typedef void (APIENTRY* PFNENGINEBINDRENDERBUFFERPROC)(GLenum target, GLuint renderbuffer);
+typedef void (APIENTRY* PFNENGINERENDERBUFFERSTORAGEPROC)(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+typedef void (APIENTRY* PFNENGINEFRAMEBUFFERRENDERBUFFERPROC)(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+typedef void (APIENTRY* PFNENGINEBLITFRAMEBUFFERPROC)(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
+typedef void (APIENTRY* PFNENGINEGENQUERIESPROC)(GLsizei n, GLuint* ids);
+typedef void (APIENTRY* PFNENGINEDELETEQUERIESPROC)(GLsizei n, const GLuint* ids);
+typedef void (APIENTRY* PFNENGINEBEGINQUERYPROC)(GLenum target, GLuint id);
+typedef void (APIENTRY* PFNENGINEENDQUERYPROC)(GLenum target);
+typedef void (APIENTRY* PFNENGINEGETQUERYOBJECTIVPROC)(GLuint id, GLenum pname, GLint* params);
+typedef void (APIENTRY* PFNENGINEGETQUERYOBJECTUI64VPROC)(GLuint id, GLenum pname, uint64_t* params);
+typedef void (APIENTRY* PFNENGINECOMPRESSEDTEXIMAGE2DPROC)(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data);
+
+/**
+ * @class GLExtensions
+ * @brief Contiene i puntatori alle funzioni OpenGL caricate a runtime.
+ *
+ * Va inizializzata con `load` dopo la creazione del contesto (vedi `Engine::init`).
+ */
+class LIB_API GLExtensions
+{
+public:
+
+    /**
+     * @brief Carica le funzioni OpenGL dal contesto corrente.
+     * @return `true` se sono disponibili tutte le funzioni necessarie agli shader.
+     */
+    static bool load();
+
+    /**
+     * @brief Verifica se shader e uniform buffer sono disponibili.
+     * @return `true` se `load` ha caricato con successo le funzioni degli shader.
+     */
+    static bool isShaderSupported();
+
+    /**
+     * @brief Verifica se le texture buffer (OpenGL 3.1) sono disponibili.
+     * @return `true` se `load` ha caricato `glTexBuffer` e `glActiveTexture`.
+     */
+    static bool isTextureBufferSupported();
+
+    /**
+     * @brief Verifica se le texture compresse S3TC (DXT1/DXT3/DXT5) sono disponibili.
+     * @return `true` se `load` ha caricato `glCompressedTexImage2D` e il driver espone `GL_EXT_texture_compression_s3tc`.
+     */
+    static bool isTextureCompressionSupported();
+
+    /**
+     * @brief Verifica se sono disponibili i vertex buffer e le coordinate `GL_HALF_FLOAT` negli array dei vertici.
+     * @return `true` con OpenGL 3.0 o con `GL_ARB_half_float_vertex`.
+     */
+    static bool isPackedVertexSupported();
+
+    /**
+     * @brief Verifica se i pixel buffer object (OpenGL 2.1) sono disponibili per caricare le texture.
+     * @return `true` se `load` ha caricato le funzioni dei buffer, `glMapBuffer` e `glUnmapBuffer`.
+     */
+    static bool isPixelBufferSupported();
+
+    /**
+     * @brief Verifica se i framebuffer object e la copia tra framebuffer sono disponibili.
+     * @return `true` se `load` ha caricato le funzioni dei framebuffer e dei renderbuffer e `glBlitFramebuffer`.
+     */
+    static bool isFramebufferSupported();
+
+    /**
+     * @brief Verifica se le timer query (OpenGL 3.3) sono disponibili per misurare il tempo della GPU.
+     * @return `true` se `load` ha caricato le funzioni delle query e `glGetQueryObjectui64v`.
+     */
+    static bool isTimerQuerySupported();
+
+    // Rilascio delle risorse da altri thread
+
+    /**
+     * @brief Registra il thread corrente come proprietario del contesto OpenGL.
+     *
+     * Finche' non viene chiamata, ogni thread e' considerato il thread del contesto.
+     */
+    static void setContextThread();
+
+    /**
+     * @brief Verifica se il thread corrente possiede il contesto OpenGL.
+     * @return `true` se le chiamate OpenGL possono essere eseguite subito.
+     */
+    static bool isContextThread();
+
+    /**
+     * @brief Elimina un buffer, subito o al prossimo `flushReleases` se chiamata fuori dal thread del contesto.
+     * @param buffer Il nome del buffer (0 viene ignorato).
+     */
+    static void releaseBuffer(const unsigned int buffer);
+
+    /**
+     * @brief Elimina una texture, subito o al prossimo `flushReleases` se chiamata fuori dal thread del contesto.
+     * @param texture Il nome della texture (0 viene ignorato).
+     */
+    static void releaseTexture(const unsigned int texture);
+
+    /**
+     * @brief Elimina le risorse rilasciate da altri thread. Da chiamare sul thread del contesto.
+     */
+    static void flushReleases();
+
+    static PFNENGINECREATESHADERPROC createShader;
+    static PFNENGINESHADERSOURCEPROC shaderSource;
+    static PFNENGINECOMPILESHADERPROC compileShader;
+    static PFNENGINEGETSHADERIVPROC getShaderiv;
+    static PFNENGINEGETSHADERINFOLOGPROC getShaderInfoLog;
+    static PFNENGINEDELETESHADERPROC deleteShader;
+    static PFNENGINECREATEPROGRAMPROC createProgram;
+    static PFNENGINEATTACHSHADERPROC attachShader;
+    static PFNENGINELINKPROGRAMPROC linkProgram;
+    static PFNENGINEGETPROGRAMIVPROC getProgramiv;
+    static PFNENGINEGETPROGRAMINFOLOGPROC getProgramInfoLog;
+    static PFNENGINEDELETEPROGRAMPROC deleteProgram;
+    static PFNENGINEUSEPROGRAMPROC useProgram;
+    static PFNENGINEGETUNIFORMLOCATIONPROC getUniformLocation;
+    static PFNENGINEUNIFORM1IPROC uniform1i;
+    static PFNENGINEUNIFORM1IVPROC uniform1iv;
+    static PFNENGINEUNIFORM1FPROC uniform1f;
+    static PFNENGINEGETUNIFORMBLOCKINDEXPROC getUniformBlockIndex;
+    static PFNENGINEUNIFORMBLOCKBINDINGPROC uniformBlockBinding;
+    static PFNENGINEGENBUFFERSPROC genBuffers;
+    static PFNENGINEDELETEBUFFERSPROC deleteBuffers;
+    static PFNENGINEBINDBUFFERPROC bindBuffer;
+    static PFNENGINEBUFFERDATAPROC bufferData;
+    static PFNENGINEBUFFERSUBDATAPROC bufferSubData;
+    static PFNENGINEBINDBUFFERBASEPROC bindBufferBase;
+    static PFNENGINEUNIFORM2FPROC uniform2f;
+    static PFNENGINEACTIVETEXTUREPROC activeTexture;
+    static PFNENGINETEXBUFFERPROC texBuffer;
+    static PFNENGINECOMPRESSEDTEXIMAGE2DPROC compressedTexImage2D;
+    static PFNENGINEMAPBUFFERPROC mapBuffer;
+    static PFNENGINEUNMAPBUFFERPROC unmapBuffer;
+    static PFNENGINEGENFRAMEBUFFERSPROC genFramebuffers;
+    static PFNENGINEDELETEFRAMEBUFFERSPROC deleteFramebuffers;
+    static PFNENGINEBINDFRAMEBUFFERPROC bindFramebuffer;
+    static PFNENGINECHECKFRAMEBUFFERSTATUSPROC checkFramebufferStatus;
+    static PFNENGINEGENRENDERBUFFERSPROC genRenderbuffers;
+    static PFNENGINEDELETERENDERBUFFERSPROC deleteRenderbuffers;
+    static PFNENGINEBINDRENDERBUFFERPROC bindRenderbuffer;
+    static PFNENGINERENDERBUFFERSTORAGEPROC renderbufferStorage;
+    static PFNENGINEFRAMEBUFFERRENDERBUFFERPROC framebufferRenderbuffer;
+    static PFNENGINEBLITFRAMEBUFFERPROC blitFramebuffer;
+    static PFNENGINEGENQUERIESPROC genQueries;
+    static PFNENGINEDELETEQUERIESPROC deleteQueries;
+    static PFNENGINEBEGINQUERYPROC beginQuery;
+    static PFNENGINEENDQUERYPROC endQuery;
+    static PFNENGINEGETQUERYOBJECTIVPROC getQueryObjectiv;
+    static PFNENGINEGETQUERYOBJECTUI64VPROC getQueryObjectui64v;
+
+private:
+    static bool shaderSupported; ///< Esito del caricamento delle funzioni degli shader.
+    static bool textureBufferSupported; ///< Esito del caricamento delle funzioni delle texture buffer.
+    static bool textureCompressionSupported; ///< Disponibilita' delle texture compresse S3TC.
+    static bool packedVertexSupported; ///< Disponibilita' dei formati dei vertici compatti.
+    static bool pixelBufferSupported; ///< Disponibilita' dei pixel buffer object.
+    static bool framebufferSupported; ///< Disponibilita' dei framebuffer object.
+    static bool timerQuerySupported; ///< Disponibilita' delle timer query.
+
+    static std::thread::id contextThread;            ///< Thread del contesto (vuoto = nessuno registrato).
+    static std::mutex releaseMutex;                  ///< Protegge le code delle risorse da eliminare.
+    static std::vector<unsigned int> pendingBuffers;  ///< Buffer rilasciati da altri thread.
+    static std::vector<unsigned int> pendingTextures; ///< Texture rilasciate da altri thread.
+};
@@ -0,0 +1,126 @@
+#include "HandleAllocator.h"
+
+/**
+ * @brief Assegna un handle a un oggetto.
+ */
+int LIB_API HandleAllocator::allocate(Object* object)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    uint32_t index;
+
+    if (!this->_freeList.empty())
+    {
+        index = this->_freeList.back();
+        this->_freeList.pop_back();
+    }
+    else
+    {
+        if (this->_slots.size() > INDEX_MASK)
+            return INVALID_HANDLE;
+
+        index = (uint32_t)this->_slots.size();
+        this->_slots.emplace_back();
+    }
+
+    Slot& slot = this->_slots[index];
+    slot.object = object;
+    this->_liveCount++;
+
+    return (int)((slot.generation << INDEX_BITS) | index);
+}
+
+/**
+ * @brief Rilascia un handle e rimette lo slot nella lista libera.
+ */
+void LIB_API HandleAllocator::release(const int handle)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (this->findSlot(handle) == nullptr)
+        return;
+
+    const uint32_t index = HandleAllocator::getIndex(handle);
+    Slot& slot = this->_slots[index];
+
+    // La nuova generazione invalida tutte le copie dell'handle rilasciato.
+    slot.object = nullptr;
+    slot.generation = (slot.generation + 1) & GENERATION_MASK;
+    this->_freeList.push_back(index);
+    this->_liveCount--;
+}
+
+/**
+ * @brief Restituisce l'oggetto associato a un handle.
+ */
+Object* LIB_API HandleAllocator::resolve(const int handle) const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    const Slot* slot = this->findSlot(handle);
+    return slot != nullptr ? slot->object : nullptr;
+}
+
+/**
+ * @brief Restituisce l'oggetto che occupa uno slot, qualunque sia la generazione.
+ */
+Object* LIB_API HandleAllocator::resolveIndex(const uint32_t index) const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (index >= this->_slots.size())
+        return nullptr;
+
+    return this->_slots[index].object;
+}
+
+bool LIB_API HandleAllocator::isValid(const int handle) const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->findSlot(handle) != nullptr;
+}
+
+size_t LIB_API HandleAllocator::getLiveCount() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_liveCount;
+}
+
+size_t LIB_API HandleAllocator::getSlotCount() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_slots.size();
+}
+
+uint32_t LIB_API HandleAllocator::getIndex(const int handle)
+{
+    return (uint32_t)handle & INDEX_MASK;
+}
+
+uint32_t LIB_API HandleAllocator::getGeneration(const int handle)
+{
+    return ((uint32_t)handle >> INDEX_BITS) & GENERATION_MASK;
+}
+
+/**
+ * @brief Restituisce lo slot occupato dall'handle, `nullptr` se l'handle non e' valido.
+ *
+ * Va chiamato con il mutex acquisito.
+ */
+const HandleAllocator::Slot* HandleAllocator::findSlot(const int handle) const
+{
+    if (handle < 0)
+        return nullptr;
+
+    const uint32_t index = HandleAllocator::getIndex(handle);
+
+    if (index >= this->_slots.size())
+        return nullptr;
+
+    const Slot& slot = this->_slots[index];
+
+    if (slot.object == nullptr || slot.generation != HandleAllocator::getGeneration(handle))
+        return nullptr;
+
+    return &slot;
+}
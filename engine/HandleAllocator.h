@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "Common.h"
+
+class Object;
+
+/**
+ * @file HandleAllocator.h
+ * @brief Dichiarazione dell'allocatore di handle generazionali usato per gli ID degli oggetti.
+ */
+
+ /**
+  * @class HandleAllocator
+  * @brief Assegna handle univoci (indice di slot + generazione) e li risolve in tempo costante.
+  *
+  * Ogni handle e' un intero non negativo: i 20 bit meno significativi sono l'indice dello slot
+  * nella tabella, gli 11 successivi la generazione dello slot. Quando un handle viene rilasciato
+  * lo slot torna nella lista libera e la sua generazione aumenta, quindi il prossimo handle sullo
+  * stesso slot e' diverso da quello rilasciato e le risoluzioni con l'handle vecchio falliscono.
+  *
+  * Tutti i metodi sono protetti da un mutex e possono essere chiamati da piu' thread.
+  */
+class LIB_API HandleAllocator
+{
+public:
+
+    static constexpr int INDEX_BITS = 20;                                  ///< Bit dell'indice di slot.
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;         ///< Maschera dell'indice.
+    static constexpr uint32_t GENERATION_MASK = (1u << (31 - INDEX_BITS)) - 1; ///< Maschera della generazione.
+    static constexpr int INVALID_HANDLE = -1;                              ///< Handle non valido.
+
+    /**
+     * @brief Assegna un handle a un oggetto.
+     *
+     * Riusa lo slot liberato piu' di recente, altrimenti ne aggiunge uno alla tabella.
+     *
+     * @param object L'oggetto da associare all'handle.
+     * @return L'handle, `INVALID_HANDLE` se la tabella e' piena.
+     */
+    int allocate(Object* object);
+
+    /**
+     * @brief Rilascia un handle e rimette lo slot nella lista libera.
+     *
+     * Gli handle non validi o gia' rilasciati vengono ignorati.
+     *
+     * @param handle L'handle da rilasciare.
+     */
+    void release(const int handle);
+
+    /**
+     * @brief Restituisce l'oggetto associato a un handle.
+     * @param handle L'handle da risolvere.
+     * @return L'oggetto, `nullptr` se l'handle e' stato rilasciato o non e' valido.
+     */
+    Object* resolve(const int handle) const;
+
+    /**
+     * @brief Restituisce l'oggetto che occupa uno slot, qualunque sia la generazione.
+     *
+     * Serve quando si conosce solo l'indice, ad esempio nel color picking.
+     *
+     * @param index L'indice dello slot.
+     * @return L'oggetto, `nullptr` se lo slot e' libero.
+     */
+    Object* resolveIndex(const uint32_t index) const;
+
+    /**
+     * @brief Verifica se un handle e' ancora associato a un oggetto.
+     * @param handle L'handle.
+     * @return `true` se l'handle non e' stato rilasciato.
+     */
+    bool isValid(const int handle) const;
+
+    /**
+     * @brief Restituisce il numero di handle assegnati e non ancora rilasciati.
+     * @return Il numero di handle vivi.
+     */
+    size_t getLiveCount() const;
+
+    /**
+     * @brief Restituisce il numero di slot della tabella, liberi compresi.
+     * @return La dimensione della tabella.
+     */
+    size_t getSlotCount() const;
+
+    /**
+     * @brief Estrae l'indice di slot da un handle.
+     * @param handle L'handle.
+     * @return L'indice.
+     */
+    static uint32_t getIndex(const int handle);
+
+    /**
+     * @brief Estrae la generazione da un handle.
+     * @param handle L'handle.
+     * @return La generazione.
+     */
+    static uint32_t getGeneration(const int handle);
+
+private:
+
+    /**
+     * @struct Slot
+     * @brief Elemento della tabella degli handle.
+     */
+    struct Slot
+    {
+        Object* object = nullptr;  ///< Oggetto associato, `nullptr` se lo slot e' libero.
+        uint32_t generation = 0;   ///< Generazione corrente dello slot.
+    };
+
+    const Slot* findSlot(const int handle) const;
+
+    mutable std::mutex _mutex;        ///< Protegge tabella e lista libera.
+    std::vector<Slot> _slots;         ///< Tabella densa degli slot.
+    std::vector<uint32_t> _freeList;  ///< Indici degli slot liberi.
+    size_t _liveCount = 0;            ///< Handle assegnati.
+};
@@ -0,0 +1,254 @@
+#include "LightClusterGrid.h"
+#include "TaskPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <glm/gtc/constants.hpp>
+
+// Sotto questa soglia il costo di distribuzione dei task supera quello dell'assegnazione.
+static constexpr size_t PARALLEL_LIGHT_THRESHOLD = 64;
+
+/**
+ * @brief Configura la griglia per una proiezione prospettica.
+ *
+ * Il box di ogni cluster contiene gli 8 vertici del tronco di frustum compreso tra la sua
+ * tile e le due profondita' della sua fetta.
+ */
+void LIB_API LightClusterGrid::configure(const float fov, const float aspectRatio, const float nearClipping, const float farClipping)
+{
+    if (fov == this->_fov && aspectRatio == this->_aspectRatio && nearClipping == this->_near && farClipping == this->_far)
+        return;
+
+    this->_fov = fov;
+    this->_aspectRatio = aspectRatio;
+    this->_near = nearClipping;
+    this->_far = farClipping;
+
+    if (!this->isConfigured())
+        return;
+
+    this->_boxMin.resize(CLUSTER_COUNT);
+    this->_boxMax.resize(CLUSTER_COUNT);
+
+    const float tanHalfFovY = std::tan(glm::radians(fov) * 0.5f);
+    const float tanHalfFovX = tanHalfFovY * aspectRatio;
+
+    for (int z = 0; z < SLICES; z++)
+    {
+        const float depthNear = nearClipping * std::pow(farClipping / nearClipping, (float)z / SLICES);
+        const float depthFar = nearClipping * std::pow(farClipping / nearClipping, (float)(z + 1) / SLICES);
+
+        for (int y = 0; y < TILES_Y; y++)
+        {
+            const float ndcY0 = -1.0f + 2.0f * y / TILES_Y;
+            const float ndcY1 = -1.0f + 2.0f * (y + 1) / TILES_Y;
+
+            for (int x = 0; x < TILES_X; x++)
+            {
+                const float ndcX0 = -1.0f + 2.0f * x / TILES_X;
+                const float ndcX1 = -1.0f + 2.0f * (x + 1) / TILES_X;
+
+                glm::vec3 minimum(std::numeric_limits<float>::max());
+                glm::vec3 maximum(-std::numeric_limits<float>::max());
+
+                for (const float depth : { depthNear, depthFar })
+                {
+                    for (const float ndcX : { ndcX0, ndcX1 })
+                    {
+                        for (const float ndcY : { ndcY0, ndcY1 })
+                        {
+                            // La camera guarda lungo -Z.
+                            const glm::vec3 corner(ndcX * tanHalfFovX * depth, ndcY * tanHalfFovY * depth, -depth);
+                            minimum = glm::min(minimum, corner);
+                            maximum = glm::max(maximum, corner);
+                        }
+                    }
+                }
+
+                const int index = LightClusterGrid::getClusterIndex(x, y, z);
+                this->_boxMin[index] = minimum;
+                this->_boxMax[index] = maximum;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Assegna le luci ai cluster.
+ */
+void LIB_API LightClusterGrid::assign(const std::vector<LightData>& lights)
+{
+    this->_clusters.assign(2 * CLUSTER_COUNT, 0);
+    this->_indices.clear();
+
+    if (!this->isConfigured())
+        return;
+
+    // Sfere delle sole luci limitate: le altre raggiungono tutti i cluster.
+    this->_bounds.clear();
+    this->_boundedLights.clear();
+    this->_sliceRanges.clear();
+
+    for (int i = 0; i < (int)lights.size(); i++)
+    {
+        if (lights[i].position.w == 0.0f || lights[i].range <= 0.0f)
+            continue;
+
+        const glm::vec4 sphere = LightClusterGrid::getLightBounds(lights[i]);
+        const float depth = -sphere.z;
+
+        this->_bounds.push_back(sphere);
+        this->_boundedLights.push_back(i);
+        this->_sliceRanges.emplace_back(this->getSlice(depth - sphere.w), this->getSlice(depth + sphere.w));
+    }
+
+    this->_sliceIndices.resize(SLICES);
+    this->_clusterCounts.assign(CLUSTER_COUNT, 0);
+
+    if (this->_bounds.size() < PARALLEL_LIGHT_THRESHOLD)
+    {
+        this->assignSlices(0, SLICES);
+    }
+    else
+    {
+        // Ogni task elabora un gruppo contiguo di fette e scrive solo i propri dati.
+        TaskPool::getShared().parallelFor(SLICES, 1, [this](const size_t first, const size_t last)
+            {
+                this->assignSlices((int)first, (int)last);
+            });
+    }
+
+    // Concatena le liste delle fette e calcola gli offset di ogni cluster.
+    uint32_t offset = 0;
+
+    for (int z = 0; z < SLICES; z++)
+    {
+        for (int tile = 0; tile < TILES_X * TILES_Y; tile++)
+        {
+            const int cluster = z * TILES_X * TILES_Y + tile;
+            this->_clusters[2 * cluster] = offset;
+            this->_clusters[2 * cluster + 1] = this->_clusterCounts[cluster];
+            offset += this->_clusterCounts[cluster];
+        }
+
+        this->_indices.insert(this->_indices.end(), this->_sliceIndices[z].begin(), this->_sliceIndices[z].end());
+    }
+}
+
+/**
+ * @brief Assegna le luci ai cluster delle fette [firstSlice, lastSlice).
+ *
+ * Per ogni luce vengono visitate solo le fette comprese nell'intervallo di profondita' della sua sfera.
+ */
+void LightClusterGrid::assignSlices(const int firstSlice, const int lastSlice)
+{
+    // Una lista per thread, riutilizzata tra i frame.
+    static thread_local std::vector<int> sliceLights;
+
+    for (int z = firstSlice; z < lastSlice; z++)
+    {
+        std::vector<uint16_t>& sliceIndices = this->_sliceIndices[z];
+        sliceIndices.clear();
+
+        // Luci la cui sfera interseca l'intervallo di profondita' della fetta.
+        sliceLights.clear();
+        for (int l = 0; l < (int)this->_bounds.size(); l++)
+        {
+            if (this->_sliceRanges[l].x <= z && z <= this->_sliceRanges[l].y)
+                sliceLights.push_back(l);
+        }
+
+        for (int tile = 0; tile < TILES_X * TILES_Y; tile++)
+        {
+            const int cluster = z * TILES_X * TILES_Y + tile;
+            const glm::vec3& boxMin = this->_boxMin[cluster];
+            const glm::vec3& boxMax = this->_boxMax[cluster];
+            uint32_t count = 0;
+
+            for (const int l : sliceLights)
+            {
+                const glm::vec4& sphere = this->_bounds[l];
+
+                // Distanza tra il centro della sfera e il box del cluster.
+                const glm::vec3 center(sphere);
+                const glm::vec3 delta = center - glm::clamp(center, boxMin, boxMax);
+
+                if (glm::dot(delta, delta) <= sphere.w * sphere.w)
+                {
+                    sliceIndices.push_back((uint16_t)this->_boundedLights[l]);
+                    count++;
+                }
+            }
+
+            this->_clusterCounts[cluster] = count;
+        }
+    }
+}
+
+bool LIB_API LightClusterGrid::isConfigured() const
+{
+    return this->_fov > 0.0f && this->_aspectRatio > 0.0f && this->_near > 0.0f && this->_far > this->_near;
+}
+
+const std::vector<uint32_t>& LIB_API LightClusterGrid::getClusters() const
+{
+    return this->_clusters;
+}
+
+const std::vector<uint16_t>& LIB_API LightClusterGrid::getIndices() const
+{
+    return this->_indices;
+}
+
+int LIB_API LightClusterGrid::getClusterIndex(const int x, const int y, const int z)
+{
+    return (z * TILES_Y + y) * TILES_X + x;
+}
+
+int LIB_API LightClusterGrid::getSlice(const float depth) const
+{
+    if (depth <= this->_near)
+        return 0;
+
+    const glm::vec2 parameters = this->getSliceParameters();
+    const int slice = (int)std::floor(std::log(depth) * parameters.x - parameters.y);
+    return std::clamp(slice, 0, SLICES - 1);
+}
+
+glm::vec2 LIB_API LightClusterGrid::getSliceParameters() const
+{
+    const float scale = SLICES / std::log(this->_far / this->_near);
+    return glm::vec2(scale, std::log(this->_near) * scale);
+}
+
+/**
+ * @brief Calcola la sfera che contiene il volume illuminato da una luce.
+ *
+ * Per le spot con cono stretto la sfera che contiene il cono e' molto piu' piccola
+ * di quella del raggio di influenza: si sceglie la minore delle due.
+ */
+glm::vec4 LIB_API LightClusterGrid::getLightBounds(const LightData& light)
+{
+    const glm::vec3 position(light.position);
+    glm::vec4 sphere(position, light.range);
+
+    if (light.spotCutoff < 90.0f && glm::dot(light.spotDirection, light.spotDirection) > 0.0f)
+    {
+        const glm::vec3 direction = glm::normalize(light.spotDirection);
+        const float angle = glm::radians(light.spotCutoff);
+        const float cosine = std::cos(angle);
+
+        if (angle > glm::quarter_pi<float>())
+        {
+            sphere = glm::vec4(position + direction * (cosine * light.range), std::sin(angle) * light.range);
+        }
+        else
+        {
+            const float radius = light.range / (2.0f * cosine * cosine);
+            sphere = glm::vec4(position + direction * radius, radius);
+        }
+    }
+
+    return sphere;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "LightManager.h"
+#include "Common.h"
+
+/**
+ * @file LightClusterGrid.h
+ * @brief Dichiarazione della griglia di cluster per l'assegnazione delle luci (clustered forward).
+ */
+
+ /**
+  * @class LightClusterGrid
+  * @brief Divide il frustum della camera prospettica in cluster 3D e assegna ad ognuno le luci che lo raggiungono.
+  *
+  * Il frustum e' diviso in `TILES_X` x `TILES_Y` tile in spazio schermo e in `SLICES` fette
+  * di profondita' a progressione esponenziale tra i piani di clipping. Per ogni luce con
+  * raggio di influenza (il raggio delle `PointLight` e delle `SpotLight`, vedi `Light::getLightData`)
+  * viene calcolata una sfera (ristretta al cono del cutoff per le spot) e confrontata
+  * con i box dei cluster delle sole fette che interseca. Il risultato e' una lista compatta:
+  * per ogni cluster (offset, numero) in `getClusters` e gli indici delle luci in `getIndices`.
+  *
+  * Le luci senza raggio e quelle direzionali raggiungono tutti i cluster e non vengono assegnate:
+  * il chiamante le valuta separatamente.
+  */
+class LIB_API LightClusterGrid
+{
+public:
+
+    static constexpr int TILES_X = 16;   ///< Tile orizzontali.
+    static constexpr int TILES_Y = 9;    ///< Tile verticali.
+    static constexpr int SLICES = 24;    ///< Fette di profondita'.
+    static constexpr int CLUSTER_COUNT = TILES_X * TILES_Y * SLICES; ///< Numero totale di cluster.
+
+    /**
+     * @brief Configura la griglia per una proiezione prospettica.
+     *
+     * I box dei cluster vengono ricalcolati solo se i parametri cambiano.
+     *
+     * @param fov Il campo visivo verticale in gradi.
+     * @param aspectRatio Il rapporto larghezza/altezza del viewport.
+     * @param nearClipping La distanza del piano vicino.
+     * @param farClipping La distanza del piano lontano.
+     */
+    void configure(const float fov, const float aspectRatio, const float nearClipping, const float farClipping);
+
+    /**
+     * @brief Assegna le luci ai cluster.
+     *
+     * Con molte luci le fette di profondita' vengono suddivise tra i thread di `TaskPool`; ogni task scrive
+     * solo le proprie fette, quindi il risultato non dipende dal numero di thread.
+     *
+     * @param lights Le luci del frame in spazio vista.
+     */
+    void assign(const std::vector<LightData>& lights);
+
+    /**
+     * @brief Verifica se la griglia e' stata configurata.
+     * @return `true` dopo una chiamata a `configure` con parametri validi.
+     */
+    bool isConfigured() const;
+
+    /**
+     * @brief Restituisce per ogni cluster la coppia (offset, numero di luci) nella lista degli indici.
+     * @return Un vettore di `2 * CLUSTER_COUNT` valori.
+     */
+    const std::vector<uint32_t>& getClusters() const;
+
+    /**
+     * @brief Restituisce la lista compatta degli indici delle luci.
+     * @return Gli indici delle luci, raggruppati per cluster.
+     */
+    const std::vector<uint16_t>& getIndices() const;
+
+    /**
+     * @brief Restituisce l'indice lineare di un cluster.
+     * @param x La tile orizzontale.
+     * @param y La tile verticale.
+     * @param z La fetta di profondita'.
+     * @return L'indice del cluster.
+     */
+    static int getClusterIndex(const int x, const int y, const int z);
+
+    /**
+     * @brief Restituisce la fetta di profondita' che contiene una distanza dalla camera.
+     * @param depth La distanza lungo l'asse di vista (positiva).
+     * @return La fetta, limitata a [0, SLICES - 1].
+     */
+    int getSlice(const float depth) const;
+
+    /**
+     * @brief Restituisce i coefficienti per calcolare la fetta nello shader.
+     * @return (scala, offset): fetta = log(profondita') * scala - offset.
+     */
+    glm::vec2 getSliceParameters() const;
+
+    /**
+     * @brief Calcola la sfera che contiene il volume illuminato da una luce.
+     * @param light La luce in spazio vista (deve avere un raggio di influenza).
+     * @return Centro (xyz) e raggio (w) della sfera.
+     */
+    static glm::vec4 getLightBounds(const LightData& light);
+
+private:
+    void assignSlices(const int firstSlice, const int lastSlice);
+
+    float _fov = 0.0f;                                  ///< Campo visivo configurato.
+    float _aspectRatio = 0.0f;                          ///< Rapporto d'aspetto configurato.
+    float _near = 0.0f;                                 ///< Piano vicino configurato.
+    float _far = 0.0f;                                  ///< Piano lontano configurato.
+    std::vector<glm::vec3> _boxMin;                     ///< Angolo minimo del box di ogni cluster (spazio vista).
+    std::vector<glm::vec3> _boxMax;                     ///< Angolo massimo del box di ogni cluster (spazio vista).
+    std::vector<glm::vec4> _bounds;                     ///< Sfere delle luci limitate del frame.
+    std::vector<int> _boundedLights;                    ///< Indici delle luci limitate del frame.
+    std::vector<glm::ivec2> _sliceRanges;               ///< Prima e ultima fetta raggiunte da ogni luce limitata.
+    std::vector<std::vector<uint16_t>> _sliceIndices;   ///< Indici prodotti da ogni fetta.
+    std::vector<uint32_t> _clusterCounts;               ///< Luci per cluster, scritte per fetta.
+    std::vector<uint32_t> _clusters;                    ///< Coppie (offset, numero) per cluster.
+    std::vector<uint16_t> _indices;                     ///< Lista compatta degli indici.
+};
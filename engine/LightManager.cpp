@@ -0,0 +1,551 @@
+#include "LightManager.h"
+#include "LightClusterGrid.h"
+#include "GLExtensions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <glm/gtc/type_ptr.hpp>
+
+std::unique_ptr<Shader> LightManager::program;
+bool LightManager::shaderPathEnabled = true;
+bool LightManager::bound = false;
+bool LightManager::dirty = false;
+int LightManager::textureEnabled = -1;
+int LightManager::capacity = 0;
+int LightManager::fixedFunctionCapacity = 8;
+int LightManager::enabledSlots = 0;
+bool LightManager::overflowReported = false;
+unsigned int LightManager::uniformBuffer = 0;
+int LightManager::objectLightCountLocation = -1;
+int LightManager::objectLightsLocation = -1;
+int LightManager::useTextureLocation = -1;
+std::vector<LightData> LightManager::lights;
+std::vector<glm::vec4> LightManager::packedLights;
+std::unique_ptr<LightClusterGrid> LightManager::clusterGrid = std::make_unique<LightClusterGrid>();
+bool LightManager::clustersAvailable = false;
+bool LightManager::clustersActive = false;
+glm::vec2 LightManager::viewportSize(0.0f);
+unsigned int LightManager::clusterBuffers[2] = { 0, 0 };
+unsigned int LightManager::clusterTextures[2] = { 0, 0 };
+int LightManager::useClustersLocation = -1;
+int LightManager::clusterTileSizeLocation = -1;
+int LightManager::clusterSliceLocation = -1;
+
+// Ogni luce occupa 5 vec4 nell'uniform buffer (layout std140).
+static constexpr int LIGHT_VEC4_COUNT = 5;
+// Binding point dell'uniform buffer delle luci.
+static constexpr unsigned int LIGHT_BLOCK_BINDING = 0;
+// Limite superiore alle luci per frame, indipendente dalla dimensione massima dei blocchi.
+static constexpr int MAX_FRAME_LIGHTS = 1024;
+// Unita' di texture delle liste dei cluster (la 0 e' riservata alla texture del materiale).
+static constexpr int CLUSTER_GRID_UNIT = 1;
+static constexpr int CLUSTER_LIGHTS_UNIT = 2;
+
+// Il vertex shader passa posizione e normale in spazio vista: l'illuminazione e' per pixel.
+static const char* lightingVertexShader = R"(
+out vec3 eyePosition;
+out vec3 eyeNormal;
+out vec2 texCoord;
+
+void main()
+{
+    eyePosition = vec3(gl_ModelViewMatrix * gl_Vertex);
+    eyeNormal = gl_NormalMatrix * gl_Normal;
+    texCoord = gl_MultiTexCoord0.xy;
+    gl_Position = ftransform();
+}
+)";
+
+// Riproduce le equazioni della pipeline fissa (attenuazione costante, cono spot,
+// osservatore locale). Le luci valutate sono quelle della lista dell'oggetto e,
+// con i cluster attivi, quelle assegnate al cluster del frammento.
+static const char* lightingFragmentShader = R"(
+layout(std140) uniform LightBlock
+{
+    vec4 lightData[MAX_LIGHTS * 5];
+};
+
+uniform int objectLightCount;
+uniform int objectLights[MAX_OBJECT_LIGHTS];
+uniform int useTexture;
+uniform sampler2D diffuseTexture;
+
+uniform int useClusters;
+uniform usamplerBuffer clusterGrid;
+uniform usamplerBuffer clusterLights;
+uniform vec2 clusterTileSize;
+uniform vec2 clusterSlice;
+
+in vec3 eyePosition;
+in vec3 eyeNormal;
+in vec2 texCoord;
+out vec4 fragColor;
+
+vec3 shadeLight(int index, vec3 N, vec3 V)
+{
+    int base = index * 5;
+    vec4 position = lightData[base];
+    vec4 spot = lightData[base + 1];
+    vec4 ambient = lightData[base + 2];
+    vec4 diffuse = lightData[base + 3];
+    vec4 specular = lightData[base + 4];
+
+    vec3 L;
+    float attenuation = 1.0;
+
+    if (position.w == 0.0)
+    {
+        L = normalize(position.xyz);
+    }
+    else
+    {
+        vec3 toLight = position.xyz - eyePosition;
+        float distance = length(toLight);
+        L = toLight / distance;
+        attenuation = 1.0 / diffuse.a;
+
+        // Dissolvenza verso zero al bordo del raggio di influenza.
+        if (specular.a > 0.0)
+        {
+            float fade = clamp(1.0 - pow(distance / specular.a, 4.0), 0.0, 1.0);
+            attenuation *= fade * fade;
+        }
+
+        // spot.w: coseno del cutoff, -2 per le luci non spot.
+        if (spot.w > -1.5)
+        {
+            float cosine = dot(-L, normalize(spot.xyz));
+            attenuation *= cosine < spot.w ? 0.0 : pow(max(cosine, 0.0), ambient.a);
+        }
+    }
+
+    float NdotL = max(dot(N, L), 0.0);
+    vec3 term = ambient.rgb * gl_FrontMaterial.ambient.rgb + NdotL * diffuse.rgb * gl_FrontMaterial.diffuse.rgb;
+
+    if (NdotL > 0.0)
+    {
+        vec3 H = normalize(L + V);
+        term += pow(max(dot(N, H), 0.0), gl_FrontMaterial.shininess) * specular.rgb * gl_FrontMaterial.specular.rgb;
+    }
+
+    return attenuation * term;
+}
+
+void main()
+{
+    vec3 N = normalize(eyeNormal);
+    vec3 V = normalize(-eyePosition);
+    vec3 color = gl_FrontMaterial.emission.rgb + gl_LightModel.ambient.rgb * gl_FrontMaterial.ambient.rgb;
+
+    for (int i = 0; i < objectLightCount; i++)
+        color += shadeLight(objectLights[i], N, V);
+
+    if (useClusters != 0)
+    {
+        ivec2 tile = clamp(ivec2(gl_FragCoord.xy / clusterTileSize), ivec2(0), ivec2(CLUSTER_TILES_X - 1, CLUSTER_TILES_Y - 1));
+        int slice = clamp(int(floor(log(max(-eyePosition.z, 1e-6)) * clusterSlice.x - clusterSlice.y)), 0, CLUSTER_SLICES - 1);
+        uvec2 cluster = texelFetch(clusterGrid, (slice * CLUSTER_TILES_Y + tile.y) * CLUSTER_TILES_X + tile.x).rg;
+
+        for (uint i = 0u; i < cluster.y; i++)
+            color += shadeLight(int(texelFetch(clusterLights, int(cluster.x + i)).r), N, V);
+    }
+
+    vec4 result = vec4(color, gl_FrontMaterial.diffuse.a);
+
+    if (useTexture != 0)
+        result *= texture(diffuseTexture, texCoord);
+
+    fragColor = result;
+}
+)";
+
+/**
+ * @brief Inizializza il programma di illuminazione e l'uniform buffer.
+ *
+ * La capacita' dipende da `GL_MAX_UNIFORM_BLOCK_SIZE` (almeno 16 KB, cioe' 204 luci)
+ * e viene inserita nei sorgenti come costante. Anche `GL_MAX_LIGHTS` viene letto qui una volta
+ * sola, per il percorso fixed-function.
+ */
+void LIB_API LightManager::init()
+{
+    GLint maxLights = 0;
+    glGetIntegerv(GL_MAX_LIGHTS, &maxLights);
+    if (maxLights > 0)
+        LightManager::fixedFunctionCapacity = maxLights;
+
+    if (!GLExtensions::isShaderSupported())
+    {
+        WARNING("GLSL lighting not available, using fixed-function lights.");
+        return;
+    }
+
+    GLint maxBlockSize = 0;
+    glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &maxBlockSize);
+    LightManager::capacity = std::min(MAX_FRAME_LIGHTS, (int)(maxBlockSize / (LIGHT_VEC4_COUNT * sizeof(glm::vec4))));
+
+    if (LightManager::capacity <= 0)
+    {
+        WARNING("Uniform buffers not available, using fixed-function lights.");
+        return;
+    }
+
+    const std::string header = "#version 140\n#extension GL_ARB_compatibility : enable\n"
+        "#define MAX_LIGHTS " + std::to_string(LightManager::capacity) + "\n"
+        "#define MAX_OBJECT_LIGHTS " + std::to_string(LightManager::MAX_OBJECT_LIGHTS) + "\n"
+        "#define CLUSTER_TILES_X " + std::to_string(LightClusterGrid::TILES_X) + "\n"
+        "#define CLUSTER_TILES_Y " + std::to_string(LightClusterGrid::TILES_Y) + "\n"
+        "#define CLUSTER_SLICES " + std::to_string(LightClusterGrid::SLICES) + "\n";
+
+    LightManager::program = std::make_unique<Shader>(header + lightingVertexShader, header + lightingFragmentShader);
+
+    if (!LightManager::program->isLinked())
+    {
+        WARNING("GLSL lighting program not available, using fixed-function lights.");
+        LightManager::program.reset();
+        return;
+    }
+
+    const GLuint programId = LightManager::program->getProgramId();
+    const GLuint blockIndex = GLExtensions::getUniformBlockIndex(programId, "LightBlock");
+    GLExtensions::uniformBlockBinding(programId, blockIndex, LIGHT_BLOCK_BINDING);
+
+    LightManager::objectLightCountLocation = LightManager::program->getUniformLocation("objectLightCount");
+    LightManager::objectLightsLocation = LightManager::program->getUniformLocation("objectLights");
+    LightManager::useTextureLocation = LightManager::program->getUniformLocation("useTexture");
+
+    LightManager::useClustersLocation = LightManager::program->getUniformLocation("useClusters");
+    LightManager::clusterTileSizeLocation = LightManager::program->getUniformLocation("clusterTileSize");
+    LightManager::clusterSliceLocation = LightManager::program->getUniformLocation("clusterSlice");
+
+    LightManager::program->use();
+    GLExtensions::uniform1i(LightManager::program->getUniformLocation("diffuseTexture"), 0);
+    GLExtensions::uniform1i(LightManager::program->getUniformLocation("clusterGrid"), CLUSTER_GRID_UNIT);
+    GLExtensions::uniform1i(LightManager::program->getUniformLocation("clusterLights"), CLUSTER_LIGHTS_UNIT);
+    GLExtensions::uniform1i(LightManager::useClustersLocation, 0);
+    GLExtensions::useProgram(0);
+
+    // Il buffer viene allocato una volta con la capacita' massima e aggiornato ad ogni frame.
+    GLExtensions::genBuffers(1, &LightManager::uniformBuffer);
+    GLExtensions::bindBuffer(GL_UNIFORM_BUFFER, LightManager::uniformBuffer);
+    GLExtensions::bufferData(GL_UNIFORM_BUFFER, (EngineGLsizeiptr)LightManager::capacity * LIGHT_VEC4_COUNT * sizeof(glm::vec4), nullptr, GL_DYNAMIC_DRAW);
+    GLExtensions::bindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Liste dei cluster: (offset, numero) per cluster e indici compatti, in due texture buffer.
+    if (GLExtensions::isTextureBufferSupported())
+    {
+        const GLenum formats[2] = { GL_RG32UI, GL_R16UI };
+
+        GLExtensions::genBuffers(2, LightManager::clusterBuffers);
+        glGenTextures(2, LightManager::clusterTextures);
+
+        for (int i = 0; i < 2; i++)
+        {
+            GLExtensions::bindBuffer(GL_TEXTURE_BUFFER, LightManager::clusterBuffers[i]);
+            GLExtensions::bufferData(GL_TEXTURE_BUFFER, sizeof(uint32_t) * 2, nullptr, GL_STREAM_DRAW);
+            glBindTexture(GL_TEXTURE_BUFFER, LightManager::clusterTextures[i]);
+            GLExtensions::texBuffer(GL_TEXTURE_BUFFER, formats[i], LightManager::clusterBuffers[i]);
+        }
+
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        GLExtensions::bindBuffer(GL_TEXTURE_BUFFER, 0);
+        LightManager::clustersAvailable = true;
+    }
+
+    LightManager::lights.reserve(LightManager::capacity);
+    LightManager::packedLights.reserve((size_t)LightManager::capacity * LIGHT_VEC4_COUNT);
+
+    DEBUG("GLSL lighting enabled (" << LightManager::capacity << " lights per frame, clusters " << (LightManager::clustersAvailable ? "on" : "off") << ").");
+}
+
+void LIB_API LightManager::quit()
+{
+    if (LightManager::uniformBuffer != 0)
+        GLExtensions::deleteBuffers(1, &LightManager::uniformBuffer);
+
+    LightManager::uniformBuffer = 0;
+
+    if (LightManager::clustersAvailable)
+    {
+        GLExtensions::deleteBuffers(2, LightManager::clusterBuffers);
+        glDeleteTextures(2, LightManager::clusterTextures);
+    }
+
+    LightManager::clustersAvailable = false;
+    LightManager::program.reset();
+}
+
+bool LIB_API LightManager::isShaderPath()
+{
+    return LightManager::shaderPathEnabled && LightManager::program != nullptr;
+}
+
+void LIB_API LightManager::setShaderPathEnabled(const bool enabled)
+{
+    LightManager::shaderPathEnabled = enabled;
+}
+
+int LIB_API LightManager::getCapacity()
+{
+    if (LightManager::isShaderPath())
+        return LightManager::capacity;
+
+    return LightManager::fixedFunctionCapacity;
+}
+
+/**
+ * @brief Imposta la proiezione usata per la griglia dei cluster.
+ *
+ * Con `fov` non positivo (camera non prospettica) i cluster vengono disattivati e
+ * si torna al culling per oggetto.
+ */
+void LIB_API LightManager::setProjection(const float fov, const float aspectRatio, const float nearClipping, const float farClipping, const int viewportWidth, const int viewportHeight)
+{
+    LightManager::clusterGrid->configure(fov, aspectRatio, nearClipping, farClipping);
+    LightManager::viewportSize = glm::vec2((float)viewportWidth, (float)viewportHeight);
+}
+
+bool LIB_API LightManager::isClustered()
+{
+    return LightManager::isShaderPath() && LightManager::clustersAvailable && LightManager::clusterGrid->isConfigured()
+        && LightManager::viewportSize.x > 0.0f && LightManager::viewportSize.y > 0.0f;
+}
+
+const LightClusterGrid& LIB_API LightManager::getClusterGrid()
+{
+    return *LightManager::clusterGrid;
+}
+
+/**
+ * @brief Prepara un nuovo frame.
+ *
+ * Nel percorso fixed-function vengono spenti solo gli slot accesi nel frame precedente.
+ */
+void LIB_API LightManager::beginFrame()
+{
+    for (int i = 0; i < LightManager::enabledSlots; i++)
+        glDisable(GL_LIGHT0 + i);
+
+    LightManager::enabledSlots = 0;
+    LightManager::lights.clear();
+    LightManager::dirty = true;
+}
+
+/**
+ * @brief Aggiunge una luce al frame corrente.
+ *
+ * Nel percorso fixed-function la luce occupa il primo slot libero e viene configurata subito
+ * (la matrice di vista e' gia' caricata in GL_MODELVIEW). Nel percorso shader viene portata
+ * nello spazio vista e conservata fino al caricamento dell'uniform buffer.
+ * Le luci con raggio nullo (attenuazione infinita) non illuminano nulla e vengono scartate.
+ */
+void LIB_API LightManager::submit(const LightData& data, const glm::mat4& viewMatrix)
+{
+    if (std::isinf(data.constantAttenuation))
+        return;
+
+    if (LightManager::isShaderPath())
+    {
+        if ((int)LightManager::lights.size() >= LightManager::capacity)
+        {
+            if (!LightManager::overflowReported)
+                WARNING("Maximum number of lights per frame exceeded: (" << LightManager::capacity << ").");
+            LightManager::overflowReported = true;
+            return;
+        }
+
+        LightData eyeData = data;
+        eyeData.position = viewMatrix * data.position;
+        eyeData.spotDirection = glm::mat3(viewMatrix) * data.spotDirection;
+        LightManager::lights.push_back(eyeData);
+        LightManager::dirty = true;
+        return;
+    }
+
+    if (LightManager::enabledSlots >= LightManager::fixedFunctionCapacity)
+    {
+        if (!LightManager::overflowReported)
+            WARNING("Maximum number of fixed-function lights exceeded: (" << LightManager::fixedFunctionCapacity << ").");
+        LightManager::overflowReported = true;
+        return;
+    }
+
+    const GLenum currentLight = GL_LIGHT0 + LightManager::enabledSlots++;
+
+    const glm::vec4 ambient(data.ambient, 1.0f);
+    const glm::vec4 diffuse(data.diffuse, 1.0f);
+    const glm::vec4 specular(data.specular, 1.0f);
+
+    glEnable(currentLight);
+    glLightfv(currentLight, GL_POSITION, glm::value_ptr(data.position));
+    glLightfv(currentLight, GL_SPOT_DIRECTION, glm::value_ptr(data.spotDirection));
+    glLightfv(currentLight, GL_AMBIENT, glm::value_ptr(ambient));
+    glLightfv(currentLight, GL_DIFFUSE, glm::value_ptr(diffuse));
+    glLightfv(currentLight, GL_SPECULAR, glm::value_ptr(specular));
+    glLightf(currentLight, GL_SPOT_CUTOFF, data.spotCutoff);
+    glLightf(currentLight, GL_SPOT_EXPONENT, data.spotExponent);
+    glLightf(currentLight, GL_CONSTANT_ATTENUATION, data.constantAttenuation);
+
+    LightManager::lights.push_back(data);
+}
+
+void LIB_API LightManager::bind()
+{
+    if (!LightManager::isShaderPath())
+        return;
+
+    LightManager::program->use();
+    GLExtensions::bindBufferBase(GL_UNIFORM_BUFFER, LIGHT_BLOCK_BINDING, LightManager::uniformBuffer);
+    LightManager::bound = true;
+    LightManager::textureEnabled = -1;
+
+    LightManager::clustersActive = LightManager::isClustered();
+    GLExtensions::uniform1i(LightManager::useClustersLocation, LightManager::clustersActive ? 1 : 0);
+
+    if (LightManager::clustersActive)
+    {
+        const glm::vec2 slice = LightManager::clusterGrid->getSliceParameters();
+        GLExtensions::uniform2f(LightManager::clusterTileSizeLocation, LightManager::viewportSize.x / LightClusterGrid::TILES_X, LightManager::viewportSize.y / LightClusterGrid::TILES_Y);
+        GLExtensions::uniform2f(LightManager::clusterSliceLocation, slice.x, slice.y);
+
+        // Le texture buffer usano unita' dedicate: la 0 resta quella dei materiali.
+        GLExtensions::activeTexture(GL_TEXTURE0 + CLUSTER_GRID_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, LightManager::clusterTextures[0]);
+        GLExtensions::activeTexture(GL_TEXTURE0 + CLUSTER_LIGHTS_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, LightManager::clusterTextures[1]);
+        GLExtensions::activeTexture(GL_TEXTURE0);
+    }
+}
+
+void LIB_API LightManager::unbind()
+{
+    if (!LightManager::bound)
+        return;
+
+    GLExtensions::useProgram(0);
+    LightManager::bound = false;
+    LightManager::clustersActive = false;
+}
+
+/**
+ * @brief Seleziona le luci che raggiungono una mesh e le passa al programma.
+ *
+ * Le luci direzionali e quelle senza raggio di influenza raggiungono sempre l'oggetto;
+ * le altre vengono scartate confrontando la sfera che contiene il volume illuminato
+ * (il cono per le spot, vedi `LightClusterGrid::getLightBounds`) con la sfera di ingombro in spazio vista.
+ * Con i cluster attivi le luci limitate sono gia' assegnate ai cluster e non vengono ripetute.
+ */
+void LIB_API LightManager::prepareObject(const glm::mat4& viewMatrix, const glm::vec3& center, const float radius)
+{
+    if (!LightManager::bound)
+        return;
+
+    if (LightManager::dirty)
+        LightManager::upload();
+
+    const glm::vec3 eyeCenter = glm::vec3(viewMatrix * glm::vec4(center, 1.0f));
+    const float scale = std::max({ glm::length(glm::vec3(viewMatrix[0])), glm::length(glm::vec3(viewMatrix[1])), glm::length(glm::vec3(viewMatrix[2])) });
+    const float eyeRadius = radius * scale;
+
+    GLint indices[LightManager::MAX_OBJECT_LIGHTS];
+    GLint count = 0;
+
+    for (int i = 0; i < (int)LightManager::lights.size() && count < LightManager::MAX_OBJECT_LIGHTS; i++)
+    {
+        const LightData& light = LightManager::lights[i];
+        const bool unbounded = light.position.w == 0.0f || light.range <= 0.0f;
+
+        if (LightManager::clustersActive && !unbounded)
+            continue;
+
+        if (unbounded)
+        {
+            indices[count++] = i;
+            continue;
+        }
+
+        const glm::vec4 bounds = LightClusterGrid::getLightBounds(light);
+        if (LightManager::isInRange(glm::vec3(bounds), bounds.w, eyeCenter, eyeRadius))
+            indices[count++] = i;
+    }
+
+    GLExtensions::uniform1i(LightManager::objectLightCountLocation, count);
+
+    if (count > 0)
+        GLExtensions::uniform1iv(LightManager::objectLightsLocation, count, indices);
+}
+
+void LIB_API LightManager::setTextureEnabled(const bool enabled)
+{
+    if (!LightManager::bound || LightManager::textureEnabled == (int)enabled)
+        return;
+
+    GLExtensions::uniform1i(LightManager::useTextureLocation, enabled ? 1 : 0);
+    LightManager::textureEnabled = (int)enabled;
+}
+
+int LIB_API LightManager::getLightCount()
+{
+    return (int)LightManager::lights.size();
+}
+
+bool LIB_API LightManager::isInRange(const glm::vec3& lightPosition, const float range, const glm::vec3& center, const float radius)
+{
+    if (range <= 0.0f)
+        return true;
+
+    const glm::vec3 delta = center - lightPosition;
+    const float reach = range + radius;
+    return glm::dot(delta, delta) <= reach * reach;
+}
+
+/**
+ * @brief Impacchetta le luci del frame e aggiorna l'uniform buffer.
+ *
+ * Layout per luce: posizione, direzione spot + coseno del cutoff, ambientale + esponente,
+ * diffuso + attenuazione costante, speculare + raggio di influenza.
+ */
+void LightManager::upload()
+{
+    LightManager::packedLights.clear();
+
+    for (const LightData& light : LightManager::lights)
+    {
+        const float spotCosine = light.spotCutoff >= 180.0f ? -2.0f : std::cos(glm::radians(light.spotCutoff));
+
+        LightManager::packedLights.push_back(light.position);
+        LightManager::packedLights.push_back(glm::vec4(light.spotDirection, spotCosine));
+        LightManager::packedLights.push_back(glm::vec4(light.ambient, light.spotExponent));
+        LightManager::packedLights.push_back(glm::vec4(light.diffuse, light.constantAttenuation));
+        LightManager::packedLights.push_back(glm::vec4(light.specular, light.range));
+    }
+
+    if (!LightManager::packedLights.empty())
+    {
+        GLExtensions::bindBuffer(GL_UNIFORM_BUFFER, LightManager::uniformBuffer);
+        GLExtensions::bufferSubData(GL_UNIFORM_BUFFER, 0, (EngineGLsizeiptr)(LightManager::packedLights.size() * sizeof(glm::vec4)), LightManager::packedLights.data());
+        GLExtensions::bindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    if (LightManager::clustersActive)
+    {
+        LightManager::clusterGrid->assign(LightManager::lights);
+
+        const std::vector<uint32_t>& clusters = LightManager::clusterGrid->getClusters();
+        const std::vector<uint16_t>& indices = LightManager::clusterGrid->getIndices();
+
+        // Il buffer viene riallocato ad ogni frame: il driver non deve attendere quello precedente.
+        GLExtensions::bindBuffer(GL_TEXTURE_BUFFER, LightManager::clusterBuffers[0]);
+        GLExtensions::bufferData(GL_TEXTURE_BUFFER, (EngineGLsizeiptr)(clusters.size() * sizeof(uint32_t)), clusters.data(), GL_STREAM_DRAW);
+
+        if (!indices.empty())
+        {
+            GLExtensions::bindBuffer(GL_TEXTURE_BUFFER, LightManager::clusterBuffers[1]);
+            GLExtensions::bufferData(GL_TEXTURE_BUFFER, (EngineGLsizeiptr)(indices.size() * sizeof(uint16_t)), indices.data(), GL_STREAM_DRAW);
+        }
+
+        GLExtensions::bindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+
+    LightManager::dirty = false;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "Common.h"
+
+class LightClusterGrid;
+
+/**
+ * @file LightManager.h
+ * @brief Dichiarazione del gestore delle luci: pipeline GLSL con culling per oggetto e ripiego fixed-function.
+ */
+
+ /**
+  * @struct LightData
+  * @brief Parametri di una luce nello stesso formato usato da `glLightfv`.
+  *
+  * Posizione e direzione sono espresse nello spazio del nodo luce: `LightManager::submit`
+  * le porta nello spazio vista con la matrice corrente.
+  */
+struct LIB_API LightData
+{
+    glm::vec4 position;          ///< Posizione (w = 1) oppure direzione (w = 0, luce direzionale).
+    glm::vec3 spotDirection;     ///< Direzione del cono (solo spot).
+    float spotCutoff;            ///< Semi-apertura del cono in gradi, 180 per le luci non spot.
+    float spotExponent;          ///< Concentrazione della luce nel cono.
+    float constantAttenuation;   ///< Attenuazione costante.
+    float range;                 ///< Raggio di influenza usato per il culling, 0 = illimitato.
+    glm::vec3 ambient;           ///< Colore ambientale.
+    glm::vec3 diffuse;           ///< Colore diffuso.
+    glm::vec3 specular;          ///< Colore speculare.
+};
+
+/**
+ * @class LightManager
+ * @brief Raccoglie le luci della scena e le applica con shader GLSL o, in mancanza, con le luci fixed-function.
+ *
+ * Con gli shader disponibili le luci di ogni frame vengono caricate in un uniform buffer
+ * e ogni mesh riceve solo la lista delle luci che ne raggiungono la sfera di ingombro:
+ * non esiste piu' il limite di `GL_MAX_LIGHTS`. Senza shader vengono usati gli slot
+ * `GL_LIGHT0 + i` nell'ordine di invio e le luci in eccesso vengono ignorate.
+ *
+ * Con una camera prospettica e le texture buffer disponibili le luci con raggio di influenza
+ * vengono assegnate ai cluster del frustum (`LightClusterGrid`): ogni frammento valuta solo
+ * quelle del proprio cluster, mentre la lista per oggetto contiene le sole luci illimitate.
+ */
+class LIB_API LightManager
+{
+public:
+
+    /**
+     * @brief Numero massimo di luci valutate per una singola mesh.
+     */
+    static constexpr int MAX_OBJECT_LIGHTS = 32;
+
+    /**
+     * @brief Inizializza il programma di illuminazione e l'uniform buffer.
+     *
+     * Da chiamare dopo `GLExtensions::load`. Se gli shader non sono disponibili
+     * resta attivo il percorso fixed-function.
+     */
+    static void init();
+
+    /**
+     * @brief Libera le risorse OpenGL del gestore.
+     */
+    static void quit();
+
+    /**
+     * @brief Verifica se l'illuminazione via shader e' attiva.
+     * @return `true` se il programma GLSL e' stato creato.
+     */
+    static bool isShaderPath();
+
+    /**
+     * @brief Abilita o disabilita l'uso degli shader, se disponibili.
+     * @param enabled `false` per forzare il percorso fixed-function.
+     */
+    static void setShaderPathEnabled(const bool enabled);
+
+    /**
+     * @brief Restituisce il numero massimo di luci per frame del percorso attivo.
+     * @return La capacita' dell'uniform buffer, oppure `GL_MAX_LIGHTS`.
+     */
+    static int getCapacity();
+
+    /**
+     * @brief Imposta la proiezione usata per la griglia dei cluster.
+     * @param fov Il campo visivo verticale in gradi, 0 per disattivare i cluster.
+     * @param aspectRatio Il rapporto larghezza/altezza del viewport.
+     * @param nearClipping La distanza del piano vicino.
+     * @param farClipping La distanza del piano lontano.
+     * @param viewportWidth La larghezza del viewport in pixel.
+     * @param viewportHeight L'altezza del viewport in pixel.
+     */
+    static void setProjection(const float fov, const float aspectRatio, const float nearClipping, const float farClipping, const int viewportWidth, const int viewportHeight);
+
+    /**
+     * @brief Verifica se l'assegnazione delle luci ai cluster e' attiva.
+     * @return `true` con shader, texture buffer e una proiezione prospettica valida.
+     */
+    static bool isClustered();
+
+    /**
+     * @brief Restituisce la griglia dei cluster dell'ultimo frame.
+     * @return Un riferimento costante alla griglia.
+     */
+    static const LightClusterGrid& getClusterGrid();
+
+    /**
+     * @brief Prepara un nuovo frame: svuota la lista delle luci e spegne gli slot fixed-function usati.
+     */
+    static void beginFrame();
+
+    /**
+     * @brief Aggiunge una luce al frame corrente.
+     *
+     * Chiamata dal `render` delle luci, con la matrice di vista gia' caricata.
+     *
+     * @param data I parametri della luce nello spazio del nodo.
+     * @param viewMatrix La matrice di vista del nodo luce.
+     */
+    static void submit(const LightData& data, const glm::mat4& viewMatrix);
+
+    /**
+     * @brief Attiva il programma di illuminazione (nessun effetto nel percorso fixed-function).
+     */
+    static void bind();
+
+    /**
+     * @brief Disattiva il programma di illuminazione.
+     */
+    static void unbind();
+
+    /**
+     * @brief Seleziona le luci che raggiungono una mesh e le passa al programma.
+     * @param viewMatrix La matrice di vista della mesh.
+     * @param center Il centro della sfera di ingombro nello spazio della mesh.
+     * @param radius Il raggio della sfera di ingombro nello spazio della mesh.
+     */
+    static void prepareObject(const glm::mat4& viewMatrix, const glm::vec3& center, const float radius);
+
+    /**
+     * @brief Indica al programma se il materiale corrente usa una texture.
+     * @param enabled `true` se la texture va campionata.
+     */
+    static void setTextureEnabled(const bool enabled);
+
+    /**
+     * @brief Restituisce il numero di luci inviate nel frame corrente.
+     * @return Il numero di luci.
+     */
+    static int getLightCount();
+
+    /**
+     * @brief Verifica se una luce limitata raggiunge una sfera.
+     * @param lightPosition La posizione della luce (stesso spazio della sfera).
+     * @param range Il raggio di influenza della luce, 0 = illimitato.
+     * @param center Il centro della sfera.
+     * @param radius Il raggio della sfera.
+     * @return `true` se la luce puo' illuminare la sfera.
+     */
+    static bool isInRange(const glm::vec3& lightPosition, const float range, const glm::vec3& center, const float radius);
+
+private:
+    static void upload();
+
+    static std::unique_ptr<Shader> program;        ///< Programma di illuminazione (nullptr senza shader).
+    static bool shaderPathEnabled;                 ///< Percorso shader richiesto dall'utente.
+    static bool bound;                             ///< Il programma e' attivo.
+    static bool dirty;                             ///< Le luci del frame non sono ancora state caricate.
+    static int textureEnabled;                     ///< Ultimo valore inviato a `useTexture` (-1 = sconosciuto).
+    static int capacity;                           ///< Luci per frame supportate dall'uniform buffer.
+    static int fixedFunctionCapacity;              ///< `GL_MAX_LIGHTS`, letto da `init` (8, il minimo garantito, prima).
+    static int enabledSlots;                       ///< Slot fixed-function accesi nell'ultimo frame.
+    static bool overflowReported;                  ///< Avviso di superamento gia' stampato.
+    static unsigned int uniformBuffer;             ///< Uniform buffer delle luci.
+    static int objectLightCountLocation;           ///< Posizione dell'uniform `objectLightCount`.
+    static int objectLightsLocation;               ///< Posizione dell'uniform `objectLights`.
+    static int useTextureLocation;                 ///< Posizione dell'uniform `useTexture`.
+    static std::vector<LightData> lights;          ///< Luci del frame nello spazio vista.
+    static std::vector<glm::vec4> packedLights;    ///< Luci impacchettate per l'uniform buffer.
+    static std::unique_ptr<LightClusterGrid> clusterGrid; ///< Griglia dei cluster del frustum.
+    static bool clustersAvailable;                 ///< Texture buffer dei cluster create.
+    static bool clustersActive;                    ///< Cluster usati nel frame corrente.
+    static glm::vec2 viewportSize;                 ///< Dimensioni del viewport in pixel.
+    static unsigned int clusterBuffers[2];         ///< Buffer dei cluster: (offset, numero) e indici.
+    static unsigned int clusterTextures[2];        ///< Texture buffer associate a `clusterBuffers`.
+    static int useClustersLocation;                ///< Posizione dell'uniform `useClusters`.
+    static int clusterTileSizeLocation;            ///< Posizione dell'uniform `clusterTileSize`.
+    static int clusterSliceLocation;               ///< Posizione dell'uniform `clusterSlice`.
+};
@@ -1,68 +1,167 @@
-#include "List.h"
-#include "Node.h"
-#include <algorithm>
-
-// Getter
-
-/**
- * @brief Restituisce una referenza alla lista degli oggetti da renderizzare.
- * @return Una referenza a `std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>`.
- */
-LIB_API std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& List::getListRendering() {
-    return _listRendering;
-}
-
-// Setter
-
-/**
- * @brief Imposta la lista degli oggetti da renderizzare.
- * @param newListRendering Il nuovo vettore contenente nodi e matrici di trasformazione.
- */
-void LIB_API List::setListRendering(std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> newListRendering) {
-    _listRendering = newListRendering;
-}
-
-/**
- * @brief Genera una lista di nodi e le loro matrici di trasformazione globale per il rendering.
- * @param sceneRoot Il nodo radice della scena.
- * @param parentWorldMatrix La matrice di trasformazione globale del nodo padre.
- * @return Un vettore di coppie contenente nodi e matrici di trasformazione globale.
- */
-std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> LIB_API List::pass(const std::shared_ptr<Node> sceneRoot, const glm::mat4 parentWorldMatrix) {
-    std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> renderListPass;
-
-    // Aggiunge il nodo corrente con la sua matrice di trasformazione globale.
-    renderListPass.push_back(std::make_pair(sceneRoot, parentWorldMatrix * sceneRoot->getLocalMatrix()));
-
-    // Itera sui figli del nodo radice e costruisce ricorsivamente la lista.
-    for (const auto& child : sceneRoot->getChildren()) {
-        auto childRenderList = List::pass(child, parentWorldMatrix * sceneRoot->getLocalMatrix());
-        renderListPass.insert(renderListPass.end(), childRenderList.begin(), childRenderList.end());
-    }
-
-    return renderListPass;
-}
-
-/**
- * @brief Riordina la lista degli oggetti da renderizzare in base alla priorit.
- */
-void List::sortListRendering() {
-    std::sort(_listRendering.begin(), _listRendering.end(),
-        [](const std::pair<std::shared_ptr<Node>, glm::mat4> a, const std::pair<std::shared_ptr<Node>, glm::mat4> b) {
-            return a.first->getPriority() > b.first->getPriority();
-        });
-}
-
-/**
- * @brief Renderizza tutti gli oggetti nella lista di rendering.
- * @param inversaCamera La matrice inversa della camera.
- */
-void LIB_API List::render(const glm::mat4 inversaCamera) const {
-    glm::mat4 viewMatrix(1.0f);
-
-    // Per ogni elemento della lista, calcola la matrice di vista e renderizza il nodo.
-    for (const auto& node : _listRendering) {
-        viewMatrix = inversaCamera * node.second;
-        node.first->render(viewMatrix);
-    }
-}
+#include "List.h"
+#include "Node.h"
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iterator>
+
+// Getter
+
+/**
+ * @brief Restituisce una referenza alla lista degli oggetti da renderizzare.
+ * @return Una referenza a `std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>`.
+ */
+LIB_API std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& List::getListRendering() {
+    return _listRendering;
+}
+
+// Setter
+
+/**
+ * @brief Imposta la lista degli oggetti da renderizzare.
+ * @param newListRendering Il nuovo vettore contenente nodi e matrici di trasformazione.
+ */
+void LIB_API List::setListRendering(const std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& newListRendering) {
+    _listRendering = newListRendering;
+}
+
+/**
+ * @brief Genera una lista di nodi e le loro matrici di trasformazione globale per il rendering.
+ * @param sceneRoot Il nodo radice della scena.
+ * @param parentWorldMatrix La matrice di trasformazione globale del nodo padre.
+ * @return Un vettore di coppie contenente nodi e matrici di trasformazione globale.
+ */
+std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> LIB_API List::pass(const std::shared_ptr<Node> sceneRoot, const glm::mat4 parentWorldMatrix) {
+    std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> renderListPass;
+    List::pass(sceneRoot, parentWorldMatrix, renderListPass);
+
+    return renderListPass;
+}
+
+/**
+ * @brief Riempie una lista esistente con i nodi e le matrici di trasformazione globale.
+ */
+void LIB_API List::pass(const std::shared_ptr<Node>& sceneRoot, const glm::mat4& parentWorldMatrix, std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& renderList) {
+    renderList.clear();
+
+    // Visita ricorsiva che aggiunge direttamente alla lista, senza liste intermedie per i figli.
+    List::appendSubtree(sceneRoot, parentWorldMatrix, renderList);
+}
+
+/**
+ * @brief Genera la lista di rendering dividendo i sottoalberi della scena tra i thread di un pool.
+ *
+ * La profondita' di divisione e' la prima in cui i nodi sono almeno quattro per thread.
+ * I nodi sopra quella profondita' vengono aggiunti dal thread chiamante a segmenti seriali;
+ * ogni sottoalbero alla profondita' di divisione riempie un segmento proprio in un task.
+ * Ogni segmento e' scritto da un solo thread, quindi la concatenazione finale non richiede lock.
+ *
+ * @param sceneRoot Il nodo radice della scena.
+ * @param parentWorldMatrix La matrice di trasformazione globale del nodo padre.
+ * @param pool Il pool di thread da usare.
+ * @return Un vettore di coppie contenente nodi e matrici di trasformazione globale.
+ */
+std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> LIB_API List::pass(const std::shared_ptr<Node> sceneRoot, const glm::mat4 parentWorldMatrix, TaskPool& pool) {
+    using RenderList = std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>;
+
+    // Cerca la profondita' con abbastanza sottoalberi da distribuire.
+    static constexpr int MAX_SPLIT_DEPTH = 8;
+    const size_t targetTasks = 4 * ((size_t)pool.getThreadCount() + 1);
+
+    int splitDepth = 0;
+    std::vector<Node*> level = { sceneRoot.get() };
+    std::vector<Node*> nextLevel;
+
+    while (level.size() < targetTasks && splitDepth < MAX_SPLIT_DEPTH)
+    {
+        nextLevel.clear();
+        for (Node* node : level)
+            for (const auto& child : node->getChildren())
+                nextLevel.push_back(child.get());
+
+        if (nextLevel.empty())
+            break;
+
+        level.swap(nextLevel);
+        splitDepth++;
+    }
+
+    if (pool.getThreadCount() == 0 || level.size() < 2)
+        return List::pass(sceneRoot, parentWorldMatrix);
+
+    // std::deque mantiene validi i riferimenti ai segmenti gia' passati ai task.
+    std::deque<RenderList> segments(1);
+    TaskPool::Group group;
+
+    const std::function<void(const std::shared_ptr<Node>&, const glm::mat4&, int)> split =
+        [&](const std::shared_ptr<Node>& node, const glm::mat4& parentMatrix, const int depth)
+        {
+            if (depth == splitDepth)
+            {
+                RenderList& segment = segments.emplace_back();
+                pool.submit(group, [&segment, node, parentMatrix]() { List::appendSubtree(node, parentMatrix, segment); });
+
+                // I nodi successivi del livello superiore vanno in un nuovo segmento seriale.
+                segments.emplace_back();
+                return;
+            }
+
+            const glm::mat4 worldMatrix = parentMatrix * node->getLocalMatrix();
+            segments.back().emplace_back(node, worldMatrix);
+
+            for (const auto& child : node->getChildren())
+                split(child, worldMatrix, depth + 1);
+        };
+
+    split(sceneRoot, parentWorldMatrix, 0);
+    pool.wait(group);
+
+    size_t size = 0;
+    for (const RenderList& segment : segments)
+        size += segment.size();
+
+    RenderList renderListPass;
+    renderListPass.reserve(size);
+
+    for (RenderList& segment : segments)
+        std::move(segment.begin(), segment.end(), std::back_inserter(renderListPass));
+
+    return renderListPass;
+}
+
+/**
+ * @brief Aggiunge un sottoalbero alla lista in ordine di visita in profondita'.
+ */
+void List::appendSubtree(const std::shared_ptr<Node>& node, const glm::mat4& parentWorldMatrix, std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& renderList) {
+    // Aggiunge il nodo corrente con la sua matrice di trasformazione globale.
+    const glm::mat4 worldMatrix = parentWorldMatrix * node->getLocalMatrix();
+    renderList.emplace_back(node, worldMatrix);
+
+    // Itera sui figli del nodo e costruisce ricorsivamente la lista.
+    for (const auto& child : node->getChildren())
+        List::appendSubtree(child, worldMatrix, renderList);
+}
+
+/**
+ * @brief Riordina la lista degli oggetti da renderizzare in base alla priorità.
+ */
+void List::sortListRendering() {
+    std::sort(_listRendering.begin(), _listRendering.end(),
+        [](const std::pair<std::shared_ptr<Node>, glm::mat4>& a, const std::pair<std::shared_ptr<Node>, glm::mat4>& b) {
+            return a.first->getPriority() > b.first->getPriority();
+        });
+}
+
+/**
+ * @brief Renderizza tutti gli oggetti nella lista di rendering.
+ * @param inversaCamera La matrice inversa della camera.
+ */
+void LIB_API List::render(const glm::mat4 inversaCamera) const {
+    glm::mat4 viewMatrix(1.0f);
+
+    // Per ogni elemento della lista, calcola la matrice di vista e renderizza il nodo.
+    for (const auto& node : _listRendering) {
+        viewMatrix = inversaCamera * node.second;
+        node.first->render(viewMatrix);
+    }
+}
@@ -1,71 +1,105 @@
-#pragma once
-
-#include "Node.h"
-#include "Common.h"
-#include <vector>
-#include <memory>
-#include <glm/glm.hpp>
-
-/**
- * @class List
- * @brief Gestisce una lista di nodi e le loro matrici di trasformazione per il rendering.
- *
- * La classe `List` mantiene una lista di nodi e le relative matrici di trasformazione
- * che sono utilizzate per il rendering. La lista viene utilizzata per ordinare e
- * gestire il rendering degli oggetti nella scena.
- */
-class LIB_API List : public Object {
-
-public:
-
-    /**
-     * @brief Costruttore di default per la classe `List`.
-     */
-    List() = default;
-
-    // Getter
-
-    /**
-     * @brief Restituisce la lista di nodi da renderizzare.
-     * @return Una referenza a `std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>` contenente
-     *         i nodi e le loro matrici di trasformazione globale.
-     */
-    std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& getListRendering();
-
-    // Setter
-
-    /**
-     * @brief Imposta la lista di nodi da renderizzare.
-     * @param newListRendering Il nuovo vettore contenente nodi e le loro matrici di trasformazione.
-     */
-    void setListRendering(std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> newListRendering);
-
-    /**
-     * @brief Riordina la lista degli oggetti da renderizzare in base alla priorit.
-     *
-     * L'ordine di importanza :
-     * - Camera
-     * - Light
-     * - Resto (es. Mesh).
-     */
-    void sortListRendering();
-
-    /**
-     * @brief Genera una lista di nodi e le relative matrici di trasformazione globale per il rendering.
-     * @param sceneRoot Il nodo radice della scena.
-     * @param parentWorldMatrix La matrice di trasformazione globale del nodo padre.
-     * @return Un vettore di coppie contenente nodi e matrici di trasformazione globale.
-     */
-    static std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> pass(const std::shared_ptr<Node> sceneRoot, const glm::mat4 parentWorldMatrix);
-
-    /**
-     * @brief Renderizza tutti gli oggetti nella lista.
-     * @param inversaCamera La matrice inversa della camera, necessaria per calcolare la matrice di vista.
-     */
-    void render(const glm::mat4 inversaCamera) const override;
-
-private:
-
-    ///< Lista dei nodi e delle loro matrici di trasformazione per il rendering.
-    std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> _listRendering;
-};
+#pragma once
+
+#include "Node.h"
+#include "Common.h"
+#include "TaskPool.h"
+#include <vector>
+#include <memory>
+#include <glm/glm.hpp>
+
+/**
+ * @class List
+ * @brief Gestisce una lista di nodi e le loro matrici di trasformazione per il rendering.
+ *
+ * La classe `List` mantiene una lista di nodi e le relative matrici di trasformazione
+ * che sono utilizzate per il rendering. La lista viene utilizzata per ordinare e
+ * gestire il rendering degli oggetti nella scena.
+ */
+class LIB_API List : public Object {
+
+public:
+
+    /**
+     * @brief Costruttore di default per la classe `List`.
+     */
+    List() = default;
+
+    // Getter
+
+    /**
+     * @brief Restituisce la lista di nodi da renderizzare.
+     * @return Una referenza a `std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>` contenente
+     *         i nodi e le loro matrici di trasformazione globale.
+     */
+    std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& getListRendering();
+
+    // Setter
+
+    /**
+     * @brief Imposta la lista di nodi da renderizzare.
+     * @param newListRendering Il nuovo vettore contenente nodi e le loro matrici di trasformazione.
+     */
+    void setListRendering(const std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& newListRendering);
+
+    /**
+     * @brief Riordina la lista degli oggetti da renderizzare in base alla priorità.
+     *
+     * L'ordine di importanza è:
+     * - Camera
+     * - Light
+     * - Resto (es. Mesh).
+     */
+    void sortListRendering();
+
+    /**
+     * @brief Genera una lista di nodi e le relative matrici di trasformazione globale per il rendering.
+     * @param sceneRoot Il nodo radice della scena.
+     * @param parentWorldMatrix La matrice di trasformazione globale del nodo padre.
+     * @return Un vettore di coppie contenente nodi e matrici di trasformazione globale.
+     */
+    static std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> pass(const std::shared_ptr<Node> sceneRoot, const glm::mat4 parentWorldMatrix);
+
+    /**
+     * @brief Riempie una lista esistente con i nodi e le matrici di trasformazione globale.
+     *
+     * La lista viene svuotata ma conserva la memoria: riusandola tra i frame non si alloca.
+     *
+     * @param sceneRoot Il nodo radice della scena.
+     * @param parentWorldMatrix La matrice di trasformazione globale del nodo padre.
+     * @param renderList La lista da riempire.
+     */
+    static void pass(const std::shared_ptr<Node>& sceneRoot, const glm::mat4& parentWorldMatrix, std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& renderList);
+
+    /**
+     * @brief Genera la lista di rendering dividendo i sottoalberi della scena tra i thread di un pool.
+     *
+     * I livelli piu' alti della gerarchia vengono visitati dal thread chiamante fino a ottenere
+     * abbastanza sottoalberi; ognuno diventa un task che riempie la propria lista. Le liste
+     * vengono poi concatenate nell'ordine della visita, quindi il risultato coincide con `pass`.
+     *
+     * @param sceneRoot Il nodo radice della scena.
+     * @param parentWorldMatrix La matrice di trasformazione globale del nodo padre.
+     * @param pool Il pool di thread da usare.
+     * @return Un vettore di coppie contenente nodi e matrici di trasformazione globale.
+     */
+    static std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> pass(const std::shared_ptr<Node> sceneRoot, const glm::mat4 parentWorldMatrix, TaskPool& pool);
+
+    /**
+     * @brief Renderizza tutti gli oggetti nella lista.
+     * @param inversaCamera La matrice inversa della camera, necessaria per calcolare la matrice di vista.
+     */
+    void render(const glm::mat4 inversaCamera) const override;
+
+private:
+
+    /**
+     * @brief Aggiunge un sottoalbero alla lista in ordine di visita in profondita'.
+     * @param node La radice del sottoalbero.
+     * @param parentWorldMatrix La matrice globale del padre.
+     * @param renderList La lista da riempire.
+     */
+    static void appendSubtree(const std::shared_ptr<Node>& node, const glm::mat4& parentWorldMatrix, std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& renderList);
+
+    ///< Lista dei nodi e delle loro matrici di trasformazione per il rendering.
+    std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> _listRendering;
+};
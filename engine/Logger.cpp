@@ -0,0 +1,302 @@
+#include "Logger.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+
+Logger::Slot Logger::slots[Logger::CAPACITY];
+std::atomic<size_t> Logger::enqueuePosition{ 0 };
+std::atomic<size_t> Logger::dequeuePosition{ 0 };
+std::atomic<int> Logger::minimumLevel{ ENGINE_LOG_LEVEL };
+std::atomic<size_t> Logger::written{ 0 };
+std::atomic<size_t> Logger::dropped{ 0 };
+std::atomic<bool> Logger::running{ false };
+std::atomic<bool> Logger::stopping{ false };
+std::mutex Logger::threadMutex;
+std::thread Logger::writer;
+
+// Pausa del thread di scrittura quando il buffer e' vuoto.
+static constexpr std::chrono::milliseconds WRITER_IDLE_SLEEP{ 2 };
+
+static_assert((Logger::CAPACITY & (Logger::CAPACITY - 1)) == 0, "Logger::CAPACITY must be a power of two");
+
+// Dopo la chiusura del programma i messaggi vengono scritti direttamente.
+static std::atomic<bool> closed{ false };
+
+/**
+ * @brief Buffer di formattazione di un thread: un array fisso, i caratteri in eccesso vengono scartati.
+ */
+class MessageBuffer : public std::streambuf
+{
+public:
+    MessageBuffer()
+    {
+        this->reset();
+    }
+
+    void reset()
+    {
+        this->setp(this->_text, this->_text + Logger::MESSAGE_SIZE - 1);
+    }
+
+    const char* data() const
+    {
+        return this->pbase();
+    }
+
+    size_t length() const
+    {
+        return (size_t)(this->pptr() - this->pbase());
+    }
+
+protected:
+    int_type overflow(int_type character) override
+    {
+        // Il messaggio e' troncato: i caratteri vengono accettati ma ignorati.
+        return traits_type::not_eof(character);
+    }
+
+private:
+    char _text[Logger::MESSAGE_SIZE];
+};
+
+/**
+ * @brief Stream di formattazione di un thread.
+ */
+struct MessageStream
+{
+    MessageBuffer buffer;
+    std::ostream stream{ &buffer };
+};
+
+static thread_local MessageStream messageStream;
+
+/**
+ * @brief Prefisso di un livello.
+ */
+static const char* levelPrefix(const LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Debug: return "[DEBUG] ";
+    case LogLevel::Info: return "[INFO] ";
+    case LogLevel::Warning: return "[WARNING] ";
+    default: return "[ERROR] ";
+    }
+}
+
+/**
+ * @brief Scrive un messaggio sulla console: gli errori su `std::cerr`, gli altri su `std::cout`.
+ */
+static void print(const LogLevel level, const char* text, const size_t length)
+{
+    std::ostream& output = level == LogLevel::Error ? std::cerr : std::cout;
+    output << levelPrefix(level);
+    output.write(text, (std::streamsize)length);
+    output.put('\n');
+}
+
+/**
+ * @brief Ferma il thread di scrittura alla chiusura del programma, scrivendo i messaggi rimasti.
+ */
+static struct LoggerShutdown
+{
+    ~LoggerShutdown()
+    {
+        closed.store(true);
+        Logger::quit();
+    }
+} loggerShutdown;
+
+void LIB_API Logger::setLevel(const LogLevel level)
+{
+    Logger::minimumLevel.store((int)level, std::memory_order_relaxed);
+}
+
+LogLevel LIB_API Logger::getLevel()
+{
+    return (LogLevel)Logger::minimumLevel.load(std::memory_order_relaxed);
+}
+
+bool LIB_API Logger::isEnabled(const LogLevel level)
+{
+    return (int)level >= Logger::minimumLevel.load(std::memory_order_relaxed);
+}
+
+std::ostream& LIB_API Logger::stream()
+{
+    messageStream.buffer.reset();
+    messageStream.stream.clear();
+    return messageStream.stream;
+}
+
+bool LIB_API Logger::submit(const LogLevel level)
+{
+    return Logger::enqueue(level, messageStream.buffer.data(), messageStream.buffer.length());
+}
+
+bool LIB_API Logger::write(const LogLevel level, const std::string& message)
+{
+    return Logger::enqueue(level, message.data(), message.size());
+}
+
+/**
+ * @brief Copia un messaggio nella prossima cella libera, senza lock.
+ *
+ * Una cella e' libera per la posizione `p` quando la sua sequenza vale `p`; dopo la copia vale
+ * `p + 1` e il thread di scrittura la puo' leggere. Se la cella contiene ancora un messaggio di
+ * un giro precedente il buffer e' pieno e il messaggio viene scartato.
+ */
+bool Logger::enqueue(const LogLevel level, const char* text, size_t length)
+{
+    if (closed.load(std::memory_order_relaxed))
+    {
+        print(level, text, length);
+        return true;
+    }
+
+    if (!Logger::running.load(std::memory_order_acquire))
+        Logger::start();
+
+    length = length < MESSAGE_SIZE ? length : MESSAGE_SIZE - 1;
+
+    size_t position = Logger::enqueuePosition.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    for (;;)
+    {
+        const size_t index = position & (CAPACITY - 1);
+        slot = &Logger::slots[index];
+
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire) + index;
+        const std::ptrdiff_t difference = (std::ptrdiff_t)(sequence - position);
+
+        if (difference == 0)
+        {
+            if (Logger::enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            Logger::dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+            position = Logger::enqueuePosition.load(std::memory_order_relaxed);
+    }
+
+    slot->level = level;
+    slot->length = length;
+    std::memcpy(slot->text, text, length);
+    slot->sequence.store(position + 1 - (position & (CAPACITY - 1)), std::memory_order_release);
+
+    return true;
+}
+
+/**
+ * @brief Scrive il prossimo messaggio, se pronto. Va chiamata da un solo thread alla volta.
+ * @return `false` se non ci sono messaggi pronti.
+ */
+bool Logger::dequeue()
+{
+    const size_t position = Logger::dequeuePosition.load(std::memory_order_relaxed);
+    const size_t index = position & (CAPACITY - 1);
+    Slot& slot = Logger::slots[index];
+
+    if (slot.sequence.load(std::memory_order_acquire) + index != position + 1)
+        return false;
+
+    print(slot.level, slot.text, slot.length);
+
+    // La cella torna libera per il giro successivo.
+    slot.sequence.store(position + CAPACITY - index, std::memory_order_release);
+    Logger::dequeuePosition.store(position + 1, std::memory_order_release);
+    Logger::written.fetch_add(1, std::memory_order_relaxed);
+
+    return true;
+}
+
+/**
+ * @brief Avvia il thread di scrittura, se non e' gia' attivo.
+ */
+void Logger::start()
+{
+    std::lock_guard<std::mutex> lock(Logger::threadMutex);
+    if (Logger::running.load(std::memory_order_relaxed) || closed.load())
+        return;
+
+    Logger::stopping.store(false);
+    Logger::writer = std::thread(&Logger::writerLoop);
+    Logger::running.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Ciclo del thread di scrittura: svuota il buffer e attende brevemente quando e' vuoto.
+ */
+void Logger::writerLoop()
+{
+    size_t reportedDrops = Logger::dropped.load(std::memory_order_relaxed);
+
+    while (!Logger::stopping.load(std::memory_order_acquire))
+    {
+        bool wrote = false;
+        while (Logger::dequeue())
+            wrote = true;
+
+        // I messaggi scartati vengono segnalati dal thread di scrittura, mai da chi li produce.
+        const size_t drops = Logger::dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops)
+        {
+            std::cout << levelPrefix(LogLevel::Warning) << (drops - reportedDrops) << " log messages dropped (buffer full).\n";
+            reportedDrops = drops;
+            wrote = true;
+        }
+
+        if (wrote)
+        {
+            std::cout.flush();
+            std::cerr.flush();
+        }
+        else
+            std::this_thread::sleep_for(WRITER_IDLE_SLEEP);
+    }
+}
+
+void LIB_API Logger::flush()
+{
+    while (Logger::running.load(std::memory_order_acquire) &&
+        Logger::dequeuePosition.load(std::memory_order_acquire) != Logger::enqueuePosition.load(std::memory_order_relaxed))
+        std::this_thread::sleep_for(WRITER_IDLE_SLEEP);
+
+    std::cout.flush();
+}
+
+size_t LIB_API Logger::getWrittenMessages()
+{
+    return Logger::written.load(std::memory_order_relaxed);
+}
+
+size_t LIB_API Logger::getDroppedMessages()
+{
+    return Logger::dropped.load(std::memory_order_relaxed);
+}
+
+void LIB_API Logger::quit()
+{
+    std::lock_guard<std::mutex> lock(Logger::threadMutex);
+
+    if (Logger::running.load())
+    {
+        Logger::stopping.store(true, std::memory_order_release);
+        Logger::writer.join();
+        Logger::running.store(false, std::memory_order_release);
+    }
+
+    // Messaggi accodati dopo l'ultimo giro del thread.
+    while (Logger::dequeue());
+
+    std::cout.flush();
+    std::cerr.flush();
+}
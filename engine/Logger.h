@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include "Common.h"
+
+/**
+ * @file Logger.h
+ * @brief Dichiarazione del registro asincrono dei messaggi con livelli.
+ */
+
+ /**
+  * @brief Livello di un messaggio, in ordine di gravita' crescente.
+  */
+enum class LogLevel : int
+{
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3,
+    None = 4 ///< Come livello minimo: nessun messaggio.
+};
+
+/**
+ * @class Logger
+ * @brief Scrive i messaggi su console da un thread dedicato, senza mai bloccare chi li produce.
+ *
+ * Le macro `DEBUG`, `INFO`, `WARNING` ed `ERROR` di `Common.h` controllano prima il livello:
+ * quelle sotto `ENGINE_LOG_LEVEL` non vengono compilate, le altre costano una lettura atomica
+ * quando il livello minimo impostato con `setLevel` le esclude.
+ *
+ * Un messaggio accettato viene formattato in un buffer fisso del thread (senza allocazioni)
+ * e copiato in un buffer circolare di dimensione fissa; il thread di scrittura, avviato al primo messaggio, lo svuota
+ * sulla console. Se il buffer e' pieno il messaggio viene scartato e conteggiato, i messaggi
+ * piu' lunghi di `MESSAGE_SIZE` vengono troncati.
+ */
+class LIB_API Logger
+{
+public:
+
+    static constexpr size_t CAPACITY = 1024;     ///< Messaggi nel buffer circolare (potenza di 2).
+    static constexpr size_t MESSAGE_SIZE = 256;  ///< Byte di un messaggio, terminatore compreso.
+
+    /**
+     * @brief Imposta il livello minimo dei messaggi scritti.
+     * @param level Il livello minimo (`LogLevel::None` per non scrivere nulla).
+     */
+    static void setLevel(const LogLevel level);
+
+    /**
+     * @brief Restituisce il livello minimo dei messaggi scritti.
+     * @return Il livello minimo.
+     */
+    static LogLevel getLevel();
+
+    /**
+     * @brief Verifica se un messaggio del livello dato verrebbe scritto.
+     * @param level Il livello del messaggio.
+     * @return `true` se il livello e' almeno quello minimo.
+     */
+    static bool isEnabled(const LogLevel level);
+
+    /**
+     * @brief Restituisce lo stream del thread corrente, svuotato, in cui formattare un messaggio.
+     * @return Lo stream da passare poi a `submit`.
+     */
+    static std::ostream& stream();
+
+    /**
+     * @brief Accoda il messaggio formattato nello stream del thread corrente.
+     * @param level Il livello del messaggio.
+     * @return `false` se il buffer era pieno e il messaggio e' stato scartato.
+     */
+    static bool submit(const LogLevel level);
+
+    /**
+     * @brief Accoda un messaggio gia' formattato.
+     * @param level Il livello del messaggio.
+     * @param message Il testo del messaggio.
+     * @return `false` se il buffer era pieno e il messaggio e' stato scartato.
+     */
+    static bool write(const LogLevel level, const std::string& message);
+
+    /**
+     * @brief Attende che il thread di scrittura abbia scritto tutti i messaggi accodati.
+     */
+    static void flush();
+
+    /**
+     * @brief Restituisce il numero di messaggi scritti sulla console.
+     * @return I messaggi scritti.
+     */
+    static size_t getWrittenMessages();
+
+    /**
+     * @brief Restituisce il numero di messaggi scartati perche' il buffer era pieno.
+     * @return I messaggi scartati.
+     */
+    static size_t getDroppedMessages();
+
+    /**
+     * @brief Ferma il thread di scrittura dopo aver scritto i messaggi rimasti.
+     *
+     * Un messaggio successivo riavvia il thread.
+     */
+    static void quit();
+
+private:
+
+    /**
+     * @brief Un messaggio del buffer circolare.
+     *
+     * `sequence` vale `posizione - indice` della cella: 0 per tutte le celle all'avvio, cosi' che
+     * il buffer sia valido anche per i messaggi scritti durante l'inizializzazione statica.
+     */
+    struct Slot
+    {
+        std::atomic<size_t> sequence{ 0 }; ///< Stato della cella (vedi sopra).
+        LogLevel level = LogLevel::Info;  ///< Livello del messaggio.
+        size_t length = 0;                ///< Byte del testo.
+        char text[MESSAGE_SIZE] = {};     ///< Testo del messaggio.
+    };
+
+    static bool enqueue(const LogLevel level, const char* text, size_t length);
+    static bool dequeue();
+    static void start();
+    static void writerLoop();
+
+    static Slot slots[CAPACITY];                   ///< Buffer circolare.
+    static std::atomic<size_t> enqueuePosition;    ///< Prossima cella da riempire.
+    static std::atomic<size_t> dequeuePosition;    ///< Prossima cella da scrivere.
+    static std::atomic<int> minimumLevel;          ///< Livello minimo dei messaggi scritti.
+    static std::atomic<size_t> written;            ///< Messaggi scritti.
+    static std::atomic<size_t> dropped;            ///< Messaggi scartati.
+    static std::atomic<bool> running;              ///< Il thread di scrittura e' attivo.
+    static std::atomic<bool> stopping;             ///< Richiesta di arresto del thread.
+    static std::mutex threadMutex;                 ///< Protegge avvio e arresto del thread.
+    static std::thread writer;                     ///< Thread di scrittura.
+};
@@ -1,79 +1,205 @@
-#include "Material.h"
-#include <GL/freeglut.h>
-#include <glm/gtc/type_ptr.hpp>
-
-/**
- * @brief Costruttore di default per la classe `Material`.
- *
- * Crea una nuova istanza di `Material` con i seguenti parametri di default:
- * - Colore di emissione: (0.0f, 0.0f, 0.0f)
- * - Colore ambientale: (0.75f, 0.75f, 0.75f)
- * - Colore diffuso: (0.75f, 0.75f, 0.75f)
- * - Colore speculare: (0.75f, 0.75f, 0.75f)
- * - Lucentezza: 64.0f
- * - Valore alpha: 1.0f
- * - Texture: Nessuna texture applicata.
- */
-Material::Material()
-    : Object("Material")
-{
-    this->setEmissionColor(glm::vec3(0.0f, 0.0f, 0.0f));
-    this->setAmbientColor(glm::vec3(0.75f, 0.75f, 0.75f));
-    this->setDiffuseColor(glm::vec3(0.75f, 0.75f, 0.75f));
-    this->setSpecularColor(glm::vec3(0.75f, 0.75f, 0.75f));
-    this->setShininess(64.0f);
-    this->setAlpha(1.0f);
-    this->setTexture(nullptr);
-}
-
-// Getter
-
-glm::vec3 LIB_API Material::getEmissionColor() const {
-    return _emissionColor;
-}
-
-// Setter
-
-void LIB_API Material::setEmissionColor(const glm::vec3 newColor) {
-    this->_emissionColor = newColor;
-}
-
-void LIB_API Material::setAmbientColor(const glm::vec3 newColor) {
-    this->_ambientColor = newColor;
-}
-
-void LIB_API Material::setDiffuseColor(const glm::vec3 newColor) {
-    this->_diffuseColor = newColor;
-}
-
-void LIB_API Material::setSpecularColor(const glm::vec3 newColor) {
-    this->_specularColor = newColor;
-}
-
-void LIB_API Material::setShininess(const float newShininess) {
-    this->_shininess = newShininess;
-}
-
-void LIB_API Material::setAlpha(const float newAlpha) {
-    this->_alpha = newAlpha;
-}
-
-void LIB_API Material::setTexture(const std::shared_ptr<Texture> newTexture) {
-    this->_texture = newTexture;
-}
-
-// Render Material
-
-void LIB_API Material::render(const glm::mat4 viewMatrix) const {
-    glDisable(GL_TEXTURE_2D);
-
-    glMaterialfv(GL_FRONT_AND_BACK, GL_EMISSION, glm::value_ptr(this->_emissionColor));
-    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, glm::value_ptr(this->_ambientColor));
-    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, glm::value_ptr(this->_diffuseColor));
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, glm::value_ptr(this->_specularColor));
-    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, this->_shininess);
-
-    if (this->_texture != nullptr) {
-        this->_texture->render(viewMatrix);
-    }
-}
+#include "Material.h"
+#include "LightManager.h"
+#include <GL/freeglut.h>
+#include <glm/gtc/type_ptr.hpp>
+
+std::atomic<unsigned int> Material::versionCounter{ 0 };
+unsigned int Material::currentVersion = 0;
+int Material::textureEnabled = -1;
+unsigned int Material::boundTexture = 0;
+unsigned int Material::avoidedStateChanges = 0;
+
+/**
+ * @brief Costruttore di default per la classe `Material`.
+ *
+ * Crea una nuova istanza di `Material` con i seguenti parametri di default:
+ * - Colore di emissione: (0.0f, 0.0f, 0.0f)
+ * - Colore ambientale: (0.75f, 0.75f, 0.75f)
+ * - Colore diffuso: (0.75f, 0.75f, 0.75f)
+ * - Colore speculare: (0.75f, 0.75f, 0.75f)
+ * - Lucentezza: 64.0f
+ * - Valore alpha: 1.0f
+ * - Texture: Nessuna texture applicata.
+ */
+Material::Material()
+    : Object("Material")
+{
+    this->setEmissionColor(glm::vec3(0.0f, 0.0f, 0.0f));
+    this->setAmbientColor(glm::vec3(0.75f, 0.75f, 0.75f));
+    this->setDiffuseColor(glm::vec3(0.75f, 0.75f, 0.75f));
+    this->setSpecularColor(glm::vec3(0.75f, 0.75f, 0.75f));
+    this->setShininess(64.0f);
+    this->setAlpha(1.0f);
+    this->setTexture(nullptr);
+}
+
+// Getter
+
+glm::vec3 LIB_API Material::getEmissionColor() const {
+    return this->_state.emissionColor;
+}
+
+glm::vec3 LIB_API Material::getDiffuseColor() const {
+    return this->_state.diffuseColor;
+}
+
+const std::shared_ptr<Texture>& LIB_API Material::getTexture() const {
+    return this->_state.texture;
+}
+
+const MaterialState& LIB_API Material::getState() const {
+    return this->_state;
+}
+
+// Setter
+
+void LIB_API Material::setEmissionColor(const glm::vec3 newColor) {
+    this->_state.emissionColor = newColor;
+    this->touch();
+}
+
+void LIB_API Material::setAmbientColor(const glm::vec3 newColor) {
+    this->_state.ambientColor = newColor;
+    this->touch();
+}
+
+void LIB_API Material::setDiffuseColor(const glm::vec3 newColor) {
+    this->_state.diffuseColor = newColor;
+    this->touch();
+}
+
+void LIB_API Material::setSpecularColor(const glm::vec3 newColor) {
+    this->_state.specularColor = newColor;
+    this->touch();
+}
+
+void LIB_API Material::setShininess(const float newShininess) {
+    this->_state.shininess = newShininess;
+    this->touch();
+}
+
+void LIB_API Material::setAlpha(const float newAlpha) {
+    this->_state.alpha = newAlpha;
+    this->touch();
+}
+
+void LIB_API Material::setTexture(const std::shared_ptr<Texture> newTexture) {
+    this->_state.texture = newTexture;
+    this->touch();
+}
+
+// Render Material
+
+/**
+ * @brief Applica il materiale evitando le chiamate OpenGL ridondanti.
+ *
+ * Se il materiale (alla stessa versione) e' gia' applicato i parametri non vengono reinviati;
+ * l'abilitazione di GL_TEXTURE_2D e l'associazione della texture vengono modificate solo
+ * quando cambiano. Il contatore misura le chiamate risparmiate rispetto all'invio completo.
+ */
+void LIB_API Material::render(const glm::mat4 /*viewMatrix*/) const {
+    Material::apply(this->_state);
+}
+
+/**
+ * @brief Applica uno stato di materiale, anche copiato in un'istantanea della scena.
+ */
+void LIB_API Material::apply(const MaterialState& state) {
+    const bool textured = state.texture != nullptr;
+
+    // Il programma di illuminazione non legge GL_TEXTURE_2D: lo stato va passato come uniform.
+    LightManager::setTextureEnabled(textured);
+
+    // La versione 0 indica uno stato modificato da un override: va sempre inviato.
+    if (state.version != 0 && Material::currentVersion == state.version)
+    {
+        Material::avoidedStateChanges += 5;
+    }
+    else
+    {
+        // glMaterialfv legge quattro componenti: l'alpha del materiale va nel colore diffuso.
+        glMaterialfv(GL_FRONT_AND_BACK, GL_EMISSION, glm::value_ptr(glm::vec4(state.emissionColor, 1.0f)));
+        glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, glm::value_ptr(glm::vec4(state.ambientColor, 1.0f)));
+        glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, glm::value_ptr(glm::vec4(state.diffuseColor, state.alpha)));
+        glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, glm::value_ptr(glm::vec4(state.specularColor, 1.0f)));
+        glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, state.shininess);
+        Material::currentVersion = state.version;
+    }
+
+    if (textured)
+    {
+        // Senza cache: glDisable + glBindTexture + glEnable.
+        const unsigned int textureId = state.texture->getRenderId();
+        unsigned int issued = 0;
+
+        if (Material::boundTexture != textureId)
+        {
+            glBindTexture(GL_TEXTURE_2D, textureId);
+            Material::boundTexture = textureId;
+            issued++;
+        }
+
+        if (Material::textureEnabled != 1)
+        {
+            glEnable(GL_TEXTURE_2D);
+            Material::textureEnabled = 1;
+            issued++;
+        }
+
+        Material::avoidedStateChanges += 3 - issued;
+    }
+    else if (Material::textureEnabled != 0)
+    {
+        glDisable(GL_TEXTURE_2D);
+        Material::textureEnabled = 0;
+    }
+    else
+    {
+        Material::avoidedStateChanges++;
+    }
+}
+
+/**
+ * @brief Applica lo stato di un materiale condiviso con le modifiche di una mesh.
+ *
+ * Lo stato modificato ha versione 0: viene inviato per intero e la mesh successiva
+ * reinvia il proprio materiale anche se e' lo stesso condiviso.
+ */
+void LIB_API Material::apply(const MaterialState& state, const MaterialOverride& override) {
+    if (!override.isActive())
+    {
+        Material::apply(state);
+        return;
+    }
+
+    MaterialState modified = state;
+    modified.emissionColor += override.emission;
+    modified.ambientColor *= override.diffuseTint;
+    modified.diffuseColor *= override.diffuseTint;
+    modified.alpha *= override.alpha;
+    modified.version = 0;
+
+    Material::apply(modified);
+}
+
+bool LIB_API MaterialOverride::isActive() const {
+    return this->emission != glm::vec3(0.0f) || this->diffuseTint != glm::vec3(1.0f) || this->alpha != 1.0f;
+}
+
+void LIB_API Material::invalidateStateCache() {
+    Material::currentVersion = 0;
+    Material::textureEnabled = -1;
+    Material::boundTexture = 0;
+}
+
+unsigned int LIB_API Material::getAvoidedStateChanges() {
+    return Material::avoidedStateChanges;
+}
+
+void LIB_API Material::resetAvoidedStateChanges() {
+    Material::avoidedStateChanges = 0;
+}
+
+void Material::touch() {
+    this->_state.version = ++Material::versionCounter;
+}
@@ -1,97 +1,202 @@
-#pragma once
-
-#include <memory>
-#include "Object.h"
-#include "Texture.h"
-#include "Common.h"
-
-/**
- * @class Material
- * @brief Rappresenta un materiale che conferisce colore e texture alle mesh.
- *
- * La classe `Material` gestisce gli attributi visivi di un materiale, come il colore di emissione,
- * il colore ambientale, il colore diffuso e il colore speculare. Inoltre, supporta la definizione
- * della lucentezza, del valore alpha e dell'applicazione di una texture.
- *
- * Un materiale viene applicato a una mesh per determinare come essa interagisce con la luce
- * e come viene visualizzata nella scena.
- */
-class LIB_API Material : public Object
-{
-public:
-    /**
-     * @brief Costruttore di default per la classe `Material`.
-     *
-     * Inizializza un materiale con valori predefiniti per emissione, colore ambientale,
-     * colore diffuso, colore speculare, lucentezza e trasparenza.
-     */
-    Material();
-    virtual ~Material() = default;
-
-    // Getter
-
-    /**
-     * @brief Restituisce il colore di emissione del materiale.
-     * @return Il colore di emissione del materiale.
-     */
-    glm::vec3 getEmissionColor() const;
-
-    // Setter
-
-    /**
-     * @brief Cambia il colore di emissione del materiale.
-     * @param newColor Il nuovo colore di emissione.
-     */
-    void setEmissionColor(const glm::vec3 newColor);
-
-    /**
-     * @brief Cambia il colore ambientale del materiale.
-     * @param newColor Il nuovo colore ambientale.
-     */
-    void setAmbientColor(const glm::vec3 newColor);
-
-    /**
-     * @brief Cambia il colore diffuso del materiale.
-     * @param newColor Il nuovo colore diffuso.
-     */
-    void setDiffuseColor(const glm::vec3 newColor);
-
-    /**
-     * @brief Cambia il colore speculare del materiale.
-     * @param newColor Il nuovo colore speculare.
-     */
-    void setSpecularColor(const glm::vec3 newColor);
-
-    /**
-     * @brief Cambia il valore di lucentezza del materiale.
-     * @param newShininess Il nuovo valore di lucentezza.
-     */
-    void setShininess(const float newShininess);
-
-    /**
-     * @brief Cambia il valore alpha del materiale.
-     * @param newAlpha Il nuovo valore alpha.
-     */
-    void setAlpha(const float newAlpha);
-
-    /**
-     * @brief Imposta la texture associata al materiale.
-     * @param newTexture La nuova texture da applicare.
-     */
-    void setTexture(const std::shared_ptr<Texture> newTexture);
-
-    /**
-     * @brief Renderizza il materiale utilizzando le impostazioni correnti.
-     * @param viewMatrix La matrice di vista da utilizzare.
-     */
-    void render(const glm::mat4 viewMatrix) const override;
-
-private:
-    glm::vec3 _emissionColor; ///< Colore di emissione del materiale.
-    glm::vec3 _ambientColor; ///< Colore ambientale del materiale.
-    glm::vec3 _diffuseColor; ///< Colore diffuso del materiale.
-    glm::vec3 _specularColor; ///< Colore speculare del materiale.
-    float _shininess; ///< Lucentezza del materiale.
-    float _alpha; ///< Valore alpha del materiale.
-    std::shared_ptr<Texture> _texture; ///< Texture applicata al materiale.
-};
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "Object.h"
+#include "Texture.h"
+#include "Common.h"
+
+/**
+ * @struct MaterialState
+ * @brief Parametri di un materiale copiabili per valore.
+ *
+ * Il thread di simulazione copia lo stato dei materiali nelle istantanee della scena:
+ * il thread di rendering lo applica con `Material::apply` senza leggere il materiale.
+ */
+struct LIB_API MaterialState
+{
+    glm::vec3 emissionColor{ 0.0f };   ///< Colore di emissione.
+    glm::vec3 ambientColor{ 0.75f };   ///< Colore ambientale.
+    glm::vec3 diffuseColor{ 0.75f };   ///< Colore diffuso.
+    glm::vec3 specularColor{ 0.75f };  ///< Colore speculare.
+    float shininess = 64.0f;           ///< Lucentezza.
+    float alpha = 1.0f;                ///< Valore alpha.
+    std::shared_ptr<Texture> texture;  ///< Texture applicata (`nullptr` se assente).
+    unsigned int version = 0;          ///< Versione dei parametri, unica fra tutti i materiali.
+};
+
+/**
+ * @struct MaterialOverride
+ * @brief Modifiche di una singola mesh applicate sopra il suo materiale condiviso.
+ *
+ * Permette di evidenziare o sfumare una mesh senza modificare ne' copiare il materiale,
+ * che puo' essere condiviso da molte altre mesh: le mesh continuano a essere raggruppate
+ * per materiale nella coda di rendering.
+ */
+struct LIB_API MaterialOverride
+{
+    glm::vec3 emission{ 0.0f };     ///< Emissione aggiunta a quella del materiale.
+    glm::vec3 diffuseTint{ 1.0f };  ///< Fattore moltiplicato per i colori ambientale e diffuso.
+    float alpha = 1.0f;             ///< Fattore moltiplicato per l'alpha del materiale.
+
+    /**
+     * @brief Verifica se l'override modifica il materiale.
+     * @return `false` se tutti i valori sono quelli di default.
+     */
+    bool isActive() const;
+};
+
+/**
+ * @class Material
+ * @brief Rappresenta un materiale che conferisce colore e texture alle mesh.
+ *
+ * La classe `Material` gestisce gli attributi visivi di un materiale, come il colore di emissione,
+ * il colore ambientale, il colore diffuso e il colore speculare. Inoltre, supporta la definizione
+ * della lucentezza, del valore alpha e dell'applicazione di una texture.
+ *
+ * Un materiale viene applicato a una mesh per determinare come essa interagisce con la luce
+ * e come viene visualizzata nella scena.
+ */
+class LIB_API Material : public Object
+{
+public:
+    /**
+     * @brief Costruttore di default per la classe `Material`.
+     *
+     * Inizializza un materiale con valori predefiniti per emissione, colore ambientale,
+     * colore diffuso, colore speculare, lucentezza e trasparenza.
+     */
+    Material();
+    virtual ~Material() = default;
+
+    // Getter
+
+    /**
+     * @brief Restituisce il colore di emissione del materiale.
+     * @return Il colore di emissione del materiale.
+     */
+    glm::vec3 getEmissionColor() const;
+
+    /**
+     * @brief Restituisce il colore diffuso del materiale.
+     * @return Il colore diffuso del materiale.
+     */
+    glm::vec3 getDiffuseColor() const;
+
+    /**
+     * @brief Restituisce la texture associata al materiale.
+     * @return La texture del materiale, `nullptr` se assente.
+     */
+    const std::shared_ptr<Texture>& getTexture() const;
+
+    /**
+     * @brief Restituisce tutti i parametri del materiale.
+     * @return Lo stato corrente, copiabile nelle istantanee della scena.
+     */
+    const MaterialState& getState() const;
+
+    // Setter
+
+    /**
+     * @brief Cambia il colore di emissione del materiale.
+     * @param newColor Il nuovo colore di emissione.
+     */
+    void setEmissionColor(const glm::vec3 newColor);
+
+    /**
+     * @brief Cambia il colore ambientale del materiale.
+     * @param newColor Il nuovo colore ambientale.
+     */
+    void setAmbientColor(const glm::vec3 newColor);
+
+    /**
+     * @brief Cambia il colore diffuso del materiale.
+     * @param newColor Il nuovo colore diffuso.
+     */
+    void setDiffuseColor(const glm::vec3 newColor);
+
+    /**
+     * @brief Cambia il colore speculare del materiale.
+     * @param newColor Il nuovo colore speculare.
+     */
+    void setSpecularColor(const glm::vec3 newColor);
+
+    /**
+     * @brief Cambia il valore di lucentezza del materiale.
+     * @param newShininess Il nuovo valore di lucentezza.
+     */
+    void setShininess(const float newShininess);
+
+    /**
+     * @brief Cambia il valore alpha del materiale.
+     * @param newAlpha Il nuovo valore alpha.
+     */
+    void setAlpha(const float newAlpha);
+
+    /**
+     * @brief Imposta la texture associata al materiale.
+     * @param newTexture La nuova texture da applicare.
+     */
+    void setTexture(const std::shared_ptr<Texture> newTexture);
+
+    /**
+     * @brief Renderizza il materiale utilizzando le impostazioni correnti.
+     * @param viewMatrix La matrice di vista da utilizzare.
+     */
+    void render(const glm::mat4 viewMatrix) const override;
+
+    /**
+     * @brief Applica uno stato di materiale usando la cache dello stato OpenGL.
+     * @param state Lo stato da applicare (vedi `getState`).
+     */
+    static void apply(const MaterialState& state);
+
+    /**
+     * @brief Applica uno stato di materiale modificato dall'override di una mesh.
+     *
+     * Senza override attivo equivale ad `apply(state)`; altrimenti i parametri modificati
+     * vengono sempre inviati e la cache dei parametri viene invalidata.
+     *
+     * @param state Lo stato del materiale condiviso.
+     * @param override Le modifiche della mesh.
+     */
+    static void apply(const MaterialState& state, const MaterialOverride& override);
+
+    // Cache dello stato OpenGL
+
+    /**
+     * @brief Invalida la cache dello stato OpenGL dei materiali.
+     *
+     * Da chiamare quando lo stato del materiale o delle texture viene modificato
+     * al di fuori di `Material::render` (es. inizio frame, color picking).
+     */
+    static void invalidateStateCache();
+
+    /**
+     * @brief Restituisce il numero di chiamate OpenGL evitate dalla cache dall'ultimo azzeramento.
+     * @return Il numero di cambi di stato evitati.
+     */
+    static unsigned int getAvoidedStateChanges();
+
+    /**
+     * @brief Azzera il contatore dei cambi di stato evitati.
+     */
+    static void resetAvoidedStateChanges();
+
+private:
+    /**
+     * @brief Segna il materiale come modificato assegnandogli una nuova versione.
+     *
+     * Le versioni sono uniche fra tutti i materiali: la cache confronta solo la versione,
+     * senza rischi se l'indirizzo di un materiale distrutto viene riutilizzato.
+     */
+    void touch();
+
+    static std::atomic<unsigned int> versionCounter; ///< Ultima versione assegnata (i materiali possono essere creati in background).
+    static unsigned int currentVersion;      ///< Versione del materiale attualmente applicato (0 = nessuno o modificato da un override).
+    static int textureEnabled;               ///< Stato di GL_TEXTURE_2D (-1 = sconosciuto).
+    static unsigned int boundTexture;        ///< Texture attualmente associata (0 = sconosciuta).
+    static unsigned int avoidedStateChanges; ///< Chiamate OpenGL evitate.
+
+    MaterialState _state; ///< Parametri e versione corrente del materiale.
+};
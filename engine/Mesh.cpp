@@ -1,205 +1,231 @@
-#include "Mesh.h"
-
-#include <GL/freeglut.h>
-
-bool Mesh::isColorPickingMode = false;
-
-/**
- * @brief Costruttore della classe Mesh.
- *
- * Inizializza una mesh con un materiale di default e abilita le ombre.
- */
-Mesh::Mesh()
-    : Node{ "Mesh" }
-{
-    this->setMaterial(std::make_shared<Material>());
-    this->setShadows(true);
-}
-
-/**
- * @brief Distruttore della classe Mesh.
- *
- * Libera le risorse associate alla mesh, incluso il materiale.
- */
-Mesh::~Mesh()
-{
-    _material.reset(); // Libera il puntatore condiviso al materiale.
-}
-
-// Getter
-
-bool LIB_API Mesh::getShadows() const
-{
-    return this->_castShadows;
-}
-
-std::shared_ptr<Material> LIB_API Mesh::getMaterial() const
-{
-    return this->_material;
-}
-
-const MeshData& LIB_API Mesh::getMeshData() const {
-    return _meshData;
-}
-
-
-// Setter
-
-void LIB_API Mesh::setMaterial(const std::shared_ptr<Material> newMaterial)
-{
-    this->_material = newMaterial;
-}
-
-void LIB_API Mesh::setShadows(const bool newShadows)
-{
-    this->_castShadows = newShadows;
-}
-
-void LIB_API Mesh::setMeshData(const MeshData& data)
-{
-    _meshData = data;
-}
-
-// Render Mesh
-
-void LIB_API Mesh::render(const glm::mat4 viewMatrix) const
-{
-    Node::render(viewMatrix);
-
-    if (Mesh::isColorPickingMode)
-    {
-        int id = this->getId();
-        float idRange = id / 255.0f;
-
-        glDisable(GL_LIGHTING);
-        glDisable(GL_TEXTURE_2D);
-        glColor4f(idRange, idRange, idRange, 1.0f);
-
-        for (const auto& face : _meshData.getFaces())
-        {
-            glBegin(GL_TRIANGLES);
-
-            const glm::vec3 vertex_0 = _meshData.getVertices()[std::get<0>(face)];
-            const glm::vec3 vertex_1 = _meshData.getVertices()[std::get<1>(face)];
-            const glm::vec3 vertex_2 = _meshData.getVertices()[std::get<2>(face)];
-
-            glVertex3f(vertex_0.x, vertex_0.y, vertex_0.z);
-            glVertex3f(vertex_1.x, vertex_1.y, vertex_1.z);
-            glVertex3f(vertex_2.x, vertex_2.y, vertex_2.z);
-
-            glEnd();
-        }
-
-        glEnable(GL_LIGHTING);
-        glEnable(GL_TEXTURE_2D);
-    }
-    else
-    {
-        this->_material->render(viewMatrix);
-
-        for (const auto& face : _meshData.getFaces())
-        {
-            glBegin(GL_TRIANGLES);
-
-            const glm::vec3 vertex_0 = _meshData.getVertices()[std::get<0>(face)];
-            const glm::vec3 vertex_1 = _meshData.getVertices()[std::get<1>(face)];
-            const glm::vec3 vertex_2 = _meshData.getVertices()[std::get<2>(face)];
-
-            const glm::vec3 normal_0 = _meshData.getNormals()[std::get<0>(face)];
-            const glm::vec3 normal_1 = _meshData.getNormals()[std::get<1>(face)];
-            const glm::vec3 normal_2 = _meshData.getNormals()[std::get<2>(face)];
-
-            const glm::vec2 uv_0 = _meshData.getUVs()[std::get<0>(face)];
-            const glm::vec2 uv_1 = _meshData.getUVs()[std::get<1>(face)];
-            const glm::vec2 uv_2 = _meshData.getUVs()[std::get<2>(face)];
-
-            glTexCoord2f(uv_0.x, uv_0.y);
-            glNormal3f(normal_0.x, normal_0.y, normal_0.z);
-            glVertex3f(vertex_0.x, vertex_0.y, vertex_0.z);
-
-            glTexCoord2f(uv_1.x, uv_1.y);
-            glNormal3f(normal_1.x, normal_1.y, normal_1.z);
-            glVertex3f(vertex_1.x, vertex_1.y, vertex_1.z);
-
-            glTexCoord2f(uv_2.x, uv_2.y);
-            glNormal3f(normal_2.x, normal_2.y, normal_2.z);
-            glVertex3f(vertex_2.x, vertex_2.y, vertex_2.z);
-
-            glEnd();
-        }
-        if (getName().find("Pawn") != std::string::npos)
-        {
-            // Trasforma la mesh per appiattirla rispetto all'asse Y.
-            glScalef(1.0f, 0.01f, 1.0f); // Schiaccia lungo l'asse Y.
-
-            // Trasla la mesh verso il piano e leggermente in diagonale rispetto agli assi X e Z.
-            glTranslatef(0.02f, -4.5f, -0.02f); // Modifica i valori per regolare la posizione dell'ombra.
-        }
-        else if (getName().find("Bishop") != std::string::npos)
-        {
-            glScalef(1.0f, 0.01f, 1.0f); // Schiaccia lungo l'asse Y.
-
-            // Trasla la mesh verso il piano e leggermente in diagonale rispetto agli assi X e Z.
-            glTranslatef(0.02f, -6.7f, -0.02f); // Modifica i valori per regolare la posizione dell'ombra.
-        }
-        else if (getName().find("King") != std::string::npos)
-        {
-            glScalef(1.0f, 0.01f, 1.0f); // Schiaccia lungo l'asse Y.
-
-            // Trasla la mesh verso il piano e leggermente in diagonale rispetto agli assi X e Z.
-            glTranslatef(0.02f, -9.7f, -0.02f); // Modifica i valori per regolare la posizione dell'ombra.
-        }
-        else if (getName().find("Queen") != std::string::npos)
-        {
-            glScalef(1.0f, 0.01f, 1.0f); // Schiaccia lungo l'asse Y.
-
-            // Trasla la mesh verso il piano e leggermente in diagonale rispetto agli assi X e Z.
-            glTranslatef(0.02f, -8.7f, -0.02f); // Modifica i valori per regolare la posizione dell'ombra.
-        }
-        else if (getName().find("Rook") != std::string::npos)
-        {
-            glScalef(1.0f, 0.01f, 1.0f); // Schiaccia lungo l'asse Y.
-
-            // Trasla la mesh verso il piano e leggermente in diagonale rispetto agli assi X e Z.
-            glTranslatef(0.02f, -7.7f, -0.02f); // Modifica i valori per regolare la posizione dell'ombra.
-        }
-        else if (getName().find("Knight") != std::string::npos)
-        {
-            glScalef(1.0f, 0.01f, 1.0f); // Schiaccia lungo l'asse Y.
-
-            // Trasla la mesh verso il piano e leggermente in diagonale rispetto agli assi X e Z.
-            glTranslatef(0.02f, -4.7f, -0.02f); // Modifica i valori per regolare la posizione dell'ombra.
-        }
-        // Duplica la mesh per creare l'effetto ombra.
-        glPushMatrix();
-
-        glColor4f(0.0f, 0.0f, 0.0f, 1.0f);
-        // Imposta il colore nero per l'ombra.
-
-        glDisable(GL_LIGHTING);
-
-        // Renderizza la mesh come ombra.
-        for (const auto& face : _meshData.getFaces())
-        {
-            glBegin(GL_TRIANGLES);
-
-            const glm::vec3 vertex_0 = _meshData.getVertices()[std::get<0>(face)];
-            const glm::vec3 vertex_1 = _meshData.getVertices()[std::get<1>(face)];
-            const glm::vec3 vertex_2 = _meshData.getVertices()[std::get<2>(face)];
-
-            glVertex3f(vertex_0.x, vertex_0.y, vertex_0.z);
-            glVertex3f(vertex_1.x, vertex_1.y, vertex_1.z);
-            glVertex3f(vertex_2.x, vertex_2.y, vertex_2.z);
-
-            glEnd();
-        }
-
-        // Ripristina lo stato grafico.
-        glEnable(GL_LIGHTING); // Riabilita l'illuminazione dopo aver renderizzato l'ombra.
-
-        glPopMatrix();
-
-
-
-    }
+#include "Mesh.h"
+#include "LightManager.h"
+
+#include <GL/freeglut.h>
+#include <algorithm>
+#include <cmath>
+
+bool Mesh::isColorPickingMode = false;
+float Mesh::lodPixelScale = 0.0f;
+float Mesh::lodThreshold = 128.0f;
+unsigned int Mesh::submittedTriangles = 0;
+
+// Margine attorno alle soglie dei livelli di dettaglio.
+static constexpr float LOD_HYSTERESIS = 0.1f;
+
+/**
+ * @brief Costruttore della classe Mesh.
+ *
+ * Inizializza una mesh con un materiale di default e abilita le ombre.
+ */
+Mesh::Mesh()
+    : Node{ "Mesh" }, _lods(1), _currentLod{ 0 }, _occluder{ false }
+{
+    this->setMaterial(std::make_shared<Material>());
+    this->setShadows(true);
+}
+
+/**
+ * @brief Distruttore della classe Mesh.
+ *
+ * Libera le risorse associate alla mesh, incluso il materiale.
+ */
+Mesh::~Mesh()
+{
+    _material.reset(); // Libera il puntatore condiviso al materiale.
+}
+
+// Getter
+
+bool LIB_API Mesh::getShadows() const
+{
+    return this->_castShadows;
+}
+
+std::shared_ptr<Material> LIB_API Mesh::getMaterial() const
+{
+    return this->_material;
+}
+
+const MeshData& LIB_API Mesh::getMeshData() const {
+    return this->_lods[0];
+}
+
+const MeshData& LIB_API Mesh::getMeshData(const int lod) const
+{
+    return this->_lods[lod];
+}
+
+int LIB_API Mesh::getLodCount() const
+{
+    return (int)this->_lods.size();
+}
+
+int LIB_API Mesh::getCurrentLod() const
+{
+    return this->_currentLod;
+}
+
+
+// Setter
+
+void LIB_API Mesh::setMaterial(const std::shared_ptr<Material> newMaterial)
+{
+    this->_material = newMaterial;
+}
+
+void LIB_API Mesh::setShadows(const bool newShadows)
+{
+    this->_castShadows = newShadows;
+}
+
+bool LIB_API Mesh::isOccluder() const
+{
+    return this->_occluder;
+}
+
+void LIB_API Mesh::setOccluder(const bool occluder)
+{
+    this->_occluder = occluder;
+}
+
+const MaterialOverride& LIB_API Mesh::getMaterialOverride() const
+{
+    return this->_override;
+}
+
+void LIB_API Mesh::setMaterialOverride(const MaterialOverride& override)
+{
+    this->_override = override;
+}
+
+void LIB_API Mesh::resetMaterialOverride()
+{
+    this->_override = MaterialOverride();
+}
+
+void LIB_API Mesh::setMeshData(const MeshData& data)
+{
+    this->_lods.assign(1, data);
+    this->_currentLod = 0;
+}
+
+void LIB_API Mesh::addLod(const MeshData& data)
+{
+    this->_lods.push_back(data);
+}
+
+// LOD
+
+/**
+ * @brief Sceglie il livello di dettaglio per una dimensione proiettata, partendo da quello corrente.
+ */
+int LIB_API Mesh::selectLod(const float screenSize) const
+{
+    const int lastLod = (int)this->_lods.size() - 1;
+    int lod = std::min(this->_currentLod, lastLod);
+
+    // Soglia tra il livello i e il livello i + 1.
+    auto threshold = [](const int i) { return Mesh::lodThreshold / (float)(1 << i); };
+
+    while (lod < lastLod && screenSize < threshold(lod) * (1.0f - LOD_HYSTERESIS))
+        lod++;
+
+    while (lod > 0 && screenSize > threshold(lod - 1) * (1.0f + LOD_HYSTERESIS))
+        lod--;
+
+    this->_currentLod = lod;
+    return lod;
+}
+
+void LIB_API Mesh::setLodProjection(const float fov, const int viewportHeight)
+{
+    if (fov <= 0.0f || viewportHeight <= 0)
+        Mesh::lodPixelScale = 0.0f;
+    else
+        Mesh::lodPixelScale = viewportHeight / (2.0f * std::tan(glm::radians(fov) * 0.5f));
+}
+
+void LIB_API Mesh::setLodThreshold(const float pixels)
+{
+    Mesh::lodThreshold = pixels;
+}
+
+float LIB_API Mesh::getLodThreshold()
+{
+    return Mesh::lodThreshold;
+}
+
+unsigned int LIB_API Mesh::getSubmittedTriangles()
+{
+    return Mesh::submittedTriangles;
+}
+
+void LIB_API Mesh::resetSubmittedTriangles()
+{
+    Mesh::submittedTriangles = 0;
+}
+
+// Render Mesh
+
+void LIB_API Mesh::render(const glm::mat4 viewMatrix) const
+{
+    this->render(viewMatrix, this->_material->getState(), &this->_override);
+}
+
+/**
+ * @brief Renderizza la mesh con uno stato di materiale fornito dal chiamante.
+ *
+ * Usato per le istantanee della scena (lo stato e' una copia fatta dal thread di simulazione)
+ * e per le ombre, senza sostituire il materiale della mesh. Le ombre non passano l'override
+ * e riusano il livello scelto per la mesh, senza toccare lo stato dell'isteresi.
+ */
+void LIB_API Mesh::render(const glm::mat4 viewMatrix, const MaterialState& material, const MaterialOverride* override, const bool selectLevel) const
+{
+    Node::render(viewMatrix);
+
+    // Il livello si sceglie dalla sfera di ingombro del livello 0 proiettata sullo schermo.
+    if (selectLevel && this->_lods.size() > 1 && Mesh::lodPixelScale > 0.0f && !Mesh::isColorPickingMode)
+    {
+        const MeshData& baseData = this->_lods[0];
+        const glm::vec3 center = glm::vec3(viewMatrix * glm::vec4(baseData.getBoundingCenter(), 1.0f));
+        const float scale = std::max({ glm::length(glm::vec3(viewMatrix[0])), glm::length(glm::vec3(viewMatrix[1])), glm::length(glm::vec3(viewMatrix[2])) });
+        const float distance = std::max(-center.z, 1e-4f);
+
+        this->selectLod(2.0f * baseData.getBoundingRadius() * scale * Mesh::lodPixelScale / distance);
+    }
+
+    const MeshData& meshData = this->_lods[this->_currentLod];
+    Mesh::submittedTriangles += (unsigned int)meshData.getFaceCount();
+
+    if (Mesh::isColorPickingMode)
+    {
+        // L'indice dello slot dell'ID (20 bit) viene codificato nei canali RGB.
+        const uint32_t slot = HandleAllocator::getIndex(this->getId());
+
+        glDisable(GL_LIGHTING);
+        glDisable(GL_TEXTURE_2D);
+        glColor4ub((GLubyte)(slot & 0xFF), (GLubyte)((slot >> 8) & 0xFF), (GLubyte)((slot >> 16) & 0xFF), 255);
+
+        meshData.draw(false);
+
+        glEnable(GL_LIGHTING);
+        glEnable(GL_TEXTURE_2D);
+
+        // Lo stato delle texture e' stato modificato fuori da Material::render.
+        Material::invalidateStateCache();
+    }
+    else
+    {
+        if (override != nullptr)
+            Material::apply(material, *override);
+        else
+            Material::apply(material);
+
+        // Nel percorso shader passa al programma solo le luci che raggiungono la mesh.
+        LightManager::prepareObject(viewMatrix, this->_lods[0].getBoundingCenter(), this->_lods[0].getBoundingRadius());
+
+        // Vertici, normali e coordinate UV in un'unica chiamata dal vertex buffer.
+        meshData.draw(true);
+    }
 }
\ No newline at end of file
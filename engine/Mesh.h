@@ -1,83 +1,209 @@
-#pragma once
-
-#include "Material.h"
-#include "Node.h"
-#include "MeshData.h"
-#include "Common.h"
-
-/**
- * @class Mesh
- * @brief Rappresenta una mesh che viene renderizzata all'interno di una scena.
- *
- * Una mesh  una rappresentazione tridimensionale di una forma. Include dati geometrici,
- * come vertici e facce, ed  associata a un materiale per definire l'aspetto visivo
- * della superficie. Le mesh possono anche proiettare ombre.
- */
-class LIB_API Mesh : public Node
-{
-public:
-    /**
-     * @brief Costruttore della classe Mesh.
-     *
-     * Inizializza una mesh con un materiale di default e abilita le ombre.
-     */
-    Mesh();
-
-    /**
-     * @brief Distruttore della classe Mesh.
-     *
-     * Libera le risorse associate alla mesh, incluso il materiale.
-     */
-    ~Mesh();
-
-    // Getter
-
-    /**
-     * @brief Verifica se la mesh proietta ombre.
-     * @return `true` se la mesh proietta ombre, `false` altrimenti.
-     */
-    bool getShadows() const;
-
-    /**
-     * @brief Restituisce il materiale associato alla mesh.
-     * @return Un puntatore condiviso al materiale della mesh.
-     */
-    std::shared_ptr<Material> getMaterial() const;
-
-    // Setter
-
-    /**
-     * @brief Imposta un nuovo materiale per la mesh.
-     * @param newMaterial Un puntatore condiviso al nuovo materiale.
-     */
-    void setMaterial(const std::shared_ptr<Material> newMaterial);
-
-    /**
-     * @brief Imposta se la mesh deve proiettare ombre.
-     * @param newCastShadows `true` per abilitare le ombre, `false` per disabilitarle.
-     */
-    void setShadows(const bool newCastShadows);
-
-    /**
-     * @brief Imposta i dati della mesh.
-     * @param data I dati geometrici della mesh (vertici, facce, normali e coordinate UV).
-     */
-    void setMeshData(const MeshData& data);
-
-    /**
-     * @brief Renderizza la mesh.
-     * @param viewMatrix La matrice di vista da utilizzare per il rendering.
-     */
-    void render(const glm::mat4 viewMatrix) const override;
-    const MeshData& getMeshData() const;
-
-    /**
-     * @brief Modalit per il rendering della mesh solo con colori (senza illuminazione).
-     */
-    static bool isColorPickingMode;
-
-private:
-    MeshData _meshData; ///< Dati della mesh, inclusi vertici, facce, normali e coordinate UV.
-    std::shared_ptr<Material> _material; ///< Materiale associato alla mesh.
-    bool _castShadows; ///< Indica se la mesh deve proiettare ombre.
-};
+#pragma once
+
+#include "Material.h"
+#include "Node.h"
+#include "MeshData.h"
+#include "Common.h"
+
+/**
+ * @class Mesh
+ * @brief Rappresenta una mesh che viene renderizzata all'interno di una scena.
+ *
+ * Una mesh è una rappresentazione tridimensionale di una forma. Include dati geometrici,
+ * come vertici e facce, ed è associata a un materiale per definire l'aspetto visivo
+ * della superficie. Le mesh possono anche proiettare ombre.
+ */
+class LIB_API Mesh : public Node
+{
+public:
+    /**
+     * @brief Costruttore della classe Mesh.
+     *
+     * Inizializza una mesh con un materiale di default e abilita le ombre.
+     */
+    Mesh();
+
+    /**
+     * @brief Distruttore della classe Mesh.
+     *
+     * Libera le risorse associate alla mesh, incluso il materiale.
+     */
+    ~Mesh();
+
+    // Getter
+
+    /**
+     * @brief Verifica se la mesh proietta ombre.
+     * @return `true` se la mesh proietta ombre, `false` altrimenti.
+     */
+    bool getShadows() const;
+
+    /**
+     * @brief Restituisce il materiale associato alla mesh.
+     * @return Un puntatore condiviso al materiale della mesh.
+     */
+    std::shared_ptr<Material> getMaterial() const;
+
+    /**
+     * @brief Verifica se la mesh viene disegnata nel depth buffer dell'occlusion culling.
+     * @return `true` se la mesh e' un occlusore.
+     */
+    bool isOccluder() const;
+
+    /**
+     * @brief Restituisce le modifiche applicate da questa mesh al materiale condiviso.
+     * @return L'override della mesh (inattivo per default).
+     */
+    const MaterialOverride& getMaterialOverride() const;
+
+    // Setter
+
+    /**
+     * @brief Imposta un nuovo materiale per la mesh.
+     * @param newMaterial Un puntatore condiviso al nuovo materiale.
+     */
+    void setMaterial(const std::shared_ptr<Material> newMaterial);
+
+    /**
+     * @brief Imposta se la mesh deve proiettare ombre.
+     * @param newCastShadows `true` per abilitare le ombre, `false` per disabilitarle.
+     */
+    void setShadows(const bool newCastShadows);
+
+    /**
+     * @brief Designa la mesh come occlusore per `OcclusionCuller`.
+     *
+     * Conviene designare poche mesh grandi e opache (pavimento, tavolo, pareti):
+     * ogni frame vengono rasterizzate sulla CPU al livello di dettaglio meno dettagliato.
+     *
+     * @param occluder `true` per rasterizzare la mesh nel depth buffer dell'occlusion culling.
+     */
+    void setOccluder(const bool occluder);
+
+    /**
+     * @brief Imposta le modifiche al materiale valide solo per questa mesh.
+     *
+     * Serve per evidenziazioni e dissolvenze: il materiale, condiviso con altre mesh, non cambia.
+     *
+     * @param override L'emissione aggiunta, la tinta e il fattore alpha.
+     */
+    void setMaterialOverride(const MaterialOverride& override);
+
+    /**
+     * @brief Rimuove le modifiche al materiale di questa mesh.
+     */
+    void resetMaterialOverride();
+
+    /**
+     * @brief Imposta i dati della mesh.
+     *
+     * I dati diventano il livello di dettaglio 0; eventuali altri livelli vengono rimossi.
+     *
+     * @param data I dati geometrici della mesh (vertici, facce, normali e coordinate UV).
+     */
+    void setMeshData(const MeshData& data);
+
+    /**
+     * @brief Aggiunge un livello di dettaglio meno dettagliato dei precedenti.
+     * @param data I dati geometrici del livello.
+     */
+    void addLod(const MeshData& data);
+
+    /**
+     * @brief Renderizza la mesh.
+     * @param viewMatrix La matrice di vista da utilizzare per il rendering.
+     */
+    void render(const glm::mat4 viewMatrix) const override;
+
+    /**
+     * @brief Renderizza la mesh con uno stato di materiale al posto del materiale associato.
+     * @param viewMatrix La matrice di vista da utilizzare per il rendering.
+     * @param material Lo stato del materiale da applicare.
+     * @param override Le modifiche da applicare sopra il materiale, `nullptr` per nessuna.
+     * @param selectLevel `false` per riusare il livello di dettaglio dell'ultimo rendering (es. le ombre,
+     *                    la cui matrice appiattita darebbe una distanza diversa).
+     */
+    void render(const glm::mat4 viewMatrix, const MaterialState& material, const MaterialOverride* override = nullptr, const bool selectLevel = true) const;
+    const MeshData& getMeshData() const;
+
+    /**
+     * @brief Restituisce i dati di un livello di dettaglio.
+     * @param lod Il livello, 0 e' il piu' dettagliato.
+     * @return I dati del livello.
+     */
+    const MeshData& getMeshData(const int lod) const;
+
+    /**
+     * @brief Restituisce il numero di livelli di dettaglio.
+     * @return Almeno 1.
+     */
+    int getLodCount() const;
+
+    /**
+     * @brief Restituisce il livello di dettaglio usato nell'ultimo rendering.
+     * @return Il livello corrente.
+     */
+    int getCurrentLod() const;
+
+    /**
+     * @brief Sceglie il livello di dettaglio per una dimensione proiettata, partendo da quello corrente.
+     *
+     * Si passa al livello `i + 1` quando la dimensione scende sotto `getLodThreshold() / 2^i`
+     * e si torna al livello `i` solo quando la supera: la soglia e' allargata del 10%
+     * nei due versi per evitare che il livello cambi ad ogni frame vicino al limite.
+     *
+     * @param screenSize Il diametro della sfera di ingombro sullo schermo, in pixel.
+     * @return Il livello scelto, che diventa il livello corrente.
+     */
+    int selectLod(const float screenSize) const;
+
+    /**
+     * @brief Imposta la proiezione usata per stimare la dimensione delle mesh sullo schermo.
+     *
+     * Va chiamata ad ogni frame; con `fov` pari a 0 (camera non prospettica) viene sempre usato il livello 0.
+     *
+     * @param fov Il campo visivo verticale in gradi.
+     * @param viewportHeight L'altezza del viewport in pixel.
+     */
+    static void setLodProjection(const float fov, const int viewportHeight);
+
+    /**
+     * @brief Imposta la dimensione sullo schermo sotto la quale si passa al livello 1.
+     * @param pixels Il diametro in pixel, ogni livello successivo usa la meta' del precedente.
+     */
+    static void setLodThreshold(const float pixels);
+
+    /**
+     * @brief Restituisce la dimensione sullo schermo sotto la quale si passa al livello 1.
+     * @return Il diametro in pixel.
+     */
+    static float getLodThreshold();
+
+    /**
+     * @brief Restituisce i triangoli inviati dalle mesh dall'ultimo azzeramento.
+     * @return Il numero di triangoli.
+     */
+    static unsigned int getSubmittedTriangles();
+
+    /**
+     * @brief Azzera il contatore dei triangoli inviati.
+     */
+    static void resetSubmittedTriangles();
+
+    /**
+     * @brief Modalità per il rendering della mesh solo con colori (senza illuminazione).
+     */
+    static bool isColorPickingMode;
+
+private:
+    std::vector<MeshData> _lods; ///< Livelli di dettaglio, dal piu' dettagliato: vertici, facce, normali e coordinate UV.
+    mutable int _currentLod; ///< Livello usato nell'ultimo rendering.
+    std::shared_ptr<Material> _material; ///< Materiale associato alla mesh.
+    bool _castShadows; ///< Indica se la mesh deve proiettare ombre.
+    bool _occluder; ///< Indica se la mesh nasconde le altre nell'occlusion culling.
+    MaterialOverride _override; ///< Modifiche al materiale valide solo per questa mesh.
+
+    static float lodPixelScale; ///< Pixel per unita' di lunghezza a distanza 1 dalla camera (0 = LOD disattivati).
+    static float lodThreshold; ///< Dimensione in pixel sotto la quale si passa al livello 1.
+    static unsigned int submittedTriangles; ///< Triangoli inviati dall'ultimo azzeramento.
+};
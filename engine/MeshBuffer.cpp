@@ -0,0 +1,94 @@
+#include "MeshBuffer.h"
+#include "MeshData.h"
+#include "GLExtensions.h"
+
+/**
+ * @brief Carica i dati di una mesh in memoria video.
+ *
+ * I dati non cambiano dopo il caricamento: i buffer usano `GL_STATIC_DRAW`.
+ */
+MeshBuffer::MeshBuffer(const MeshData& data)
+    : _vertexBuffer{ 0 }, _indexBuffer{ 0 }, _indexCount{ 0 }, _indexType{ GL_UNSIGNED_SHORT }
+{
+    if (!MeshBuffer::isSupported())
+        return;
+
+    const std::vector<PackedVertex>& vertices = data.getVertices();
+
+    GLExtensions::genBuffers(1, &this->_vertexBuffer);
+    GLExtensions::bindBuffer(GL_ARRAY_BUFFER, this->_vertexBuffer);
+    GLExtensions::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(PackedVertex), vertices.data(), GL_STATIC_DRAW);
+    GLExtensions::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    GLExtensions::genBuffers(1, &this->_indexBuffer);
+    GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->_indexBuffer);
+
+    if (data.hasShortIndices())
+    {
+        this->_indexType = GL_UNSIGNED_SHORT;
+        this->_indexCount = (int)data.getShortIndices().size();
+        GLExtensions::bufferData(GL_ELEMENT_ARRAY_BUFFER, data.getShortIndices().size() * sizeof(uint16_t), data.getShortIndices().data(), GL_STATIC_DRAW);
+    }
+    else
+    {
+        this->_indexType = GL_UNSIGNED_INT;
+        this->_indexCount = (int)data.getIndices().size();
+        GLExtensions::bufferData(GL_ELEMENT_ARRAY_BUFFER, data.getIndices().size() * sizeof(uint32_t), data.getIndices().data(), GL_STATIC_DRAW);
+    }
+
+    GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+MeshBuffer::~MeshBuffer()
+{
+    // L'ultimo riferimento puo' essere rilasciato dal thread di simulazione.
+    GLExtensions::releaseBuffer(this->_vertexBuffer);
+    GLExtensions::releaseBuffer(this->_indexBuffer);
+}
+
+bool LIB_API MeshBuffer::isValid() const
+{
+    return this->_vertexBuffer != 0 && this->_indexBuffer != 0;
+}
+
+/**
+ * @brief Disegna i triangoli con una sola chiamata `glDrawElements`.
+ *
+ * Gli array abilitati vengono disabilitati al termine: il resto dell'engine disegna
+ * ancora in modalita' immediata.
+ */
+void LIB_API MeshBuffer::draw(const bool withAttributes) const
+{
+    GLExtensions::bindBuffer(GL_ARRAY_BUFFER, this->_vertexBuffer);
+    GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->_indexBuffer);
+
+    const GLsizei stride = sizeof(PackedVertex);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, stride, (const void*)offsetof(PackedVertex, position));
+
+    if (withAttributes)
+    {
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glNormalPointer(GL_BYTE, stride, (const void*)offsetof(PackedVertex, normal));
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_HALF_FLOAT, stride, (const void*)offsetof(PackedVertex, uv));
+    }
+
+    glDrawElements(GL_TRIANGLES, this->_indexCount, this->_indexType, nullptr);
+
+    if (withAttributes)
+    {
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_NORMAL_ARRAY);
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    GLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GLExtensions::bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+bool LIB_API MeshBuffer::isSupported()
+{
+    return GLExtensions::isPackedVertexSupported();
+}
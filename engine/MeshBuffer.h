@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Common.h"
+
+class MeshData;
+
+/**
+ * @file MeshBuffer.h
+ * @brief Dichiarazione del vertex buffer di una mesh.
+ */
+
+ /**
+  * @class MeshBuffer
+  * @brief Contiene i vertici e gli indici di una `MeshData` in memoria video.
+  *
+  * I vertici vengono caricati nel formato interlacciato di `PackedVertex`: posizione in float,
+  * normale in `GL_BYTE` e coordinate UV in `GL_HALF_FLOAT`. Gli indici mantengono
+  * la dimensione scelta da `MeshData` (16 o 32 bit). Il buffer non e' copiabile e viene
+  * condiviso dalle copie della stessa `MeshData`.
+  */
+class LIB_API MeshBuffer
+{
+public:
+
+    /**
+     * @brief Carica i dati di una mesh in memoria video.
+     * @param data I dati della mesh.
+     */
+    MeshBuffer(const MeshData& data);
+
+    /**
+     * @brief Libera i buffer OpenGL.
+     */
+    ~MeshBuffer();
+
+    MeshBuffer(const MeshBuffer&) = delete;
+    MeshBuffer& operator=(const MeshBuffer&) = delete;
+
+    /**
+     * @brief Verifica se il caricamento e' riuscito.
+     * @return `true` se i buffer sono stati creati.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Disegna i triangoli con una sola chiamata `glDrawElements`.
+     * @param withAttributes `false` per abilitare solo le posizioni.
+     */
+    void draw(const bool withAttributes) const;
+
+    /**
+     * @brief Verifica se il contesto supporta vertex buffer e formati compatti.
+     * @return `true` se `GLExtensions::isPackedVertexSupported` e' vero.
+     */
+    static bool isSupported();
+
+private:
+    unsigned int _vertexBuffer; ///< Buffer dei vertici.
+    unsigned int _indexBuffer;  ///< Buffer degli indici.
+    int _indexCount;            ///< Numero di indici.
+    unsigned int _indexType;    ///< `GL_UNSIGNED_SHORT` o `GL_UNSIGNED_INT`.
+};
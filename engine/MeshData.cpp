@@ -1,60 +1,224 @@
-#include "MeshData.h"
-
-// Getter
-
-/**
- * @brief Restituisce la lista dei vertici per questa mesh.
- * @return Un riferimento costante al vettore dei vertici.
- */
-LIB_API const std::vector<glm::vec3>& MeshData::getVertices() const {
-    return _vertices;
-}
-
-/**
- * @brief Restituisce la lista delle facce per questa mesh.
- *
- * Le facce sono rappresentate come tuple di indici, ciascuna contenente tre indici che formano un triangolo.
- * @return Un riferimento costante al vettore delle facce.
- */
-LIB_API const std::vector<std::tuple<uint32_t, uint32_t, uint32_t>>& MeshData::getFaces() const {
-    return _faces;
-}
-
-/**
- * @brief Restituisce la lista delle normali per questa mesh.
- * @return Un riferimento costante al vettore delle normali.
- */
-LIB_API const std::vector<glm::vec3>& MeshData::getNormals() const {
-    return _normals;
-}
-
-/**
- * @brief Restituisce la lista delle coordinate UV per questa mesh.
- * @return Un riferimento costante al vettore delle coordinate UV.
- */
-LIB_API const std::vector<glm::vec2>& MeshData::getUVs() const {
-    return _uvs;
-}
-
-// Setter
-
-/**
- * @brief Imposta i dati della mesh, inclusi vertici, facce, normali e coordinate UV.
- *
- * @param newVertices I nuovi vertici per la mesh.
- * @param newFaces Le nuove facce per la mesh, rappresentate come tuple di indici dei vertici.
- * @param newNormals Le nuove normali per la mesh.
- * @param newUvs Le nuove coordinate UV per la mesh.
- */
-void LIB_API MeshData::set_mesh_data(
-    const std::vector<glm::vec3> newVertices,
-    const std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> newFaces,
-    const std::vector<glm::vec3> newNormals,
-    const std::vector<glm::vec2> newUvs)
-{
-    // Assegna i nuovi dati ai membri privati della classe
-    _vertices = newVertices;
-    _faces = newFaces;
-    _normals = newNormals;
-    _uvs = newUvs;
-}
+#include "MeshData.h"
+#include "MeshBuffer.h"
+
+#include <algorithm>
+#include <GL/freeglut.h>
+#include <glm/gtc/packing.hpp>
+
+// Getter
+
+/**
+ * @brief Restituisce la lista dei vertici per questa mesh.
+ * @return Un riferimento costante al vettore dei vertici compatti.
+ */
+LIB_API const std::vector<PackedVertex>& MeshData::getVertices() const {
+    return _vertices;
+}
+
+LIB_API size_t MeshData::getVertexCount() const {
+    return _vertices.size();
+}
+
+LIB_API glm::vec3 MeshData::getPosition(const size_t index) const {
+    return _vertices[index].position;
+}
+
+LIB_API glm::vec3 MeshData::getNormal(const size_t index) const {
+    return glm::vec3(glm::unpackSnorm4x8(_vertices[index].normal));
+}
+
+LIB_API glm::vec2 MeshData::getUV(const size_t index) const {
+    return glm::unpackHalf2x16(_vertices[index].uv);
+}
+
+LIB_API size_t MeshData::getFaceCount() const {
+    return (_shortIndices.size() + _indices.size()) / 3;
+}
+
+/**
+ * @brief Restituisce gli indici dei tre vertici di una faccia.
+ *
+ * Gli indici vengono letti dal vettore a 16 o a 32 bit in uso.
+ */
+LIB_API glm::uvec3 MeshData::getFace(const size_t index) const {
+    if (!_shortIndices.empty())
+        return glm::uvec3(_shortIndices[3 * index], _shortIndices[3 * index + 1], _shortIndices[3 * index + 2]);
+
+    return glm::uvec3(_indices[3 * index], _indices[3 * index + 1], _indices[3 * index + 2]);
+}
+
+LIB_API bool MeshData::hasShortIndices() const {
+    return _indices.empty();
+}
+
+LIB_API const std::vector<uint16_t>& MeshData::getShortIndices() const {
+    return _shortIndices;
+}
+
+LIB_API const std::vector<uint32_t>& MeshData::getIndices() const {
+    return _indices;
+}
+
+LIB_API size_t MeshData::getMemorySize() const {
+    return _vertices.size() * sizeof(PackedVertex) + _shortIndices.size() * sizeof(uint16_t) + _indices.size() * sizeof(uint32_t);
+}
+
+/**
+ * @brief Restituisce il centro della sfera di ingombro della mesh.
+ */
+LIB_API glm::vec3 MeshData::getBoundingCenter() const {
+    return _boundingCenter;
+}
+
+/**
+ * @brief Restituisce il raggio della sfera di ingombro della mesh.
+ */
+LIB_API float MeshData::getBoundingRadius() const {
+    return _boundingRadius;
+}
+
+// Setter
+
+/**
+ * @brief Imposta i dati della mesh, inclusi vertici, facce, normali e coordinate UV.
+ *
+ * @param newVertices I nuovi vertici per la mesh.
+ * @param newFaces Le nuove facce per la mesh, rappresentate come tuple di indici dei vertici.
+ * @param newNormals Le nuove normali per la mesh.
+ * @param newUvs Le nuove coordinate UV per la mesh.
+ */
+void LIB_API MeshData::set_mesh_data(
+    const std::vector<glm::vec3> newVertices,
+    const std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> newFaces,
+    const std::vector<glm::vec3> newNormals,
+    const std::vector<glm::vec2> newUvs)
+{
+    // Comprime normali e coordinate UV nel formato di PackedVertex.
+    std::vector<PackedVertex> packedVertices(newVertices.size());
+
+    for (size_t i = 0; i < newVertices.size(); i++)
+    {
+        const glm::vec3 normal = i < newNormals.size() ? newNormals[i] : glm::vec3(0.0f);
+        const glm::vec2 uv = i < newUvs.size() ? newUvs[i] : glm::vec2(0.0f);
+
+        packedVertices[i].position = newVertices[i];
+        packedVertices[i].normal = glm::packSnorm4x8(glm::vec4(normal, 0.0f));
+        packedVertices[i].uv = glm::packHalf2x16(uv);
+    }
+
+    std::vector<uint32_t> indices;
+    indices.reserve(newFaces.size() * 3);
+
+    for (const auto& face : newFaces)
+    {
+        indices.push_back(std::get<0>(face));
+        indices.push_back(std::get<1>(face));
+        indices.push_back(std::get<2>(face));
+    }
+
+    this->setPackedData(std::move(packedVertices), indices);
+}
+
+/**
+ * @brief Imposta i dati della mesh gia' in formato compatto.
+ *
+ * Gli indici vengono memorizzati a 16 bit quando tutti i vertici sono indirizzabili.
+ * Il vertex buffer esistente viene abbandonato e ricreato al rendering successivo.
+ */
+void LIB_API MeshData::setPackedData(std::vector<PackedVertex> newVertices, const std::vector<uint32_t>& newIndices)
+{
+    _vertices = std::move(newVertices);
+    _shortIndices.clear();
+    _indices.clear();
+    _buffer.reset();
+
+    if (_vertices.size() <= 65536)
+        _shortIndices.assign(newIndices.begin(), newIndices.end());
+    else
+        _indices = newIndices;
+
+    this->computeBounds();
+}
+
+/**
+ * @brief Calcola la sfera di ingombro: centro del box allineato agli assi e distanza massima dei vertici.
+ */
+void MeshData::computeBounds()
+{
+    _boundingCenter = glm::vec3(0.0f);
+    _boundingRadius = 0.0f;
+
+    if (_vertices.empty())
+        return;
+
+    glm::vec3 minimum = _vertices.front().position;
+    glm::vec3 maximum = _vertices.front().position;
+
+    for (const PackedVertex& vertex : _vertices)
+    {
+        minimum = glm::min(minimum, vertex.position);
+        maximum = glm::max(maximum, vertex.position);
+    }
+
+    _boundingCenter = (minimum + maximum) * 0.5f;
+
+    for (const PackedVertex& vertex : _vertices)
+        _boundingRadius = std::max(_boundingRadius, glm::length(vertex.position - _boundingCenter));
+}
+
+// Render
+
+/**
+ * @brief Crea il vertex buffer se non esiste ancora.
+ */
+void LIB_API MeshData::upload() const
+{
+    if (_buffer == nullptr && !_vertices.empty() && MeshBuffer::isSupported())
+        _buffer = std::make_shared<MeshBuffer>(*this);
+}
+
+/**
+ * @brief Disegna i triangoli della mesh.
+ *
+ * Il vertex buffer viene creato alla prima chiamata, quando il contesto OpenGL esiste.
+ * Senza vertex buffer o senza i formati compatti i vertici vengono decompressi e inviati uno alla volta.
+ */
+void LIB_API MeshData::draw(const bool withAttributes) const
+{
+    if (_vertices.empty())
+        return;
+
+    this->upload();
+
+    if (_buffer != nullptr && _buffer->isValid())
+    {
+        _buffer->draw(withAttributes);
+        return;
+    }
+
+    const size_t faceCount = this->getFaceCount();
+
+    glBegin(GL_TRIANGLES);
+
+    for (size_t i = 0; i < faceCount; i++)
+    {
+        const glm::uvec3 face = this->getFace(i);
+
+        for (int corner = 0; corner < 3; corner++)
+        {
+            const PackedVertex& vertex = _vertices[face[corner]];
+
+            if (withAttributes)
+            {
+                const glm::vec2 uv = glm::unpackHalf2x16(vertex.uv);
+                const glm::vec3 normal = glm::vec3(glm::unpackSnorm4x8(vertex.normal));
+                glTexCoord2f(uv.x, uv.y);
+                glNormal3f(normal.x, normal.y, normal.z);
+            }
+
+            glVertex3f(vertex.position.x, vertex.position.y, vertex.position.z);
+        }
+    }
+
+    glEnd();
+}
@@ -1,72 +1,183 @@
-#pragma once
-
-#include "Common.h"
-
-#include <tuple>
-#include <vector>
-#include <glm/glm.hpp>
-
-/**
- * @class MeshData
- * @brief Rappresenta i dati di una mesh: vertici, facce, normali, coordinate UV.
- *
- * Questa classe gestisce i dati geometrici necessari per renderizzare una mesh nella scena.
- * Include informazioni su:
- * - Vertici (`_vertices`): Posizioni dei punti nello spazio 3D.
- * - Facce (`_faces`): Definizione dei triangoli attraverso indici di vertici.
- * - Normali (`_normals`): Vettori per illuminazione e shading.
- * - Coordinate UV (`_uvs`): Mappatura delle texture.
- */
-class LIB_API MeshData
-{
-public:
-    // Getter
-
-    /**
-     * @brief Restituisce la lista dei vertici per questa mesh.
-     * @return Un riferimento costante al vettore dei vertici.
-     */
-    const std::vector<glm::vec3>& getVertices() const;
-
-    /**
-     * @brief Restituisce la lista delle facce per questa mesh.
-     *
-     * Le facce sono rappresentate come tuple di indici, ciascuna contenente tre indici che formano un triangolo.
-     * @return Un riferimento costante al vettore delle facce.
-     */
-    const std::vector<std::tuple<uint32_t, uint32_t, uint32_t>>& getFaces() const;
-
-    /**
-     * @brief Restituisce la lista delle normali per questa mesh.
-     * @return Un riferimento costante al vettore delle normali.
-     */
-    const std::vector<glm::vec3>& getNormals() const;
-
-    /**
-     * @brief Restituisce la lista delle coordinate UV per questa mesh.
-     * @return Un riferimento costante al vettore delle coordinate UV.
-     */
-    const std::vector<glm::vec2>& getUVs() const;
-
-    // Setter
-
-    /**
-     * @brief Imposta i dati della mesh, inclusi vertici, facce, normali e coordinate UV.
-     *
-     * @param newVertices I nuovi vertici per la mesh.
-     * @param newFaces Le nuove facce per la mesh, rappresentate come tuple di indici dei vertici.
-     * @param newNormals Le nuove normali per la mesh.
-     * @param newUvs Le nuove coordinate UV per la mesh.
-     */
-    void set_mesh_data(
-        const std::vector<glm::vec3> new_vertices,
-        const std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> new_faces,
-        const std::vector<glm::vec3> new_normals,
-        const std::vector<glm::vec2> new_uvs);
-
-private:
-    std::vector<glm::vec3> _vertices; ///< Lista dei vertici della mesh.
-    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> _faces; ///< Lista delle facce della mesh.
-    std::vector<glm::vec3> _normals; ///< Lista delle normali della mesh.
-    std::vector<glm::vec2> _uvs; ///< Lista delle coordinate UV della mesh.
-};
+#pragma once
+
+#include "Common.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include <glm/glm.hpp>
+
+class MeshBuffer;
+
+/**
+ * @struct PackedVertex
+ * @brief Vertice interlacciato in formato compatto (20 byte invece di 32).
+ *
+ * La normale occupa 4 byte snorm (`GL_BYTE`, l'unico formato compatto accettato da `glNormalPointer`
+ * su tutti i driver) e le coordinate UV sono i due half float del file OVO (`GL_HALF_FLOAT`),
+ * che arrivano alla GPU senza conversioni.
+ */
+struct LIB_API PackedVertex
+{
+    glm::vec3 position; ///< Posizione.
+    uint32_t normal;    ///< Normale, 4 x snorm8 (x nel byte meno significativo, il quarto vale 0).
+    uint32_t uv;        ///< Coordinate UV, due half float (u nei 16 bit meno significativi).
+};
+
+/**
+ * @class MeshData
+ * @brief Rappresenta i dati di una mesh: vertici, facce, normali, coordinate UV.
+ *
+ * Questa classe gestisce i dati geometrici necessari per renderizzare una mesh nella scena.
+ * Include informazioni su:
+ * - Vertici (`_vertices`): Posizioni, normali e coordinate UV interlacciate in formato compatto.
+ * - Indici (`_shortIndices` o `_indices`): Definizione dei triangoli, a 16 bit se i vertici sono al massimo 65536.
+ *
+ * Al primo rendering i dati vengono caricati in un vertex buffer (`MeshBuffer`), condiviso tra le copie.
+ */
+class LIB_API MeshData
+{
+public:
+    // Getter
+
+    /**
+     * @brief Restituisce la lista dei vertici per questa mesh.
+     * @return Un riferimento costante al vettore dei vertici compatti.
+     */
+    const std::vector<PackedVertex>& getVertices() const;
+
+    /**
+     * @brief Restituisce il numero di vertici.
+     * @return Il numero di vertici.
+     */
+    size_t getVertexCount() const;
+
+    /**
+     * @brief Restituisce la posizione di un vertice.
+     * @param index L'indice del vertice.
+     * @return La posizione.
+     */
+    glm::vec3 getPosition(const size_t index) const;
+
+    /**
+     * @brief Restituisce la normale di un vertice, decompressa.
+     * @param index L'indice del vertice.
+     * @return La normale.
+     */
+    glm::vec3 getNormal(const size_t index) const;
+
+    /**
+     * @brief Restituisce le coordinate UV di un vertice, decompresse.
+     * @param index L'indice del vertice.
+     * @return Le coordinate UV.
+     */
+    glm::vec2 getUV(const size_t index) const;
+
+    /**
+     * @brief Restituisce il numero di facce (triangoli).
+     * @return Il numero di facce.
+     */
+    size_t getFaceCount() const;
+
+    /**
+     * @brief Restituisce gli indici dei tre vertici di una faccia.
+     * @param index L'indice della faccia.
+     * @return Gli indici dei vertici.
+     */
+    glm::uvec3 getFace(const size_t index) const;
+
+    /**
+     * @brief Verifica se gli indici sono memorizzati a 16 bit.
+     * @return `true` se si usa `getShortIndices`, `false` se si usa `getIndices`.
+     */
+    bool hasShortIndices() const;
+
+    /**
+     * @brief Restituisce gli indici a 16 bit (vuoti se la mesh usa indici a 32 bit).
+     * @return Tre indici per faccia.
+     */
+    const std::vector<uint16_t>& getShortIndices() const;
+
+    /**
+     * @brief Restituisce gli indici a 32 bit (vuoti se la mesh usa indici a 16 bit).
+     * @return Tre indici per faccia.
+     */
+    const std::vector<uint32_t>& getIndices() const;
+
+    /**
+     * @brief Restituisce la memoria occupata da vertici e indici.
+     * @return La dimensione in byte.
+     */
+    size_t getMemorySize() const;
+
+    /**
+     * @brief Restituisce il centro della sfera di ingombro della mesh.
+     * @return Il centro del box allineato agli assi che contiene i vertici.
+     */
+    glm::vec3 getBoundingCenter() const;
+
+    /**
+     * @brief Restituisce il raggio della sfera di ingombro della mesh.
+     * @return La distanza massima di un vertice dal centro.
+     */
+    float getBoundingRadius() const;
+
+    // Setter
+
+    /**
+     * @brief Imposta i dati della mesh, inclusi vertici, facce, normali e coordinate UV.
+     *
+     * Normali e coordinate UV vengono compresse nel formato di `PackedVertex`; i vertici
+     * senza normale o senza coordinate corrispondenti ricevono valori nulli.
+     *
+     * @param newVertices I nuovi vertici per la mesh.
+     * @param newFaces Le nuove facce per la mesh, rappresentate come tuple di indici dei vertici.
+     * @param newNormals Le nuove normali per la mesh.
+     * @param newUvs Le nuove coordinate UV per la mesh.
+     */
+    void set_mesh_data(
+        const std::vector<glm::vec3> new_vertices,
+        const std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> new_faces,
+        const std::vector<glm::vec3> new_normals,
+        const std::vector<glm::vec2> new_uvs);
+
+    /**
+     * @brief Imposta i dati della mesh gia' in formato compatto.
+     *
+     * @param newVertices I vertici compatti.
+     * @param newIndices Tre indici per faccia; vengono ridotti a 16 bit se possibile.
+     */
+    void setPackedData(std::vector<PackedVertex> newVertices, const std::vector<uint32_t>& newIndices);
+
+    // Render
+
+    /**
+     * @brief Crea il vertex buffer della mesh, se supportato e non ancora creato.
+     *
+     * Altrimenti viene creato al primo `draw`; il caricamento asincrono lo anticipa
+     * per distribuire il lavoro OpenGL su piu' frame. Va chiamata sul thread del contesto.
+     */
+    void upload() const;
+
+    /**
+     * @brief Disegna i triangoli della mesh.
+     *
+     * Usa il vertex buffer se il contesto supporta i formati compatti, altrimenti
+     * invia i vertici uno alla volta.
+     *
+     * @param withAttributes `false` per inviare solo le posizioni (color picking e ombre).
+     */
+    void draw(const bool withAttributes) const;
+
+private:
+    void computeBounds();
+
+    std::vector<PackedVertex> _vertices; ///< Vertici interlacciati della mesh.
+    std::vector<uint16_t> _shortIndices; ///< Indici a 16 bit delle facce.
+    std::vector<uint32_t> _indices; ///< Indici a 32 bit delle facce (solo oltre 65536 vertici).
+    mutable std::shared_ptr<MeshBuffer> _buffer; ///< Vertex buffer creato al primo rendering.
+    glm::vec3 _boundingCenter{ 0.0f }; ///< Centro della sfera di ingombro.
+    float _boundingRadius = 0.0f; ///< Raggio della sfera di ingombro.
+};
@@ -0,0 +1,402 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace
+{
+    // Chiave per l'unione dei vertici: confronto e hash sui 20 byte del vertice.
+    struct VertexKey
+    {
+        const PackedVertex* vertex;
+
+        bool operator==(const VertexKey& other) const
+        {
+            return memcmp(this->vertex, other.vertex, sizeof(PackedVertex)) == 0;
+        }
+    };
+
+    struct VertexKeyHash
+    {
+        size_t operator()(const VertexKey& key) const
+        {
+            // FNV-1a
+            const uint8_t* bytes = (const uint8_t*)key.vertex;
+            uint64_t hash = 14695981039346656037ull;
+
+            for (size_t i = 0; i < sizeof(PackedVertex); i++)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+
+            return (size_t)hash;
+        }
+    };
+}
+
+/**
+ * @brief Esegue i passi richiesti su una mesh.
+ *
+ * Se gli indici non sono validi la mesh non viene modificata.
+ */
+MeshOptimizationReport LIB_API MeshOptimizer::optimize(std::vector<PackedVertex>& vertices, std::vector<uint32_t>& indices, const MeshOptimizationOptions& options)
+{
+    MeshOptimizationReport report;
+    report.verticesBefore = vertices.size();
+    report.acmrBefore = MeshOptimizer::computeAcmr(indices, options.cacheSize);
+    report.atvrBefore = MeshOptimizer::computeAtvr(indices, vertices.size(), options.cacheSize);
+
+    const bool validIndices = indices.size() % 3 == 0 &&
+        std::all_of(indices.begin(), indices.end(), [&vertices](const uint32_t index) { return index < vertices.size(); });
+
+    if (validIndices && !indices.empty())
+    {
+        if (options.weld)
+            MeshOptimizer::weldVertices(vertices, indices);
+
+        if (options.vertexCache)
+        {
+            const std::vector<uint32_t> clusters = MeshOptimizer::optimizeVertexCache(indices, vertices.size(), options.cacheSize);
+
+            if (options.overdraw)
+                MeshOptimizer::optimizeOverdraw(indices, vertices, clusters, options.cacheSize, options.overdrawThreshold);
+        }
+
+        if (options.vertexFetch)
+            MeshOptimizer::optimizeVertexFetch(vertices, indices);
+    }
+
+    report.verticesAfter = vertices.size();
+    report.acmrAfter = MeshOptimizer::computeAcmr(indices, options.cacheSize);
+    report.atvrAfter = MeshOptimizer::computeAtvr(indices, vertices.size(), options.cacheSize);
+    return report;
+}
+
+/**
+ * @brief Unisce i vertici con attributi identici (confronto esatto dei byte).
+ */
+void LIB_API MeshOptimizer::weldVertices(std::vector<PackedVertex>& vertices, std::vector<uint32_t>& indices)
+{
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> unique;
+    unique.reserve(vertices.size());
+
+    std::vector<uint32_t> remap(vertices.size());
+    std::vector<PackedVertex> welded;
+    welded.reserve(vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        // La chiave punta al vertice originale, che resta valido fino alla fine del ciclo.
+        const auto inserted = unique.emplace(VertexKey{ &vertices[i] }, (uint32_t)welded.size());
+
+        if (inserted.second)
+            welded.push_back(vertices[i]);
+
+        remap[i] = inserted.first->second;
+    }
+
+    for (uint32_t& index : indices)
+        index = remap[index];
+
+    vertices.swap(welded);
+}
+
+/**
+ * @brief Riordina i triangoli per la cache dei vertici trasformati (Tipsify).
+ *
+ * A partire da un vertice vengono emessi tutti i suoi triangoli non ancora emessi (un ventaglio);
+ * il vertice successivo e' il vicino con triangoli rimasti che restera' in cache piu' a lungo.
+ * Nei vicoli ciechi si riparte dagli ultimi vertici emessi o, in mancanza, dal primo vertice
+ * con triangoli rimasti.
+ */
+std::vector<uint32_t> LIB_API MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, const size_t vertexCount, const int cacheSize)
+{
+    const size_t triangleCount = indices.size() / 3;
+    std::vector<uint32_t> clusters(1, 0);
+
+    if (triangleCount == 0 || vertexCount == 0)
+        return clusters;
+
+    // Triangoli adiacenti ad ogni vertice (formato compresso per righe).
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (const uint32_t index : indices)
+        liveTriangles[index]++;
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    std::partial_sum(liveTriangles.begin(), liveTriangles.end(), offsets.begin() + 1);
+
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++)
+        adjacency[fill[indices[i]]++] = (uint32_t)(i / 3);
+
+    const int64_t cache = cacheSize;
+    std::vector<int64_t> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnds;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+
+    int64_t timestamp = cache + 1;
+    size_t cursor = 0;
+    int64_t fanning = 0;
+
+    while (fanning >= 0)
+    {
+        candidates.clear();
+
+        for (uint32_t a = offsets[fanning]; a < offsets[fanning + 1]; a++)
+        {
+            const uint32_t triangle = adjacency[a];
+            if (emitted[triangle])
+                continue;
+
+            for (int corner = 0; corner < 3; corner++)
+            {
+                const uint32_t vertex = indices[3 * triangle + corner];
+                output.push_back(vertex);
+                deadEnds.push_back(vertex);
+                candidates.push_back(vertex);
+                liveTriangles[vertex]--;
+
+                if (timestamp - cacheTime[vertex] > cache)
+                    cacheTime[vertex] = timestamp++;
+            }
+
+            emitted[triangle] = true;
+        }
+
+        // Vicino con triangoli rimasti che restera' in cache piu' a lungo.
+        int64_t next = -1;
+        int64_t bestPriority = -1;
+
+        for (const uint32_t vertex : candidates)
+        {
+            if (liveTriangles[vertex] == 0)
+                continue;
+
+            int64_t priority = 0;
+            if (timestamp - cacheTime[vertex] + 2 * (int64_t)liveTriangles[vertex] <= cache)
+                priority = timestamp - cacheTime[vertex];
+
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                next = vertex;
+            }
+        }
+
+        if (next == -1)
+        {
+            // Vicolo cieco: gli ultimi vertici emessi, poi il primo vertice con triangoli rimasti.
+            while (!deadEnds.empty() && next == -1)
+            {
+                const uint32_t vertex = deadEnds.back();
+                deadEnds.pop_back();
+
+                if (liveTriangles[vertex] > 0)
+                    next = vertex;
+            }
+
+            while (next == -1 && cursor < vertexCount)
+            {
+                if (liveTriangles[cursor] > 0)
+                    next = (int64_t)cursor;
+                else
+                    cursor++;
+            }
+
+            if (next != -1 && output.size() / 3 > clusters.back())
+                clusters.push_back((uint32_t)(output.size() / 3));
+        }
+
+        fanning = next;
+    }
+
+    indices.swap(output);
+    return clusters;
+}
+
+/**
+ * @brief Ordina i gruppi di triangoli per ridurre l'overdraw.
+ */
+void LIB_API MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<PackedVertex>& vertices,
+    const std::vector<uint32_t>& clusters, const int cacheSize, const float threshold)
+{
+    const uint32_t triangleCount = (uint32_t)(indices.size() / 3);
+
+    if (triangleCount == 0)
+        return;
+
+    // Spezza i gruppi dove l'ACMR locale e' gia' vicino a quello dell'intera mesh.
+    const float targetAcmr = MeshOptimizer::computeAcmr(indices, cacheSize) * threshold;
+    std::vector<uint32_t> starts;
+
+    // Cache FIFO simulata: aumentare il tempo di cacheSize + 1 equivale a svuotarla.
+    std::vector<int64_t> entryTime(vertices.size(), std::numeric_limits<int64_t>::min() / 2);
+    int64_t time = 0;
+
+    for (size_t c = 0; c < clusters.size(); c++)
+    {
+        const uint32_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+        uint32_t start = clusters[c];
+        size_t misses = 0;
+
+        starts.push_back(start);
+        time += cacheSize + 1;
+
+        for (uint32_t t = start; t < end; t++)
+        {
+            for (int corner = 0; corner < 3; corner++)
+            {
+                const uint32_t vertex = indices[3 * t + corner];
+
+                if (time - entryTime[vertex] > cacheSize)
+                {
+                    entryTime[vertex] = time++;
+                    misses++;
+                }
+            }
+
+            if (t + 1 < end && (float)misses / (float)(t + 1 - start) <= targetAcmr)
+            {
+                starts.push_back(t + 1);
+                start = t + 1;
+                misses = 0;
+                time += cacheSize + 1;
+            }
+        }
+    }
+
+    // Centro e normale media (pesati per area) di ogni gruppo e dell'intera mesh.
+    struct Cluster
+    {
+        uint32_t first;
+        uint32_t last;
+        float sortKey;
+    };
+
+    std::vector<Cluster> sorted(starts.size());
+    std::vector<glm::vec3> centers(starts.size(), glm::vec3(0.0f));
+    std::vector<glm::vec3> normals(starts.size(), glm::vec3(0.0f));
+    std::vector<float> areas(starts.size(), 0.0f);
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+
+    for (size_t c = 0; c < starts.size(); c++)
+    {
+        sorted[c].first = starts[c];
+        sorted[c].last = c + 1 < starts.size() ? starts[c + 1] : triangleCount;
+
+        for (uint32_t t = sorted[c].first; t < sorted[c].last; t++)
+        {
+            const glm::vec3& p0 = vertices[indices[3 * t]].position;
+            const glm::vec3& p1 = vertices[indices[3 * t + 1]].position;
+            const glm::vec3& p2 = vertices[indices[3 * t + 2]].position;
+
+            const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            const float area = glm::length(normal);
+            const glm::vec3 center = (p0 + p1 + p2) / 3.0f;
+
+            centers[c] += center * area;
+            normals[c] += normal;
+            areas[c] += area;
+        }
+
+        meshCenter += centers[c];
+        meshArea += areas[c];
+    }
+
+    if (meshArea > 0.0f)
+        meshCenter /= meshArea;
+
+    for (size_t c = 0; c < sorted.size(); c++)
+    {
+        const glm::vec3 center = areas[c] > 0.0f ? centers[c] / areas[c] : meshCenter;
+        const float normalLength = glm::length(normals[c]);
+        sorted[c].sortKey = normalLength > 0.0f ? glm::dot(center - meshCenter, normals[c] / normalLength) : 0.0f;
+    }
+
+    // Prima i gruppi piu' esterni.
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+
+    for (const Cluster& cluster : sorted)
+        output.insert(output.end(), indices.begin() + 3 * cluster.first, indices.begin() + 3 * cluster.last);
+
+    indices.swap(output);
+}
+
+/**
+ * @brief Riordina i vertici nell'ordine in cui vengono usati dagli indici.
+ */
+void LIB_API MeshOptimizer::optimizeVertexFetch(std::vector<PackedVertex>& vertices, std::vector<uint32_t>& indices)
+{
+    std::vector<uint32_t> remap(vertices.size(), std::numeric_limits<uint32_t>::max());
+    std::vector<PackedVertex> ordered;
+    ordered.reserve(vertices.size());
+
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == std::numeric_limits<uint32_t>::max())
+        {
+            remap[index] = (uint32_t)ordered.size();
+            ordered.push_back(vertices[index]);
+        }
+
+        index = remap[index];
+    }
+
+    vertices.swap(ordered);
+}
+
+float LIB_API MeshOptimizer::computeAcmr(const std::vector<uint32_t>& indices, const int cacheSize)
+{
+    if (indices.size() < 3)
+        return 0.0f;
+
+    return (float)MeshOptimizer::countCacheMisses(indices.data(), indices.size(), cacheSize) / (float)(indices.size() / 3);
+}
+
+float LIB_API MeshOptimizer::computeAtvr(const std::vector<uint32_t>& indices, const size_t vertexCount, const int cacheSize)
+{
+    if (vertexCount == 0)
+        return 0.0f;
+
+    return (float)MeshOptimizer::countCacheMisses(indices.data(), indices.size(), cacheSize) / (float)vertexCount;
+}
+
+/**
+ * @brief Conta i vertici trasformati con una cache FIFO inizialmente vuota.
+ *
+ * Un vertice e' in cache se dopo il suo ingresso ci sono stati meno di `cacheSize` altri ingressi.
+ */
+size_t MeshOptimizer::countCacheMisses(const uint32_t* indices, const size_t count, const int cacheSize)
+{
+    if (count == 0)
+        return 0;
+
+    const uint32_t maxIndex = *std::max_element(indices, indices + count);
+    std::vector<int64_t> entryTime(maxIndex + 1, std::numeric_limits<int64_t>::min() / 2);
+
+    int64_t time = 0;
+    size_t misses = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (time - entryTime[indices[i]] > cacheSize)
+        {
+            entryTime[indices[i]] = time++;
+            misses++;
+        }
+    }
+
+    return misses;
+}
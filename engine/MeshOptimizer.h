@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MeshData.h"
+#include "Common.h"
+
+/**
+ * @file MeshOptimizer.h
+ * @brief Dichiarazione delle ottimizzazioni delle mesh eseguite al caricamento.
+ */
+
+ /**
+  * @struct MeshOptimizationOptions
+  * @brief Passi di `MeshOptimizer::optimize` da eseguire.
+  */
+struct LIB_API MeshOptimizationOptions
+{
+    bool weld = true;                 ///< Unisce i vertici con attributi identici.
+    bool vertexCache = true;          ///< Riordina i triangoli per la cache dei vertici trasformati.
+    bool overdraw = true;             ///< Ordina i gruppi di triangoli per ridurre l'overdraw.
+    bool vertexFetch = true;          ///< Riordina i vertici nell'ordine di primo utilizzo.
+    int cacheSize = 16;               ///< Dimensione della cache FIFO simulata.
+    float overdrawThreshold = 1.05f;  ///< Peggioramento dell'ACMR accettato per spezzare i gruppi (1 = nessuno).
+};
+
+/**
+ * @struct MeshOptimizationReport
+ * @brief Statistiche di una mesh prima e dopo l'ottimizzazione.
+ *
+ * ACMR: vertici trasformati per triangolo (da 0.5 a 3, minore e' meglio).
+ * ATVR: vertici trasformati per vertice della mesh (da 1 in su, minore e' meglio).
+ */
+struct LIB_API MeshOptimizationReport
+{
+    size_t verticesBefore = 0;  ///< Vertici prima dell'unione.
+    size_t verticesAfter = 0;   ///< Vertici dopo l'unione.
+    float acmrBefore = 0.0f;    ///< ACMR dell'ordine originale.
+    float acmrAfter = 0.0f;     ///< ACMR dell'ordine ottimizzato.
+    float atvrBefore = 0.0f;    ///< ATVR dell'ordine originale.
+    float atvrAfter = 0.0f;     ///< ATVR dell'ordine ottimizzato.
+};
+
+/**
+ * @class MeshOptimizer
+ * @brief Riordina vertici e indici di una mesh per la cache dei vertici della GPU.
+ *
+ * I passi, tutti facoltativi, sono:
+ * 1. unione dei vertici con gli stessi byte (posizione, normale e coordinate UV);
+ * 2. ordine dei triangoli con l'algoritmo Tipsify (Sander, Nehab, Barczak 2007);
+ * 3. ordine dei gruppi di triangoli dall'esterno verso l'interno per ridurre l'overdraw;
+ * 4. ordine dei vertici secondo il primo utilizzo, per la localita' delle letture.
+ *
+ * Le funzioni lavorano sui dati compatti prima che vengano assegnati a `MeshData`.
+ */
+class LIB_API MeshOptimizer
+{
+public:
+
+    /**
+     * @brief Esegue i passi richiesti su una mesh.
+     * @param vertices I vertici, modificati sul posto.
+     * @param indices Tre indici per faccia, modificati sul posto.
+     * @param options I passi da eseguire.
+     * @return Le statistiche prima e dopo.
+     */
+    static MeshOptimizationReport optimize(std::vector<PackedVertex>& vertices, std::vector<uint32_t>& indices, const MeshOptimizationOptions& options);
+
+    /**
+     * @brief Unisce i vertici con attributi identici (confronto esatto dei byte).
+     * @param vertices I vertici, ridotti ai soli vertici distinti.
+     * @param indices Gli indici, aggiornati ai nuovi vertici.
+     */
+    static void weldVertices(std::vector<PackedVertex>& vertices, std::vector<uint32_t>& indices);
+
+    /**
+     * @brief Riordina i triangoli per la cache dei vertici trasformati (Tipsify).
+     * @param indices Gli indici da riordinare.
+     * @param vertexCount Il numero di vertici.
+     * @param cacheSize La dimensione della cache.
+     * @return L'inizio di ogni gruppo di triangoli (in triangoli) chiuso da un vicolo cieco dell'algoritmo.
+     */
+    static std::vector<uint32_t> optimizeVertexCache(std::vector<uint32_t>& indices, const size_t vertexCount, const int cacheSize);
+
+    /**
+     * @brief Ordina i gruppi di triangoli per ridurre l'overdraw.
+     *
+     * I gruppi vengono ulteriormente spezzati dove l'ACMR locale non supera `threshold` volte
+     * quello della mesh, poi ordinati per distanza dal centro lungo la loro normale media:
+     * le parti esterne, che coprono le altre, vengono disegnate per prime.
+     *
+     * @param indices Gli indici, ordinati per la cache.
+     * @param vertices I vertici della mesh.
+     * @param clusters L'inizio dei gruppi restituito da `optimizeVertexCache`.
+     * @param cacheSize La dimensione della cache.
+     * @param threshold Il peggioramento dell'ACMR accettato.
+     */
+    static void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<PackedVertex>& vertices,
+        const std::vector<uint32_t>& clusters, const int cacheSize, const float threshold);
+
+    /**
+     * @brief Riordina i vertici nell'ordine in cui vengono usati dagli indici.
+     *
+     * I vertici non referenziati vengono rimossi.
+     *
+     * @param vertices I vertici da riordinare.
+     * @param indices Gli indici, aggiornati al nuovo ordine.
+     */
+    static void optimizeVertexFetch(std::vector<PackedVertex>& vertices, std::vector<uint32_t>& indices);
+
+    /**
+     * @brief Calcola l'ACMR simulando una cache FIFO.
+     * @param indices Gli indici.
+     * @param cacheSize La dimensione della cache.
+     * @return I vertici trasformati per triangolo.
+     */
+    static float computeAcmr(const std::vector<uint32_t>& indices, const int cacheSize);
+
+    /**
+     * @brief Calcola l'ATVR simulando una cache FIFO.
+     * @param indices Gli indici.
+     * @param vertexCount Il numero di vertici.
+     * @param cacheSize La dimensione della cache.
+     * @return I vertici trasformati per vertice della mesh.
+     */
+    static float computeAtvr(const std::vector<uint32_t>& indices, const size_t vertexCount, const int cacheSize);
+
+private:
+    static size_t countCacheMisses(const uint32_t* indices, const size_t count, const int cacheSize);
+};
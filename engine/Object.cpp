@@ -1,98 +1,151 @@
-#include "Object.h"
-
-#include <sstream>
-
-int Object::nextId = 0;
-
-/**
- * @brief Costruttore della classe Object.
- * @param type Il tipo dell'oggetto.
- *
- * Il costruttore assegna automaticamente un ID univoco all'oggetto e imposta
- * il nome dell'oggetto nel formato "[<id>]".
- */
-Object::Object(const std::string type)
-    : _type(type)
-{
-    this->_id = Object::nextId++;
-
-    std::stringstream stream;
-    stream << '[' << this->getId() << ']';
-    this->_name = stream.str();
-}
-
-/**
- * @brief Distruttore della classe `Object`.
- */
-Object::~Object()
-{
-    nextId--;
-}
-
-
-///// Getter
-
-/**
- * @brief Restituisce l'ID univoco assegnato a questo oggetto.
- *
- * Questo metodo restituisce l'ID che viene auto-generato per l'oggetto
- * al momento della sua creazione. L'ID identifica
- * in modo univoco ogni istanza della classe `Object`.
- *
- * @return L'ID dell'oggetto.
- */
-int LIB_API Object::getId() const
-{
-    return this->_id;
-}
-
-/**
- * @brief Restituisce il nome di questo oggetto.
- *
- * @return Il nome dell'oggetto come stringa.
- */
-std::string LIB_API Object::getName() const
-{
-    return this->_name;
-}
-
-/**
- * @brief Restituisce il tipo di questo oggetto.
- *
- * @return Il tipo dell'oggetto come stringa.
- */
-const std::string LIB_API Object::getType() const {
-    return _type;
-}
-
-////// Setter
-
-/**
- * @brief Imposta un nuovo nome per questo oggetto.
- *
- * @param newName Il nuovo nome da assegnare all'oggetto.
- */
-void LIB_API Object::setName(const std::string newName)
-{
-    this->_name = newName;
-}
-
-/**
- * @brief Imposta un nuovo tipo per questo oggetto.
- *
- * @param type Il nuovo tipo da assegnare all'oggetto.
- */
-void LIB_API Object::setType(const std::string& type) {
-    this->_type = type;
-}
-
-///// Other
-
-/**
- * @brief Resetta il generatore di ID a zero.
- *
- * Questo metodo ripristina il contatore degli ID a zero.
- */
-void LIB_API Object::resetIdGenerator() {
-    nextId = 0;
-}
+#include "Object.h"
+
+#include <sstream>
+
+/**
+ * @brief Tabella degli ID degli oggetti.
+ *
+ * Creata al primo utilizzo, perche' alcuni oggetti statici (es. `Engine::shadowMaterial`)
+ * vengono costruiti durante l'inizializzazione statica di altre unita' di compilazione.
+ */
+HandleAllocator& Object::getHandles()
+{
+    static HandleAllocator handles;
+    return handles;
+}
+
+/**
+ * @brief Costruttore della classe Object.
+ * @param type Il tipo dell'oggetto.
+ *
+ * Il costruttore assegna automaticamente un ID univoco all'oggetto e imposta
+ * il nome dell'oggetto nel formato "[<id>]".
+ */
+Object::Object(const std::string type)
+    : _type(type)
+{
+    this->_id = Object::getHandles().allocate(this);
+
+    std::stringstream stream;
+    stream << '[' << this->getId() << ']';
+    this->_name = stream.str();
+}
+
+/**
+ * @brief Costruttore di copia: la copia riceve un nuovo ID, nome e tipo vengono copiati.
+ * @param other L'oggetto da copiare.
+ */
+Object::Object(const Object& other)
+    : _name(other._name), _type(other._type)
+{
+    this->_id = Object::getHandles().allocate(this);
+}
+
+/**
+ * @brief Copia nome e tipo mantenendo l'ID di questo oggetto.
+ */
+Object& Object::operator=(const Object& other)
+{
+    this->_name = other._name;
+    this->_type = other._type;
+    return *this;
+}
+
+/**
+ * @brief Distruttore della classe `Object`.
+ */
+Object::~Object()
+{
+    Object::getHandles().release(this->_id);
+}
+
+
+///// Getter
+
+/**
+ * @brief Restituisce l'ID univoco assegnato a questo oggetto.
+ *
+ * Questo metodo restituisce l'ID che viene auto-generato per l'oggetto
+ * al momento della sua creazione. L'ID identifica
+ * in modo univoco ogni istanza della classe `Object`.
+ *
+ * @return L'ID dell'oggetto.
+ */
+int LIB_API Object::getId() const
+{
+    return this->_id;
+}
+
+/**
+ * @brief Restituisce il nome di questo oggetto.
+ *
+ * Restituisce un riferimento: chiamata nel rendering di ogni mesh, non deve copiare la stringa.
+ *
+ * @return Il nome dell'oggetto come stringa.
+ */
+const std::string& LIB_API Object::getName() const
+{
+    return this->_name;
+}
+
+/**
+ * @brief Restituisce il tipo di questo oggetto.
+ *
+ * @return Il tipo dell'oggetto come stringa.
+ */
+const std::string LIB_API Object::getType() const {
+    return _type;
+}
+
+////// Setter
+
+/**
+ * @brief Imposta un nuovo nome per questo oggetto.
+ *
+ * @param newName Il nuovo nome da assegnare all'oggetto.
+ */
+void LIB_API Object::setName(const std::string newName)
+{
+    this->_name = newName;
+}
+
+/**
+ * @brief Imposta un nuovo tipo per questo oggetto.
+ *
+ * @param type Il nuovo tipo da assegnare all'oggetto.
+ */
+void LIB_API Object::setType(const std::string& type) {
+    this->_type = type;
+}
+
+///// Other
+
+/**
+ * @brief Restituisce l'oggetto vivo con l'ID indicato.
+ *
+ * @param id L'ID dell'oggetto.
+ * @return L'oggetto, `nullptr` se l'ID e' stato rilasciato.
+ */
+Object* LIB_API Object::findById(const int id)
+{
+    return Object::getHandles().resolve(id);
+}
+
+/**
+ * @brief Restituisce l'oggetto vivo che occupa uno slot della tabella degli ID.
+ *
+ * @param index L'indice dello slot.
+ * @return L'oggetto, `nullptr` se lo slot e' libero.
+ */
+Object* LIB_API Object::findBySlot(const uint32_t index)
+{
+    return Object::getHandles().resolveIndex(index);
+}
+
+/**
+ * @brief Restituisce il numero di oggetti vivi.
+ */
+size_t LIB_API Object::getLiveCount()
+{
+    return Object::getHandles().getLiveCount();
+}
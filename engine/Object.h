@@ -1,88 +1,124 @@
-#pragma once
-
-#include <vector>
-#include <glm/glm.hpp>
-
-#include "Common.h"
-
-/**
- * @class Object
- * @brief Rappresenta un oggetto di base all'interno del sistema.
- *
- * La classe Object fornisce una base comune a tutti gli oggetti nel sistema.
- * Ogni oggetto ha un identificatore univoco, un tipo e un nome associato.
- * La classe serve come base per altre classi.
- */
-class LIB_API Object
-{
-public:
-    /**
-     * @brief Costruttore di default.
-     */
-    Object() = default;
-
-    /**
-     * @brief Costruttore parametrico.
-     * @param type Il tipo dell'oggetto.
-     */
-    Object(const std::string type);
-
-    /**
-     * @brief Distruttore della classe `Object`.
-     *
-     * Rimuove la luce decrementando il contatore globale degli ID degli oggetti.
-     */
-    virtual ~Object();
-
-    // Getter
-
-    /**
-     * @brief Restituisce l'ID dell'oggetto.
-     * @return L'ID univoco dell'oggetto.
-     */
-    int getId() const;
-
-    /**
-     * @brief Restituisce il nome dell'oggetto.
-     * @return Il nome dell'oggetto.
-     */
-    std::string getName() const;
-
-    /**
-     * @brief Restituisce il tipo dell'oggetto.
-     * @return Il tipo dell'oggetto.
-     */
-    const std::string getType() const;
-
-    // Setter
-
-    /**
-     * @brief Imposta il nome dell'oggetto.
-     * @param newName Il nuovo nome dell'oggetto.
-     */
-    void setName(const std::string newName);
-
-    /**
-     * @brief Imposta il tipo dell'oggetto.
-     * @param type Il nuovo tipo dell'oggetto.
-     */
-    void setType(const std::string& type);
-
-    /**
-     * @brief Metodo virtuale puro per il rendering.
-     * @param viewMatrix La matrice di visualizzazione (camera inversa moltiplicata per la matrice del mondo).
-     */
-    virtual void render(const glm::mat4 viewMatrix) const = 0;
-
-    /**
-     * @brief Resetta il generatore di ID a zero.
-     */
-    static void resetIdGenerator();
-
-private:
-    int _id;  ///< Identificatore univoco dell'oggetto.
-    std::string _name; ///< Nome dell'oggetto.
-    std::string _type; ///< Tipo dell'oggetto.
-
-    static int nextId; ///< Prossimo ID da assegnare agli oggetti.
-};
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Common.h"
+#include "HandleAllocator.h"
+
+/**
+ * @class Object
+ * @brief Rappresenta un oggetto di base all'interno del sistema.
+ *
+ * La classe Object fornisce una base comune a tutti gli oggetti nel sistema.
+ * Ogni oggetto ha un identificatore univoco, un tipo e un nome associato.
+ * La classe serve come base per altre classi.
+ *
+ * L'identificatore e' un handle generazionale (`HandleAllocator`): gli slot degli oggetti
+ * distrutti vengono riusati, ma un ID non viene assegnato di nuovo finche' la generazione
+ * dello slot non compie un giro completo (2048 riusi).
+ */
+class LIB_API Object
+{
+public:
+    /**
+     * @brief Costruttore di default.
+     */
+    Object() = default;
+
+    /**
+     * @brief Costruttore parametrico.
+     * @param type Il tipo dell'oggetto.
+     */
+    Object(const std::string type);
+
+    /**
+     * @brief Costruttore di copia: la copia riceve un nuovo ID.
+     * @param other L'oggetto da copiare.
+     */
+    Object(const Object& other);
+
+    /**
+     * @brief Copia nome e tipo mantenendo l'ID dell'oggetto.
+     * @param other L'oggetto da copiare.
+     * @return Questo oggetto.
+     */
+    Object& operator=(const Object& other);
+
+    /**
+     * @brief Distruttore della classe `Object`.
+     *
+     * Rilascia l'ID dell'oggetto: lo slot potra' essere riusato con una nuova generazione.
+     */
+    virtual ~Object();
+
+    // Getter
+
+    /**
+     * @brief Restituisce l'ID dell'oggetto.
+     * @return L'ID univoco dell'oggetto.
+     */
+    int getId() const;
+
+    /**
+     * @brief Restituisce il nome dell'oggetto.
+     * @return Un riferimento costante al nome dell'oggetto.
+     */
+    const std::string& getName() const;
+
+    /**
+     * @brief Restituisce il tipo dell'oggetto.
+     * @return Il tipo dell'oggetto.
+     */
+    const std::string getType() const;
+
+    // Setter
+
+    /**
+     * @brief Imposta il nome dell'oggetto.
+     * @param newName Il nuovo nome dell'oggetto.
+     */
+    void setName(const std::string newName);
+
+    /**
+     * @brief Imposta il tipo dell'oggetto.
+     * @param type Il nuovo tipo dell'oggetto.
+     */
+    void setType(const std::string& type);
+
+    /**
+     * @brief Metodo virtuale puro per il rendering.
+     * @param viewMatrix La matrice di visualizzazione (camera inversa moltiplicata per la matrice del mondo).
+     */
+    virtual void render(const glm::mat4 viewMatrix) const = 0;
+
+    /**
+     * @brief Restituisce l'oggetto vivo con l'ID indicato in tempo costante.
+     * @param id L'ID dell'oggetto.
+     * @return L'oggetto, `nullptr` se e' stato distrutto.
+     */
+    static Object* findById(const int id);
+
+    /**
+     * @brief Restituisce l'oggetto vivo che occupa uno slot della tabella degli ID.
+     *
+     * Usato dal color picking, che codifica nel colore solo l'indice dello slot.
+     *
+     * @param index L'indice dello slot (`HandleAllocator::getIndex`).
+     * @return L'oggetto, `nullptr` se lo slot e' libero.
+     */
+    static Object* findBySlot(const uint32_t index);
+
+    /**
+     * @brief Restituisce il numero di oggetti vivi.
+     * @return Il numero di ID assegnati e non rilasciati.
+     */
+    static size_t getLiveCount();
+
+private:
+    static HandleAllocator& getHandles();
+
+    int _id = HandleAllocator::INVALID_HANDLE;  ///< Identificatore univoco dell'oggetto.
+    std::string _name; ///< Nome dell'oggetto.
+    std::string _type; ///< Tipo dell'oggetto.
+};
@@ -0,0 +1,379 @@
+#include "OcclusionCuller.h"
+#include "List.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define OCCLUSION_CULLER_SSE
+#endif
+
+// Sotto questo valore di w il vertice e' considerato dietro la camera.
+static constexpr float MIN_CLIP_W = 1e-5f;
+
+OcclusionCuller::OcclusionCuller(const int width, const int height)
+    : _width{ 0 }, _height{ 0 }
+{
+    this->setResolution(width, height);
+}
+
+void LIB_API OcclusionCuller::setResolution(const int width, const int height)
+{
+    const int alignedWidth = std::max(4, (width + 3) & ~3);
+    const int clampedHeight = std::max(1, height);
+
+    if (alignedWidth == this->_width && clampedHeight == this->_height)
+        return;
+
+    this->_width = alignedWidth;
+    this->_height = clampedHeight;
+    this->_depth.assign((size_t)this->_width * this->_height, 1.0f);
+
+    // Una colonna di angoli in piu' e tre di margine per i gruppi di quattro angoli della riga.
+    this->_cornerStride = this->_width + 4;
+    this->_corners.assign((size_t)this->_cornerStride * (this->_height + 1), 1.0f);
+}
+
+int LIB_API OcclusionCuller::getWidth() const
+{
+    return this->_width;
+}
+
+int LIB_API OcclusionCuller::getHeight() const
+{
+    return this->_height;
+}
+
+void LIB_API OcclusionCuller::begin(const glm::mat4& projection)
+{
+    this->_projection = projection;
+    this->_occluderCount = 0;
+    std::fill(this->_depth.begin(), this->_depth.end(), 1.0f);
+    std::fill(this->_corners.begin(), this->_corners.end(), 1.0f);
+}
+
+/**
+ * @brief Rasterizza una mesh nel depth buffer.
+ *
+ * Si usa il livello 0: i livelli ridotti possono sporgere dalla geometria reale. I triangoli
+ * con un vertice dietro la camera vengono saltati: un occlusore incompleto scarta meno mesh,
+ * ma non ne scarta mai una visibile.
+ */
+void LIB_API OcclusionCuller::drawOccluder(const Mesh& mesh, const glm::mat4& modelView)
+{
+    const MeshData& data = mesh.getMeshData(0);
+    const glm::mat4 modelViewProjection = this->_projection * modelView;
+    const size_t vertexCount = data.getVertexCount();
+
+    this->_screen.resize(vertexCount);
+
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        const glm::vec4 clip = modelViewProjection * glm::vec4(data.getPosition(i), 1.0f);
+
+        if (clip.w <= MIN_CLIP_W)
+        {
+            this->_screen[i] = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+            continue;
+        }
+
+        const float inverseW = 1.0f / clip.w;
+        this->_screen[i] = glm::vec4(
+            (clip.x * inverseW * 0.5f + 0.5f) * this->_width,
+            (clip.y * inverseW * 0.5f + 0.5f) * this->_height,
+            clip.z * inverseW,
+            1.0f);
+    }
+
+    const size_t faceCount = data.getFaceCount();
+
+    for (size_t i = 0; i < faceCount; i++)
+    {
+        const glm::uvec3 face = data.getFace(i);
+        const glm::vec4& a = this->_screen[face.x];
+        const glm::vec4& b = this->_screen[face.y];
+        const glm::vec4& c = this->_screen[face.z];
+
+        if (a.w < 0.0f || b.w < 0.0f || c.w < 0.0f)
+            continue;
+
+        this->rasterizeTriangle(glm::vec3(a), glm::vec3(b), glm::vec3(c));
+    }
+
+    // Ogni pixel prende la profondita' del suo angolo piu' lontano: resta vuoto (1) se un angolo
+    // non e' coperto, e un occlusore non nasconde mai cio' che in una parte del pixel e' davanti.
+    for (int y = 0; y < this->_height; y++)
+    {
+        const float* bottom = this->_corners.data() + (size_t)y * this->_cornerStride;
+        const float* top = bottom + this->_cornerStride;
+        float* row = this->_depth.data() + (size_t)y * this->_width;
+
+        for (int x = 0; x < this->_width; x++)
+            row[x] = std::max(std::max(bottom[x], bottom[x + 1]), std::max(top[x], top[x + 1]));
+    }
+
+    this->_occluderCount++;
+}
+
+/**
+ * @brief Scrive la profondita' minima di un triangolo negli angoli dei pixel che copre.
+ *
+ * Funzioni di bordo e profondita' sono lineari nello spazio schermo: con SSE si valutano
+ * quattro angoli consecutivi della riga con una sola operazione per grandezza.
+ */
+void OcclusionCuller::rasterizeTriangle(glm::vec3 v0, glm::vec3 v1, glm::vec3 v2)
+{
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+
+    if (std::fabs(area) < 1e-8f)
+        return;
+
+    // Entrambe le facce nascondono cio' che sta dietro: si porta il triangolo in senso antiorario.
+    if (area < 0.0f)
+    {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    // Gli angoli dei pixel hanno coordinate intere, da 0 a larghezza e altezza comprese.
+    const int minX = std::max(0, (int)std::floor(std::min({ v0.x, v1.x, v2.x }))) & ~3;
+    const int maxX = std::min(this->_width, (int)std::ceil(std::max({ v0.x, v1.x, v2.x })));
+    const int minY = std::max(0, (int)std::floor(std::min({ v0.y, v1.y, v2.y })));
+    const int maxY = std::min(this->_height, (int)std::ceil(std::max({ v0.y, v1.y, v2.y })));
+
+    if (minX > maxX || minY > maxY)
+        return;
+
+    // Funzione di bordo a -> b: e(x, y) = ex * x + ey * y + e0, positiva all'interno.
+    const auto edge = [](const glm::vec3& a, const glm::vec3& b) {
+        return glm::vec3(a.y - b.y, b.x - a.x, a.x * b.y - a.y * b.x);
+    };
+    const glm::vec3 e0 = edge(v1, v2);
+    const glm::vec3 e1 = edge(v2, v0);
+    const glm::vec3 e2 = edge(v0, v1);
+
+    // Piano della profondita': z(x, y) = zx * x + zy * y + z0 (coordinate baricentriche = e / area).
+    const float inverseArea = 1.0f / area;
+    const glm::vec3 z = (e0 * v0.z + e1 * v1.z + e2 * v2.z) * inverseArea;
+
+#ifdef OCCLUSION_CULLER_SSE
+    const __m128 laneOffset = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        const float py = (float)y;
+        float* row = this->_corners.data() + (size_t)y * this->_cornerStride;
+
+        for (int x = minX; x <= maxX; x += 4)
+        {
+            const __m128 px = _mm_add_ps(_mm_set1_ps((float)x), laneOffset);
+
+            const __m128 w0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e0.x), px), _mm_set1_ps(e0.y * py + e0.z));
+            const __m128 w1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e1.x), px), _mm_set1_ps(e1.y * py + e1.z));
+            const __m128 w2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e2.x), px), _mm_set1_ps(e2.y * py + e2.z));
+            const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)), _mm_cmpge_ps(w2, zero));
+
+            if (_mm_movemask_ps(inside) == 0)
+                continue;
+
+            const __m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(z.x), px), _mm_set1_ps(z.y * py + z.z));
+            const __m128 previous = _mm_loadu_ps(row + x);
+            const __m128 nearest = _mm_min_ps(previous, depth);
+
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, previous)));
+        }
+    }
+#else
+    for (int y = minY; y <= maxY; y++)
+    {
+        const float py = (float)y;
+        float* row = this->_corners.data() + (size_t)y * this->_cornerStride;
+
+        for (int x = minX; x <= maxX; x++)
+        {
+            const float px = (float)x;
+
+            if (e0.x * px + e0.y * py + e0.z < 0.0f || e1.x * px + e1.y * py + e1.z < 0.0f || e2.x * px + e2.y * py + e2.z < 0.0f)
+                continue;
+
+            row[x] = std::min(row[x], z.x * px + z.y * py + z.z);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Verifica se una sfera e' almeno in parte davanti agli occlusori.
+ *
+ * Il rettangolo sullo schermo e' quello degli otto vertici del cubo che contiene la sfera
+ * nello spazio vista; la profondita' e' quella del punto della sfera piu' vicino alla camera.
+ */
+bool LIB_API OcclusionCuller::isVisible(const glm::vec3& center, const float radius, const glm::mat4& modelView) const
+{
+    if (this->_occluderCount == 0)
+        return true;
+
+    const glm::vec3 viewCenter = glm::vec3(modelView * glm::vec4(center, 1.0f));
+    const float scale = std::max({ glm::length(glm::vec3(modelView[0])), glm::length(glm::vec3(modelView[1])), glm::length(glm::vec3(modelView[2])) });
+    const float viewRadius = radius * scale;
+
+    float minX = (float)this->_width;
+    float minY = (float)this->_height;
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+
+    for (int corner = 0; corner < 8; corner++)
+    {
+        const glm::vec3 offset((corner & 1) ? viewRadius : -viewRadius, (corner & 2) ? viewRadius : -viewRadius, (corner & 4) ? viewRadius : -viewRadius);
+        const glm::vec4 clip = this->_projection * glm::vec4(viewCenter + offset, 1.0f);
+
+        // La sfera attraversa il piano della camera: non si puo' proiettare.
+        if (clip.w <= MIN_CLIP_W)
+            return true;
+
+        const float x = (clip.x / clip.w * 0.5f + 0.5f) * this->_width;
+        const float y = (clip.y / clip.w * 0.5f + 0.5f) * this->_height;
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    const int x0 = std::max(0, (int)std::floor(minX));
+    const int y0 = std::max(0, (int)std::floor(minY));
+    const int x1 = std::min(this->_width - 1, (int)std::ceil(maxX) - 1);
+    const int y1 = std::min(this->_height - 1, (int)std::ceil(maxY) - 1);
+
+    // Fuori dallo schermo: non e' compito dell'occlusion culling.
+    if (x0 > x1 || y0 > y1)
+        return true;
+
+    const glm::vec4 nearestClip = this->_projection * glm::vec4(viewCenter.x, viewCenter.y, viewCenter.z + viewRadius, 1.0f);
+    const float nearestDepth = nearestClip.z / nearestClip.w;
+
+#ifdef OCCLUSION_CULLER_SSE
+    const __m128 reference = _mm_set1_ps(nearestDepth);
+    const __m128 laneIndex = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 first = _mm_set1_ps((float)x0);
+    const __m128 last = _mm_set1_ps((float)x1);
+
+    for (int y = y0; y <= y1; y++)
+    {
+        const float* row = this->_depth.data() + (size_t)y * this->_width;
+
+        for (int x = x0 & ~3; x <= x1; x += 4)
+        {
+            // Solo le colonne del rettangolo: i gruppi di quattro pixel possono sporgere ai lati.
+            const __m128 column = _mm_add_ps(_mm_set1_ps((float)x), laneIndex);
+            const __m128 inRange = _mm_and_ps(_mm_cmpge_ps(column, first), _mm_cmple_ps(column, last));
+            const __m128 uncovered = _mm_cmpge_ps(_mm_loadu_ps(row + x), reference);
+
+            if (_mm_movemask_ps(_mm_and_ps(inRange, uncovered)) != 0)
+                return true;
+        }
+    }
+#else
+    for (int y = y0; y <= y1; y++)
+    {
+        const float* row = this->_depth.data() + (size_t)y * this->_width;
+
+        for (int x = x0; x <= x1; x++)
+        {
+            if (row[x] >= nearestDepth)
+                return true;
+        }
+    }
+#endif
+
+    return false;
+}
+
+size_t LIB_API OcclusionCuller::cull(RenderQueue& queue, const glm::mat4& projection, const glm::mat4& inverseCameraMatrix)
+{
+    this->begin(projection);
+
+    const std::vector<RenderItem>& items = queue.getItems();
+
+    // Solo le mesh hanno un materiale nella coda.
+    for (const RenderItem& item : items)
+    {
+        if (item.material != nullptr && static_cast<const Mesh*>(item.node)->isOccluder())
+            this->drawOccluder(*static_cast<const Mesh*>(item.node), inverseCameraMatrix * item.worldMatrix);
+    }
+
+    if (this->_occluderCount == 0)
+        return 0;
+
+    size_t culled = 0;
+    this->_keep.assign(items.size(), 1);
+
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        const RenderItem& item = items[i];
+
+        if (item.material == nullptr)
+            continue;
+
+        const Mesh* mesh = static_cast<const Mesh*>(item.node);
+        const MeshData& data = mesh->getMeshData(0);
+
+        if (mesh->isOccluder() || data.getFaceCount() == 0)
+            continue;
+
+        if (!this->isVisible(data.getBoundingCenter(), data.getBoundingRadius(), inverseCameraMatrix * item.worldMatrix))
+        {
+            this->_keep[i] = 0;
+            culled++;
+        }
+    }
+
+    if (culled > 0)
+        queue.retain(this->_keep);
+
+    return culled;
+}
+
+size_t LIB_API OcclusionCuller::getOccluderCount() const
+{
+    return this->_occluderCount;
+}
+
+const std::vector<float>& LIB_API OcclusionCuller::getDepthBuffer() const
+{
+    return this->_depth;
+}
+
+/**
+ * @brief Designa come occlusori le mesh opache piu' grandi di una scena.
+ */
+size_t LIB_API OcclusionCuller::markLargestOccluders(const std::shared_ptr<Node>& root, const size_t count)
+{
+    if (root == nullptr || count == 0)
+        return 0;
+
+    std::vector<std::pair<float, Mesh*>> candidates;
+
+    for (const auto& entry : List::pass(root, glm::mat4(1.0f)))
+    {
+        Mesh* mesh = dynamic_cast<Mesh*>(entry.first.get());
+
+        // Le mesh trasparenti lasciano vedere cio' che sta dietro.
+        if (mesh == nullptr || mesh->getMeshData(0).getFaceCount() == 0 || (mesh->getMaterial() != nullptr && mesh->getMaterial()->getState().alpha < 1.0f))
+            continue;
+
+        const glm::mat4& world = entry.second;
+        const float scale = std::max({ glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2])) });
+        candidates.emplace_back(mesh->getMeshData(0).getBoundingRadius() * scale, mesh);
+    }
+
+    const size_t marked = std::min(count, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + marked, candidates.end(),
+        [](const std::pair<float, Mesh*>& a, const std::pair<float, Mesh*>& b) { return a.first > b.first; });
+
+    for (size_t i = 0; i < marked; i++)
+        candidates[i].second->setOccluder(true);
+
+    return marked;
+}
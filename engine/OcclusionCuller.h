@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Mesh.h"
+#include "RenderQueue.h"
+#include "Common.h"
+
+/**
+ * @file OcclusionCuller.h
+ * @brief Dichiarazione dell'occlusion culling software su un depth buffer a bassa risoluzione.
+ */
+
+ /**
+  * @class OcclusionCuller
+  * @brief Scarta le mesh nascoste da pochi occlusori rasterizzati sulla CPU.
+  *
+  * A ogni frame le mesh designate come occlusori (`Mesh::setOccluder`) vengono rasterizzate,
+  * al livello di dettaglio 0, in un depth buffer di poche centinaia di pixel
+  * (quattro pixel alla volta con SSE). Per le altre mesh si proietta la sfera di ingombro:
+  * se in tutti i pixel del rettangolo che la contiene un occlusore e' piu' vicino del punto
+  * piu' vicino della sfera, la mesh non viene disegnata.
+  *
+  * Il test e' conservativo: i livelli ridotti possono sporgere dalla geometria reale e non
+  * vengono usati, e la profondita' viene calcolata negli angoli dei pixel: un pixel e' coperto
+  * solo se lo sono i suoi quattro angoli e vale la profondita' dell'angolo piu' lontano.
+  */
+class LIB_API OcclusionCuller
+{
+public:
+
+    /**
+     * @brief Crea il depth buffer.
+     * @param width La larghezza in pixel (arrotondata a un multiplo di 4).
+     * @param height L'altezza in pixel.
+     */
+    OcclusionCuller(const int width = 256, const int height = 128);
+
+    /**
+     * @brief Cambia la risoluzione del depth buffer.
+     * @param width La larghezza in pixel (arrotondata a un multiplo di 4).
+     * @param height L'altezza in pixel.
+     */
+    void setResolution(const int width, const int height);
+
+    /**
+     * @brief Restituisce la larghezza del depth buffer.
+     * @return La larghezza in pixel, multipla di 4.
+     */
+    int getWidth() const;
+
+    /**
+     * @brief Restituisce l'altezza del depth buffer.
+     * @return L'altezza in pixel.
+     */
+    int getHeight() const;
+
+    /**
+     * @brief Svuota il depth buffer e imposta la proiezione del frame.
+     * @param projection La matrice di proiezione della camera.
+     */
+    void begin(const glm::mat4& projection);
+
+    /**
+     * @brief Rasterizza una mesh nel depth buffer.
+     * @param mesh La mesh, disegnata al livello di dettaglio 0.
+     * @param modelView La matrice di vista della mesh (inversa della camera per matrice globale).
+     */
+    void drawOccluder(const Mesh& mesh, const glm::mat4& modelView);
+
+    /**
+     * @brief Verifica se una sfera e' almeno in parte davanti agli occlusori.
+     * @param center Il centro della sfera nello spazio della mesh.
+     * @param radius Il raggio della sfera nello spazio della mesh.
+     * @param modelView La matrice di vista della mesh.
+     * @return `false` solo se la sfera e' interamente nascosta dagli occlusori.
+     */
+    bool isVisible(const glm::vec3& center, const float radius, const glm::mat4& modelView) const;
+
+    /**
+     * @brief Esegue l'occlusion culling sulla coda di rendering di un frame.
+     *
+     * Rasterizza gli occlusori della coda, quindi sposta le mesh nascoste in
+     * `RenderQueue::getCulledItems`.
+     * Senza occlusori la coda non viene modificata.
+     *
+     * @param queue La coda, gia' ordinata.
+     * @param projection La matrice di proiezione della camera.
+     * @param inverseCameraMatrix La matrice inversa della camera.
+     * @return Il numero di mesh rimosse.
+     */
+    size_t cull(RenderQueue& queue, const glm::mat4& projection, const glm::mat4& inverseCameraMatrix);
+
+    /**
+     * @brief Restituisce il numero di occlusori rasterizzati dall'ultimo `begin`.
+     * @return Il numero di occlusori.
+     */
+    size_t getOccluderCount() const;
+
+    /**
+     * @brief Restituisce il depth buffer (profondita' NDC, 1 = vuoto), riga per riga dal basso.
+     * @return I `getWidth() * getHeight()` valori.
+     */
+    const std::vector<float>& getDepthBuffer() const;
+
+    /**
+     * @brief Designa come occlusori le mesh opache piu' grandi di una scena.
+     *
+     * La dimensione e' il raggio della sfera di ingombro scalato dalla matrice globale.
+     *
+     * @param root La radice della scena.
+     * @param count Il numero massimo di occlusori.
+     * @return Il numero di mesh designate.
+     */
+    static size_t markLargestOccluders(const std::shared_ptr<Node>& root, const size_t count);
+
+private:
+    void rasterizeTriangle(glm::vec3 v0, glm::vec3 v1, glm::vec3 v2);
+
+    int _width;                        ///< Larghezza del depth buffer (multipla di 4).
+    int _height;                       ///< Altezza del depth buffer.
+    std::vector<float> _depth;         ///< Profondita' NDC di ogni pixel, la piu' lontana dei suoi angoli.
+    std::vector<float> _corners;       ///< Profondita' NDC piu' vicina di ogni angolo dei pixel.
+    int _cornerStride = 0;             ///< Angoli per riga di `_corners` (larghezza + 4).
+    glm::mat4 _projection{ 1.0f };     ///< Proiezione del frame corrente.
+    size_t _occluderCount = 0;         ///< Occlusori rasterizzati nel frame.
+    std::vector<glm::vec4> _screen;    ///< Vertici dell'occlusore in coordinate schermo (w < 0 = dietro la camera).
+    std::vector<uint8_t> _keep;        ///< Elementi della coda da mantenere.
+};
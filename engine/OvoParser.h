@@ -1,112 +1,189 @@
-#pragma once
-
-#include <unordered_map>
-#include <filesystem>
-#include "Common.h"
-#include "Mesh.h"
-#include "Node.h"
-#include "Light.h"
-#include "Material.h"
-#include "MeshData.h"
-#include "Texture.h"
-#include "DirectionalLight.h"
-#include "PointLight.h"
-#include "SpotLight.h"
-
-/**
- * @class OVOParser
- * @brief Parser per il caricamento di grafi di scena da file OVO.
- *
- * La classe `OVOParser` fornisce funzionalit per caricare e analizzare i dati delle scene dal formato di file OVO.
- * Converte i dati di questi file in una struttura di grafo di scena composta da nodi, mesh, materiali e luci.
- *
- * ### Funzionalit principali:
- * - Caricamento di un grafo di scena completo da un file OVO.
- * - Analisi dei chunk di dati corrispondenti a nodi, mesh, materiali e luci.
- * - Estrazione di stringhe dai dati binari.
- * - Gestione di una mappa per evitare duplicazioni dei materiali.
- */
-class LIB_API OVOParser
-{
-public:
-    /**
-     * @brief Carica un grafo di scena da un file OVO.
-     *
-     * Questa funzione legge un file `.ovo` specificato dal percorso `filePath`, analizza i dati in esso contenuti e
-     * costruisce una struttura di grafo di scena composta da nodi, mesh, luci e materiali.
-     *
-     * @param filePath Il percorso del file `.ovo` da caricare.
-     * @return Un puntatore condiviso al nodo radice della scena caricata.
-     *
-     * @throws std::runtime_error Se il file non pu essere aperto o se i dati del file sono corrotti.
-     */
-    static std::shared_ptr<Node> fromFile(const std::string filePath);
-
-private:
-    /**
-     * @brief Analizza un chunk di dati per creare un nodo della scena.
-     *
-     * Questo metodo estrae i dati di un nodo dal chunk fornito e costruisce un oggetto `Node`.
-     * Include informazioni come il nome del nodo, la matrice di trasformazione e il numero di figli.
-     *
-     * @param chunkData I dati del chunk in formato binario.
-     * @param chunkSize La dimensione del chunk in byte.
-     * @return Una coppia contenente un puntatore condiviso al nodo e il numero di figli associati.
-     */
-    static std::pair<std::shared_ptr<Node>, uint32_t> parseNodeChunk(const uint8_t* chunkData, const uint32_t chunkSize);
-
-    /**
-     * @brief Analizza un chunk di dati per creare una mesh.
-     *
-     * Questo metodo estrae i dati di una mesh dal chunk fornito e costruisce un oggetto `Mesh` popolato
-     * con informazioni sui vertici, le facce, le normali e le coordinate UV.
-     *
-     * @param chunkData I dati del chunk in formato binario.
-     * @param chunkSize La dimensione del chunk in byte.
-     * @return Una coppia contenente un puntatore condiviso alla mesh e il numero di figli associati.
-     */
-    static std::pair<std::shared_ptr<Mesh>, uint32_t> parseMeshChunk(const uint8_t* chunkData, const uint32_t chunkSize);
-
-    /**
-     * @brief Analizza un chunk di dati per creare un materiale.
-     *
-     * Questo metodo estrae i dati di un materiale dal chunk fornito e costruisce un oggetto `Material`
-     * con informazioni come il nome, i colori albedo e di emissione, la rugosit, la trasparenza e le texture.
-     *
-     * @param chunkData I dati del chunk in formato binario.
-     * @param chunkSize La dimensione del chunk in byte.
-     * @return Una coppia contenente un puntatore condiviso al materiale e il nome del materiale.
-     */
-    static std::pair<std::shared_ptr<Material>, std::string> parseMaterialChunk(const uint8_t* chunkData, const uint32_t chunkSize);
-
-    /**
-     * @brief Analizza un chunk di dati per creare una luce.
-     *
-     * Questo metodo estrae i dati di una luce dal chunk fornito e costruisce un oggetto `Light` di tipo
-     * specifico (PointLight, DirectionalLight o SpotLight), popolato con informazioni come il colore,
-     * la direzione, il raggio di influenza e il tipo di luce.
-     *
-     * @param chunkData I dati del chunk in formato binario.
-     * @param chunkSize La dimensione del chunk in byte.
-     * @return Una coppia contenente un puntatore condiviso alla luce e il numero di figli associati.
-     */
-    static std::pair<std::shared_ptr<Light>, uint32_t> parseLightChunk(const uint8_t* chunkData, const uint32_t chunkSize);
-
-    /**
-     * @brief Converte un array di byte in una stringa terminata con carattere null.
-     *
-     * Questo metodo estrae una stringa da un buffer di byte, terminata da un carattere null (`\0`).
-     *
-     * @param data Puntatore al buffer di dati binari.
-     * @return La stringa estratta dai dati forniti.
-     */
-    static std::string parseString(const uint8_t* data);
-
-    /**
-     * @brief Mappa contenente i materiali caricati durante il parsing.
-     *
-     * Questa mappa viene utilizzata per evitare la duplicazione dei materiali durante il caricamento della scena.
-     * La chiave  il nome del materiale, mentre il valore  un puntatore condiviso al materiale stesso.
-     */
-    static std::unordered_map<std::string, std::shared_ptr<Material>> materials;
-};
+#pragma once
+
+#include <unordered_map>
+#include <filesystem>
+#include "Common.h"
+#include "ChunkCompressor.h"
+#include "Mesh.h"
+#include "Node.h"
+#include "Light.h"
+#include "Material.h"
+#include "MeshData.h"
+#include "MeshOptimizer.h"
+#include "OvoWriter.h"
+#include "SceneArena.h"
+#include "SceneLoader.h"
+#include "TaskPool.h"
+#include "Texture.h"
+#include "TextureManager.h"
+#include "TextureStreamer.h"
+#include "DirectionalLight.h"
+#include "PointLight.h"
+#include "SpotLight.h"
+
+/**
+ * @class OVOParser
+ * @brief Parser per il caricamento di grafi di scena da file OVO.
+ *
+ * La classe `OVOParser` fornisce funzionalitá per caricare e analizzare i dati delle scene dal formato di file OVO.
+ * Converte i dati di questi file in una struttura di grafo di scena composta da nodi, mesh, materiali e luci.
+ *
+ * ### Funzionalitá principali:
+ * - Caricamento di un grafo di scena completo da un file OVO.
+ * - Analisi dei chunk di dati corrispondenti a nodi, mesh, materiali e luci.
+ * - Estrazione di stringhe dai dati binari.
+ * - Gestione di una mappa per evitare duplicazioni dei materiali.
+ * - Caricamento asincrono, con la scena mostrata man mano che viene letta.
+ * - Mesh compresse (chunk esteso scritto da `OVOWriter`) decompresse sui thread di `TaskPool`.
+ */
+class LIB_API OVOParser
+{
+public:
+    /**
+     * @brief Carica un grafo di scena da un file OVO.
+     *
+     * Questa funzione legge un file `.ovo` specificato dal percorso `filePath`, analizza i dati in esso contenuti e
+     * costruisce una struttura di grafo di scena composta da nodi, mesh, luci e materiali.
+     *
+     * @param filePath Il percorso del file `.ovo` da caricare.
+     * @return Un puntatore condiviso al nodo radice della scena caricata, nullptr se il file non puó essere aperto.
+     */
+    static std::shared_ptr<Node> fromFile(const std::string filePath);
+
+    /**
+     * @brief Avvia il caricamento di un grafo di scena da un file OVO senza bloccare il chiamante.
+     *
+     * Il file viene letto su un thread in background; la radice restituita da `SceneLoader::getRoot`
+     * puo' essere aggiunta subito alla scena e si riempie man mano che i sottoalberi sono pronti
+     * (vedi `SceneLoader`).
+     *
+     * @param filePath Il percorso del file `.ovo` da caricare.
+     * @return Il caricamento in corso.
+     */
+    static std::shared_ptr<SceneLoader> loadAsync(const std::string filePath);
+
+    /**
+     * @brief Abilita o disabilita l'ottimizzazione delle mesh al caricamento.
+     *
+     * Con l'ottimizzazione attiva (default) i vertici duplicati vengono uniti e triangoli e vertici
+     * vengono riordinati per la cache della GPU; per ogni mesh viene stampato ACMR/ATVR prima e dopo.
+     *
+     * @param enabled `true` per abilitare l'ottimizzazione.
+     */
+    static void setMeshOptimization(const bool enabled);
+
+    /**
+     * @brief Verifica se l'ottimizzazione delle mesh al caricamento e' abilitata.
+     * @return `true` se abilitata.
+     */
+    static bool isMeshOptimizationEnabled();
+
+private:
+    friend class SceneLoader;
+
+    /**
+     * @brief Legge un file OVO e ne aggiunge la scena a un nodo.
+     * @param filePath Il percorso del file `.ovo`.
+     * @param sceneRoot Il nodo a cui aggiungere la scena.
+     * @param sceneLoader Il caricamento asincrono a cui consegnare i nodi, nullptr per un caricamento sincrono.
+     * @return `false` se il file non puó essere aperto.
+     */
+    static bool parse(const std::string& filePath, const std::shared_ptr<Node>& sceneRoot, SceneLoader* sceneLoader);
+
+    /**
+     * @brief Analizza un chunk di dati per creare un nodo della scena.
+     *
+     * Questo metodo estrae i dati di un nodo dal chunk fornito e costruisce un oggetto `Node`.
+     * Include informazioni come il nome del nodo, la matrice di trasformazione e il numero di figli.
+     *
+     * @param chunkData I dati del chunk in formato binario.
+     * @param chunkSize La dimensione del chunk in byte.
+     * @return Una coppia contenente un puntatore condiviso al nodo e il numero di figli associati.
+     */
+    static std::pair<std::shared_ptr<Node>, uint32_t> parseNodeChunk(const uint8_t* chunkData, const uint32_t chunkSize);
+
+    /**
+     * @brief Analizza un chunk di dati per creare una mesh.
+     *
+     * Questo metodo estrae i dati di una mesh dal chunk fornito e costruisce un oggetto `Mesh` popolato
+     * con informazioni sui vertici, le facce, le normali e le coordinate UV.
+     *
+     * @param chunkData I dati del chunk in formato binario.
+     * @param chunkSize La dimensione del chunk in byte.
+     * @return Una coppia contenente un puntatore condiviso alla mesh e il numero di figli associati.
+     */
+    static std::pair<std::shared_ptr<Mesh>, uint32_t> parseMeshChunk(const uint8_t* chunkData, const uint32_t chunkSize);
+
+    /**
+     * @brief Analizza un chunk di mesh compressa (`OVOWriter::COMPRESSED_MESH_CHUNK`).
+     *
+     * L'intestazione viene letta subito; vertici e indici vengono decompressi da un task aggiunto
+     * a `group`, che va atteso prima di consegnare la mesh.
+     *
+     * @param chunkData I dati del chunk in formato binario.
+     * @param chunkSize La dimensione del chunk in byte.
+     * @param group Il gruppo di task della decompressione.
+     * @return Una coppia contenente un puntatore condiviso alla mesh e il numero di figli associati.
+     */
+    static std::pair<std::shared_ptr<Mesh>, uint32_t> parseCompressedMeshChunk(const uint8_t* chunkData, const uint32_t chunkSize, TaskPool::Group& group);
+
+    /**
+     * @brief Legge i campi comuni ai chunk di mesh, dal nome ai dati di fisica.
+     *
+     * @param chunkData I dati del chunk in formato binario.
+     * @param chunkPointer La posizione nel chunk, portata dopo i dati di fisica.
+     * @return Una coppia contenente un puntatore condiviso alla mesh e il numero di figli associati.
+     */
+    static std::pair<std::shared_ptr<Mesh>, uint32_t> parseMeshHeader(const uint8_t* chunkData, uint32_t& chunkPointer);
+
+    /**
+     * @brief Decomprime vertici e indici di una mesh compressa e li assegna alla mesh.
+     *
+     * @param mesh La mesh.
+     * @param flags I flag del chunk (`OVOWriter::COMPRESSED_MESH_OPTIMIZED`, `OVOWriter::COMPRESSED_MESH_STORED`).
+     * @param rawSize La dimensione dei dati decompressi.
+     * @param data I dati compressi.
+     * @return `false` se i dati sono corrotti; la mesh resta senza geometria.
+     */
+    static bool parseMeshPayload(Mesh& mesh, const uint8_t flags, const uint32_t rawSize, const std::vector<uint8_t>& data);
+
+    /**
+     * @brief Analizza un chunk di dati per creare un materiale.
+     *
+     * Questo metodo estrae i dati di un materiale dal chunk fornito e costruisce un oggetto `Material`
+     * con informazioni come il nome, i colori albedo e di emissione, la rugositá, la trasparenza e le texture.
+     *
+     * @param chunkData I dati del chunk in formato binario.
+     * @param chunkSize La dimensione del chunk in byte.
+     * @return Una coppia contenente un puntatore condiviso al materiale e il nome del materiale.
+     */
+    static std::pair<std::shared_ptr<Material>, std::string> parseMaterialChunk(const uint8_t* chunkData, const uint32_t chunkSize);
+
+    /**
+     * @brief Analizza un chunk di dati per creare una luce.
+     *
+     * Questo metodo estrae i dati di una luce dal chunk fornito e costruisce un oggetto `Light` di tipo
+     * specifico (PointLight, DirectionalLight o SpotLight), popolato con informazioni come il colore,
+     * la direzione, il raggio di influenza e il tipo di luce.
+     *
+     * @param chunkData I dati del chunk in formato binario.
+     * @param chunkSize La dimensione del chunk in byte.
+     * @return Una coppia contenente un puntatore condiviso alla luce e il numero di figli associati.
+     */
+    static std::pair<std::shared_ptr<Light>, uint32_t> parseLightChunk(const uint8_t* chunkData, const uint32_t chunkSize);
+
+    /**
+     * @brief Converte un array di byte in una stringa terminata con carattere null.
+     *
+     * Questo metodo estrae una stringa da un buffer di byte, terminata da un carattere null (`\0`).
+     *
+     * @param data Puntatore al buffer di dati binari.
+     * @return La stringa estratta dai dati forniti.
+     */
+    static std::string parseString(const uint8_t* data);
+
+    /**
+     * @brief Indica se le mesh vengono ottimizzate al caricamento.
+     */
+    static bool meshOptimization;
+};
@@ -0,0 +1,466 @@
+#include "OvoWriter.h"
+#include "ChunkCompressor.h"
+#include "DirectionalLight.h"
+#include "Mesh.h"
+#include "MeshOptimizer.h"
+#include "PointLight.h"
+#include "SpotLight.h"
+#include "TextureManager.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <glm/gtc/packing.hpp>
+
+#pragma warning(disable:4996) // Disable Visual Studio warning
+
+// Tipi dei chunk, come in OVOParser::parse.
+static constexpr uint32_t CHUNK_VERSION = 0;
+static constexpr uint32_t CHUNK_NODE = 1;
+static constexpr uint32_t CHUNK_MATERIAL = 9;
+static constexpr uint32_t CHUNK_LIGHT = 16;
+static constexpr uint32_t CHUNK_MESH = 18;
+
+/**
+ * @brief Aggiunge i byte di un valore in fondo a un buffer.
+ */
+template<typename T>
+static void appendBytes(std::vector<uint8_t>& buffer, const T& value)
+{
+    const uint8_t* bytes = (const uint8_t*)&value;
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+OVOWriter::~OVOWriter()
+{
+    this->close();
+}
+
+bool LIB_API OVOWriter::open(const std::string& filePath)
+{
+    this->close();
+
+    this->_file = fopen(filePath.c_str(), "wb");
+    if (this->_file == nullptr)
+    {
+        ERROR("Failed to create file \"" << filePath << "\".");
+        return false;
+    }
+
+    this->_failed = false;
+    this->_bytesWritten = 0;
+    this->_chunkCount = 0;
+
+    this->_chunk.clear();
+    this->put(VERSION);
+    this->writeChunk(CHUNK_VERSION);
+
+    return true;
+}
+
+bool LIB_API OVOWriter::close()
+{
+    if (this->_file == nullptr)
+        return !this->_failed;
+
+    if (fclose(this->_file) != 0)
+        this->_failed = true;
+    this->_file = nullptr;
+
+    return !this->_failed;
+}
+
+bool LIB_API OVOWriter::isOpen() const
+{
+    return this->_file != nullptr;
+}
+
+void LIB_API OVOWriter::writeNode(const std::string& name, const glm::mat4& matrix, const uint32_t children)
+{
+    this->_chunk.clear();
+    this->putString(name);
+    this->put(matrix);
+    this->put(children);
+    this->writeChunk(CHUNK_NODE);
+}
+
+void LIB_API OVOWriter::writeMaterial(const OVOMaterialDesc& material)
+{
+    this->_chunk.clear();
+    this->putString(material.name);
+    this->put(material.emission);
+    this->put(material.albedo);
+    this->put(material.roughness);
+    this->put(material.metalness);
+    this->put(material.alpha);
+    this->putString(material.texture);
+
+    // Normal, height, roughness e metalness map.
+    for (int i = 0; i < 4; i++)
+        this->putString("[none]");
+
+    this->writeChunk(CHUNK_MATERIAL);
+}
+
+void LIB_API OVOWriter::writeLight(const OVOLightDesc& light)
+{
+    this->_chunk.clear();
+    this->putString(light.name);
+    this->put(light.matrix);
+    this->put(light.children);
+    this->putString("[none]"); // Target node
+    this->put(light.subtype);
+    this->put(light.color);
+    this->put(light.radius);
+    this->put(light.direction);
+    this->put(light.cutoff);
+    this->put(light.exponent);
+    this->writeChunk(CHUNK_LIGHT);
+}
+
+void LIB_API OVOWriter::writeMesh(const OVOMeshDesc& mesh)
+{
+    if (this->_compressMeshes)
+    {
+        this->writeCompressedMesh(mesh);
+        return;
+    }
+
+    this->putMeshHeader(mesh);
+
+    this->put((uint32_t)mesh.lods.size());
+    for (const OVOMeshLod& lod : mesh.lods)
+    {
+        const uint32_t numberOfVertices = (uint32_t)lod.positions.size();
+        const uint32_t numberOfFaces = (uint32_t)(lod.indices.size() / 3);
+        this->put(numberOfVertices);
+        this->put(numberOfFaces);
+
+        for (uint32_t i = 0; i < numberOfVertices; i++)
+        {
+            const glm::vec3 normal = i < lod.normals.size() ? lod.normals[i] : glm::vec3(0.0f, 1.0f, 0.0f);
+            const glm::vec2 uv = i < lod.uvs.size() ? lod.uvs[i] : glm::vec2(0.0f);
+
+            this->put(lod.positions[i]);
+            this->put(glm::packSnorm3x10_1x2(glm::vec4(normal, 0.0f)));
+            this->put(glm::packHalf2x16(uv));
+            this->put((uint32_t)0); // Tangente
+        }
+
+        this->put(lod.indices.data(), numberOfFaces * 3 * sizeof(uint32_t));
+    }
+
+    this->writeChunk(CHUNK_MESH);
+}
+
+/**
+ * @brief Scrive una mesh nel chunk compresso (vedi la descrizione della classe).
+ *
+ * Se i dati compressi non sono piu' piccoli di quelli originali vengono salvati cosi' come sono.
+ */
+void OVOWriter::writeCompressedMesh(const OVOMeshDesc& mesh)
+{
+    uint8_t flags = this->_optimizeMeshes ? COMPRESSED_MESH_OPTIMIZED : 0;
+
+    this->_payload.clear();
+    appendBytes(this->_payload, (uint32_t)mesh.lods.size());
+
+    std::vector<PackedVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<uint16_t> shortIndices;
+
+    for (const OVOMeshLod& lod : mesh.lods)
+    {
+        // Vertici nel formato di MeshData, come li produce OVOParser dal chunk 18.
+        vertices.resize(lod.positions.size());
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            const glm::vec3 normal = i < lod.normals.size() ? lod.normals[i] : glm::vec3(0.0f, 1.0f, 0.0f);
+            const glm::vec2 uv = i < lod.uvs.size() ? lod.uvs[i] : glm::vec2(0.0f);
+
+            vertices[i].position = lod.positions[i];
+            vertices[i].normal = glm::packSnorm4x8(glm::vec4(normal, 0.0f));
+            vertices[i].uv = glm::packHalf2x16(uv);
+        }
+        indices.assign(lod.indices.begin(), lod.indices.begin() + lod.indices.size() / 3 * 3);
+
+        if (this->_optimizeMeshes)
+            MeshOptimizer::optimize(vertices, indices, MeshOptimizationOptions());
+
+        // Indici a 16 bit quando tutti i vertici sono indirizzabili, come in MeshData.
+        const uint8_t indexSize = vertices.size() <= 65536 ? sizeof(uint16_t) : sizeof(uint32_t);
+
+        appendBytes(this->_payload, (uint32_t)vertices.size());
+        appendBytes(this->_payload, (uint32_t)(indices.size() / 3));
+        appendBytes(this->_payload, indexSize);
+
+        size_t offset = this->_payload.size();
+        this->_payload.resize(offset + vertices.size() * sizeof(PackedVertex));
+        ChunkCompressor::shuffle((const uint8_t*)vertices.data(), vertices.size(), sizeof(PackedVertex), this->_payload.data() + offset);
+
+        const uint8_t* indexData = (const uint8_t*)indices.data();
+        if (indexSize == sizeof(uint16_t))
+        {
+            shortIndices.assign(indices.begin(), indices.end());
+            indexData = (const uint8_t*)shortIndices.data();
+        }
+
+        offset = this->_payload.size();
+        this->_payload.resize(offset + indices.size() * indexSize);
+        ChunkCompressor::shuffle(indexData, indices.size(), indexSize, this->_payload.data() + offset);
+    }
+
+    ChunkCompressor::compress(this->_payload.data(), this->_payload.size(), this->_compressed);
+
+    const std::vector<uint8_t>* data = &this->_compressed;
+    if (this->_compressed.size() >= this->_payload.size())
+    {
+        flags |= COMPRESSED_MESH_STORED;
+        data = &this->_payload;
+    }
+
+    this->putMeshHeader(mesh);
+    this->put(flags);
+    this->put((uint32_t)this->_payload.size());
+    this->put((uint32_t)data->size());
+    this->put(data->data(), data->size());
+    this->writeChunk(COMPRESSED_MESH_CHUNK);
+}
+
+/**
+ * @brief Prepara i campi del chunk 18 che precedono i LOD, fino ai dati di fisica (assenti).
+ * Raggio e bounding box vengono calcolati dal primo livello di dettaglio.
+ */
+void OVOWriter::putMeshHeader(const OVOMeshDesc& mesh)
+{
+    glm::vec3 minimum(0.0f);
+    glm::vec3 maximum(0.0f);
+    float radius = 0.0f;
+
+    if (!mesh.lods.empty() && !mesh.lods[0].positions.empty())
+    {
+        minimum = glm::vec3(FLT_MAX);
+        maximum = glm::vec3(-FLT_MAX);
+        for (const glm::vec3& position : mesh.lods[0].positions)
+        {
+            minimum = glm::min(minimum, position);
+            maximum = glm::max(maximum, position);
+            radius = std::max(radius, glm::length(position));
+        }
+    }
+
+    this->_chunk.clear();
+    this->putString(mesh.name);
+    this->put(mesh.matrix);
+    this->put(mesh.children);
+    this->putString("[none]"); // Target node
+    this->put((uint8_t)0);     // Sub-type
+    this->putString(mesh.material);
+    this->put(radius);
+    this->put(minimum);
+    this->put(maximum);
+    this->put((uint8_t)0);     // Nessun dato di fisica
+}
+
+bool LIB_API OVOWriter::writeScene(const std::shared_ptr<Node>& root)
+{
+    if (this->_file == nullptr || root == nullptr)
+        return false;
+
+    // I materiali vanno scritti prima delle mesh: nomi assegnati nella prima visita, usati nella seconda.
+    std::unordered_map<const Material*, std::string> names;
+    std::unordered_set<std::string> used;
+    this->writeSceneMaterials(root, names, used);
+    this->writeSceneNode(root, names);
+
+    return !this->_failed;
+}
+
+/**
+ * @brief Scrive i materiali delle mesh di un sottoalbero non ancora scritti, con un nome unico.
+ */
+void OVOWriter::writeSceneMaterials(const std::shared_ptr<Node>& node, std::unordered_map<const Material*, std::string>& names, std::unordered_set<std::string>& used)
+{
+    if (const Mesh* mesh = dynamic_cast<const Mesh*>(node.get()))
+    {
+        const std::shared_ptr<Material> material = mesh->getMaterial();
+
+        if (material != nullptr && names.find(material.get()) == names.end())
+        {
+            std::string base = material->getName();
+            if (base.empty() || base == "[none]")
+                base = "material";
+
+            std::string name = base;
+            for (size_t suffix = 1; used.count(name) > 0; suffix++)
+                name = base + "_" + std::to_string(suffix);
+            used.insert(name);
+            names[material.get()] = name;
+
+            const MaterialState& state = material->getState();
+
+            OVOMaterialDesc description;
+            description.name = name;
+            description.emission = state.emissionColor;
+            description.albedo = state.diffuseColor;
+            // Inverso della lucentezza calcolata da OVOParser: (1 - sqrt(roughness)) * 128.
+            description.roughness = std::pow(1.0f - glm::clamp(state.shininess, 0.0f, 128.0f) / 128.0f, 2.0f);
+            description.alpha = state.alpha;
+
+            const std::string texture = TextureManager::getPath(state.texture);
+            if (!texture.empty())
+                description.texture = texture;
+
+            this->writeMaterial(description);
+        }
+    }
+
+    for (const std::shared_ptr<Node>& child : node->getChildren())
+        this->writeSceneMaterials(child, names, used);
+}
+
+/**
+ * @brief Scrive un nodo, nel chunk del suo tipo, seguito dai suoi figli.
+ */
+void OVOWriter::writeSceneNode(const std::shared_ptr<Node>& node, const std::unordered_map<const Material*, std::string>& names)
+{
+    const std::vector<std::shared_ptr<Node>>& children = node->getChildren();
+    const uint32_t numberOfChildren = (uint32_t)children.size();
+
+    if (const Mesh* mesh = dynamic_cast<const Mesh*>(node.get()))
+    {
+        OVOMeshDesc description;
+        description.name = mesh->getName();
+        description.matrix = mesh->getLocalMatrix();
+        description.children = numberOfChildren;
+
+        const auto material = names.find(mesh->getMaterial().get());
+        if (material != names.end())
+            description.material = material->second;
+
+        description.lods.resize(mesh->getLodCount());
+        for (int l = 0; l < mesh->getLodCount(); l++)
+        {
+            const MeshData& data = mesh->getMeshData(l);
+            OVOMeshLod& lod = description.lods[l];
+
+            for (size_t i = 0; i < data.getVertexCount(); i++)
+            {
+                lod.positions.push_back(data.getPosition(i));
+                lod.normals.push_back(data.getNormal(i));
+                lod.uvs.push_back(data.getUV(i));
+            }
+
+            for (size_t i = 0; i < data.getFaceCount(); i++)
+            {
+                const glm::uvec3 face = data.getFace(i);
+                lod.indices.insert(lod.indices.end(), { face.x, face.y, face.z });
+            }
+        }
+
+        this->writeMesh(description);
+    }
+    else if (const Light* light = dynamic_cast<const Light*>(node.get()))
+    {
+        OVOLightDesc description;
+        description.name = light->getName();
+        description.matrix = light->getLocalMatrix();
+        description.children = numberOfChildren;
+        description.color = light->getDiffuseColor();
+
+        if (const DirectionalLight* directional = dynamic_cast<const DirectionalLight*>(light))
+        {
+            description.subtype = 1;
+            description.direction = directional->getDirection();
+        }
+        else if (const SpotLight* spot = dynamic_cast<const SpotLight*>(light))
+        {
+            description.subtype = 2;
+            description.radius = spot->getRadius();
+            description.direction = spot->getDirection();
+            description.cutoff = spot->getCutoff();
+            description.exponent = spot->getExponent();
+        }
+        else if (const PointLight* point = dynamic_cast<const PointLight*>(light))
+        {
+            description.subtype = 0;
+            description.radius = point->getRadius() * PointLight::RADIUS_SCALE;
+        }
+
+        this->writeLight(description);
+    }
+    else
+    {
+        this->writeNode(node->getName(), node->getLocalMatrix(), numberOfChildren);
+    }
+
+    for (const std::shared_ptr<Node>& child : children)
+        this->writeSceneNode(child, names);
+}
+
+void LIB_API OVOWriter::setMeshCompression(const bool enabled)
+{
+    this->_compressMeshes = enabled;
+}
+
+bool LIB_API OVOWriter::isMeshCompressionEnabled() const
+{
+    return this->_compressMeshes;
+}
+
+void LIB_API OVOWriter::setMeshOptimization(const bool enabled)
+{
+    this->_optimizeMeshes = enabled;
+}
+
+bool LIB_API OVOWriter::isMeshOptimizationEnabled() const
+{
+    return this->_optimizeMeshes;
+}
+
+uint64_t LIB_API OVOWriter::getBytesWritten() const
+{
+    return this->_bytesWritten;
+}
+
+uint32_t LIB_API OVOWriter::getChunkCount() const
+{
+    return this->_chunkCount;
+}
+
+/**
+ * @brief Scrive l'intestazione (tipo e dimensione) e i dati del chunk in preparazione.
+ */
+void OVOWriter::writeChunk(const uint32_t type)
+{
+    if (this->_file == nullptr)
+        return;
+
+    const uint32_t size = (uint32_t)this->_chunk.size();
+
+    if (fwrite(&type, sizeof(uint32_t), 1, this->_file) != 1 ||
+        fwrite(&size, sizeof(uint32_t), 1, this->_file) != 1 ||
+        (size > 0 && fwrite(this->_chunk.data(), 1, size, this->_file) != size))
+    {
+        if (!this->_failed)
+            ERROR("Failed to write OVO chunk " << type << ".");
+        this->_failed = true;
+        return;
+    }
+
+    this->_bytesWritten += 2 * sizeof(uint32_t) + size;
+    this->_chunkCount++;
+}
+
+void OVOWriter::put(const void* data, const size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    this->_chunk.insert(this->_chunk.end(), bytes, bytes + size);
+}
+
+void OVOWriter::putString(const std::string& string)
+{
+    // La stringa viene scritta con il terminatore null, come la legge OVOParser::parseString.
+    this->put(string.c_str(), string.size() + 1);
+}
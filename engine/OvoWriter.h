@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Common.h"
+
+class Material;
+class Node;
+
+/**
+ * @file OvoWriter.h
+ * @brief Dichiarazione della scrittura di file OVO.
+ */
+
+ /**
+  * @brief Un materiale da scrivere in un chunk OVO (tipo 9).
+  */
+struct LIB_API OVOMaterialDesc
+{
+    std::string name;                       ///< Nome con cui le mesh fanno riferimento al materiale.
+    glm::vec3 emission = glm::vec3(0.0f);   ///< Colore di emissione.
+    glm::vec3 albedo = glm::vec3(0.8f);     ///< Colore albedo.
+    float roughness = 0.5f;                 ///< Rugosita' (0: speculare, 1: opaco).
+    float metalness = 0.0f;                 ///< Metallicita' (ignorata dal parser).
+    float alpha = 1.0f;                     ///< Opacita'.
+    std::string texture = "[none]";         ///< Percorso della texture diffusa.
+};
+
+/**
+ * @brief Una luce da scrivere in un chunk OVO (tipo 16).
+ */
+struct LIB_API OVOLightDesc
+{
+    std::string name;                                   ///< Nome della luce.
+    glm::mat4 matrix = glm::mat4(1.0f);                 ///< Matrice rispetto al padre.
+    uint32_t children = 0;                              ///< Figli scritti dopo la luce.
+    uint8_t subtype = 0;                                ///< 0: point, 1: directional, 2: spot.
+    glm::vec3 color = glm::vec3(1.0f);                  ///< Colore.
+    float radius = 250.0f;                              ///< Raggio di influenza.
+    glm::vec3 direction = glm::vec3(0.0f, -1.0f, 0.0f); ///< Direzione (directional e spot).
+    float cutoff = 45.0f;                               ///< Angolo di apertura (spot).
+    float exponent = 1.0f;                              ///< Esponente (spot).
+};
+
+/**
+ * @brief Un livello di dettaglio di una mesh: attributi per vertice e tre indici per triangolo.
+ */
+struct LIB_API OVOMeshLod
+{
+    std::vector<glm::vec3> positions;   ///< Posizioni dei vertici.
+    std::vector<glm::vec3> normals;     ///< Normali (stessa lunghezza delle posizioni).
+    std::vector<glm::vec2> uvs;         ///< Coordinate UV (stessa lunghezza delle posizioni).
+    std::vector<uint32_t> indices;      ///< Indici dei triangoli.
+};
+
+/**
+ * @brief Una mesh da scrivere in un chunk OVO (tipo 18).
+ */
+struct LIB_API OVOMeshDesc
+{
+    std::string name;                       ///< Nome della mesh.
+    glm::mat4 matrix = glm::mat4(1.0f);     ///< Matrice rispetto al padre.
+    uint32_t children = 0;                  ///< Figli scritti dopo la mesh.
+    std::string material = "[none]";        ///< Nome di un materiale gia' scritto.
+    std::vector<OVOMeshLod> lods;           ///< Livelli di dettaglio, dal piu' dettagliato.
+};
+
+/**
+ * @class OVOWriter
+ * @brief Scrive un file OVO un chunk alla volta, negli stessi formati letti da `OVOParser`.
+ *
+ * I nodi vanno scritti in profondita', ognuno seguito dai suoi `children` figli, come li
+ * ricostruisce il parser; i materiali vanno scritti prima delle mesh che li usano.
+ * Le normali vengono compresse in snorm 10-10-10-2 e le coordinate UV in due half float,
+ * i campi ignorati dal parser (fisica, tangenti, mappe) vengono scritti vuoti.
+ *
+ * Con `setMeshCompression` le mesh vengono scritte nel chunk esteso `COMPRESSED_MESH_CHUNK`,
+ * letto solo da questo motore: l'intestazione e' quella del chunk 18, seguita da un byte di
+ * flag, dalle dimensioni dei dati decompressi e compressi e dai dati (`ChunkCompressor`).
+ * I dati decompressi contengono il numero di LOD e, per ognuno, il numero di vertici e di
+ * facce, la dimensione degli indici (2 o 4 byte), i vertici nel formato di `PackedVertex`
+ * e gli indici, entrambi riordinati con `ChunkCompressor::shuffle`. I vertici sono gia' nel
+ * formato usato per il rendering e, se ottimizzati qui, il parser non li ottimizza di nuovo.
+ */
+class LIB_API OVOWriter
+{
+public:
+
+    /// Versione scritta nel primo chunk del file.
+    static constexpr uint32_t VERSION = 8;
+
+    /// Tipo del chunk esteso con una mesh compressa.
+    static constexpr uint32_t COMPRESSED_MESH_CHUNK = 100;
+
+    /// Flag del chunk compresso: vertici e indici gia' ottimizzati con `MeshOptimizer`.
+    static constexpr uint8_t COMPRESSED_MESH_OPTIMIZED = 1;
+
+    /// Flag del chunk compresso: dati salvati senza compressione perche' non si riducevano.
+    static constexpr uint8_t COMPRESSED_MESH_STORED = 2;
+
+    OVOWriter() = default;
+    ~OVOWriter();
+
+    OVOWriter(const OVOWriter&) = delete;
+    OVOWriter& operator=(const OVOWriter&) = delete;
+
+    /**
+     * @brief Crea il file e scrive il chunk della versione.
+     * @param filePath Il percorso del file.
+     * @return `false` se il file non puo' essere creato.
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * @brief Chiude il file.
+     * @return `false` se una scrittura e' fallita.
+     */
+    bool close();
+
+    /**
+     * @brief Verifica se il file e' aperto.
+     * @return `true` se `open` e' riuscita e `close` non e' ancora stata chiamata.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Scrive un nodo senza geometria (chunk 1).
+     * @param name Il nome del nodo.
+     * @param matrix La matrice rispetto al padre.
+     * @param children Il numero di figli che verranno scritti dopo il nodo.
+     */
+    void writeNode(const std::string& name, const glm::mat4& matrix, const uint32_t children);
+
+    /**
+     * @brief Scrive un materiale (chunk 9).
+     * @param material Il materiale.
+     */
+    void writeMaterial(const OVOMaterialDesc& material);
+
+    /**
+     * @brief Scrive una luce (chunk 16).
+     * @param light La luce.
+     */
+    void writeLight(const OVOLightDesc& light);
+
+    /**
+     * @brief Scrive una mesh con tutti i suoi livelli di dettaglio (chunk 18).
+     * @param mesh La mesh.
+     */
+    void writeMesh(const OVOMeshDesc& mesh);
+
+    /**
+     * @brief Scrive un grafo di scena: prima i materiali usati dalle mesh, poi i nodi in profondita'.
+     *
+     * `root` diventa il nodo radice del file (per una scena letta con `OVOParser::fromFile`
+     * va passato il figlio della radice restituita). Mesh, luci direzionali, spot e puntiformi
+     * vengono scritte con i loro dati, gli altri nodi come nodi semplici; le matrici sono le
+     * matrici locali correnti. I materiali con lo stesso nome ricevono un suffisso numerico.
+     *
+     * @param root Il nodo radice.
+     * @return `false` se il file non e' aperto o una scrittura e' fallita.
+     */
+    bool writeScene(const std::shared_ptr<Node>& root);
+
+    /**
+     * @brief Abilita o disabilita la scrittura delle mesh nel chunk compresso.
+     * @param enabled `true` per il chunk `COMPRESSED_MESH_CHUNK`, `false` (default) per il chunk 18.
+     */
+    void setMeshCompression(const bool enabled);
+
+    /**
+     * @brief Verifica se le mesh vengono scritte nel chunk compresso.
+     * @return `true` se abilitato.
+     */
+    bool isMeshCompressionEnabled() const;
+
+    /**
+     * @brief Abilita o disabilita l'ottimizzazione delle mesh scritte nel chunk compresso.
+     *
+     * Con l'ottimizzazione attiva (default) i vertici duplicati vengono uniti e vertici e
+     * triangoli riordinati (`MeshOptimizer`) prima della compressione, una volta sola invece
+     * che a ogni caricamento.
+     *
+     * @param enabled `true` per abilitare l'ottimizzazione.
+     */
+    void setMeshOptimization(const bool enabled);
+
+    /**
+     * @brief Verifica se le mesh compresse vengono ottimizzate.
+     * @return `true` se abilitata.
+     */
+    bool isMeshOptimizationEnabled() const;
+
+    /**
+     * @brief Restituisce i byte scritti finora.
+     * @return I byte del file, intestazioni dei chunk comprese.
+     */
+    uint64_t getBytesWritten() const;
+
+    /**
+     * @brief Restituisce il numero di chunk scritti finora.
+     * @return I chunk scritti, versione compresa.
+     */
+    uint32_t getChunkCount() const;
+
+private:
+    void writeChunk(const uint32_t type);
+    void putMeshHeader(const OVOMeshDesc& mesh);
+    void writeCompressedMesh(const OVOMeshDesc& mesh);
+    void writeSceneMaterials(const std::shared_ptr<Node>& node, std::unordered_map<const Material*, std::string>& names, std::unordered_set<std::string>& used);
+    void writeSceneNode(const std::shared_ptr<Node>& node, const std::unordered_map<const Material*, std::string>& names);
+    void put(const void* data, const size_t size);
+    void putString(const std::string& string);
+
+    template<typename T>
+    void put(const T& value)
+    {
+        this->put(&value, sizeof(T));
+    }
+
+    FILE* _file = nullptr;              ///< File in scrittura.
+    bool _failed = false;               ///< Una scrittura e' fallita.
+    std::vector<uint8_t> _chunk;        ///< Dati del chunk in preparazione, riutilizzati.
+    uint64_t _bytesWritten = 0;         ///< Byte scritti.
+    uint32_t _chunkCount = 0;           ///< Chunk scritti.
+    bool _compressMeshes = false;       ///< Mesh scritte nel chunk compresso.
+    bool _optimizeMeshes = true;        ///< Mesh compresse ottimizzate prima della scrittura.
+    std::vector<uint8_t> _payload;      ///< Dati di una mesh compressa prima della compressione, riutilizzati.
+    std::vector<uint8_t> _compressed;   ///< Dati compressi di una mesh, riutilizzati.
+};
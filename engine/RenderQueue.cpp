@@ -0,0 +1,281 @@
+#include "RenderQueue.h"
+#include "Light.h"
+#include "Mesh.h"
+
+#include <GL/freeglut.h>
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief Costruisce la coda a partire dalla lista di rendering del frame.
+ *
+ * Le camere e le luci ricevono solo il passo (dalla priorita' del nodo), cosi' da essere
+ * renderizzate prima delle mesh e nell'ordine di visita. Le mesh vengono raggruppate per
+ * texture e materiale e, a parita' di stato, ordinate dalla piu' vicina alla piu' lontana.
+ */
+void LIB_API RenderQueue::build(const std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& listRendering, const glm::mat4& inverseCameraMatrix)
+{
+    this->clear();
+    this->_items.reserve(listRendering.size());
+    this->_keys.reserve(listRendering.size());
+
+    for (const auto& entry : listRendering)
+    {
+        const Mesh* mesh = dynamic_cast<const Mesh*>(entry.first.get());
+        const MaterialState* material = mesh != nullptr && mesh->getMaterial() != nullptr ? &mesh->getMaterial()->getState() : nullptr;
+        const MaterialOverride* override = material != nullptr && mesh->getMaterialOverride().isActive() ? &mesh->getMaterialOverride() : nullptr;
+
+        this->add(entry.first.get(), entry.second, material, override, nullptr, inverseCameraMatrix);
+    }
+}
+
+/**
+ * @brief Costruisce la coda a partire da un'istantanea della scena.
+ *
+ * I materiali e i parametri delle luci sono le copie dell'istantanea: il rendering non legge
+ * mesh e luci, che il thread di simulazione puo' modificare nel frattempo.
+ */
+void LIB_API RenderQueue::build(const SceneSnapshot& snapshot)
+{
+    this->clear();
+    this->_items.reserve(snapshot.items.size());
+    this->_keys.reserve(snapshot.items.size());
+
+    for (const SnapshotItem& item : snapshot.items)
+        this->add(item.node.get(), item.worldMatrix, item.hasMaterial ? &item.material : nullptr,
+            item.hasMaterial && item.override.isActive() ? &item.override : nullptr, item.hasLight ? &item.light : nullptr, snapshot.inverseCameraMatrix);
+}
+
+void RenderQueue::add(Node* node, const glm::mat4& worldMatrix, const MaterialState* material, const MaterialOverride* override, const LightData* light, const glm::mat4& inverseCameraMatrix)
+{
+    // Priorita' piu' alta -> passo piu' basso -> renderizzato prima.
+    const uint32_t pass = 15u - (uint32_t)std::clamp(node->getPriority(), 0, 15);
+
+    uint32_t state = 0;
+    uint32_t texture = 0;
+    uint32_t materialKey = 0;
+    uint32_t depth = 0;
+
+    if (material != nullptr)
+    {
+        // Profondita' in spazio vista: la camera guarda lungo -Z.
+        const glm::vec4 viewPosition = inverseCameraMatrix * worldMatrix[3];
+
+        // Le mesh trasparenti vengono ordinate solo per profondita', dalla piu' lontana.
+        const float alpha = material->alpha * (override != nullptr ? override->alpha : 1.0f);
+        if (alpha < 1.0f)
+        {
+            this->_transparentKeys.emplace_back(RenderQueue::backToFrontKey(-viewPosition.z), (uint32_t)this->_transparent.size());
+            this->_transparent.push_back({ this->_transparentKeys.back().first, node, worldMatrix, material, override, light });
+            return;
+        }
+
+        state = material->texture != nullptr ? 1u : 0u;
+        texture = material->texture != nullptr ? material->texture->getTextureId() : 0u;
+
+        // La versione e' unica per materiale: raggruppa le mesh che condividono i parametri.
+        materialKey = material->version;
+
+        depth = RenderQueue::quantizeDepth(-viewPosition.z);
+    }
+
+    this->_keys.emplace_back(RenderQueue::makeKey(pass, state, texture, materialKey, depth), (uint32_t)this->_items.size());
+    this->_items.push_back({ this->_keys.back().first, node, worldMatrix, material, override, light });
+}
+
+/**
+ * @brief Ordina gli elementi per chiave crescente.
+ */
+void LIB_API RenderQueue::sort()
+{
+    std::sort(this->_keys.begin(), this->_keys.end());
+
+    this->_scratch.clear();
+    this->_scratch.reserve(this->_items.size());
+
+    for (const auto& key : this->_keys)
+        this->_scratch.push_back(this->_items[key.second]);
+
+    this->_items.swap(this->_scratch);
+
+    for (uint32_t i = 0; i < (uint32_t)this->_keys.size(); i++)
+        this->_keys[i].second = i;
+
+    this->sortTransparent();
+}
+
+/**
+ * @brief Ordina gli elementi trasparenti con un radix sort LSD a 8 bit sulle chiavi di profondita'.
+ *
+ * Quattro passaggi di conteggio e distribuzione, stabili; i byte uguali in tutte
+ * le chiavi vengono saltati.
+ */
+void RenderQueue::sortTransparent()
+{
+    const size_t count = this->_transparentKeys.size();
+    if (count < 2)
+        return;
+
+    this->_radixScratch.resize(count);
+
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        size_t histogram[256] = {};
+
+        for (const auto& key : this->_transparentKeys)
+            histogram[(key.first >> shift) & 0xFFu]++;
+
+        // Tutte le chiavi hanno lo stesso byte: il passaggio non cambierebbe l'ordine.
+        if (histogram[(this->_transparentKeys[0].first >> shift) & 0xFFu] == count)
+            continue;
+
+        size_t offset = 0;
+        for (size_t& bucket : histogram)
+        {
+            const size_t size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+
+        for (const auto& key : this->_transparentKeys)
+            this->_radixScratch[histogram[(key.first >> shift) & 0xFFu]++] = key;
+
+        this->_transparentKeys.swap(this->_radixScratch);
+    }
+
+    this->_scratch.clear();
+    this->_scratch.reserve(count);
+
+    for (const auto& key : this->_transparentKeys)
+        this->_scratch.push_back(this->_transparent[key.second]);
+
+    this->_transparent.swap(this->_scratch);
+
+    for (uint32_t i = 0; i < (uint32_t)count; i++)
+        this->_transparentKeys[i].second = i;
+}
+
+/**
+ * @brief Renderizza gli elementi nell'ordine della coda.
+ */
+void LIB_API RenderQueue::render(const glm::mat4& inverseCameraMatrix) const
+{
+    for (const auto& item : this->_items)
+    {
+        // Solo le mesh hanno un materiale.
+        if (item.material != nullptr)
+            static_cast<const Mesh*>(item.node)->render(inverseCameraMatrix * item.worldMatrix, *item.material, item.override);
+        else if (item.light != nullptr)
+            static_cast<const Light*>(item.node)->render(inverseCameraMatrix * item.worldMatrix, *item.light);
+        else
+            item.node->render(inverseCameraMatrix * item.worldMatrix);
+    }
+}
+
+/**
+ * @brief Renderizza gli elementi trasparenti.
+ *
+ * Il blending combina ogni mesh con quanto gia' disegnato dietro di essa; la profondita'
+ * viene ancora verificata ma non scritta, cosi' una superficie trasparente non nasconde
+ * quelle disegnate dopo.
+ */
+void LIB_API RenderQueue::renderTransparent(const glm::mat4& inverseCameraMatrix) const
+{
+    if (this->_transparent.empty())
+        return;
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+
+    for (const auto& item : this->_transparent)
+        static_cast<const Mesh*>(item.node)->render(inverseCameraMatrix * item.worldMatrix, *item.material, item.override);
+
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+}
+
+void LIB_API RenderQueue::retain(const std::vector<uint8_t>& keep)
+{
+    size_t kept = 0;
+
+    for (size_t i = 0; i < this->_items.size(); i++)
+    {
+        if (i < keep.size() && keep[i] == 0)
+        {
+            this->_culled.push_back(this->_items[i]);
+            continue;
+        }
+
+        if (kept != i)
+            this->_items[kept] = this->_items[i];
+        kept++;
+    }
+
+    this->_items.resize(kept);
+}
+
+void LIB_API RenderQueue::clear()
+{
+    this->_items.clear();
+    this->_keys.clear();
+    this->_transparent.clear();
+    this->_transparentKeys.clear();
+    this->_culled.clear();
+}
+
+const std::vector<RenderItem>& LIB_API RenderQueue::getItems() const
+{
+    return this->_items;
+}
+
+const std::vector<RenderItem>& LIB_API RenderQueue::getTransparentItems() const
+{
+    return this->_transparent;
+}
+
+const std::vector<RenderItem>& LIB_API RenderQueue::getCulledItems() const
+{
+    return this->_culled;
+}
+
+/**
+ * @brief Compone una chiave di ordinamento: pass(4) | stato(4) | texture(16) | materiale(16) | profondita'(24).
+ */
+uint64_t LIB_API RenderQueue::makeKey(const uint32_t pass, const uint32_t state, const uint32_t texture, const uint32_t material, const uint32_t depth)
+{
+    return ((uint64_t)(pass & 0xFu) << 60)
+        | ((uint64_t)(state & 0xFu) << 56)
+        | ((uint64_t)(texture & 0xFFFFu) << 40)
+        | ((uint64_t)(material & 0xFFFFu) << 24)
+        | (uint64_t)(depth & 0xFFFFFFu);
+}
+
+/**
+ * @brief Quantizza una profondita' di vista in 24 bit.
+ *
+ * Per i float positivi la rappresentazione binaria e' monotona: gli 8 bit meno
+ * significativi della mantissa vengono scartati, senza bisogno di conoscere i piani di clipping.
+ */
+uint32_t LIB_API RenderQueue::quantizeDepth(const float depth)
+{
+    const float clamped = depth > 0.0f ? depth : 0.0f;
+    uint32_t bits;
+    std::memcpy(&bits, &clamped, sizeof(bits));
+    return bits >> 8;
+}
+
+/**
+ * @brief Converte una profondita' in una chiave decrescente con la distanza.
+ *
+ * I bit del float vengono resi monotoni anche per i valori negativi (segno invertito
+ * per i positivi, tutti i bit invertiti per i negativi) e poi complementati, cosi' che
+ * l'ordine crescente delle chiavi vada dal piu' lontano al piu' vicino.
+ */
+uint32_t LIB_API RenderQueue::backToFrontKey(const float depth)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    const uint32_t ordered = (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+    return ~ordered;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Node.h"
+#include "SceneSnapshot.h"
+#include "Common.h"
+
+/**
+ * @file RenderQueue.h
+ * @brief Dichiarazione della coda di rendering ordinata per stato.
+ */
+
+ /**
+  * @struct RenderItem
+  * @brief Elemento della coda di rendering: nodo, matrice globale e chiave di ordinamento.
+  */
+struct LIB_API RenderItem
+{
+    uint64_t key;           ///< Chiave di ordinamento a 64 bit.
+    Node* node;             ///< Nodo da renderizzare (mantenuto vivo dalla lista del frame).
+    glm::mat4 worldMatrix;  ///< Matrice di trasformazione globale del nodo.
+    const MaterialState* material; ///< Materiale da applicare se il nodo e' una mesh, altrimenti `nullptr`.
+    const MaterialOverride* override; ///< Modifiche della mesh al materiale, `nullptr` se nessuna.
+    const LightData* light; ///< Parametri copiati di una luce dell'istantanea, `nullptr` per leggerli dal nodo.
+};
+
+/**
+ * @class RenderQueue
+ * @brief Coda di rendering che ordina gli elementi per minimizzare i cambi di stato OpenGL.
+ *
+ * Ogni elemento riceve una chiave a 64 bit composta, dal bit piu' significativo, da:
+ * - pass (4 bit): camere, poi luci, poi mesh (derivato dalla priorita' del nodo);
+ * - stato (4 bit): mesh con o senza texture;
+ * - texture (16 bit): id OpenGL della texture;
+ * - materiale (16 bit): versione del materiale (unica per materiale);
+ * - profondita' (24 bit): distanza dalla camera, dal piu' vicino al piu' lontano.
+ *
+ * In questo modo le mesh che condividono texture e materiale vengono disegnate consecutivamente
+ * e `Material::render` puo' saltare le chiamate ridondanti.
+ *
+ * Le mesh con alpha minore di 1 (materiale per override) finiscono in una coda separata,
+ * ordinata dalla piu' lontana alla piu' vicina con un radix sort sulla profondita' di vista
+ * e disegnata da `renderTransparent` dopo quella opaca.
+ */
+class LIB_API RenderQueue
+{
+public:
+
+    /**
+     * @brief Costruisce la coda a partire dalla lista di rendering del frame.
+     * @param listRendering I nodi con le rispettive matrici globali (vedi `List::pass`).
+     * @param inverseCameraMatrix La matrice inversa della camera attiva.
+     */
+    void build(const std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& listRendering, const glm::mat4& inverseCameraMatrix);
+
+    /**
+     * @brief Costruisce la coda a partire da un'istantanea pubblicata dal thread di simulazione.
+     * @param snapshot L'istantanea, che deve restare valida fino al rendering della coda.
+     */
+    void build(const SceneSnapshot& snapshot);
+
+    /**
+     * @brief Ordina gli elementi per chiave crescente e quelli trasparenti dal piu' lontano.
+     *
+     * Vengono ordinate solo le coppie (chiave, indice), piu' leggere degli elementi;
+     * gli elementi sono poi riposizionati con un unico passaggio. A parita' di chiave
+     * l'indice mantiene l'ordine di visita del grafo. Gli elementi trasparenti sono ordinati
+     * con un radix sort in tempo lineare.
+     */
+    void sort();
+
+    /**
+     * @brief Renderizza gli elementi opachi nell'ordine della coda.
+     * @param inverseCameraMatrix La matrice inversa della camera attiva.
+     */
+    void render(const glm::mat4& inverseCameraMatrix) const;
+
+    /**
+     * @brief Renderizza gli elementi trasparenti con il blending attivo e senza scrivere la profondita'.
+     *
+     * Va chiamata dopo `render` e dopo gli altri elementi opachi del frame.
+     *
+     * @param inverseCameraMatrix La matrice inversa della camera attiva.
+     */
+    void renderTransparent(const glm::mat4& inverseCameraMatrix) const;
+
+    /**
+     * @brief Rimuove gli elementi scartati mantenendo l'ordine degli altri.
+     *
+     * Gli elementi rimossi non vengono disegnati ma restano disponibili in `getCulledItems`:
+     * una mesh nascosta puo' comunque proiettare un'ombra visibile.
+     *
+     * @param keep Un valore per elemento, nell'ordine di `getItems`: 0 rimuove l'elemento.
+     */
+    void retain(const std::vector<uint8_t>& keep);
+
+    /**
+     * @brief Svuota la coda mantenendo la memoria allocata.
+     */
+    void clear();
+
+    /**
+     * @brief Restituisce gli elementi opachi nell'ordine corrente.
+     * @return Un riferimento costante agli elementi della coda.
+     */
+    const std::vector<RenderItem>& getItems() const;
+
+    /**
+     * @brief Restituisce gli elementi trasparenti nell'ordine corrente.
+     * @return Un riferimento costante agli elementi trasparenti.
+     */
+    const std::vector<RenderItem>& getTransparentItems() const;
+
+    /**
+     * @brief Restituisce gli elementi opachi rimossi da `retain` nel frame corrente.
+     * @return Un riferimento costante agli elementi scartati.
+     */
+    const std::vector<RenderItem>& getCulledItems() const;
+
+    /**
+     * @brief Compone una chiave di ordinamento.
+     * @param pass Il passo di rendering (0-15).
+     * @param state Lo stato di rendering (0-15).
+     * @param texture L'id della texture (troncato a 16 bit).
+     * @param material La versione del materiale (troncata a 16 bit).
+     * @param depth La profondita' quantizzata (troncata a 24 bit).
+     * @return La chiave a 64 bit.
+     */
+    static uint64_t makeKey(const uint32_t pass, const uint32_t state, const uint32_t texture, const uint32_t material, const uint32_t depth);
+
+    /**
+     * @brief Quantizza una profondita' di vista in 24 bit mantenendone l'ordine.
+     * @param depth La distanza dalla camera (i valori negativi vengono portati a zero).
+     * @return La profondita' quantizzata.
+     */
+    static uint32_t quantizeDepth(const float depth);
+
+    /**
+     * @brief Converte una profondita' di vista in una chiave che ordina dal piu' lontano al piu' vicino.
+     * @param depth La distanza dalla camera (anche negativa).
+     * @return La chiave a 32 bit, crescente al diminuire della profondita'.
+     */
+    static uint32_t backToFrontKey(const float depth);
+
+private:
+    void add(Node* node, const glm::mat4& worldMatrix, const MaterialState* material, const MaterialOverride* override, const LightData* light, const glm::mat4& inverseCameraMatrix);
+
+    void sortTransparent();
+
+    std::vector<RenderItem> _items;                   ///< Elementi della coda, riutilizzati tra i frame.
+    std::vector<RenderItem> _scratch;                 ///< Buffer di appoggio per il riordino degli elementi.
+    std::vector<std::pair<uint64_t, uint32_t>> _keys; ///< Coppie (chiave, indice) ordinate al posto degli elementi.
+    std::vector<RenderItem> _transparent;             ///< Elementi trasparenti, riutilizzati tra i frame.
+    std::vector<RenderItem> _culled;                  ///< Elementi rimossi da `retain`, riutilizzati tra i frame.
+    std::vector<std::pair<uint32_t, uint32_t>> _transparentKeys; ///< Coppie (chiave, indice) degli elementi trasparenti.
+    std::vector<std::pair<uint32_t, uint32_t>> _radixScratch;    ///< Buffer di appoggio del radix sort.
+};
@@ -0,0 +1,63 @@
+#include "SceneArena.h"
+
+/**
+ * @brief Alloca memoria dall'arena.
+ */
+void* LIB_API SceneArena::allocate(const size_t size, const size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_usedBytes += size;
+
+    // Le richieste grandi ricevono un blocco dedicato, senza sprecare il blocco corrente.
+    if (size + alignment > SceneArena::CHUNK_SIZE / 4)
+    {
+        this->_chunks.emplace_back(new uint8_t[size + alignment]);
+        this->_reservedBytes += size + alignment;
+
+        const uintptr_t address = (uintptr_t)this->_chunks.back().get();
+        return (void*)((address + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    }
+
+    uintptr_t address = ((uintptr_t)this->_cursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+    if (this->_cursor == nullptr || address + size > (uintptr_t)this->_end)
+    {
+        this->_chunks.emplace_back(new uint8_t[SceneArena::CHUNK_SIZE]);
+        this->_reservedBytes += SceneArena::CHUNK_SIZE;
+        this->_cursor = this->_chunks.back().get();
+        this->_end = this->_cursor + SceneArena::CHUNK_SIZE;
+
+        address = ((uintptr_t)this->_cursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+
+    this->_cursor = (uint8_t*)(address + size);
+    return (void*)address;
+}
+
+/**
+ * @brief Segnala che un'allocazione non e' piu' usata.
+ *
+ * Puo' essere chiamato da qualunque thread rilasci l'ultimo riferimento a un oggetto.
+ */
+void LIB_API SceneArena::deallocate(const size_t size)
+{
+    this->_usedBytes -= size;
+}
+
+size_t LIB_API SceneArena::getUsedBytes() const
+{
+    return this->_usedBytes;
+}
+
+size_t LIB_API SceneArena::getReservedBytes() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_reservedBytes;
+}
+
+size_t LIB_API SceneArena::getChunkCount() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_chunks.size();
+}
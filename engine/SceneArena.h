@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Common.h"
+
+/**
+ * @file SceneArena.h
+ * @brief Dichiarazione dell'arena di memoria per gli oggetti di una scena.
+ */
+
+ /**
+  * @class SceneArena
+  * @brief Arena a blocchi contigui da cui vengono allocati gli oggetti di una scena caricata.
+  *
+  * Le allocazioni avanzano un puntatore dentro blocchi da `CHUNK_SIZE` byte: oggetti creati
+  * uno dopo l'altro (ad esempio nodi, mesh e materiali letti da un file OVO) restano vicini
+  * in memoria. La deallocazione di un singolo oggetto non restituisce memoria: tutti i blocchi
+  * vengono liberati insieme quando l'arena viene distrutta.
+  *
+  * L'arena va creata con `std::make_shared`: ogni oggetto allocato con `make` ne conserva un
+  * riferimento tramite `ArenaAllocator`, quindi l'arena vive finche' esiste almeno un oggetto.
+  */
+class LIB_API SceneArena
+{
+public:
+
+    static constexpr size_t CHUNK_SIZE = 64 * 1024; ///< Dimensione di un blocco.
+
+    SceneArena() = default;
+    SceneArena(const SceneArena&) = delete;
+    SceneArena& operator=(const SceneArena&) = delete;
+
+    /**
+     * @brief Alloca memoria dall'arena.
+     *
+     * Le richieste piu' grandi di un quarto di blocco ricevono un blocco dedicato.
+     *
+     * @param size La dimensione in byte.
+     * @param alignment L'allineamento richiesto.
+     * @return Il puntatore alla memoria.
+     */
+    void* allocate(const size_t size, const size_t alignment);
+
+    /**
+     * @brief Segnala che un'allocazione non e' piu' usata; la memoria resta all'arena.
+     * @param size La dimensione in byte.
+     */
+    void deallocate(const size_t size);
+
+    /**
+     * @brief Restituisce i byte assegnati agli oggetti e non ancora deallocati.
+     * @return I byte in uso.
+     */
+    size_t getUsedBytes() const;
+
+    /**
+     * @brief Restituisce i byte riservati dai blocchi.
+     * @return I byte riservati.
+     */
+    size_t getReservedBytes() const;
+
+    /**
+     * @brief Restituisce il numero di blocchi.
+     * @return Il numero di blocchi.
+     */
+    size_t getChunkCount() const;
+
+    /**
+     * @brief Crea un oggetto nell'arena, o con `std::make_shared` se l'arena e' nulla.
+     * @param arena L'arena, puo' essere `nullptr`.
+     * @param args Gli argomenti del costruttore.
+     * @return Il puntatore condiviso all'oggetto.
+     */
+    template <typename T, typename... Args>
+    static std::shared_ptr<T> make(const std::shared_ptr<SceneArena>& arena, Args&&... args);
+
+private:
+    mutable std::mutex _mutex;                      ///< Protegge i blocchi.
+    std::vector<std::unique_ptr<uint8_t[]>> _chunks; ///< Blocchi di memoria.
+    uint8_t* _cursor = nullptr;                     ///< Prossimo byte libero del blocco corrente.
+    uint8_t* _end = nullptr;                        ///< Fine del blocco corrente.
+    size_t _reservedBytes = 0;                      ///< Byte riservati dai blocchi.
+    std::atomic<size_t> _usedBytes{ 0 };            ///< Byte in uso.
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief Allocatore standard che prende memoria da una `SceneArena`.
+ *
+ * Usato con `std::allocate_shared`: blocco di controllo e oggetto vengono allocati insieme
+ * nell'arena, e l'allocatore copiato nel blocco di controllo mantiene viva l'arena.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<SceneArena> arena)
+        : _arena(std::move(arena))
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : _arena(other.getArena())
+    {
+    }
+
+    T* allocate(const size_t count)
+    {
+        return static_cast<T*>(this->_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, const size_t count)
+    {
+        this->_arena->deallocate(count * sizeof(T));
+    }
+
+    const std::shared_ptr<SceneArena>& getArena() const
+    {
+        return this->_arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const
+    {
+        return this->_arena == other.getArena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const
+    {
+        return this->_arena != other.getArena();
+    }
+
+private:
+    std::shared_ptr<SceneArena> _arena; ///< Arena da cui allocare.
+};
+
+template <typename T, typename... Args>
+std::shared_ptr<T> SceneArena::make(const std::shared_ptr<SceneArena>& arena, Args&&... args)
+{
+    if (arena == nullptr)
+        return std::make_shared<T>(std::forward<Args>(args)...);
+
+    return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+}
@@ -0,0 +1,263 @@
+#include "SceneGenerator.h"
+#include "OvoWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Lato di una scacchiera e di una sua casella.
+static constexpr float BOARD_SIZE = 8.0f;
+static constexpr float CELL_SIZE = BOARD_SIZE / 8.0f;
+
+// Dimensioni di un pezzo.
+static constexpr float PIECE_RADIUS = 0.35f;
+static constexpr float PIECE_HEIGHT = 0.8f;
+
+/**
+ * @brief Griglia quadrata nel piano XZ, centrata nell'origine, con `resolution` x `resolution` quadrati.
+ */
+static OVOMeshLod makeBoardLod(const uint32_t resolution)
+{
+    OVOMeshLod lod;
+    const uint32_t side = resolution + 1;
+
+    for (uint32_t z = 0; z < side; z++)
+        for (uint32_t x = 0; x < side; x++)
+        {
+            const glm::vec2 uv((float)x / resolution, (float)z / resolution);
+            lod.positions.push_back(glm::vec3((uv.x - 0.5f) * BOARD_SIZE, 0.0f, (uv.y - 0.5f) * BOARD_SIZE));
+            lod.normals.push_back(glm::vec3(0.0f, 1.0f, 0.0f));
+            lod.uvs.push_back(uv);
+        }
+
+    for (uint32_t z = 0; z < resolution; z++)
+        for (uint32_t x = 0; x < resolution; x++)
+        {
+            const uint32_t i = z * side + x;
+            lod.indices.insert(lod.indices.end(), { i, i + side, i + 1, i + 1, i + side, i + side + 1 });
+        }
+
+    return lod;
+}
+
+/**
+ * @brief Cilindro con base nell'origine: superficie laterale e coperchio, `segments` spicchi.
+ */
+static OVOMeshLod makePieceLod(const uint32_t segments)
+{
+    OVOMeshLod lod;
+    const float step = 2.0f * glm::pi<float>() / segments;
+
+    // Superficie laterale: una coppia di vertici (base, cima) per spicchio, il primo ripetuto per le UV.
+    for (uint32_t s = 0; s <= segments; s++)
+    {
+        const glm::vec3 normal(std::cos(s * step), 0.0f, std::sin(s * step));
+        const float u = (float)s / segments;
+
+        lod.positions.push_back(normal * PIECE_RADIUS);
+        lod.normals.push_back(normal);
+        lod.uvs.push_back(glm::vec2(u, 0.0f));
+
+        lod.positions.push_back(normal * PIECE_RADIUS + glm::vec3(0.0f, PIECE_HEIGHT, 0.0f));
+        lod.normals.push_back(normal);
+        lod.uvs.push_back(glm::vec2(u, 1.0f));
+    }
+
+    for (uint32_t s = 0; s < segments; s++)
+    {
+        const uint32_t i = s * 2;
+        lod.indices.insert(lod.indices.end(), { i, i + 1, i + 2, i + 2, i + 1, i + 3 });
+    }
+
+    // Coperchio: un ventaglio attorno al centro.
+    const uint32_t center = (uint32_t)lod.positions.size();
+    lod.positions.push_back(glm::vec3(0.0f, PIECE_HEIGHT, 0.0f));
+    lod.normals.push_back(glm::vec3(0.0f, 1.0f, 0.0f));
+    lod.uvs.push_back(glm::vec2(0.5f));
+
+    for (uint32_t s = 0; s < segments; s++)
+    {
+        const glm::vec2 direction(std::cos(s * step), std::sin(s * step));
+        lod.positions.push_back(glm::vec3(direction.x * PIECE_RADIUS, PIECE_HEIGHT, direction.y * PIECE_RADIUS));
+        lod.normals.push_back(glm::vec3(0.0f, 1.0f, 0.0f));
+        lod.uvs.push_back(direction * 0.5f + 0.5f);
+    }
+
+    for (uint32_t s = 0; s < segments; s++)
+        lod.indices.insert(lod.indices.end(), { center, center + 1 + (s + 1) % segments, center + 1 + s });
+
+    return lod;
+}
+
+/**
+ * @brief Casella di un pezzo: prima le due righe di ogni lato, come nella posizione iniziale.
+ */
+static uint32_t pieceCell(const uint32_t piece)
+{
+    if (piece < 16)
+        return piece;
+    if (piece < 32)
+        return 48 + (piece - 16);
+    return 16 + (piece - 32);
+}
+
+bool LIB_API SceneGenerator::generate(const std::string& filePath, const SceneGeneratorOptions& options, SceneGeneratorReport* report)
+{
+    OVOWriter writer;
+    if (!writer.open(filePath))
+        return false;
+
+    writer.setMeshCompression(options.compressMeshes);
+
+    SceneGeneratorReport result;
+    std::mt19937 random(options.seed);
+
+    // Valori in [0, 1) dai 24 bit alti del generatore: mt19937 produce la stessa sequenza su tutte le piattaforme.
+    const auto unit = [&random]()
+    {
+        return (float)(random() >> 8) * (1.0f / 16777216.0f);
+    };
+
+    // Estrae tre valori in ordine: l'ordine di valutazione degli argomenti non e' definito.
+    const auto randomVector = [&unit](const float minimum, const float maximum)
+    {
+        const float x = unit();
+        const float y = unit();
+        const float z = unit();
+        return glm::vec3(minimum) + glm::vec3(x, y, z) * (maximum - minimum);
+    };
+
+    const uint32_t pieces = std::min(options.piecesPerBoard, 64u);
+    const uint32_t resolution = std::max(options.meshResolution, 3u);
+    const uint32_t fanout = options.groupFanout;
+    const uint32_t columns = std::max(1u, (uint32_t)std::ceil(std::sqrt((double)options.boards)));
+
+    // La geometria e' la stessa per tutte le scacchiere e tutti i pezzi: cambiano nome, matrice e materiale.
+    OVOMeshDesc board;
+    OVOMeshDesc piece;
+    for (uint32_t l = 0; l < std::max(options.lods, 1u); l++)
+    {
+        board.lods.push_back(makeBoardLod(std::max(resolution >> l, 1u)));
+        piece.lods.push_back(makePieceLod(std::max(resolution >> l, 3u)));
+    }
+
+    const auto countGeometry = [&result](const OVOMeshDesc& mesh)
+    {
+        for (const OVOMeshLod& lod : mesh.lods)
+        {
+            result.vertices += lod.positions.size();
+            result.triangles += lod.indices.size() / 3;
+        }
+        result.meshes++;
+        result.nodes++;
+    };
+
+    // Materiali, prima delle mesh che li usano.
+    for (uint32_t i = 0; i < options.materials; i++)
+    {
+        OVOMaterialDesc material;
+        material.name = "material_" + std::to_string(i);
+        material.albedo = randomVector(0.0f, 1.0f);
+        material.roughness = 0.2f + 0.6f * unit();
+        if (i < options.textures)
+            material.texture = options.texturePrefix + std::to_string(i) + ".png";
+
+        writer.writeMaterial(material);
+        result.materials++;
+    }
+
+    const auto materialName = [&options](const uint32_t index) -> std::string
+    {
+        return options.materials > 0 ? "material_" + std::to_string(index % options.materials) : "[none]";
+    };
+
+    // Figli diretti di un nodo che raccoglie `count` scacchiere.
+    const auto childCount = [fanout](const uint32_t count) -> uint32_t
+    {
+        if (fanout < 2 || count <= fanout)
+            return count;
+        const uint32_t groupSize = (count + fanout - 1) / fanout;
+        return (count + groupSize - 1) / groupSize;
+    };
+
+    // Radice: le luci e le scacchiere (o i loro raggruppamenti).
+    writer.writeNode("[root]", glm::mat4(1.0f), options.lights + childCount(options.boards));
+    result.nodes++;
+
+    const float extent = columns * options.boardSpacing;
+    for (uint32_t i = 0; i < options.lights; i++)
+    {
+        OVOLightDesc light;
+        light.name = "light_" + std::to_string(i);
+        light.color = randomVector(0.6f, 1.0f);
+
+        // La prima luce illumina tutta la scena, le altre sono sparse sopra le scacchiere.
+        if (i == 0)
+        {
+            light.subtype = 1;
+            light.direction = glm::normalize(glm::vec3(-0.3f, -1.0f, -0.2f));
+        }
+        else
+        {
+            const glm::vec3 position = randomVector(0.0f, extent);
+            light.matrix = glm::translate(glm::mat4(1.0f), glm::vec3(position.x, 6.0f, position.z));
+        }
+
+        writer.writeLight(light);
+        result.lights++;
+        result.nodes++;
+    }
+
+    uint32_t groups = 0;
+    const std::function<void(uint32_t, uint32_t)> writeBoards = [&](const uint32_t first, const uint32_t count)
+    {
+        if (fanout >= 2 && count > fanout)
+        {
+            // Raggruppamenti di dimensione uguale (l'ultimo eventualmente piu' piccolo), scritti in profondita'.
+            const uint32_t groupSize = (count + fanout - 1) / fanout;
+            for (uint32_t start = 0; start < count; start += groupSize)
+            {
+                const uint32_t size = std::min(groupSize, count - start);
+                writer.writeNode("group_" + std::to_string(groups++), glm::mat4(1.0f), childCount(size));
+                result.nodes++;
+                writeBoards(first + start, size);
+            }
+            return;
+        }
+
+        for (uint32_t b = first; b < first + count; b++)
+        {
+            board.name = "board_" + std::to_string(b);
+            board.matrix = glm::translate(glm::mat4(1.0f), glm::vec3((b % columns) * options.boardSpacing, 0.0f, (b / columns) * options.boardSpacing));
+            board.children = pieces;
+            board.material = materialName(0);
+            writer.writeMesh(board);
+            countGeometry(board);
+
+            for (uint32_t p = 0; p < pieces; p++)
+            {
+                const uint32_t cell = pieceCell(p);
+                const glm::vec3 position(((cell % 8) - 3.5f) * CELL_SIZE, 0.0f, ((cell / 8) - 3.5f) * CELL_SIZE);
+
+                piece.name = board.name + "_piece_" + std::to_string(p);
+                piece.matrix = glm::rotate(glm::translate(glm::mat4(1.0f), position), unit() * glm::two_pi<float>(), glm::vec3(0.0f, 1.0f, 0.0f));
+                piece.material = materialName(b + p + 1);
+                writer.writeMesh(piece);
+                countGeometry(piece);
+            }
+        }
+    };
+    writeBoards(0, options.boards);
+
+    result.bytes = writer.getBytesWritten();
+    const bool written = writer.close();
+
+    if (report != nullptr)
+        *report = result;
+
+    return written;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Common.h"
+
+/**
+ * @file SceneGenerator.h
+ * @brief Dichiarazione della generazione di scene OVO sintetiche.
+ */
+
+ /**
+  * @brief Parametri di una scena sintetica.
+  */
+struct LIB_API SceneGeneratorOptions
+{
+    uint32_t boards = 100;          ///< Scacchiere nella scena.
+    uint32_t piecesPerBoard = 32;   ///< Pezzi per scacchiera (al massimo 64, uno per casella).
+    uint32_t groupFanout = 10;      ///< Figli per nodo di raggruppamento (0: scacchiere figlie della radice).
+    uint32_t meshResolution = 8;    ///< Suddivisioni della geometria di scacchiere e pezzi (almeno 3).
+    uint32_t lods = 1;              ///< Livelli di dettaglio per mesh, ognuno a meta' risoluzione del precedente.
+    uint32_t materials = 4;         ///< Materiali condivisi (0: nessun materiale).
+    uint32_t textures = 0;          ///< Materiali che fanno riferimento a una texture.
+    uint32_t lights = 4;            ///< Luci figlie della radice.
+    float boardSpacing = 12.0f;     ///< Distanza tra due scacchiere vicine.
+    uint32_t seed = 1;              ///< Seme dei colori e delle rotazioni casuali.
+    std::string texturePrefix = "generated_texture_"; ///< Le texture si chiamano prefisso + indice + ".png".
+    bool compressMeshes = false;    ///< Mesh scritte nel chunk compresso (vedi `OVOWriter::setMeshCompression`).
+};
+
+/**
+ * @brief Dimensioni di una scena generata.
+ */
+struct LIB_API SceneGeneratorReport
+{
+    uint32_t nodes = 0;         ///< Nodi scritti (mesh, luci e raggruppamenti compresi).
+    uint32_t meshes = 0;        ///< Mesh scritte.
+    uint32_t materials = 0;     ///< Materiali scritti.
+    uint32_t lights = 0;        ///< Luci scritte.
+    uint64_t vertices = 0;      ///< Vertici di tutti i livelli di dettaglio.
+    uint64_t triangles = 0;     ///< Triangoli di tutti i livelli di dettaglio.
+    uint64_t bytes = 0;         ///< Byte del file.
+};
+
+/**
+ * @class SceneGenerator
+ * @brief Genera scene grandi e ripetibili per misurare caricamento, memoria e frame time.
+ *
+ * La scena e' una radice con le luci e le scacchiere, raccolte in nodi di raggruppamento con
+ * al massimo `groupFanout` figli ciascuno. Ogni scacchiera e' una mesh a griglia con i pezzi
+ * come figli; i pezzi sono cilindri e usano i materiali a rotazione. Con gli stessi parametri
+ * (seme compreso) viene generata sempre la stessa scena.
+ */
+class LIB_API SceneGenerator
+{
+public:
+
+    /**
+     * @brief Scrive una scena sintetica in un file OVO (vedi `OVOWriter`).
+     * @param filePath Il percorso del file.
+     * @param options I parametri della scena.
+     * @param report Se non nullo, riceve le dimensioni della scena scritta.
+     * @return `false` se il file non puo' essere scritto.
+     */
+    static bool generate(const std::string& filePath, const SceneGeneratorOptions& options, SceneGeneratorReport* report = nullptr);
+};
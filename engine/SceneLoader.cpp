@@ -0,0 +1,283 @@
+#include "SceneLoader.h"
+#include "OvoParser.h"
+
+#include <algorithm>
+#include <chrono>
+
+std::mutex SceneLoader::registryMutex;
+std::vector<std::shared_ptr<SceneLoader>> SceneLoader::loaders;
+
+SceneLoader::SceneLoader(const std::string& path)
+    : _path{ path }, _state{ State::Loading }, _finished{ false }, _cancelled{ false }, _progress{ 0.0f }, _attached{ 0 }
+{
+    this->_root = std::make_shared<Node>();
+    this->_root->setName("Scene Root");
+}
+
+SceneLoader::~SceneLoader()
+{
+    this->_cancelled = true;
+
+    if (this->_thread.joinable())
+        this->_thread.join();
+}
+
+/**
+ * @brief Registra il caricamento e avvia il thread di lettura.
+ *
+ * Il registro mantiene vivo il caricamento finche' `attachReady` non ha aggiunto l'ultimo sottoalbero.
+ */
+void SceneLoader::start(const std::shared_ptr<SceneLoader>& self)
+{
+    {
+        std::lock_guard<std::mutex> lock(SceneLoader::registryMutex);
+        SceneLoader::loaders.push_back(self);
+    }
+
+    this->_thread = std::thread(&SceneLoader::run, this);
+}
+
+void SceneLoader::run()
+{
+    OVOParser::parse(this->_path, this->_root, this);
+    this->_finished = true;
+}
+
+const std::string& LIB_API SceneLoader::getPath() const
+{
+    return this->_path;
+}
+
+SceneLoader::State LIB_API SceneLoader::getState() const
+{
+    return this->_state;
+}
+
+bool LIB_API SceneLoader::isDone() const
+{
+    return this->_state != State::Loading;
+}
+
+float LIB_API SceneLoader::getProgress() const
+{
+    return this->_progress;
+}
+
+std::shared_ptr<Node> LIB_API SceneLoader::getRoot() const
+{
+    return this->_root;
+}
+
+std::string LIB_API SceneLoader::getError() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_error;
+}
+
+size_t LIB_API SceneLoader::getAttachedCount() const
+{
+    return this->_attached;
+}
+
+/**
+ * @brief Interrompe il caricamento.
+ *
+ * Il thread si ferma al chunk successivo; i lotti non ancora aggiunti vengono scartati.
+ */
+void LIB_API SceneLoader::cancel()
+{
+    this->_cancelled = true;
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_batches.clear();
+    this->_ready.clear();
+
+    State loading = State::Loading;
+    this->_state.compare_exchange_strong(loading, State::Cancelled);
+}
+
+bool SceneLoader::isCancelled() const
+{
+    return this->_cancelled;
+}
+
+void SceneLoader::setProgress(const float progress)
+{
+    this->_progress = progress;
+}
+
+void SceneLoader::fail(const std::string& error)
+{
+    ERROR(error);
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_error = error;
+
+    State loading = State::Loading;
+    this->_state.compare_exchange_strong(loading, State::Failed);
+}
+
+/**
+ * @brief Accoda un sottoalbero completo.
+ */
+void SceneLoader::emit(const std::shared_ptr<Node>& parent, const std::shared_ptr<Node>& node)
+{
+    Batch batch;
+    batch.parent = parent;
+    batch.node = node;
+
+    // Raccoglie le mesh del sottoalbero, i cui vertex buffer vengono creati prima di mostrarlo.
+    std::vector<std::shared_ptr<Node>> stack = { node };
+
+    while (!stack.empty())
+    {
+        const std::shared_ptr<Node> current = stack.back();
+        stack.pop_back();
+
+        if (std::shared_ptr<Mesh> mesh = std::dynamic_pointer_cast<Mesh>(current))
+            batch.meshes.push_back(mesh);
+
+        for (const std::shared_ptr<Node>& child : current->getChildren())
+            stack.push_back(child);
+    }
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (!this->_cancelled)
+        this->_batches.push_back(std::move(batch));
+}
+
+/**
+ * @brief Esegue un passo del primo lotto: i vertex buffer di una mesh o la consegna.
+ * @return `false` se non ci sono lotti.
+ */
+bool SceneLoader::uploadStep()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (this->_batches.empty())
+        return false;
+
+    Batch& batch = this->_batches.front();
+
+    if (batch.nextMesh < batch.meshes.size())
+    {
+        const std::shared_ptr<Mesh>& mesh = batch.meshes[batch.nextMesh++];
+
+        for (int lod = 0; lod < mesh->getLodCount(); lod++)
+            mesh->getMeshData(lod).upload();
+    }
+    else
+    {
+        this->_ready.emplace_back(batch.parent, batch.node);
+        this->_batches.pop_front();
+    }
+
+    return true;
+}
+
+/**
+ * @brief Aggiunge i sottoalberi pronti e aggiorna lo stato.
+ */
+size_t SceneLoader::attach()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    const size_t count = this->_ready.size();
+
+    for (const auto& ready : this->_ready)
+        ready.first->addChild(ready.second);
+
+    this->_ready.clear();
+    this->_attached += count;
+
+    if (this->_finished && this->_batches.empty())
+    {
+        State loading = State::Loading;
+        this->_state.compare_exchange_strong(loading, State::Completed);
+    }
+
+    return count;
+}
+
+bool LIB_API SceneLoader::hasPendingWork()
+{
+    std::lock_guard<std::mutex> lock(SceneLoader::registryMutex);
+    return !SceneLoader::loaders.empty();
+}
+
+/**
+ * @brief Crea le risorse OpenGL dei lotti pronti, un passo per caricamento alla volta.
+ */
+size_t LIB_API SceneLoader::upload(const double budgetMs)
+{
+    std::vector<std::shared_ptr<SceneLoader>> active;
+    {
+        std::lock_guard<std::mutex> lock(SceneLoader::registryMutex);
+        active = SceneLoader::loaders;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t steps = 0;
+    bool progress = true;
+
+    while (progress)
+    {
+        progress = false;
+
+        for (const std::shared_ptr<SceneLoader>& loader : active)
+        {
+            if (loader->uploadStep())
+            {
+                progress = true;
+                steps++;
+            }
+        }
+
+        const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed >= budgetMs)
+            break;
+    }
+
+    return steps;
+}
+
+/**
+ * @brief Aggiunge i sottoalberi pronti e rimuove dal registro i caricamenti terminati.
+ */
+size_t LIB_API SceneLoader::attachReady()
+{
+    std::vector<std::shared_ptr<SceneLoader>> active;
+    {
+        std::lock_guard<std::mutex> lock(SceneLoader::registryMutex);
+        active = SceneLoader::loaders;
+    }
+
+    size_t count = 0;
+
+    for (const std::shared_ptr<SceneLoader>& loader : active)
+        count += loader->attach();
+
+    std::lock_guard<std::mutex> lock(SceneLoader::registryMutex);
+    SceneLoader::loaders.erase(std::remove_if(SceneLoader::loaders.begin(), SceneLoader::loaders.end(),
+        [](const std::shared_ptr<SceneLoader>& loader) { return loader->isDone() && loader->_finished; }),
+        SceneLoader::loaders.end());
+
+    return count;
+}
+
+void LIB_API SceneLoader::cancelAll()
+{
+    std::vector<std::shared_ptr<SceneLoader>> active;
+    {
+        std::lock_guard<std::mutex> lock(SceneLoader::registryMutex);
+        active.swap(SceneLoader::loaders);
+    }
+
+    for (const std::shared_ptr<SceneLoader>& loader : active)
+    {
+        loader->cancel();
+
+        if (loader->_thread.joinable())
+            loader->_thread.join();
+    }
+}
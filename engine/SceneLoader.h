@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Mesh.h"
+#include "Node.h"
+#include "Common.h"
+
+/**
+ * @file SceneLoader.h
+ * @brief Dichiarazione del caricamento asincrono delle scene.
+ */
+
+ /**
+  * @class SceneLoader
+  * @brief Caricamento di un file OVO in background, restituito da `OVOParser::loadAsync`.
+  *
+  * Il file viene letto e analizzato su un thread dedicato; le texture arrivano separatamente
+  * da `TextureStreamer`. Ogni figlio diretto del nodo radice del file diventa un lotto quando il
+  * suo sottoalbero e' completo: sul thread del contesto `upload` crea i vertex buffer dei lotti
+  * entro un budget di tempo per frame, e `attachReady` aggiunge i sottoalberi pronti a `getRoot()`.
+  * La scena compare quindi un pezzo alla volta senza bloccare il rendering.
+  *
+  * `Engine::update` chiama `upload` e `attachReady` a ogni frame.
+  */
+class LIB_API SceneLoader
+{
+public:
+
+    /**
+     * @brief Lo stato del caricamento.
+     */
+    enum class State
+    {
+        Loading,   ///< Il file e' in lettura o ci sono sottoalberi non ancora aggiunti.
+        Completed, ///< Tutti i sottoalberi sono stati aggiunti a `getRoot()`.
+        Failed,    ///< Il file non e' stato letto; `getError` ne indica il motivo.
+        Cancelled  ///< Il caricamento e' stato interrotto con `cancel`.
+    };
+
+    SceneLoader(const SceneLoader&) = delete;
+    SceneLoader& operator=(const SceneLoader&) = delete;
+
+    /**
+     * @brief Interrompe il caricamento, se ancora in corso, e attende il thread.
+     */
+    ~SceneLoader();
+
+    /**
+     * @brief Restituisce il percorso del file.
+     * @return Il percorso passato a `OVOParser::loadAsync`.
+     */
+    const std::string& getPath() const;
+
+    /**
+     * @brief Restituisce lo stato del caricamento.
+     * @return Lo stato corrente.
+     */
+    State getState() const;
+
+    /**
+     * @brief Verifica se il caricamento e' terminato, con o senza successo.
+     * @return `true` se lo stato non e' piu' `Loading`.
+     */
+    bool isDone() const;
+
+    /**
+     * @brief Restituisce l'avanzamento della lettura del file.
+     * @return Un valore tra 0 e 1.
+     */
+    float getProgress() const;
+
+    /**
+     * @brief Restituisce la radice della scena, inizialmente vuota.
+     *
+     * La radice puo' essere aggiunta subito al grafo: i sottoalberi le vengono aggiunti
+     * da `attachReady` man mano che sono pronti.
+     *
+     * @return Il nodo radice ("Scene Root").
+     */
+    std::shared_ptr<Node> getRoot() const;
+
+    /**
+     * @brief Restituisce il motivo del fallimento.
+     * @return Il messaggio di errore, vuoto se il caricamento non e' fallito.
+     */
+    std::string getError() const;
+
+    /**
+     * @brief Restituisce il numero di sottoalberi gia' aggiunti alla radice.
+     * @return Il numero di sottoalberi.
+     */
+    size_t getAttachedCount() const;
+
+    /**
+     * @brief Interrompe il caricamento. I sottoalberi gia' aggiunti restano nella scena.
+     */
+    void cancel();
+
+    /**
+     * @brief Verifica se qualche caricamento ha ancora lavoro per il thread del contesto.
+     * @return `true` se `upload` o `attachReady` hanno qualcosa da fare.
+     */
+    static bool hasPendingWork();
+
+    /**
+     * @brief Crea le risorse OpenGL dei lotti pronti, entro un budget di tempo.
+     *
+     * Ogni passo crea i vertex buffer di una mesh; almeno un passo viene
+     * sempre eseguito, quindi il budget puo' essere superato di un passo. Va chiamata
+     * sul thread del contesto.
+     *
+     * @param budgetMs Il tempo massimo in millisecondi.
+     * @return Il numero di passi eseguiti.
+     */
+    static size_t upload(const double budgetMs);
+
+    /**
+     * @brief Aggiunge alla radice i sottoalberi con tutte le risorse create.
+     *
+     * Va chiamata dal thread che modifica il grafo (sotto `Engine::lockSimulation`
+     * quando la simulazione e' attiva).
+     *
+     * @return Il numero di sottoalberi aggiunti.
+     */
+    static size_t attachReady();
+
+    /**
+     * @brief Interrompe tutti i caricamenti e ne attende i thread.
+     */
+    static void cancelAll();
+
+private:
+    friend class OVOParser;
+
+    /**
+     * @brief Un sottoalbero completo e le risorse da creare prima di aggiungerlo.
+     */
+    struct Batch
+    {
+        std::shared_ptr<Node> parent;               ///< Nodo a cui aggiungere il sottoalbero.
+        std::shared_ptr<Node> node;                 ///< Radice del sottoalbero.
+        std::vector<std::shared_ptr<Mesh>> meshes;  ///< Mesh di cui creare i vertex buffer.
+        size_t nextMesh = 0;                        ///< Prima mesh non ancora caricata.
+    };
+
+    SceneLoader(const std::string& path);
+
+    void start(const std::shared_ptr<SceneLoader>& self);
+    void run();
+
+    // Chiamate dal thread di caricamento attraverso OVOParser.
+    bool isCancelled() const;
+    void setProgress(const float progress);
+    void fail(const std::string& error);
+    void emit(const std::shared_ptr<Node>& parent, const std::shared_ptr<Node>& node);
+
+    bool uploadStep();
+    size_t attach();
+
+    std::string _path;                          ///< Percorso del file.
+    std::shared_ptr<Node> _root;                ///< Radice a cui vengono aggiunti i sottoalberi.
+    std::thread _thread;                        ///< Thread di lettura e analisi.
+    std::atomic<State> _state;                  ///< Stato del caricamento.
+    std::atomic<bool> _finished;                ///< Il thread ha finito di leggere il file.
+    std::atomic<bool> _cancelled;               ///< Richiesta di interruzione.
+    std::atomic<float> _progress;               ///< Frazione del file letta.
+    std::atomic<size_t> _attached;              ///< Sottoalberi aggiunti alla radice.
+    std::string _error;                         ///< Motivo del fallimento.
+
+    mutable std::mutex _mutex;                  ///< Protegge le code e l'errore.
+    std::deque<Batch> _batches;                 ///< Lotti in attesa delle risorse OpenGL.
+    std::vector<std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>>> _ready; ///< Sottoalberi pronti da aggiungere, con il genitore.
+
+    static std::mutex registryMutex;                           ///< Protegge `loaders`.
+    static std::vector<std::shared_ptr<SceneLoader>> loaders;  ///< Caricamenti con lavoro in sospeso.
+};
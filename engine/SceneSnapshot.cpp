@@ -0,0 +1,57 @@
+#include "SceneSnapshot.h"
+
+SnapshotBuffer::SnapshotBuffer()
+    : _middle{ 1 }, _write{ 0 }, _read{ 2 }, _sequence{ 0 }
+{
+}
+
+/**
+ * @brief Restituisce l'istantanea da riempire.
+ *
+ * I nodi rimasti dalla scrittura precedente vengono rilasciati qui: se erano gli ultimi
+ * riferimenti, le risorse OpenGL vengono accodate per il thread del contesto.
+ */
+SceneSnapshot& LIB_API SnapshotBuffer::beginWrite()
+{
+    SceneSnapshot& snapshot = this->_slots[this->_write];
+    snapshot.items.clear();
+    snapshot.camera = nullptr;
+    return snapshot;
+}
+
+void LIB_API SnapshotBuffer::publish()
+{
+    this->_slots[this->_write].sequence = ++this->_sequence;
+
+    // Lo scambio rilascia la scrittura a chi legge e acquisisce lo slot che ha lasciato.
+    this->_write = this->_middle.exchange(this->_write | SnapshotBuffer::FRESH, std::memory_order_acq_rel) & ~SnapshotBuffer::FRESH;
+}
+
+const SceneSnapshot* LIB_API SnapshotBuffer::acquire()
+{
+    if ((this->_middle.load(std::memory_order_relaxed) & SnapshotBuffer::FRESH) != 0)
+        this->_read = this->_middle.exchange(this->_read, std::memory_order_acq_rel) & ~SnapshotBuffer::FRESH;
+
+    return this->getCurrent();
+}
+
+const SceneSnapshot* LIB_API SnapshotBuffer::getCurrent() const
+{
+    const SceneSnapshot& snapshot = this->_slots[this->_read];
+    return snapshot.sequence != 0 ? &snapshot : nullptr;
+}
+
+void LIB_API SnapshotBuffer::reset()
+{
+    for (SceneSnapshot& snapshot : this->_slots)
+    {
+        snapshot.items.clear();
+        snapshot.camera = nullptr;
+        snapshot.screenText.clear();
+        snapshot.sequence = 0;
+    }
+
+    this->_middle.store(1, std::memory_order_release);
+    this->_write = 0;
+    this->_read = 2;
+}
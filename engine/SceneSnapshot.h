@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Camera.h"
+#include "LightManager.h"
+#include "Material.h"
+#include "Node.h"
+#include "Common.h"
+
+/**
+ * @file SceneSnapshot.h
+ * @brief Dichiarazione delle istantanee della scena scambiate tra simulazione e rendering.
+ */
+
+ /**
+  * @struct SnapshotItem
+  * @brief Un nodo da renderizzare con i dati letti dalla simulazione.
+  */
+struct LIB_API SnapshotItem
+{
+    std::shared_ptr<Node> node;  ///< Nodo da renderizzare, mantenuto vivo dall'istantanea.
+    glm::mat4 worldMatrix;       ///< Matrice globale al momento della pubblicazione.
+    bool hasMaterial;            ///< `true` per le mesh: `material` e' valido.
+    MaterialState material;      ///< Copia dei parametri del materiale della mesh.
+    MaterialOverride override;   ///< Copia delle modifiche della mesh al materiale.
+    bool hasLight;               ///< `true` per le luci: `light` e' valido.
+    LightData light;             ///< Copia dei parametri della luce.
+};
+
+/**
+ * @struct SceneSnapshot
+ * @brief Tutto cio' che serve per disegnare un frame, immutabile dopo la pubblicazione.
+ */
+struct LIB_API SceneSnapshot
+{
+    std::vector<SnapshotItem> items;      ///< Nodi nell'ordine di visita del grafo.
+    std::shared_ptr<Camera> camera;       ///< Camera attiva, non letta dal rendering: i parametri sono copiati qui sotto.
+    bool perspective = false;             ///< `true` se la camera attiva e' prospettica.
+    float fov = 0.0f;                     ///< Campo visivo della camera in gradi.
+    float nearClipping = 0.0f;            ///< Distanza del piano di clipping vicino.
+    float farClipping = 0.0f;             ///< Distanza del piano di clipping lontano.
+    glm::mat4 inverseCameraMatrix{ 1.0f }; ///< Inversa della matrice globale della camera.
+    std::string screenText;               ///< Testo da visualizzare sullo schermo.
+    uint64_t sequence = 0;                ///< Numero progressivo della pubblicazione (0 = vuota).
+};
+
+/**
+ * @class SnapshotBuffer
+ * @brief Triplo buffer senza lock tra un thread che scrive e uno che legge le istantanee.
+ *
+ * Chi scrive riempie sempre la propria istantanea e la scambia con quella di mezzo;
+ * chi legge prende quella di mezzo solo se e' piu' recente della sua. Nessuno dei due
+ * aspetta l'altro: la simulazione puo' pubblicare piu' volte per frame e il rendering
+ * puo' ridisegnare la stessa istantanea piu' volte.
+ */
+class LIB_API SnapshotBuffer
+{
+public:
+    SnapshotBuffer();
+    SnapshotBuffer(const SnapshotBuffer&) = delete;
+    SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+
+    /**
+     * @brief Restituisce l'istantanea da riempire, svuotata mantenendo la memoria.
+     * @return L'istantanea riservata a chi scrive.
+     */
+    SceneSnapshot& beginWrite();
+
+    /**
+     * @brief Rende disponibile a chi legge l'istantanea restituita da `beginWrite`.
+     */
+    void publish();
+
+    /**
+     * @brief Passa all'istantanea piu' recente, se ne e' stata pubblicata una nuova.
+     * @return L'istantanea corrente di chi legge, `nullptr` se non ne e' mai stata pubblicata una.
+     */
+    const SceneSnapshot* acquire();
+
+    /**
+     * @brief Restituisce l'istantanea corrente di chi legge senza cercarne una piu' recente.
+     * @return L'ultima istantanea acquisita, `nullptr` se nessuna.
+     */
+    const SceneSnapshot* getCurrent() const;
+
+    /**
+     * @brief Svuota tutte le istantanee. Da chiamare quando nessuno dei due thread le usa.
+     */
+    void reset();
+
+private:
+    static constexpr uint32_t FRESH = 4; ///< Bit dello slot di mezzo: pubblicato e non ancora letto.
+
+    SceneSnapshot _slots[3];          ///< Le tre istantanee.
+    std::atomic<uint32_t> _middle;    ///< Slot di mezzo, con il bit `FRESH`.
+    uint32_t _write;                  ///< Slot di chi scrive.
+    uint32_t _read;                   ///< Slot di chi legge.
+    uint64_t _sequence;               ///< Ultimo numero progressivo assegnato.
+};
@@ -0,0 +1,110 @@
+#include "Shader.h"
+#include "GLExtensions.h"
+
+#include <vector>
+
+/**
+ * @brief Compila e collega un programma a partire dai sorgenti.
+ *
+ * Gli shader intermedi vengono eliminati subito dopo il collegamento.
+ */
+Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource)
+    : _programId{ 0 }
+{
+    if (!GLExtensions::isShaderSupported())
+        return;
+
+    const GLuint vertexShader = Shader::compile(GL_VERTEX_SHADER, vertexSource);
+    const GLuint fragmentShader = Shader::compile(GL_FRAGMENT_SHADER, fragmentSource);
+
+    if (vertexShader == 0 || fragmentShader == 0)
+    {
+        if (vertexShader != 0)
+            GLExtensions::deleteShader(vertexShader);
+        if (fragmentShader != 0)
+            GLExtensions::deleteShader(fragmentShader);
+        return;
+    }
+
+    const GLuint program = GLExtensions::createProgram();
+    GLExtensions::attachShader(program, vertexShader);
+    GLExtensions::attachShader(program, fragmentShader);
+    GLExtensions::linkProgram(program);
+
+    // Il programma mantiene gli shader collegati: possono essere eliminati.
+    GLExtensions::deleteShader(vertexShader);
+    GLExtensions::deleteShader(fragmentShader);
+
+    GLint status = 0;
+    GLExtensions::getProgramiv(program, GL_LINK_STATUS, &status);
+
+    if (status == 0)
+    {
+        GLint length = 0;
+        GLExtensions::getProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length > 1 ? length : 1, '\0');
+        GLExtensions::getProgramInfoLog(program, (GLsizei)log.size(), nullptr, log.data());
+        ERROR("Unable to link shader program: " << log.data());
+        GLExtensions::deleteProgram(program);
+        return;
+    }
+
+    this->_programId = program;
+}
+
+Shader::~Shader()
+{
+    if (this->_programId != 0)
+        GLExtensions::deleteProgram(this->_programId);
+}
+
+bool LIB_API Shader::isLinked() const
+{
+    return this->_programId != 0;
+}
+
+unsigned int LIB_API Shader::getProgramId() const
+{
+    return this->_programId;
+}
+
+int LIB_API Shader::getUniformLocation(const std::string& name) const
+{
+    if (this->_programId == 0)
+        return -1;
+
+    return GLExtensions::getUniformLocation(this->_programId, name.c_str());
+}
+
+void LIB_API Shader::use() const
+{
+    GLExtensions::useProgram(this->_programId);
+}
+
+/**
+ * @brief Compila un singolo shader.
+ * @return L'id dello shader, 0 in caso di errore (il log viene stampato).
+ */
+unsigned int Shader::compile(const unsigned int type, const std::string& source)
+{
+    const GLuint shader = GLExtensions::createShader(type);
+    const char* sourcePointer = source.c_str();
+    GLExtensions::shaderSource(shader, 1, &sourcePointer, nullptr);
+    GLExtensions::compileShader(shader);
+
+    GLint status = 0;
+    GLExtensions::getShaderiv(shader, GL_COMPILE_STATUS, &status);
+
+    if (status == 0)
+    {
+        GLint length = 0;
+        GLExtensions::getShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length > 1 ? length : 1, '\0');
+        GLExtensions::getShaderInfoLog(shader, (GLsizei)log.size(), nullptr, log.data());
+        ERROR("Unable to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader: " << log.data());
+        GLExtensions::deleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
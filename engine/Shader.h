@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+
+#include "Common.h"
+
+/**
+ * @file Shader.h
+ * @brief Dichiarazione della classe Shader, un programma GLSL composto da vertex e fragment shader.
+ */
+
+ /**
+  * @class Shader
+  * @brief Compila e collega un programma GLSL.
+  *
+  * Richiede che `GLExtensions::load` sia stata chiamata con successo. Se la compilazione
+  * o il collegamento falliscono il log viene stampato e `isLinked` restituisce `false`.
+  */
+class LIB_API Shader
+{
+public:
+
+    /**
+     * @brief Compila e collega un programma a partire dai sorgenti.
+     * @param vertexSource Il sorgente del vertex shader.
+     * @param fragmentSource Il sorgente del fragment shader.
+     */
+    Shader(const std::string& vertexSource, const std::string& fragmentSource);
+
+    /**
+     * @brief Distruttore della classe Shader. Libera il programma OpenGL.
+     */
+    ~Shader();
+
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    /**
+     * @brief Verifica se il programma e' stato collegato correttamente.
+     * @return `true` se il programma e' utilizzabile.
+     */
+    bool isLinked() const;
+
+    /**
+     * @brief Restituisce l'identificatore OpenGL del programma.
+     * @return L'id del programma, 0 se non valido.
+     */
+    unsigned int getProgramId() const;
+
+    /**
+     * @brief Restituisce la posizione di una variabile uniform.
+     * @param name Il nome della variabile.
+     * @return La posizione della variabile, -1 se non esiste.
+     */
+    int getUniformLocation(const std::string& name) const;
+
+    /**
+     * @brief Attiva il programma.
+     */
+    void use() const;
+
+private:
+    static unsigned int compile(const unsigned int type, const std::string& source);
+
+    unsigned int _programId; ///< Identificatore OpenGL del programma.
+};
@@ -0,0 +1,202 @@
+#include "TaskPool.h"
+
+#include <algorithm>
+
+// Pool e coda del thread corrente, se e' un thread di un pool.
+static thread_local const TaskPool* currentPool = nullptr;
+static thread_local size_t currentQueue = 0;
+
+/**
+ * @brief Avvia i thread del pool.
+ *
+ * La coda 0 riceve i task dei thread esterni, le code da 1 in poi appartengono ai thread.
+ */
+TaskPool::TaskPool(unsigned int threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+    for (unsigned int i = 0; i <= threadCount; i++)
+        this->_queues.push_back(std::make_unique<Queue>());
+
+    for (unsigned int i = 1; i <= threadCount; i++)
+        this->_threads.emplace_back(&TaskPool::workerLoop, this, (size_t)i);
+}
+
+/**
+ * @brief Completa i task in coda e ferma i thread.
+ */
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_sleepMutex);
+        this->_stopping = true;
+    }
+    this->_wake.notify_all();
+
+    for (std::thread& thread : this->_threads)
+        thread.join();
+
+    // Senza thread i task rimasti vengono eseguiti qui.
+    while (this->runOne(0))
+        ;
+}
+
+/**
+ * @brief Aggiunge un task a un gruppo.
+ */
+void LIB_API TaskPool::submit(Group& group, std::function<void()> task)
+{
+    group.pending++;
+
+    Queue& queue = *this->_queues[this->getHomeQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back({ std::move(task), &group });
+    }
+
+    {
+        // Il lock evita che un thread si addormenti tra il controllo della coda e la notifica.
+        std::lock_guard<std::mutex> lock(this->_sleepMutex);
+        this->_queued++;
+    }
+    this->_wake.notify_one();
+}
+
+/**
+ * @brief Esegue task finche' tutti quelli del gruppo non sono completati.
+ */
+void LIB_API TaskPool::wait(Group& group)
+{
+    const size_t home = this->getHomeQueue();
+
+    while (group.pending > 0)
+    {
+        if (!this->runOne(home))
+            std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Esegue una funzione su intervalli contigui in parallelo.
+ *
+ * Gli intervalli sono al massimo quattro per thread (chiamante compreso), per bilanciare
+ * il carico senza creare troppi task.
+ */
+void LIB_API TaskPool::parallelFor(const size_t count, const size_t grain, const std::function<void(size_t, size_t)>& function)
+{
+    if (count == 0)
+        return;
+
+    const size_t maxTasks = 4 * ((size_t)this->getThreadCount() + 1);
+    const size_t step = std::max(std::max<size_t>(grain, 1), (count + maxTasks - 1) / maxTasks);
+
+    if (step >= count || this->_threads.empty())
+    {
+        function(0, count);
+        return;
+    }
+
+    Group group;
+    for (size_t begin = step; begin < count; begin += step)
+    {
+        const size_t end = std::min(begin + step, count);
+        this->submit(group, [&function, begin, end]() { function(begin, end); });
+    }
+
+    function(0, step);
+    this->wait(group);
+}
+
+unsigned int LIB_API TaskPool::getThreadCount() const
+{
+    return (unsigned int)this->_threads.size();
+}
+
+/**
+ * @brief Restituisce il pool condiviso del motore.
+ */
+TaskPool& LIB_API TaskPool::getShared()
+{
+    static TaskPool pool;
+    return pool;
+}
+
+/**
+ * @brief Ciclo di un thread: esegue task propri o rubati, altrimenti attende.
+ */
+void TaskPool::workerLoop(const size_t index)
+{
+    currentPool = this;
+    currentQueue = index;
+
+    while (true)
+    {
+        if (this->runOne(index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(this->_sleepMutex);
+        this->_wake.wait(lock, [this]() { return this->_stopping || this->_queued > 0; });
+
+        if (this->_stopping && this->_queued == 0)
+            return;
+    }
+}
+
+/**
+ * @brief Esegue un task: prima dalla fine della propria coda, poi dall'inizio delle altre.
+ * @param home La coda del thread corrente.
+ * @return `true` se e' stato eseguito un task.
+ */
+bool TaskPool::runOne(const size_t home)
+{
+    Task task;
+    bool found = false;
+
+    {
+        Queue& queue = *this->_queues[home];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    for (size_t offset = 1; !found && offset < this->_queues.size(); offset++)
+    {
+        Queue& queue = *this->_queues[(home + offset) % this->_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    this->_queued--;
+    task.function();
+    task.group->pending--;
+
+    return true;
+}
+
+/**
+ * @brief Restituisce la coda in cui il thread corrente inserisce i task.
+ *
+ * I thread del pool usano la propria coda; gli altri distribuiscono i task a turno.
+ */
+size_t TaskPool::getHomeQueue() const
+{
+    if (currentPool == this)
+        return currentQueue;
+
+    return this->_nextQueue.fetch_add(1) % this->_queues.size();
+}
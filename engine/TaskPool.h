@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common.h"
+
+/**
+ * @file TaskPool.h
+ * @brief Dichiarazione del pool di thread con work stealing.
+ */
+
+ /**
+  * @class TaskPool
+  * @brief Pool di thread persistenti che eseguono piccoli task con work stealing.
+  *
+  * Ogni thread ha la sua coda: i task creati da un thread del pool finiscono nella sua coda e
+  * vengono presi dalla fine (ultimo inserito, ancora caldo in cache), mentre i thread senza
+  * lavoro li rubano dall'inizio delle code degli altri. Chi chiama `wait` non resta fermo ma
+  * esegue task finche' il gruppo non e' completo, quindi si puo' attendere anche da un task.
+  */
+class LIB_API TaskPool
+{
+public:
+
+    /**
+     * @struct Group
+     * @brief Insieme di task da attendere insieme con `wait`.
+     */
+    struct Group
+    {
+        std::atomic<size_t> pending{ 0 }; ///< Task del gruppo non ancora completati.
+    };
+
+    /**
+     * @brief Avvia i thread del pool.
+     * @param threadCount Il numero di thread; 0 per usarne uno in meno dei core disponibili.
+     */
+    explicit TaskPool(unsigned int threadCount = 0);
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /**
+     * @brief Completa i task in coda e ferma i thread.
+     */
+    ~TaskPool();
+
+    /**
+     * @brief Aggiunge un task a un gruppo.
+     * @param group Il gruppo, che deve restare valido fino alla fine di `wait`.
+     * @param task Il task da eseguire.
+     */
+    void submit(Group& group, std::function<void()> task);
+
+    /**
+     * @brief Esegue task finche' tutti quelli del gruppo non sono completati.
+     * @param group Il gruppo da attendere.
+     */
+    void wait(Group& group);
+
+    /**
+     * @brief Esegue `function(begin, end)` su intervalli di `[0, count)` in parallelo.
+     * @param count Il numero di elementi.
+     * @param grain Il numero minimo di elementi per task.
+     * @param function La funzione da eseguire su ogni intervallo.
+     */
+    void parallelFor(const size_t count, const size_t grain, const std::function<void(size_t, size_t)>& function);
+
+    /**
+     * @brief Restituisce il numero di thread del pool, escluso chi chiama `wait`.
+     * @return Il numero di thread.
+     */
+    unsigned int getThreadCount() const;
+
+    /**
+     * @brief Restituisce il pool condiviso del motore, creato al primo utilizzo.
+     * @return Il pool condiviso.
+     */
+    static TaskPool& getShared();
+
+private:
+
+    /**
+     * @struct Task
+     * @brief Task in coda con il suo gruppo.
+     */
+    struct Task
+    {
+        std::function<void()> function; ///< Lavoro da eseguire.
+        Group* group;                   ///< Gruppo a cui appartiene.
+    };
+
+    /**
+     * @struct Queue
+     * @brief Coda di un thread.
+     */
+    struct Queue
+    {
+        std::mutex mutex;        ///< Protegge la coda.
+        std::deque<Task> tasks;  ///< Task in attesa.
+    };
+
+    void workerLoop(const size_t index);
+    bool runOne(const size_t home);
+    size_t getHomeQueue() const;
+
+    std::vector<std::unique_ptr<Queue>> _queues; ///< Una coda per thread piu' una per i thread esterni.
+    std::vector<std::thread> _threads;           ///< Thread del pool.
+    std::atomic<size_t> _queued{ 0 };            ///< Task in coda in tutte le code.
+    mutable std::atomic<size_t> _nextQueue{ 0 }; ///< Coda per il prossimo task da un thread esterno.
+    std::mutex _sleepMutex;                      ///< Protegge l'attesa dei thread senza lavoro.
+    std::condition_variable _wake;               ///< Sveglia i thread quando arrivano task.
+    bool _stopping = false;                      ///< Indica che il pool si sta fermando.
+};
@@ -0,0 +1,382 @@
+#include "TextRenderer.h"
+#include "GLExtensions.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+/// Font da cui vengono ricavati i glifi.
+#define TEXT_FONT GLUT_BITMAP_8_BY_13
+
+// Atlante: 16 x 6 celle da 8 x 16 pixel per i caratteri da 32 a 127.
+static constexpr int FIRST_CHARACTER = 32;
+static constexpr int LAST_CHARACTER = 127;
+static constexpr int ATLAS_COLUMNS = 16;
+static constexpr int CELL_WIDTH = 8;
+static constexpr int CELL_HEIGHT = 16;
+static constexpr int ATLAS_SIZE = 128;
+
+/// Distanza della linea di base dal fondo della cella: lascia spazio alle discendenti.
+static constexpr int CELL_BASELINE = 3;
+
+std::mutex TextRenderer::mutex;
+std::vector<TextRenderer::Block> TextRenderer::blocks;
+int TextRenderer::nextId = 0;
+unsigned int TextRenderer::atlas = 0;
+int TextRenderer::lineHeight = 13;
+
+/**
+ * @brief Crea l'atlante dei glifi.
+ */
+bool LIB_API TextRenderer::init()
+{
+    if (TextRenderer::atlas != 0)
+        return true;
+
+    if (!TextRenderer::bakeAtlas())
+    {
+        WARNING("TextRenderer: glyph atlas unavailable, falling back to glutBitmapString.");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Disegna i glifi con `glutBitmapCharacter` e li legge in una texture alpha.
+ *
+ * Con i framebuffer object si disegna fuori dalla finestra; altrimenti nel back buffer,
+ * che viene ripulito dal primo frame. Se la lettura non restituisce alcun pixel acceso
+ * (ad esempio con la finestra non ancora visibile) l'atlante non viene creato.
+ */
+bool TextRenderer::bakeAtlas()
+{
+    TextRenderer::lineHeight = glutBitmapHeight(TEXT_FONT);
+    if (TextRenderer::lineHeight <= 0)
+        TextRenderer::lineHeight = 13;
+
+    unsigned int framebuffer = 0;
+    unsigned int colorBuffer = 0;
+
+    if (GLExtensions::isFramebufferSupported())
+    {
+        GLExtensions::genRenderbuffers(1, &colorBuffer);
+        GLExtensions::bindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+        GLExtensions::renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, ATLAS_SIZE, ATLAS_SIZE);
+        GLExtensions::bindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        GLExtensions::genFramebuffers(1, &framebuffer);
+        GLExtensions::bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        GLExtensions::framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    }
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_TEXTURE_2D);
+
+    glViewport(0, 0, ATLAS_SIZE, ATLAS_SIZE);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadMatrixf(glm::value_ptr(glm::ortho(0.0f, (float)ATLAS_SIZE, 0.0f, (float)ATLAS_SIZE, -1.0f, 1.0f)));
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glColor3f(1.0f, 1.0f, 1.0f);
+
+    for (int character = FIRST_CHARACTER; character <= LAST_CHARACTER; character++)
+    {
+        const int cell = character - FIRST_CHARACTER;
+        glRasterPos2i((cell % ATLAS_COLUMNS) * CELL_WIDTH, (cell / ATLAS_COLUMNS) * CELL_HEIGHT + CELL_BASELINE);
+        glutBitmapCharacter(TEXT_FONT, character);
+    }
+
+    std::vector<unsigned char> pixels(ATLAS_SIZE * ATLAS_SIZE);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, ATLAS_SIZE, ATLAS_SIZE, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+    glPopAttrib();
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    if (framebuffer != 0)
+    {
+        GLExtensions::bindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLExtensions::deleteFramebuffers(1, &framebuffer);
+        GLExtensions::deleteRenderbuffers(1, &colorBuffer);
+    }
+
+    if (std::none_of(pixels.begin(), pixels.end(), [](const unsigned char value) { return value != 0; }))
+        return false;
+
+    glGenTextures(1, &TextRenderer::atlas);
+    glBindTexture(GL_TEXTURE_2D, TextRenderer::atlas);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, ATLAS_SIZE, ATLAS_SIZE, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // I glifi vengono disegnati a pixel interi: nessun filtro.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return true;
+}
+
+int LIB_API TextRenderer::add(const std::string& text, const glm::vec2& position, const glm::vec4& color)
+{
+    std::lock_guard<std::mutex> lock(TextRenderer::mutex);
+
+    Block block;
+    block.id = TextRenderer::nextId++;
+    block.text = text;
+    block.position = position;
+    block.color = color;
+    TextRenderer::build(block);
+
+    TextRenderer::blocks.push_back(std::move(block));
+    return TextRenderer::blocks.back().id;
+}
+
+void LIB_API TextRenderer::setText(const int id, const std::string& text)
+{
+    std::lock_guard<std::mutex> lock(TextRenderer::mutex);
+
+    Block* block = TextRenderer::find(id);
+    if (block == nullptr || block->text == text)
+        return;
+
+    block->text = text;
+    TextRenderer::build(*block);
+}
+
+void LIB_API TextRenderer::setPosition(const int id, const glm::vec2& position)
+{
+    std::lock_guard<std::mutex> lock(TextRenderer::mutex);
+
+    if (Block* block = TextRenderer::find(id))
+        block->position = position;
+}
+
+void LIB_API TextRenderer::setColor(const int id, const glm::vec4& color)
+{
+    std::lock_guard<std::mutex> lock(TextRenderer::mutex);
+
+    if (Block* block = TextRenderer::find(id))
+        block->color = color;
+}
+
+void LIB_API TextRenderer::setVisible(const int id, const bool visible)
+{
+    std::lock_guard<std::mutex> lock(TextRenderer::mutex);
+
+    if (Block* block = TextRenderer::find(id))
+        block->visible = visible;
+}
+
+void LIB_API TextRenderer::remove(const int id)
+{
+    std::lock_guard<std::mutex> lock(TextRenderer::mutex);
+
+    const auto it = std::find_if(TextRenderer::blocks.begin(), TextRenderer::blocks.end(),
+        [id](const Block& block) { return block.id == id; });
+
+    if (it == TextRenderer::blocks.end())
+        return;
+
+    GLExtensions::releaseBuffer(it->buffer);
+    TextRenderer::blocks.erase(it);
+}
+
+size_t LIB_API TextRenderer::getQuadCount(const int id)
+{
+    std::lock_guard<std::mutex> lock(TextRenderer::mutex);
+
+    const Block* block = TextRenderer::find(id);
+    return block != nullptr ? block->vertices.size() / 4 : 0;
+}
+
+int LIB_API TextRenderer::getLineHeight()
+{
+    return TextRenderer::lineHeight;
+}
+
+TextRenderer::Block* TextRenderer::find(const int id)
+{
+    for (Block& block : TextRenderer::blocks)
+        if (block.id == id)
+            return &block;
+
+    return nullptr;
+}
+
+/**
+ * @brief Ricalcola i quadrati di un blocco.
+ *
+ * Gli spazi e i caratteri fuori dall'atlante fanno solo avanzare la penna.
+ */
+void TextRenderer::build(Block& block)
+{
+    block.vertices.clear();
+    block.uploaded = false;
+
+    const float texel = 1.0f / ATLAS_SIZE;
+    float x = 0.0f;
+    float y = 0.0f;
+
+    for (const char c : block.text)
+    {
+        const int character = (unsigned char)c;
+
+        if (character == '\n')
+        {
+            x = 0.0f;
+            y -= (float)TextRenderer::lineHeight;
+            continue;
+        }
+
+        if (character > FIRST_CHARACTER && character <= LAST_CHARACTER)
+        {
+            const int cell = character - FIRST_CHARACTER;
+            const float u0 = (cell % ATLAS_COLUMNS) * CELL_WIDTH * texel;
+            const float v0 = (cell / ATLAS_COLUMNS) * CELL_HEIGHT * texel;
+            const float u1 = u0 + CELL_WIDTH * texel;
+            const float v1 = v0 + CELL_HEIGHT * texel;
+
+            const float bottom = y - CELL_BASELINE;
+            const float top = bottom + CELL_HEIGHT;
+
+            block.vertices.push_back({ x, bottom, u0, v0 });
+            block.vertices.push_back({ x + CELL_WIDTH, bottom, u1, v0 });
+            block.vertices.push_back({ x + CELL_WIDTH, top, u1, v1 });
+            block.vertices.push_back({ x, top, u0, v1 });
+        }
+
+        x += CELL_WIDTH;
+    }
+}
+
+/**
+ * @brief Disegna tutti i blocchi visibili.
+ *
+ * Il colore del blocco moltiplica l'alpha dell'atlante (`GL_MODULATE` con una texture `GL_ALPHA`).
+ */
+void LIB_API TextRenderer::render(const int windowWidth, const int windowHeight)
+{
+    std::lock_guard<std::mutex> lock(TextRenderer::mutex);
+
+    if (TextRenderer::blocks.empty())
+        return;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_CURRENT_BIT | GL_TEXTURE_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadMatrixf(glm::value_ptr(glm::ortho(0.0f, (float)windowWidth, 0.0f, (float)windowHeight, -1.0f, 1.0f)));
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+
+    if (TextRenderer::atlas == 0)
+    {
+        // Senza atlante: un carattere alla volta, come prima.
+        glDisable(GL_TEXTURE_2D);
+        glLoadIdentity();
+
+        for (const Block& block : TextRenderer::blocks)
+        {
+            if (!block.visible)
+                continue;
+
+            glColor4fv(glm::value_ptr(block.color));
+            glRasterPos2f(block.position.x, block.position.y);
+            glutBitmapString(TEXT_FONT, (const unsigned char*)block.text.c_str());
+        }
+    }
+    else
+    {
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, TextRenderer::atlas);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+        const bool buffered = GLExtensions::isPackedVertexSupported();
+
+        for (Block& block : TextRenderer::blocks)
+        {
+            if (!block.visible || block.vertices.empty())
+                continue;
+
+            const char* base = reinterpret_cast<const char*>(block.vertices.data());
+
+            if (buffered)
+            {
+                if (block.buffer == 0)
+                    GLExtensions::genBuffers(1, &block.buffer);
+
+                GLExtensions::bindBuffer(GL_ARRAY_BUFFER, block.buffer);
+
+                // Il buffer viene riscritto solo quando il testo e' cambiato.
+                if (!block.uploaded)
+                {
+                    GLExtensions::bufferData(GL_ARRAY_BUFFER, block.vertices.size() * sizeof(Vertex), block.vertices.data(), GL_DYNAMIC_DRAW);
+                    block.uploaded = true;
+                }
+
+                base = nullptr;
+            }
+
+            // Posizioni intere: i texel dell'atlante coincidono con i pixel della finestra.
+            glLoadMatrixf(glm::value_ptr(glm::translate(glm::mat4(1.0f), glm::vec3(glm::floor(block.position), 0.0f))));
+            glColor4fv(glm::value_ptr(block.color));
+
+            glVertexPointer(2, GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, x));
+            glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, u));
+            glDrawArrays(GL_QUADS, 0, (GLsizei)block.vertices.size());
+        }
+
+        if (buffered)
+            GLExtensions::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+    glPopAttrib();
+}
+
+void LIB_API TextRenderer::quit()
+{
+    std::lock_guard<std::mutex> lock(TextRenderer::mutex);
+
+    for (const Block& block : TextRenderer::blocks)
+        GLExtensions::releaseBuffer(block.buffer);
+    TextRenderer::blocks.clear();
+
+    if (TextRenderer::atlas != 0)
+        glDeleteTextures(1, &TextRenderer::atlas);
+    TextRenderer::atlas = 0;
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Common.h"
+
+/**
+ * @file TextRenderer.h
+ * @brief Dichiarazione del rendering del testo sovrapposto con un atlante di glifi.
+ */
+
+ /**
+  * @class TextRenderer
+  * @brief Disegna blocchi di testo 2D con un quadrato per carattere, un blocco per chiamata.
+  *
+  * `init` disegna una volta i caratteri ASCII stampabili del font bitmap 8x13 di GLUT in una
+  * texture (l'atlante). Ogni blocco di testo ha posizione e colore propri; i suoi quadrati
+  * vengono ricalcolati solo quando il testo cambia e caricati in un vertex buffer, quindi
+  * disegnare un blocco costa una sola `glDrawArrays` anche per molte righe.
+  *
+  * La posizione di un blocco e' la linea di base della prima riga, in pixel dall'angolo in basso
+  * a sinistra della finestra (come `glRasterPos2f`); ogni `'\n'` scende di una riga.
+  * Se l'atlante non e' disponibile i blocchi vengono disegnati con `glutBitmapString`.
+  */
+class LIB_API TextRenderer
+{
+public:
+
+    /**
+     * @brief Crea l'atlante dei glifi. Va chiamata dopo la creazione del contesto (vedi `Engine::init`).
+     * @return `true` se l'atlante e' stato creato.
+     */
+    static bool init();
+
+    /**
+     * @brief Aggiunge un blocco di testo.
+     * @param text Il testo, eventualmente su piu' righe.
+     * @param position La posizione della linea di base della prima riga, in pixel.
+     * @param color Il colore del testo (l'alpha ne regola la trasparenza).
+     * @return L'identificatore del blocco.
+     */
+    static int add(const std::string& text, const glm::vec2& position, const glm::vec4& color = glm::vec4(1.0f));
+
+    /**
+     * @brief Cambia il testo di un blocco. Se il testo non cambia non viene ricalcolato nulla.
+     * @param id L'identificatore del blocco.
+     * @param text Il nuovo testo.
+     */
+    static void setText(const int id, const std::string& text);
+
+    /**
+     * @brief Sposta un blocco senza ricalcolarne i quadrati.
+     * @param id L'identificatore del blocco.
+     * @param position La posizione della linea di base della prima riga, in pixel.
+     */
+    static void setPosition(const int id, const glm::vec2& position);
+
+    /**
+     * @brief Cambia il colore di un blocco senza ricalcolarne i quadrati.
+     * @param id L'identificatore del blocco.
+     * @param color Il nuovo colore.
+     */
+    static void setColor(const int id, const glm::vec4& color);
+
+    /**
+     * @brief Mostra o nasconde un blocco.
+     * @param id L'identificatore del blocco.
+     * @param visible `false` per non disegnarlo.
+     */
+    static void setVisible(const int id, const bool visible);
+
+    /**
+     * @brief Rimuove un blocco.
+     * @param id L'identificatore del blocco.
+     */
+    static void remove(const int id);
+
+    /**
+     * @brief Restituisce il numero di quadrati (caratteri visibili) di un blocco.
+     * @param id L'identificatore del blocco.
+     * @return Il numero di quadrati, 0 se il blocco non esiste.
+     */
+    static size_t getQuadCount(const int id);
+
+    /**
+     * @brief Restituisce l'altezza di una riga.
+     * @return La distanza in pixel tra le linee di base di due righe.
+     */
+    static int getLineHeight();
+
+    /**
+     * @brief Disegna tutti i blocchi visibili sopra la scena.
+     *
+     * Imposta una proiezione ortografica in pixel e disattiva illuminazione e profondita'
+     * una sola volta per tutti i blocchi, ripristinandole al termine.
+     *
+     * @param windowWidth La larghezza della finestra.
+     * @param windowHeight L'altezza della finestra.
+     */
+    static void render(const int windowWidth, const int windowHeight);
+
+    /**
+     * @brief Libera l'atlante, i vertex buffer e tutti i blocchi.
+     */
+    static void quit();
+
+private:
+
+    /**
+     * @brief Un vertice di un quadrato: posizione nel blocco e coordinate nell'atlante.
+     */
+    struct Vertex
+    {
+        float x, y;
+        float u, v;
+    };
+
+    /**
+     * @brief Un blocco di testo.
+     */
+    struct Block
+    {
+        int id;                         ///< Identificatore del blocco.
+        std::string text;               ///< Testo del blocco.
+        glm::vec2 position;             ///< Linea di base della prima riga, in pixel.
+        glm::vec4 color;                ///< Colore del testo.
+        bool visible = true;            ///< Il blocco viene disegnato.
+        std::vector<Vertex> vertices;   ///< Quattro vertici per carattere visibile.
+        unsigned int buffer = 0;        ///< Vertex buffer dei quadrati.
+        bool uploaded = false;          ///< Il vertex buffer contiene i vertici correnti.
+    };
+
+    static Block* find(const int id);
+    static void build(Block& block);
+    static bool bakeAtlas();
+
+    static std::mutex mutex;                 ///< Protegge i blocchi.
+    static std::vector<Block> blocks;        ///< Blocchi di testo.
+    static int nextId;                       ///< Prossimo identificatore.
+    static unsigned int atlas;               ///< Texture dei glifi (0 = non disponibile).
+    static int lineHeight;                   ///< Altezza di una riga in pixel.
+};
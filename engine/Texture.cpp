@@ -1,101 +1,228 @@
-#include "Texture.h"
-
-#include <GL/freeglut.h>
-
-#define FREEIMAGE_LIB
-#include <FreeImage.h>
-
-/**
- * @brief Crea una nuova istanza di `Texture` caricando un file immagine dal percorso specificato.
- *
- * Il costruttore carica un'immagine da un file utilizzando FreeImage e crea una texture OpenGL. Se il caricamento dell'immagine fallisce,
- * il puntatore `bitmap` viene impostato a `nullptr`.
- *
- * @param path Il percorso del file dell'immagine da caricare come texture.
- *
- * Se l'immagine viene caricata correttamente, viene convertita in un formato a 32 bit (RGBA) e configurata come texture OpenGL.
- * Se il caricamento fallisce, viene semplicemente impostato a `nullptr` e non viene creata alcuna texture.
- */
-Texture::Texture(const std::string path)
-    : Object{ "Texture" }, _textureId{ 0 }
-{
-    // Carica l'immagine dal percorso specificato utilizzando FreeImage.
-    FIBITMAP* bmp = FreeImage_Load(FreeImage_GetFileType(path.c_str(), 0), path.c_str());
-
-    if (bmp == nullptr)
-    {
-        ERROR("Impossible load the texture \"" + path + "\".");
-        this->_bitmap = nullptr;
-        return;
-    }
-
-    // Converte l'immagine caricata in un formato a 32 bit (RGBA).
-    this->_bitmap = (void*)FreeImage_ConvertTo32Bits(bmp);
-
-    // Scarica l'immagine originale non piu necessaria per liberare memoria.
-    FreeImage_Unload(bmp);
-
-    // numero di texture = 1 // Genera l'id
-    glGenTextures(1, &this->_textureId);
-    glBindTexture(GL_TEXTURE_2D, this->_textureId); // Texture attualmente attiva
-
-    // Imposta la modalita di wrapping della texture a GL_REPEAT, 
-    // che ripete la texture se le coordinate eccedono l'intervallo [0,1].
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-    // Filtro di ingrandimento // se no aliasing se ingrandisci
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    // Filtro di riduzione // se no jittering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-
-    const int width = FreeImage_GetWidth((FIBITMAP*)this->_bitmap);
-    const int height = FreeImage_GetHeight((FIBITMAP*)this->_bitmap);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, (void*)FreeImage_GetBits((FIBITMAP*)this->_bitmap));
-}
-
-/**
- * @brief Libera la memoria utilizzata da questa texture.
- *
- * Questo distruttore elimina la texture associata all'ID specificato in OpenGL e scarica
- * l'immagine caricata per liberare la memoria.
- */
-Texture::~Texture()
-{
-    // Elimina la texture associata all'ID specificato per liberare le risorse in OpenGL.
-    glDeleteTextures(1, &this->_textureId);
-
-    if (this->_bitmap != nullptr)
-        // Scarica l'immagine per liberare la memoria utilizzata da FreeImage.
-        FreeImage_Unload((FIBITMAP*)this->_bitmap);
-}
-
-///// Render texture
-
-/**
- * @brief Renderizza la texture.
- *
- * Questa funzione viene chiamata automaticamente da MyEngine non bisogna chiamarla manualmente.
- *
- * @param viewMatrix matrice da utilizzare per il rendering di questo oggetto.
- *
- * Associa la texture corrente al target di texture 2D in OpenGL e abilita l'uso delle texture 2D.
- * La texture identificata da `this->textureId` viene utilizzata per il mapping su oggetti 3D.
- */
-void LIB_API Texture::render(const glm::mat4 viewMatrix) const
-{
-    glBindTexture(GL_TEXTURE_2D, this->_textureId);
-
-    // Abilita l'uso delle texture 2D in OpenGL.
-    glEnable(GL_TEXTURE_2D);
-}
-
-/**
- * @brief Verifica se la texture  stata caricata correttamente.
- *
- * @return `true` se la texture  stata caricata con successo, `false` altrimenti.
- */
-bool Texture::isLoaded() const {
-    return (_textureId != 0 && _bitmap != nullptr);
-}
+#include "Texture.h"
+#include "DdsImage.h"
+#include "GLExtensions.h"
+#include "Material.h"
+#include "TextureStreamer.h"
+
+#include <GL/freeglut.h>
+
+#define FREEIMAGE_LIB
+#include <FreeImage.h>
+
+/**
+ * @brief Crea una nuova istanza di `Texture` caricando un file immagine dal percorso specificato.
+ *
+ * I file DDS con compressione DXT vengono caricati cosi' come sono, con tutte le mipmap del file,
+ * se il driver supporta le texture S3TC. Negli altri casi l'immagine viene caricata con FreeImage,
+ * convertita in un formato a 32 bit (RGBA) e le mipmap vengono generate da OpenGL.
+ * In entrambi i casi la copia in memoria viene liberata subito dopo il caricamento.
+ *
+ * @param path Il percorso del file dell'immagine da caricare come texture.
+ */
+Texture::Texture(const std::string path)
+    : Object{ "Texture" }, _textureId{ 0 }, _compressed{ false }, _memorySize{ 0 }, _streaming{ false }
+{
+    TextureImage image;
+
+    if (!Texture::decode(path, image))
+    {
+        ERROR("Impossible load the texture \"" + path + "\".");
+        return;
+    }
+
+    this->upload(image);
+}
+
+/**
+ * @brief Crea una texture da un'immagine gia' decodificata (vedi `decode`).
+ */
+Texture::Texture(const TextureImage& image)
+    : Object{ "Texture" }, _textureId{ 0 }, _compressed{ false }, _memorySize{ 0 }, _streaming{ false }
+{
+    if (image.compressed || !image.pixels.empty())
+        this->upload(image);
+}
+
+/**
+ * @brief Crea una texture vuota: `TextureStreamer` ne imposta i dati quando sono caricati.
+ */
+Texture::Texture()
+    : Object{ "Texture" }, _textureId{ 0 }, _compressed{ false }, _memorySize{ 0 }, _streaming{ true }
+{
+}
+
+/**
+ * @brief Legge e decodifica un file immagine senza chiamate OpenGL.
+ *
+ * Puo' essere eseguita su qualunque thread: il caricamento asincrono delle scene
+ * decodifica le immagini in background e crea le texture sul thread del contesto.
+ */
+bool LIB_API Texture::decode(const std::string& path, TextureImage& image)
+{
+    image = TextureImage();
+
+    if (GLExtensions::isTextureCompressionSupported() && image.dds.load(path))
+    {
+        // I DDS sono memorizzati dall'alto verso il basso, FreeImage li capovolge in fase di caricamento.
+        image.dds.flipVertically();
+        image.compressed = true;
+        return true;
+    }
+
+    // Carica l'immagine dal percorso specificato utilizzando FreeImage.
+    FIBITMAP* bmp = FreeImage_Load(FreeImage_GetFileType(path.c_str(), 0), path.c_str());
+
+    if (bmp == nullptr)
+        return false;
+
+    // Converte l'immagine caricata in un formato a 32 bit (RGBA).
+    FIBITMAP* bitmap = FreeImage_ConvertTo32Bits(bmp);
+
+    // Scarica l'immagine originale non piu necessaria per liberare memoria.
+    FreeImage_Unload(bmp);
+
+    if (bitmap == nullptr)
+        return false;
+
+    image.width = FreeImage_GetWidth(bitmap);
+    image.height = FreeImage_GetHeight(bitmap);
+
+    // A 32 bit le righe di FreeImage sono gia' allineate: nessun padding da rimuovere.
+    const uint8_t* bits = FreeImage_GetBits(bitmap);
+    image.pixels.assign(bits, bits + (size_t)image.width * image.height * 4);
+
+    FreeImage_Unload(bitmap);
+    return true;
+}
+
+/**
+ * @brief Crea la texture OpenGL dai dati decodificati.
+ */
+void Texture::upload(const TextureImage& image)
+{
+    if (image.compressed)
+        this->uploadCompressed(image.dds);
+    else
+        this->uploadImage(image.width, image.height, image.pixels.data());
+
+    // La texture e' ora attiva: la cache dei materiali non e' piu' valida.
+    Material::invalidateStateCache();
+}
+
+/**
+ * @brief Carica un DDS compresso con tutte le sue mipmap.
+ */
+void Texture::uploadCompressed(const DdsImage& image)
+{
+    const std::vector<DdsImage::Level>& levels = image.getLevels();
+
+    glGenTextures(1, &this->_textureId);
+    glBindTexture(GL_TEXTURE_2D, this->_textureId);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels.size() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+    // Una catena incompleta non deve rendere la texture incompleta.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size() - 1);
+
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        GLExtensions::compressedTexImage2D(GL_TEXTURE_2D, (GLint)i, image.getFormat(), levels[i].width, levels[i].height, 0,
+            (GLsizei)levels[i].size, image.getData() + levels[i].offset);
+    }
+
+    this->_compressed = true;
+    this->_memorySize = image.getDataSize();
+}
+
+/**
+ * @brief Carica un'immagine BGRA a 32 bit e genera le mipmap.
+ */
+void Texture::uploadImage(const int width, const int height, const uint8_t* pixels)
+{
+    // numero di texture = 1 // Genera l'id
+    glGenTextures(1, &this->_textureId);
+    glBindTexture(GL_TEXTURE_2D, this->_textureId); // Texture attualmente attiva
+
+    // Imposta la modalita di wrapping della texture a GL_REPEAT, 
+    // che ripete la texture se le coordinate eccedono l'intervallo [0,1].
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    // Filtro di ingrandimento // se no aliasing se ingrandisci
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // Filtro di riduzione // se no jittering
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+
+    // Le mipmap vengono generate dal driver al caricamento del livello 0 (OpenGL 1.4).
+    glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, (const void*)pixels);
+
+    // Livello 0 piu' la catena di mipmap (circa un terzo in piu').
+    this->_memorySize = (size_t)width * height * 4 * 4 / 3;
+}
+
+/**
+ * @brief Libera la memoria utilizzata da questa texture.
+ *
+ * Questo distruttore elimina la texture associata all'ID specificato in OpenGL.
+ */
+Texture::~Texture()
+{
+    // Elimina la texture associata all'ID specificato per liberare le risorse in OpenGL
+    // (al prossimo frame se il distruttore non gira sul thread del contesto).
+    GLExtensions::releaseTexture(this->_textureId);
+}
+
+///// Render texture
+
+/**
+ * @brief Renderizza la texture.
+ *
+ * Questa funzione viene chiamata automaticamente da MyEngine non bisogna chiamarla manualmente.
+ *
+ * @param viewMatrix matrice da utilizzare per il rendering di questo oggetto.
+ *
+ * Associa la texture corrente al target di texture 2D in OpenGL e abilita l'uso delle texture 2D.
+ * La texture identificata da `this->textureId` viene utilizzata per il mapping su oggetti 3D.
+ */
+void LIB_API Texture::render(const glm::mat4 viewMatrix) const
+{
+    // Finche' i dati non sono arrivati viene associato il segnaposto.
+    glBindTexture(GL_TEXTURE_2D, this->getRenderId());
+
+    // Abilita l'uso delle texture 2D in OpenGL.
+    glEnable(GL_TEXTURE_2D);
+}
+
+/**
+ * @brief Verifica se la texture è stata caricata correttamente.
+ *
+ * @return `true` se la texture è stata caricata con successo, `false` altrimenti.
+ */
+bool Texture::isLoaded() const {
+    return this->_textureId != 0;
+}
+
+unsigned int LIB_API Texture::getTextureId() const {
+    return this->_textureId;
+}
+
+unsigned int LIB_API Texture::getRenderId() const {
+    return this->_textureId != 0 ? this->_textureId : TextureStreamer::getPlaceholder();
+}
+
+bool LIB_API Texture::isStreaming() const {
+    return this->_streaming;
+}
+
+bool LIB_API Texture::isCompressed() const {
+    return this->_compressed;
+}
+
+size_t LIB_API Texture::getMemorySize() const {
+    return this->_memorySize;
+}
@@ -1,82 +1,173 @@
-#pragma once
-
-// Migliora la qualita delle texture quando sono viste da angoli inclinati.
-// Piu alto e il valore, piu dettagliata sara la texture.
-#define GL_TEXTURE_MAX_ANISOTROPY_EXT        0x84FE
-
-// Quanto puoi aumentare la qualita delle texture sulla tua scheda grafica.
-#define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT    0x84FF
-
-#include "Common.h"
-#include "Object.h"
-
-/**
- * @file Texture.h
- * @brief Dichiarazione della classe Texture per la gestione delle texture in OpenGL.
- *
- * La classe `Texture` permette di caricare immagini da file e di applicarle come texture
- * su modelli 3D.  progettata per integrarsi con OpenGL e utilizza la libreria FreeImage
- * per il caricamento delle immagini.
- */
-
- /**
-  * @class Texture
-  * @brief Rappresenta una texture che consente di applicare immagini su un modello 3D.
-  *
-  * La classe `Texture` rappresenta una texture che viene applicata sui modelli 3D,
-  * permettendo di visualizzare immagini sulle superfici delle mesh. Gestisce il caricamento
-  * di un'immagine da un percorso specificato e la renderizzazione della texture sugli oggetti 3D.
-  */
-class LIB_API Texture : public Object
-{
-public:
-    /**
-     * @brief Costruttore della classe Texture.
-     *
-     * Questo costruttore carica un'immagine da un percorso specificato utilizzando la libreria FreeImage
-     * e configura la texture in OpenGL. Se il caricamento fallisce, la texture non  valida.
-     *
-     * @param path Il percorso dell'immagine da caricare come texture.
-     */
-    Texture(const std::string path);
-
-    /**
-     * @brief Distruttore della classe Texture.
-     *
-     * Libera tutte le risorse allocate, incluse le texture OpenGL e i dati dell'immagine caricata.
-     */
-    ~Texture();
-
-    /**
-     * @brief Verifica se la texture  stata caricata correttamente.
-     *
-     * @return `true` se la texture  stata caricata con successo, `false` altrimenti.
-     */
-    bool isLoaded() const;
-
-    /**
-     * @brief Renderizza la texture.
-     *
-     * Associa la texture corrente al target di texture 2D in OpenGL
-     * e abilita l'uso delle texture 2D per il rendering.
-     *
-     * @param viewMatrix La matrice di vista da utilizzare per il rendering.
-     */
-    void render(const glm::mat4 viewMatrix) const override;
-
-private:
-    /**
-     * @brief Puntatore ai dati dell'immagine in memoria.
-     *
-     * Questo puntatore viene utilizzato per conservare i dati dell'immagine caricata
-     * tramite la libreria FreeImage.  convertito in un formato compatibile con OpenGL.
-     */
-    void* _bitmap;
-
-    /**
-     * @brief Identificatore della texture OpenGL.
-     *
-     * Questo ID  assegnato da OpenGL per rappresentare in modo univoco la texture.
-     */
-    unsigned int _textureId;
-};
+#pragma once
+
+// Migliora la qualita delle texture quando sono viste da angoli inclinati.
+// Piu alto e il valore, piu dettagliata sara la texture.
+#define GL_TEXTURE_MAX_ANISOTROPY_EXT        0x84FE
+
+// Quanto puoi aumentare la qualita delle texture sulla tua scheda grafica.
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT    0x84FF
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "Common.h"
+#include "DdsImage.h"
+#include "Object.h"
+
+/**
+ * @file Texture.h
+ * @brief Dichiarazione della classe Texture per la gestione delle texture in OpenGL.
+ *
+ * La classe `Texture` permette di caricare immagini da file e di applicarle come texture
+ * su modelli 3D. È progettata per integrarsi con OpenGL e utilizza la libreria FreeImage
+ * per il caricamento delle immagini.
+ */
+
+ /**
+  * @struct TextureImage
+  * @brief Immagine letta da file e decodificata, pronta per `Texture(const TextureImage&)`.
+  */
+struct LIB_API TextureImage
+{
+    bool compressed = false;       ///< `true` se i dati sono i livelli compressi di un DDS.
+    DdsImage dds;                  ///< Livelli compressi (solo se `compressed`).
+    int width = 0;                 ///< Larghezza dell'immagine non compressa.
+    int height = 0;                ///< Altezza dell'immagine non compressa.
+    std::vector<uint8_t> pixels;   ///< Pixel BGRA a 32 bit, dalla riga in basso.
+};
+
+ /**
+  * @class Texture
+  * @brief Rappresenta una texture che consente di applicare immagini su un modello 3D.
+  *
+  * La classe `Texture` rappresenta una texture che viene applicata sui modelli 3D,
+  * permettendo di visualizzare immagini sulle superfici delle mesh. Gestisce il caricamento
+  * di un'immagine da un percorso specificato e la renderizzazione della texture sugli oggetti 3D.
+  */
+class LIB_API Texture : public Object
+{
+public:
+    /**
+     * @brief Costruttore della classe Texture.
+     *
+     * Questo costruttore carica un'immagine da un percorso specificato e configura la texture in OpenGL.
+     * I file DDS compressi vengono caricati direttamente con tutte le loro mipmap; gli altri formati
+     * vengono letti con la libreria FreeImage e le mipmap vengono generate da OpenGL. Dopo il caricamento
+     * non viene conservata alcuna copia dell'immagine in memoria. Se il caricamento fallisce, la texture non è valida.
+     *
+     * Per condividere la stessa texture tra piu' materiali usare `TextureManager::load`.
+     *
+     * @param path Il percorso dell'immagine da caricare come texture.
+     */
+    Texture(const std::string path);
+
+    /**
+     * @brief Crea la texture da un'immagine gia' decodificata.
+     *
+     * Solo questa parte del caricamento usa OpenGL e va eseguita sul thread del contesto.
+     *
+     * @param image L'immagine restituita da `decode`.
+     */
+    explicit Texture(const TextureImage& image);
+
+    /**
+     * @brief Distruttore della classe Texture.
+     *
+     * Libera la texture OpenGL.
+     */
+    ~Texture();
+
+    /**
+     * @brief Verifica se la texture è stata caricata correttamente.
+     *
+     * @return `true` se la texture è stata caricata con successo, `false` altrimenti.
+     */
+    bool isLoaded() const;
+
+    /**
+     * @brief Restituisce l'identificatore OpenGL della texture.
+     * @return L'id della texture, 0 se non caricata.
+     */
+    unsigned int getTextureId() const;
+
+    /**
+     * @brief Restituisce la texture OpenGL da associare per il rendering.
+     *
+     * Finche' la texture non e' caricata (in streaming o dopo un errore) viene usato
+     * il segnaposto bianco 1x1 di `TextureStreamer`. Va chiamata sul thread del contesto.
+     *
+     * @return L'id della texture o del segnaposto.
+     */
+    unsigned int getRenderId() const;
+
+    /**
+     * @brief Verifica se i dati della texture sono ancora in arrivo da `TextureStreamer`.
+     * @return `true` finche' la texture richiesta con `TextureStreamer::request` non e' completa o fallita.
+     */
+    bool isStreaming() const;
+
+    /**
+     * @brief Verifica se la texture e' stata caricata in formato compresso (DXT).
+     * @return `true` se i dati sono stati caricati direttamente da un DDS compresso.
+     */
+    bool isCompressed() const;
+
+    /**
+     * @brief Restituisce la memoria video occupata dalla texture, mipmap incluse.
+     * @return La dimensione stimata in byte.
+     */
+    size_t getMemorySize() const;
+
+    /**
+     * @brief Renderizza la texture.
+     *
+     * Associa la texture corrente al target di texture 2D in OpenGL
+     * e abilita l'uso delle texture 2D per il rendering.
+     *
+     * @param viewMatrix La matrice di vista da utilizzare per il rendering.
+     */
+    void render(const glm::mat4 viewMatrix) const override;
+
+    /**
+     * @brief Legge e decodifica un file immagine senza usare OpenGL.
+     * @param path Il percorso del file.
+     * @param image L'immagine decodificata.
+     * @return `false` se il file non puo' essere letto.
+     */
+    static bool decode(const std::string& path, TextureImage& image);
+
+private:
+    friend class TextureStreamer;
+
+    /**
+     * @brief Crea una texture vuota, completata in seguito da `TextureStreamer`.
+     */
+    Texture();
+
+    void upload(const TextureImage& image);
+    void uploadCompressed(const DdsImage& image);
+    void uploadImage(const int width, const int height, const uint8_t* pixels);
+
+    /**
+     * @brief Identificatore della texture OpenGL.
+     *
+     * Questo ID è assegnato da OpenGL per rappresentare in modo univoco la texture.
+     */
+    unsigned int _textureId;
+
+    /**
+     * @brief Indica se la texture e' stata caricata da un DDS compresso.
+     */
+    bool _compressed;
+
+    /**
+     * @brief Memoria video stimata della texture, in byte.
+     */
+    size_t _memorySize;
+
+    /**
+     * @brief Indica se i dati sono ancora in arrivo da `TextureStreamer`.
+     */
+    std::atomic<bool> _streaming;
+};
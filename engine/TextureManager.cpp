@@ -0,0 +1,108 @@
+#include "TextureManager.h"
+
+#include <algorithm>
+
+std::unordered_map<std::string, std::weak_ptr<Texture>> TextureManager::textures;
+std::mutex TextureManager::mutex;
+
+/**
+ * @brief Restituisce la texture associata a un percorso, caricandola se necessario.
+ *
+ * Le voci delle texture gia' liberate vengono sostituite dal nuovo caricamento.
+ */
+std::shared_ptr<Texture> LIB_API TextureManager::load(const std::string& path)
+{
+    if (std::shared_ptr<Texture> texture = TextureManager::find(path))
+        return texture;
+
+    // Il caricamento usa OpenGL: avviene fuori dal lock.
+    return TextureManager::add(path, std::make_shared<Texture>(path));
+}
+
+std::shared_ptr<Texture> LIB_API TextureManager::find(const std::string& path)
+{
+    const std::string key = TextureManager::normalize(path);
+    std::lock_guard<std::mutex> lock(TextureManager::mutex);
+
+    auto it = TextureManager::textures.find(key);
+    if (it != TextureManager::textures.end())
+        return it->second.lock();
+
+    return nullptr;
+}
+
+std::shared_ptr<Texture> LIB_API TextureManager::add(const std::string& path, const std::shared_ptr<Texture>& texture)
+{
+    const std::string key = TextureManager::normalize(path);
+    std::lock_guard<std::mutex> lock(TextureManager::mutex);
+
+    std::weak_ptr<Texture>& entry = TextureManager::textures[key];
+    if (std::shared_ptr<Texture> existing = entry.lock())
+        return existing;
+
+    entry = texture;
+    return texture;
+}
+
+/**
+ * @brief Cerca il percorso di una texture scorrendo la mappa: serve solo all'esportazione delle scene.
+ */
+std::string LIB_API TextureManager::getPath(const std::shared_ptr<Texture>& texture)
+{
+    if (texture == nullptr)
+        return std::string();
+
+    std::lock_guard<std::mutex> lock(TextureManager::mutex);
+
+    for (const auto& entry : TextureManager::textures)
+    {
+        if (entry.second.lock() == texture)
+            return entry.first;
+    }
+
+    return std::string();
+}
+
+size_t LIB_API TextureManager::getTextureCount()
+{
+    std::lock_guard<std::mutex> lock(TextureManager::mutex);
+    size_t count = 0;
+
+    for (const auto& entry : TextureManager::textures)
+    {
+        if (!entry.second.expired())
+            count++;
+    }
+
+    return count;
+}
+
+size_t LIB_API TextureManager::getMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(TextureManager::mutex);
+    size_t memory = 0;
+
+    for (const auto& entry : TextureManager::textures)
+    {
+        if (std::shared_ptr<Texture> texture = entry.second.lock())
+            memory += texture->getMemorySize();
+    }
+
+    return memory;
+}
+
+void LIB_API TextureManager::clear()
+{
+    std::lock_guard<std::mutex> lock(TextureManager::mutex);
+    TextureManager::textures.clear();
+}
+
+/**
+ * @brief Rende confrontabili i percorsi scritti con separatori diversi.
+ */
+std::string TextureManager::normalize(const std::string& path)
+{
+    std::string key = path;
+    std::replace(key.begin(), key.end(), '\\', '/');
+    return key;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Texture.h"
+#include "Common.h"
+
+/**
+ * @file TextureManager.h
+ * @brief Dichiarazione del gestore delle texture condivise.
+ */
+
+ /**
+  * @class TextureManager
+  * @brief Carica ogni file di texture una sola volta e lo condivide tra i materiali che lo usano.
+  *
+  * Le texture sono indicizzate per percorso. Il gestore conserva solo riferimenti deboli:
+  * una texture viene liberata quando l'ultimo materiale che la usa viene distrutto e,
+  * se richiesta di nuovo, viene ricaricata.
+  */
+class LIB_API TextureManager
+{
+public:
+
+    /**
+     * @brief Restituisce la texture associata a un percorso, caricandola se necessario.
+     * @param path Il percorso del file.
+     * @return La texture condivisa (anche se il caricamento non e' riuscito, vedi `Texture::isLoaded`).
+     */
+    static std::shared_ptr<Texture> load(const std::string& path);
+
+    /**
+     * @brief Restituisce la texture gia' caricata per un percorso, senza caricarla.
+     *
+     * Puo' essere chiamata da qualunque thread.
+     *
+     * @param path Il percorso del file.
+     * @return La texture condivisa, `nullptr` se non e' in uso.
+     */
+    static std::shared_ptr<Texture> find(const std::string& path);
+
+    /**
+     * @brief Registra una texture creata fuori dal gestore (es. dal caricamento asincrono).
+     *
+     * Se il percorso ha gia' una texture in uso, viene restituita quella e `texture` non viene condivisa.
+     *
+     * @param path Il percorso del file.
+     * @param texture La texture creata.
+     * @return La texture condivisa per il percorso.
+     */
+    static std::shared_ptr<Texture> add(const std::string& path, const std::shared_ptr<Texture>& texture);
+
+    /**
+     * @brief Restituisce il percorso con cui una texture e' registrata.
+     *
+     * Puo' essere chiamata da qualunque thread.
+     *
+     * @param texture La texture.
+     * @return Il percorso (con separatori `/`), vuoto se la texture non e' registrata.
+     */
+    static std::string getPath(const std::shared_ptr<Texture>& texture);
+
+    /**
+     * @brief Restituisce il numero di texture ancora in uso.
+     * @return Il numero di texture caricate e non ancora liberate.
+     */
+    static size_t getTextureCount();
+
+    /**
+     * @brief Restituisce la memoria video occupata dalle texture in uso.
+     * @return La somma di `Texture::getMemorySize` in byte.
+     */
+    static size_t getMemoryUsage();
+
+    /**
+     * @brief Svuota la cache.
+     *
+     * Le texture ancora usate da qualche materiale restano valide ma non vengono piu' condivise.
+     */
+    static void clear();
+
+private:
+    static std::string normalize(const std::string& path);
+
+    static std::unordered_map<std::string, std::weak_ptr<Texture>> textures; ///< Texture caricate, per percorso.
+    static std::mutex mutex; ///< Protegge la mappa: il caricamento asincrono la consulta da altri thread.
+};
@@ -0,0 +1,360 @@
+#include "TextureStreamer.h"
+#include "GLExtensions.h"
+#include "Material.h"
+#include "TextureManager.h"
+
+#include <algorithm>
+#include <cstring>
+
+std::mutex TextureStreamer::mutex;
+std::condition_variable TextureStreamer::wake;
+std::deque<std::shared_ptr<TextureStreamer::Job>> TextureStreamer::decodeQueue;
+std::deque<std::shared_ptr<TextureStreamer::Job>> TextureStreamer::uploadQueue;
+std::vector<std::thread> TextureStreamer::workers;
+bool TextureStreamer::stopping = false;
+size_t TextureStreamer::decoding = 0;
+
+std::shared_ptr<TextureStreamer::Job> TextureStreamer::current;
+unsigned int TextureStreamer::pixelBuffers[2] = { 0, 0 };
+int TextureStreamer::nextPixelBuffer = 0;
+unsigned int TextureStreamer::placeholder = 0;
+
+size_t TextureStreamer::frameBudget = 2 * 1024 * 1024;
+size_t TextureStreamer::bytesLastFrame = 0;
+size_t TextureStreamer::totalBytes = 0;
+
+// Thread di decodifica: la decodifica e' dominata da lettura e decompressione dei file.
+static constexpr unsigned int MAX_DECODE_THREADS = 2;
+
+/**
+ * @brief Restituisce la texture di un percorso, accodandone la decodifica se e' nuova.
+ */
+std::shared_ptr<Texture> LIB_API TextureStreamer::request(const std::string& path)
+{
+    std::shared_ptr<Texture> texture = TextureManager::find(path);
+    if (texture != nullptr)
+        return texture;
+
+    // Se un altro thread l'ha registrata nel frattempo, vale la sua.
+    std::shared_ptr<Texture> created(new Texture());
+    texture = TextureManager::add(path, created);
+    if (texture != created)
+        return texture;
+
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    job->texture = texture;
+    job->path = path;
+
+    {
+        std::lock_guard<std::mutex> lock(TextureStreamer::mutex);
+        TextureStreamer::start();
+        TextureStreamer::decodeQueue.push_back(job);
+    }
+    TextureStreamer::wake.notify_one();
+
+    return texture;
+}
+
+/**
+ * @brief Avvia i thread di decodifica, se non sono gia' attivi. Va chiamata con il mutex acquisito.
+ */
+void TextureStreamer::start()
+{
+    if (!TextureStreamer::workers.empty())
+        return;
+
+    const unsigned int cores = std::thread::hardware_concurrency();
+    const unsigned int count = std::clamp(cores > 1 ? cores - 1 : 1u, 1u, MAX_DECODE_THREADS);
+
+    TextureStreamer::stopping = false;
+    for (unsigned int i = 0; i < count; i++)
+        TextureStreamer::workers.emplace_back(&TextureStreamer::workerLoop);
+}
+
+/**
+ * @brief Ciclo di un thread di decodifica.
+ */
+void TextureStreamer::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(TextureStreamer::mutex);
+
+    while (true)
+    {
+        TextureStreamer::wake.wait(lock, []() { return TextureStreamer::stopping || !TextureStreamer::decodeQueue.empty(); });
+
+        if (TextureStreamer::stopping)
+            return;
+
+        std::shared_ptr<Job> job = TextureStreamer::decodeQueue.front();
+        TextureStreamer::decodeQueue.pop_front();
+        TextureStreamer::decoding++;
+        lock.unlock();
+
+        // Una texture gia' distrutta non va decodificata.
+        if (!job->texture.expired() && !Texture::decode(job->path, job->image))
+        {
+            ERROR("Impossible load the texture \"" + job->path + "\".");
+            job->failed = true;
+        }
+
+        lock.lock();
+        TextureStreamer::decoding--;
+        TextureStreamer::uploadQueue.push_back(job);
+    }
+}
+
+/**
+ * @brief Carica sulla GPU i blocchi delle texture decodificate, una texture alla volta.
+ */
+size_t LIB_API TextureStreamer::update()
+{
+    size_t bytes = 0;
+
+    while (bytes < TextureStreamer::frameBudget)
+    {
+        if (TextureStreamer::current == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(TextureStreamer::mutex);
+
+            if (TextureStreamer::uploadQueue.empty())
+                break;
+
+            TextureStreamer::current = TextureStreamer::uploadQueue.front();
+            TextureStreamer::uploadQueue.pop_front();
+        }
+
+        Job& job = *TextureStreamer::current;
+        std::shared_ptr<Texture> texture = job.texture.lock();
+
+        // Texture distrutta durante il caricamento o file non leggibile: resta il segnaposto.
+        if (texture == nullptr || job.failed)
+        {
+            GLExtensions::releaseTexture(job.textureId);
+
+            if (texture != nullptr)
+                texture->_streaming = false;
+
+            TextureStreamer::current = nullptr;
+            continue;
+        }
+
+        bytes += TextureStreamer::uploadStep(job, TextureStreamer::frameBudget - bytes);
+
+        const size_t total = job.image.compressed ? job.image.dds.getLevels().size() : (size_t)job.image.height;
+        if (job.next >= total)
+        {
+            texture->_textureId = job.textureId;
+            texture->_compressed = job.image.compressed;
+            texture->_memorySize = job.image.compressed ? job.image.dds.getDataSize() : (size_t)job.image.width * job.image.height * 4 * 4 / 3;
+            texture->_streaming = false;
+
+            TextureStreamer::current = nullptr;
+        }
+    }
+
+    // Le associazioni delle texture sono cambiate alle spalle della cache dei materiali.
+    if (bytes > 0)
+        Material::invalidateStateCache();
+
+    TextureStreamer::bytesLastFrame = bytes;
+    TextureStreamer::totalBytes += bytes;
+    return bytes;
+}
+
+/**
+ * @brief Carica il blocco successivo di una texture: righe fino al budget o un livello compresso.
+ * @return I byte caricati.
+ */
+size_t TextureStreamer::uploadStep(Job& job, const size_t budget)
+{
+    const TextureImage& image = job.image;
+
+    if (job.textureId == 0)
+    {
+        glGenTextures(1, &job.textureId);
+        glBindTexture(GL_TEXTURE_2D, job.textureId);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        if (image.compressed)
+        {
+            const size_t levels = image.dds.getLevels().size();
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels - 1);
+        }
+        else
+        {
+            // Il livello 0 viene allocato subito e riempito a blocchi di righe.
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width, image.height, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+    else
+    {
+        glBindTexture(GL_TEXTURE_2D, job.textureId);
+    }
+
+    if (image.compressed)
+    {
+        const DdsImage::Level& level = image.dds.getLevels()[job.next++];
+
+        const void* data = TextureStreamer::stage(image.dds.getData() + level.offset, level.size);
+        GLExtensions::compressedTexImage2D(GL_TEXTURE_2D, (GLint)(job.next - 1), image.dds.getFormat(), level.width, level.height, 0,
+            (GLsizei)level.size, data);
+        TextureStreamer::unstage();
+
+        return level.size;
+    }
+
+    const size_t rowSize = (size_t)image.width * 4;
+    const size_t rows = std::min((size_t)image.height - job.next, std::max<size_t>(1, budget / rowSize));
+
+    // Le mipmap vengono generate una volta sola, con l'ultimo blocco del livello 0.
+    if (job.next + rows == (size_t)image.height)
+        glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+
+    const void* data = TextureStreamer::stage(image.pixels.data() + job.next * rowSize, rows * rowSize);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, (GLint)job.next, image.width, (GLsizei)rows, GL_BGRA_EXT, GL_UNSIGNED_BYTE, data);
+    TextureStreamer::unstage();
+
+    job.next += rows;
+    return rows * rowSize;
+}
+
+/**
+ * @brief Copia un blocco nel prossimo pixel buffer, se disponibili.
+ *
+ * Il buffer viene riallocato prima della copia: il driver puo' darne uno nuovo senza attendere
+ * che la GPU abbia finito di leggere il blocco precedente.
+ *
+ * @return Il puntatore da passare a `glTexSubImage2D`: l'offset nel buffer o i dati stessi.
+ */
+const void* TextureStreamer::stage(const uint8_t* data, const size_t size)
+{
+    if (!GLExtensions::isPixelBufferSupported())
+        return data;
+
+    if (TextureStreamer::pixelBuffers[0] == 0)
+        GLExtensions::genBuffers(2, TextureStreamer::pixelBuffers);
+
+    GLExtensions::bindBuffer(GL_PIXEL_UNPACK_BUFFER, TextureStreamer::pixelBuffers[TextureStreamer::nextPixelBuffer]);
+    TextureStreamer::nextPixelBuffer = 1 - TextureStreamer::nextPixelBuffer;
+
+    GLExtensions::bufferData(GL_PIXEL_UNPACK_BUFFER, (EngineGLsizeiptr)size, nullptr, GL_STREAM_DRAW);
+    void* mapped = GLExtensions::mapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+
+    if (mapped == nullptr)
+    {
+        GLExtensions::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return data;
+    }
+
+    memcpy(mapped, data, size);
+    GLExtensions::unmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    return nullptr;
+}
+
+void TextureStreamer::unstage()
+{
+    if (GLExtensions::isPixelBufferSupported())
+        GLExtensions::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void LIB_API TextureStreamer::setFrameBudget(const size_t bytes)
+{
+    TextureStreamer::frameBudget = bytes;
+}
+
+size_t LIB_API TextureStreamer::getFrameBudget()
+{
+    return TextureStreamer::frameBudget;
+}
+
+size_t LIB_API TextureStreamer::getBytesStreamedLastFrame()
+{
+    return TextureStreamer::bytesLastFrame;
+}
+
+size_t LIB_API TextureStreamer::getTotalBytesStreamed()
+{
+    return TextureStreamer::totalBytes;
+}
+
+size_t LIB_API TextureStreamer::getQueueDepth()
+{
+    std::lock_guard<std::mutex> lock(TextureStreamer::mutex);
+    return TextureStreamer::decodeQueue.size() + TextureStreamer::decoding + TextureStreamer::uploadQueue.size() +
+        (TextureStreamer::current != nullptr ? 1 : 0);
+}
+
+/**
+ * @brief Restituisce la texture bianca 1x1: moltiplicata per il colore del materiale non lo modifica.
+ */
+unsigned int LIB_API TextureStreamer::getPlaceholder()
+{
+    if (TextureStreamer::placeholder == 0)
+    {
+        const uint8_t white[4] = { 255, 255, 255, 255 };
+
+        glGenTextures(1, &TextureStreamer::placeholder);
+        glBindTexture(GL_TEXTURE_2D, TextureStreamer::placeholder);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+
+        Material::invalidateStateCache();
+    }
+
+    return TextureStreamer::placeholder;
+}
+
+void LIB_API TextureStreamer::quit()
+{
+    std::vector<std::thread> stopped;
+    {
+        std::lock_guard<std::mutex> lock(TextureStreamer::mutex);
+        TextureStreamer::stopping = true;
+        stopped.swap(TextureStreamer::workers);
+    }
+    TextureStreamer::wake.notify_all();
+
+    for (std::thread& worker : stopped)
+        worker.join();
+
+    {
+        std::lock_guard<std::mutex> lock(TextureStreamer::mutex);
+
+        for (const std::shared_ptr<Job>& job : TextureStreamer::decodeQueue)
+            if (std::shared_ptr<Texture> texture = job->texture.lock())
+                texture->_streaming = false;
+
+        for (const std::shared_ptr<Job>& job : TextureStreamer::uploadQueue)
+            if (std::shared_ptr<Texture> texture = job->texture.lock())
+                texture->_streaming = false;
+
+        TextureStreamer::decodeQueue.clear();
+        TextureStreamer::uploadQueue.clear();
+    }
+
+    if (TextureStreamer::current != nullptr)
+    {
+        GLExtensions::releaseTexture(TextureStreamer::current->textureId);
+
+        if (std::shared_ptr<Texture> texture = TextureStreamer::current->texture.lock())
+            texture->_streaming = false;
+
+        TextureStreamer::current = nullptr;
+    }
+
+    if (TextureStreamer::pixelBuffers[0] != 0)
+    {
+        GLExtensions::releaseBuffer(TextureStreamer::pixelBuffers[0]);
+        GLExtensions::releaseBuffer(TextureStreamer::pixelBuffers[1]);
+        TextureStreamer::pixelBuffers[0] = TextureStreamer::pixelBuffers[1] = 0;
+    }
+
+    GLExtensions::releaseTexture(TextureStreamer::placeholder);
+    TextureStreamer::placeholder = 0;
+}
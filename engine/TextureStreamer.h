@@ -0,0 +1,141 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Texture.h"
+#include "Common.h"
+
+/**
+ * @file TextureStreamer.h
+ * @brief Dichiarazione del caricamento progressivo delle texture.
+ */
+
+ /**
+  * @class TextureStreamer
+  * @brief Carica le texture senza bloccare: decodifica su thread dedicati e upload distribuito su piu' frame.
+  *
+  * `request` restituisce subito una texture vuota, registrata in `TextureManager`, che finche'
+  * i dati non arrivano associa un segnaposto bianco 1x1 (`getPlaceholder`). Le immagini
+  * vengono decodificate da alcuni thread in background; a ogni frame `update` ne carica sulla
+  * GPU al massimo `getFrameBudget()` byte, a blocchi di righe (o un livello di mipmap per i DDS
+  * compressi), passando per due pixel buffer object riusati a turno quando disponibili.
+  * La texture OpenGL diventa visibile solo quando e' completa.
+  *
+  * `Engine::update` chiama `update` a ogni frame; `Engine::quit` chiama `quit`.
+  */
+class LIB_API TextureStreamer
+{
+public:
+
+    /**
+     * @brief Restituisce la texture di un percorso, accodandone il caricamento se non e' gia' presente.
+     *
+     * Non usa OpenGL e puo' essere chiamata da qualunque thread.
+     *
+     * @param path Il percorso del file.
+     * @return La texture condivisa, eventualmente ancora in caricamento (vedi `Texture::isStreaming`).
+     */
+    static std::shared_ptr<Texture> request(const std::string& path);
+
+    /**
+     * @brief Carica sulla GPU i dati delle texture decodificate, entro il budget del frame.
+     *
+     * Almeno un blocco viene caricato se disponibile, quindi il budget puo' essere superato
+     * di un blocco. Va chiamata sul thread del contesto.
+     *
+     * @return I byte caricati.
+     */
+    static size_t update();
+
+    /**
+     * @brief Imposta il numero massimo di byte caricati sulla GPU per frame.
+     * @param bytes Il budget in byte (default 2 MB).
+     */
+    static void setFrameBudget(const size_t bytes);
+
+    /**
+     * @brief Restituisce il numero massimo di byte caricati sulla GPU per frame.
+     * @return Il budget in byte.
+     */
+    static size_t getFrameBudget();
+
+    /**
+     * @brief Restituisce i byte caricati sulla GPU dall'ultimo `update`.
+     * @return I byte caricati nell'ultimo frame.
+     */
+    static size_t getBytesStreamedLastFrame();
+
+    /**
+     * @brief Restituisce i byte caricati sulla GPU dall'avvio.
+     * @return I byte caricati in totale.
+     */
+    static size_t getTotalBytesStreamed();
+
+    /**
+     * @brief Restituisce il numero di texture non ancora complete (da decodificare o da caricare).
+     * @return La profondita' della coda.
+     */
+    static size_t getQueueDepth();
+
+    /**
+     * @brief Restituisce la texture segnaposto, creandola al primo utilizzo.
+     *
+     * Va chiamata sul thread del contesto.
+     *
+     * @return L'id OpenGL di una texture bianca 1x1.
+     */
+    static unsigned int getPlaceholder();
+
+    /**
+     * @brief Ferma i thread di decodifica e libera code, pixel buffer e segnaposto.
+     *
+     * Le texture non ancora complete restano vuote.
+     */
+    static void quit();
+
+private:
+
+    /**
+     * @brief Una texture in caricamento.
+     */
+    struct Job
+    {
+        std::weak_ptr<Texture> texture; ///< Texture da completare; il caricamento si ferma se viene distrutta.
+        std::string path;               ///< Percorso del file.
+        TextureImage image;             ///< Immagine decodificata.
+        bool failed = false;            ///< La decodifica non e' riuscita.
+        unsigned int textureId = 0;     ///< Texture OpenGL in costruzione.
+        size_t next = 0;                ///< Prima riga (o primo livello compresso) non ancora caricata.
+    };
+
+    static void start();
+    static void workerLoop();
+    static size_t uploadStep(Job& job, const size_t budget);
+    static const void* stage(const uint8_t* data, const size_t size);
+    static void unstage();
+
+    static std::mutex mutex;                         ///< Protegge code e thread.
+    static std::condition_variable wake;             ///< Sveglia i thread di decodifica.
+    static std::deque<std::shared_ptr<Job>> decodeQueue; ///< Texture da decodificare.
+    static std::deque<std::shared_ptr<Job>> uploadQueue; ///< Texture decodificate, da caricare.
+    static std::vector<std::thread> workers;         ///< Thread di decodifica.
+    static bool stopping;                            ///< Richiesta di arresto dei thread.
+    static size_t decoding;                          ///< Texture in decodifica in questo momento.
+
+    // Solo per il thread del contesto.
+    static std::shared_ptr<Job> current;             ///< Texture in caricamento sulla GPU.
+    static unsigned int pixelBuffers[2];             ///< Pixel buffer object usati a turno.
+    static int nextPixelBuffer;                      ///< Prossimo pixel buffer da usare.
+    static unsigned int placeholder;                 ///< Texture bianca 1x1.
+
+    static size_t frameBudget;                       ///< Byte caricabili per frame.
+    static size_t bytesLastFrame;                    ///< Byte caricati nell'ultimo frame.
+    static size_t totalBytes;                        ///< Byte caricati in totale.
+};
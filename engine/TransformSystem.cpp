@@ -0,0 +1,262 @@
+#include "TransformSystem.h"
+#include "Node.h"
+
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define TRANSFORM_SYSTEM_SSE
+#endif
+
+/**
+ * @brief Scollega tutti i nodi.
+ */
+TransformSystem::~TransformSystem()
+{
+    this->clear();
+}
+
+/**
+ * @brief Ricostruisce gli array a partire da una gerarchia.
+ *
+ * La visita in profondita' usa una pila esplicita e inserisce i figli in ordine inverso,
+ * cosi' l'ordine risultante coincide con quello di `List::pass`.
+ */
+void LIB_API TransformSystem::build(const std::shared_ptr<Node>& root)
+{
+    this->clear();
+
+    this->_root = root.get();
+    this->_hierarchyVersion = Node::getHierarchyVersion();
+
+    if (root == nullptr)
+        return;
+
+    std::vector<std::pair<Node*, int>> stack;
+    stack.emplace_back(root.get(), -1);
+
+    while (!stack.empty())
+    {
+        const auto [node, parent] = stack.back();
+        stack.pop_back();
+
+        const int index = (int)this->_nodes.size();
+
+        this->_nodes.push_back(node);
+        this->_parents.push_back(parent);
+        this->_positions.push_back(node->_position);
+        this->_rotations.push_back(node->_rotation);
+        this->_scales.push_back(node->_scale);
+        this->_baseMatrices.push_back(node->_baseMatrix);
+
+        node->_transformSystem = this;
+        node->_transformIndex = index;
+
+        const std::vector<std::shared_ptr<Node>>& children = node->children;
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+            stack.emplace_back(it->get(), index);
+    }
+
+    const size_t size = this->_nodes.size();
+    this->_localMatrices.resize(size);
+    this->_worldMatrices.resize(size);
+    this->_dirty.assign(size, 1);
+    this->_changed.assign(size, 0);
+}
+
+/**
+ * @brief Scollega tutti i nodi e svuota gli array.
+ */
+void LIB_API TransformSystem::clear()
+{
+    for (Node* node : this->_nodes)
+    {
+        if (node != nullptr)
+        {
+            node->_transformSystem = nullptr;
+            node->_transformIndex = -1;
+        }
+    }
+
+    this->_nodes.clear();
+    this->_parents.clear();
+    this->_positions.clear();
+    this->_rotations.clear();
+    this->_scales.clear();
+    this->_baseMatrices.clear();
+    this->_localMatrices.clear();
+    this->_worldMatrices.clear();
+    this->_dirty.clear();
+    this->_changed.clear();
+    this->_root = nullptr;
+}
+
+bool LIB_API TransformSystem::isStale(const std::shared_ptr<Node>& root) const
+{
+    return root.get() != this->_root || Node::getHierarchyVersion() != this->_hierarchyVersion;
+}
+
+/**
+ * @brief Aggiorna le matrici locali modificate e le matrici del mondo che ne dipendono.
+ *
+ * Poiche' ogni genitore precede i suoi figli, quando si arriva a un nodo la matrice del mondo
+ * del genitore e' gia' aggiornata e il flag `_changed` del genitore e' gia' definitivo.
+ */
+void LIB_API TransformSystem::update()
+{
+    const size_t size = this->_nodes.size();
+
+    for (size_t i = 0; i < size; i++)
+    {
+        const int parent = this->_parents[i];
+        const bool dirty = this->_dirty[i] != 0;
+        const bool changed = dirty || (parent >= 0 && this->_changed[parent] != 0);
+
+        if (dirty)
+        {
+            this->computeLocalMatrix(i);
+            this->_dirty[i] = 0;
+        }
+
+        if (changed)
+        {
+            if (parent >= 0)
+                TransformSystem::multiply(this->_worldMatrices[parent], this->_localMatrices[i], this->_worldMatrices[i]);
+            else
+                this->_worldMatrices[i] = this->_localMatrices[i];
+        }
+
+        this->_changed[i] = changed ? 1 : 0;
+    }
+}
+
+/**
+ * @brief Aggiunge alla lista di rendering i nodi con le loro matrici del mondo.
+ */
+void LIB_API TransformSystem::fillRenderList(std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& renderList) const
+{
+    renderList.reserve(renderList.size() + this->_nodes.size());
+
+    for (size_t i = 0; i < this->_nodes.size(); i++)
+    {
+        if (this->_nodes[i] != nullptr)
+            renderList.emplace_back(this->_nodes[i]->shared_from_this(), this->_worldMatrices[i]);
+    }
+}
+
+void LIB_API TransformSystem::setPosition(const int index, const glm::vec3& position)
+{
+    this->_positions[index] = position;
+    this->_dirty[index] = 1;
+}
+
+void LIB_API TransformSystem::setRotation(const int index, const glm::vec3& rotation)
+{
+    this->_rotations[index] = rotation;
+    this->_dirty[index] = 1;
+}
+
+void LIB_API TransformSystem::setScale(const int index, const glm::vec3& scale)
+{
+    this->_scales[index] = scale;
+    this->_dirty[index] = 1;
+}
+
+void LIB_API TransformSystem::setBaseMatrix(const int index, const glm::mat4& baseMatrix)
+{
+    this->_baseMatrices[index] = baseMatrix;
+    this->_dirty[index] = 1;
+}
+
+void LIB_API TransformSystem::detach(const int index)
+{
+    this->_nodes[index] = nullptr;
+}
+
+size_t LIB_API TransformSystem::getSize() const
+{
+    return this->_nodes.size();
+}
+
+int LIB_API TransformSystem::getParent(const int index) const
+{
+    return this->_parents[index];
+}
+
+Node* LIB_API TransformSystem::getNode(const int index) const
+{
+    return this->_nodes[index];
+}
+
+const glm::mat4& LIB_API TransformSystem::getLocalMatrix(const int index) const
+{
+    return this->_localMatrices[index];
+}
+
+const glm::mat4& LIB_API TransformSystem::getWorldMatrix(const int index) const
+{
+    return this->_worldMatrices[index];
+}
+
+/**
+ * @brief Moltiplica due matrici 4x4 in ordine di colonna.
+ *
+ * Ogni colonna del risultato e' la combinazione delle colonne di `a` con i coefficienti
+ * della colonna corrispondente di `b`: con SSE sono 16 moltiplicazioni e 12 somme vettoriali.
+ */
+void LIB_API TransformSystem::multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& result)
+{
+#ifdef TRANSFORM_SYSTEM_SSE
+    const float* left = &a[0][0];
+    const float* right = &b[0][0];
+    float* out = &result[0][0];
+
+    const __m128 a0 = _mm_loadu_ps(left);
+    const __m128 a1 = _mm_loadu_ps(left + 4);
+    const __m128 a2 = _mm_loadu_ps(left + 8);
+    const __m128 a3 = _mm_loadu_ps(left + 12);
+
+    // Le colonne di `b` vengono lette tutte prima di scrivere, cosi' `result` puo' essere `b`.
+    const __m128 b0 = _mm_loadu_ps(right);
+    const __m128 b1 = _mm_loadu_ps(right + 4);
+    const __m128 b2 = _mm_loadu_ps(right + 8);
+    const __m128 b3 = _mm_loadu_ps(right + 12);
+
+    const __m128 columns[4] = { b0, b1, b2, b3 };
+    for (int j = 0; j < 4; j++)
+    {
+        const __m128 column = columns[j];
+        __m128 sum = _mm_mul_ps(a0, _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(a1, _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1))));
+        sum = _mm_add_ps(sum, _mm_mul_ps(a2, _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))));
+        sum = _mm_add_ps(sum, _mm_mul_ps(a3, _mm_shuffle_ps(column, column, _MM_SHUFFLE(3, 3, 3, 3))));
+        _mm_storeu_ps(out + 4 * j, sum);
+    }
+#else
+    result = a * b;
+#endif
+}
+
+/**
+ * @brief Calcola la matrice locale come in `Node::getLocalMatrix`: T * Rz * Ry * Rx * S * base.
+ *
+ * La rotazione viene scritta direttamente dai seni e coseni dei tre angoli invece di
+ * moltiplicare tre matrici di rotazione.
+ */
+void TransformSystem::computeLocalMatrix(const size_t index)
+{
+    const glm::vec3 angles = glm::radians(this->_rotations[index]);
+    const glm::vec3& scale = this->_scales[index];
+
+    const float sx = std::sin(angles.x), cx = std::cos(angles.x);
+    const float sy = std::sin(angles.y), cy = std::cos(angles.y);
+    const float sz = std::sin(angles.z), cz = std::cos(angles.z);
+
+    glm::mat4 offset;
+    offset[0] = glm::vec4(cz * cy, sz * cy, -sy, 0.0f) * scale.x;
+    offset[1] = glm::vec4(cz * sy * sx - sz * cx, sz * sy * sx + cz * cx, cy * sx, 0.0f) * scale.y;
+    offset[2] = glm::vec4(cz * sy * cx + sz * sx, sz * sy * cx - cz * sx, cy * cx, 0.0f) * scale.z;
+    offset[3] = glm::vec4(this->_positions[index], 1.0f);
+
+    TransformSystem::multiply(offset, this->_baseMatrices[index], this->_localMatrices[index]);
+}
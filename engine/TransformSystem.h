@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Common.h"
+
+class Node;
+
+/**
+ * @file TransformSystem.h
+ * @brief Dichiarazione del sistema delle trasformazioni in array contigui.
+ */
+
+ /**
+  * @class TransformSystem
+  * @brief Memorizza le trasformazioni di una gerarchia di nodi in array contigui (SoA).
+  *
+  * `build` visita la gerarchia in profondita' e assegna a ogni nodo un indice: i genitori
+  * precedono sempre i figli, quindi `update` calcola tutte le matrici del mondo con una sola
+  * passata lineare, senza ricorsione e senza seguire puntatori. Posizione, rotazione, scala e
+  * matrice di base vengono scritte qui dai setter di `Node` mentre il nodo e' collegato.
+  *
+  * Le matrici locali vengono ricalcolate solo per i nodi modificati e le matrici del mondo solo
+  * per i nodi modificati e i loro discendenti. I prodotti 4x4 usano SSE quando disponibile.
+  */
+class LIB_API TransformSystem
+{
+public:
+
+    TransformSystem() = default;
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+
+    /**
+     * @brief Scollega tutti i nodi.
+     */
+    ~TransformSystem();
+
+    /**
+     * @brief Ricostruisce gli array a partire da una gerarchia.
+     *
+     * I nodi collegati in precedenza vengono scollegati.
+     *
+     * @param root Il nodo radice.
+     */
+    void build(const std::shared_ptr<Node>& root);
+
+    /**
+     * @brief Scollega tutti i nodi e svuota gli array.
+     */
+    void clear();
+
+    /**
+     * @brief Verifica se gli array devono essere ricostruiti.
+     * @param root La radice della gerarchia da rappresentare.
+     * @return `true` se la radice e' diversa o la gerarchia e' cambiata dall'ultimo `build`.
+     */
+    bool isStale(const std::shared_ptr<Node>& root) const;
+
+    /**
+     * @brief Aggiorna le matrici locali modificate e le matrici del mondo che ne dipendono.
+     */
+    void update();
+
+    /**
+     * @brief Aggiunge alla lista di rendering i nodi con le loro matrici del mondo.
+     *
+     * L'ordine e' lo stesso di `List::pass` (visita in profondita').
+     *
+     * @param renderList La lista da riempire.
+     */
+    void fillRenderList(std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& renderList) const;
+
+    // Setter usati da Node
+
+    void setPosition(const int index, const glm::vec3& position);
+    void setRotation(const int index, const glm::vec3& rotation);
+    void setScale(const int index, const glm::vec3& scale);
+    void setBaseMatrix(const int index, const glm::mat4& baseMatrix);
+
+    /**
+     * @brief Scollega un nodo distrutto: l'elemento resta nell'array fino al prossimo `build`.
+     * @param index L'indice del nodo.
+     */
+    void detach(const int index);
+
+    // Getter
+
+    /**
+     * @brief Restituisce il numero di nodi.
+     * @return Il numero di elementi negli array.
+     */
+    size_t getSize() const;
+
+    /**
+     * @brief Restituisce l'indice del genitore di un nodo.
+     * @param index L'indice del nodo.
+     * @return L'indice del genitore, -1 per la radice.
+     */
+    int getParent(const int index) const;
+
+    /**
+     * @brief Restituisce il nodo a un indice.
+     * @param index L'indice.
+     * @return Il nodo, `nullptr` se e' stato distrutto.
+     */
+    Node* getNode(const int index) const;
+
+    /**
+     * @brief Restituisce la matrice locale calcolata all'ultimo `update`.
+     * @param index L'indice del nodo.
+     * @return La matrice locale.
+     */
+    const glm::mat4& getLocalMatrix(const int index) const;
+
+    /**
+     * @brief Restituisce la matrice del mondo calcolata all'ultimo `update`.
+     * @param index L'indice del nodo.
+     * @return La matrice del mondo.
+     */
+    const glm::mat4& getWorldMatrix(const int index) const;
+
+    /**
+     * @brief Moltiplica due matrici 4x4 (SSE se disponibile).
+     * @param a La matrice di sinistra.
+     * @param b La matrice di destra.
+     * @param result La matrice `a * b`; puo' coincidere con `b`.
+     */
+    static void multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& result);
+
+private:
+    void computeLocalMatrix(const size_t index);
+
+    std::vector<Node*> _nodes;              ///< Nodi collegati, `nullptr` se distrutti.
+    std::vector<int> _parents;              ///< Indice del genitore, -1 per la radice.
+    std::vector<glm::vec3> _positions;      ///< Posizioni locali.
+    std::vector<glm::vec3> _rotations;      ///< Rotazioni locali (angoli di Eulero in gradi).
+    std::vector<glm::vec3> _scales;         ///< Scale locali.
+    std::vector<glm::mat4> _baseMatrices;   ///< Matrici di base.
+    std::vector<glm::mat4> _localMatrices;  ///< Matrici locali.
+    std::vector<glm::mat4> _worldMatrices;  ///< Matrici del mondo.
+    std::vector<uint8_t> _dirty;            ///< Matrice locale da ricalcolare.
+    std::vector<uint8_t> _changed;          ///< Matrice del mondo cambiata nell'ultimo `update`.
+
+    const Node* _root = nullptr;            ///< Radice dell'ultimo `build`.
+    uint64_t _hierarchyVersion = 0;         ///< Versione della gerarchia all'ultimo `build`.
+};
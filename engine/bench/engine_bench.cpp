@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "AllocationTracker.h"
+#include "engine.h"
+#include "List.h"
+#include "Logger.h"
+#include "MeshData.h"
+#include "Node.h"
+#include "OvoParser.h"
+#include "OvoWriter.h"
+#include "SceneGenerator.h"
+
+/**
+ * Microbenchmark dell'engine.
+ *
+ * Ogni benchmark stampa una riga JSON su stdout:
+ * {"benchmark": nome, "iterations": N, "ns_per_op": ..., "allocs_per_op": ..., "bytes_per_op": ...}
+ *
+ * Il tempo per operazione e' la mediana di REPETITIONS misure, ognuna lunga almeno MIN_TIME_MS.
+ * Le allocazioni vengono contate solo se l'engine e' compilato con ENGINE_TRACK_ALLOCATIONS
+ * (il target engine-bench del Makefile lo fa), altrimenti valgono null.
+ *
+ * Uso: engine-bench [filtro]   esegue solo i benchmark il cui nome contiene il filtro.
+ */
+
+// Durata minima di una misura.
+static constexpr double MIN_TIME_MS = 100.0;
+
+// Misure per benchmark.
+static constexpr int REPETITIONS = 5;
+
+// Impedisce al compilatore di eliminare i risultati delle operazioni misurate.
+static volatile uint64_t sink = 0;
+
+static const char* filter = nullptr;
+
+static void consume(const float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	sink = sink + bits;
+}
+
+static void consume(const uint64_t value)
+{
+	sink = sink + value;
+}
+
+/**
+ * Misura un'operazione e ne stampa il risultato.
+ *
+ * Il numero di iterazioni viene raddoppiato finche' una misura dura almeno MIN_TIME_MS.
+ */
+template<typename Operation>
+static void benchmark(const std::string& name, Operation operation)
+{
+	if (filter != nullptr && name.find(filter) == std::string::npos)
+		return;
+
+	using Clock = std::chrono::steady_clock;
+	const auto measure = [&operation](const uint64_t iterations)
+	{
+		const Clock::time_point start = Clock::now();
+		for (uint64_t i = 0; i < iterations; i++)
+			operation();
+		return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	};
+
+	// Riscaldamento e calibrazione.
+	uint64_t iterations = 1;
+	while (measure(iterations) < MIN_TIME_MS * 1.0e6 && iterations < (1ull << 40))
+		iterations *= 2;
+
+	std::vector<double> samples;
+	samples.reserve(REPETITIONS);
+	// Contatori di tutti i thread: la lettura compressa decomprime le mesh sui thread di TaskPool.
+	const size_t allocationsBefore = AllocationTracker::getTotalAllocations();
+	const size_t bytesBefore = AllocationTracker::getTotalBytes();
+
+	for (int r = 0; r < REPETITIONS; r++)
+		samples.push_back(measure(iterations) / (double)iterations);
+
+	const double operations = (double)iterations * REPETITIONS;
+	const size_t allocations = AllocationTracker::getTotalAllocations() - allocationsBefore;
+	const size_t bytes = AllocationTracker::getTotalBytes() - bytesBefore;
+
+	std::sort(samples.begin(), samples.end());
+
+	if (AllocationTracker::isEnabled())
+		printf("{\"benchmark\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.2f, \"allocs_per_op\": %.2f, \"bytes_per_op\": %.1f}\n",
+			name.c_str(), (unsigned long long)iterations, samples[REPETITIONS / 2], allocations / operations, bytes / operations);
+	else
+		printf("{\"benchmark\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.2f, \"allocs_per_op\": null, \"bytes_per_op\": null}\n",
+			name.c_str(), (unsigned long long)iterations, samples[REPETITIONS / 2]);
+	fflush(stdout);
+}
+
+/**
+ * Catena di nodi: ogni nodo ha un solo figlio.
+ */
+static std::shared_ptr<Node> makeDeepGraph(const int depth)
+{
+	std::shared_ptr<Node> root = std::make_shared<Node>("deep_0");
+	std::shared_ptr<Node> parent = root;
+	for (int i = 1; i < depth; i++)
+	{
+		std::shared_ptr<Node> child = std::make_shared<Node>("deep_" + std::to_string(i));
+		child->setBaseMatrix(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.01f, 0.0f)));
+		parent->addChild(child);
+		parent = child;
+	}
+	return root;
+}
+
+/**
+ * Radice con molti figli, senza nipoti.
+ */
+static std::shared_ptr<Node> makeWideGraph(const int width)
+{
+	std::shared_ptr<Node> root = std::make_shared<Node>("wide_root");
+	for (int i = 0; i < width; i++)
+	{
+		std::shared_ptr<Node> child = std::make_shared<Node>("wide_" + std::to_string(i));
+		child->setBaseMatrix(glm::translate(glm::mat4(1.0f), glm::vec3((float)i, 0.0f, 0.0f)));
+		root->addChild(child);
+	}
+	return root;
+}
+
+/**
+ * Scrive un file OVO con un albero di soli nodi: `count` nodi, `fanout` figli per nodo.
+ */
+static void writeOvoTree(const char* path, const int count, const int fanout)
+{
+	OVOWriter writer;
+	if (!writer.open(path))
+		return;
+
+	// Visita in profondita' di un albero completo numerato in ampiezza.
+	const glm::mat4 matrix = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+	std::vector<int> stack = { 0 };
+	while (!stack.empty())
+	{
+		const int node = stack.back();
+		stack.pop_back();
+
+		const int firstChild = node * fanout + 1;
+		const int children = std::clamp(count - firstChild, 0, fanout);
+		writer.writeNode("node_" + std::to_string(node), matrix, (uint32_t)children);
+
+		for (int c = children - 1; c >= 0; c--)
+			stack.push_back(firstChild + c);
+	}
+
+	writer.close();
+}
+
+/**
+ * Griglia di `side` x `side` vertici.
+ */
+static MeshData makeGridMesh(const int side)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> uvs;
+	std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> faces;
+
+	for (int y = 0; y < side; y++)
+		for (int x = 0; x < side; x++)
+		{
+			vertices.push_back(glm::vec3((float)x, 0.0f, (float)y));
+			normals.push_back(glm::vec3(0.0f, 1.0f, 0.0f));
+			uvs.push_back(glm::vec2((float)x / side, (float)y / side));
+		}
+
+	for (int y = 0; y + 1 < side; y++)
+		for (int x = 0; x + 1 < side; x++)
+		{
+			const uint32_t i = (uint32_t)(y * side + x);
+			faces.emplace_back(i, i + 1, i + side);
+			faces.emplace_back(i + 1, i + side + 1, i + side);
+		}
+
+	MeshData data;
+	data.set_mesh_data(vertices, faces, normals, uvs);
+	return data;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1)
+		filter = argv[1];
+
+	// I messaggi di debug del parser falserebbero le misure.
+	Logger::setLevel(LogLevel::Warning);
+
+	///// Node
+	{
+		Node node("bench");
+		node.setBaseMatrix(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f)));
+		benchmark("Node::getLocalMatrix", [&node]()
+		{
+			consume(node.getLocalMatrix()[3][0]);
+		});
+	}
+
+	///// List::pass
+	{
+		const std::shared_ptr<Node> deep = makeDeepGraph(1000);
+		const std::shared_ptr<Node> wide = makeWideGraph(10000);
+		std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> renderList;
+
+		benchmark("List::pass/deep_1000", [&deep]()
+		{
+			consume((uint64_t)List::pass(deep, glm::mat4(1.0f)).size());
+		});
+		benchmark("List::pass/wide_10000", [&wide]()
+		{
+			consume((uint64_t)List::pass(wide, glm::mat4(1.0f)).size());
+		});
+		benchmark("List::pass/wide_10000_reused", [&wide, &renderList]()
+		{
+			List::pass(wide, glm::mat4(1.0f), renderList);
+			consume((uint64_t)renderList.size());
+		});
+
+		// Priorita' casuali ma ripetibili; ogni operazione riparte dalla lista non ordinata.
+		std::mt19937 random(42);
+		for (const std::shared_ptr<Node>& child : wide->getChildren())
+			child->setPriority((int)(random() % 8));
+		const std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> unsorted = List::pass(wide, glm::mat4(1.0f));
+
+		List list;
+		benchmark("List::sortListRendering/10000", [&list, &unsorted]()
+		{
+			list.setListRendering(unsorted);
+			list.sortListRendering();
+			consume((uint64_t)list.getListRendering().size());
+		});
+
+		///// Engine::findObject
+		Engine::setScene(wide);
+		const std::shared_ptr<Node> last = wide->getChildren().back();
+		const std::string lastName = last->getName();
+		const int lastId = last->getId();
+
+		benchmark("Engine::findObjectByName/10000", [&lastName]()
+		{
+			consume((uint64_t)(Engine::findObjectByName(lastName) != nullptr));
+		});
+		benchmark("Engine::findObjectByID/10000", [lastId]()
+		{
+			consume((uint64_t)(Engine::findObjectByID(lastId) != nullptr));
+		});
+		Engine::setScene(nullptr);
+	}
+
+	///// OVOParser
+	{
+		const char* path = "engine_bench_nodes.ovo";
+		writeOvoTree(path, 20000, 8);
+		benchmark("OVOParser::fromFile/nodes_20000", [path]()
+		{
+			consume((uint64_t)(OVOParser::fromFile(path) != nullptr));
+		});
+		remove(path);
+
+		// Scena sintetica: 100 scacchiere da 32 pezzi, 3300 mesh
+		SceneGeneratorOptions options;
+		options.boards = 100;
+		const char* scenePath = "engine_bench_boards.ovo";
+		SceneGenerator::generate(scenePath, options);
+		benchmark("OVOParser::fromFile/boards_100", [scenePath]()
+		{
+			consume((uint64_t)(OVOParser::fromFile(scenePath) != nullptr));
+		});
+
+		// Stessa scena con le mesh compresse e gia' ottimizzate, decompresse dai thread di TaskPool
+		options.compressMeshes = true;
+		SceneGenerator::generate(scenePath, options);
+		benchmark("OVOParser::fromFile/boards_100_compressed", [scenePath]()
+		{
+			consume((uint64_t)(OVOParser::fromFile(scenePath) != nullptr));
+		});
+		remove(scenePath);
+	}
+
+	///// MeshData
+	{
+		const MeshData grid = makeGridMesh(256);
+		benchmark("MeshData::copy/65536_vertices", [&grid]()
+		{
+			const MeshData copy = grid;
+			consume((uint64_t)copy.getVertexCount());
+		});
+	}
+
+	Logger::quit();
+	return 0;
+}
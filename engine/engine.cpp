@@ -1,739 +1,1263 @@
-#include "engine.h"
-
-#ifdef _linux
-#include <unistd.h>
-#endif
-
-#include <GL/freeglut.h>
-#include <glm/gtc/type_ptr.hpp>
-#include <FreeImage.h>
-
-bool Engine::isInitializedFlag = false;
-bool Engine::isRunningFlag = false;
-int Engine::windowId = 0;
-
-// scena caricata
-std::shared_ptr<Node> Engine::scene;
-
-std::shared_ptr<Camera> Engine::activeCamera;
-int Engine::windowWidth = 0;
-int Engine::windowHeight = 0;
-std::string Engine::screenText;
-
-// Materiale per le ombre
-std::shared_ptr<Material> Engine::shadowMaterial = std::make_shared<Material>();
-
-// Frames:
-int Engine::frames = 0;
-float Engine::fps = 0.0f;
-void (*Engine::blinkingCallback)() = nullptr;
-
-// Conta quanto tempo     passato
-int timeCallback = 0;
-
-
-// se il simbolo _WINDOWS     definito.
-#ifdef _WINDOWS
-#include <Windows.h>
-
-// Questa funzione viene chiamata automaticamente dal sistema operativo quando un processo carica o scarica una DLL.
-
-// HANDLE instDLL: Un handle alla DLL che viene caricato o scaricato.
-// DWORD reason: Un codice che indica il motivo per cui la funzione DllMain     stata chiamata. 
-int APIENTRY DllMain(HANDLE instDLL, DWORD reason, LPVOID _reserved)
-{
-    switch (reason)
-    {
-        // Un processo sta caricando la DLL. 
-    case DLL_PROCESS_ATTACH:
-        break;
-
-        // Un processo sta scaricando la DLL.
-    case DLL_PROCESS_DETACH:
-        break;
-    }
-
-    return true;
-}
-#endif
-
-/**
- * @brief Inizializza il motore grafico e crea una finestra con le specifiche fornite.
- *
- * Questa funzione configura e inizializza il motore grafico, inclusi i parametri della finestra,
- * il sistema di rendering OpenGL, e la libreria FreeImage per la manipolazione delle immagini.
- * Verifica anche se l'engine     gi    stato inizializzato per evitare inizializzazioni multiple.
- *
- * @param windowTitle Il titolo da assegnare alla finestra creata.
- * @param windowWidth La larghezza della finestra in pixel.
- * @param windowHeight L'altezza della finestra in pixel.
- *
- * @note Se l'engine     gi    stato inizializzato, questa funzione emette un errore e termina senza fare nulla.
- *
- * @warning Assicurati di chiamare questa funzione prima di qualsiasi altro metodo dell'engine.
- */
-void LIB_API Engine::init(const std::string windowTitle, const int windowWidth, const int windowHeight)
-{
-    // Verifica se l'engine     gi    stato inizializzato
-    if (Engine::isInitializedFlag)
-    {
-        ERROR("Engine has already been initialized.");
-        return;
-    }
-
-    int argc = 0;
-
-    // Inizializza la libreria FreeGLUT. 
-    glutInit(&argc, NULL);
-
-    // Abilita il doppio buffer e il depth buffer.
-    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA | GLUT_DEPTH);
-
-    // Il ciclo principale di FreeLUT ritorna quando la finestra viene chiusa.
-    glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_GLUTMAINLOOP_RETURNS);
-
-    // Crea una finestra con il titolo specificato e inizializza il contesto
-    // !! Importante si pu    usare OpenGL solo dopo la sua invocazione
-    Engine::windowId = glutCreateWindow(windowTitle.c_str());
-
-    // Imposta la dimensione della finestra appena creata.
-    glutReshapeWindow(windowWidth, windowHeight);
-
-    // Come la superficie dei triangoli deve essere renderizzata.
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-    // Setup callbacks
-
-    // Questa funzione verr    chiamata da FreeLUT ogni volta che     necessario ridisegnare la finestra.
-    glutDisplayFunc(render);
-
-    // Per la gestione del ridimensionamento della finestra.
-    glutReshapeFunc(resizeCallback);
-
-    // Imposta un callback timer che chiama timerCallback ogni 50 millisecondi 
-    glutTimerFunc(50, timerCallback, 0);
-
-    // Configura OpenGL
-    // Abilita il test di profondit    per gestire la visibilit    degli oggetti.
-    glEnable(GL_DEPTH_TEST);
-    // Abilita la normalizzazione dei vettori per garantire che le normali siano sempre normalizzate.
-    // Le normali devono essere nomalizzate se ci sono scaling nella GL_MODELVIEW matrix.
-    glEnable(GL_NORMALIZE);
-    // Abilita l'illuminazione per il rendering.
-    glEnable(GL_LIGHTING);
-    // Abilita il cull face.
-    glEnable(GL_CULL_FACE);
-    // Abilita il supporto per il mapping delle texture 2D.
-    glEnable(GL_TEXTURE_2D);
-
-    // Configura la global light -> colore grigio scuro
-    // Verr    moltiplicato per il termine ambientale di ogni sorgente luminosa della scena
-    const glm::vec4 ambient(0.2f, 0.2f, 0.2f, 1.0f);
-    glLightModelfv(GL_LIGHT_MODEL_AMBIENT, glm::value_ptr(ambient));
-    // Riflessi speculari pi    accurati.
-    glLightModelf(GL_LIGHT_MODEL_LOCAL_VIEWER, 1.0f);
-
-    // Inizializza FreeImage
-    FreeImage_Initialise();
-
-    // Imposta il viewport iniziale per coprire l'intera finestra.
-    glViewport(0, 0, windowWidth, windowHeight);
-
-    // Configura il materiale per le ombre
-    // Colore ambientale del materiale per le ombre a nero.
-    Engine::shadowMaterial->setAmbientColor(glm::vec3(0.0f, 0.0f, 0.0f));
-    // Colore diffuso del materiale per le ombre a nero.
-    Engine::shadowMaterial->setDiffuseColor(glm::vec3(0.0f, 0.0f, 0.0f));
-    // Colore speculare del materiale per le ombre a nero.
-    Engine::shadowMaterial->setSpecularColor(glm::vec3(0.0f, 0.0f, 0.0f));
-    Engine::shadowMaterial->setShininess(0.0f);
-
-    // Avvia l'engine
-    Engine::isInitializedFlag = true;
-    Engine::isRunningFlag = true;
-}
-
-///// Getter
-
-/**
- * @brief Restituisce l'oggetto root della scena corrente.
- *
- * @return Un puntatore condiviso all'oggetto root della scena corrente.
- */
-std::shared_ptr<Node> LIB_API Engine::getScene()
-{
-    return Engine::scene;
-}
-
-/**
- * @brief Restituisce il puntatore alla telecamera attiva.
- *
- * @return Un puntatore condiviso alla telecamera attiva.
- */
-std::shared_ptr<Camera> LIB_API Engine::getActiveCamera() {
-    return activeCamera;
-}
-
-
-///// Setter
-
-/**
- * @brief Imposta il colore di sfondo della scena.
- *
- * @param red La quantit    di rosso nel colore di sfondo, compresa tra 0.0f e 1.0f.
- * @param green La quantit    di verde nel colore di sfondo, compresa tra 0.0f e 1.0f.
- * @param blue La quantit    di blu nel colore di sfondo, compresa tra 0.0f e 1.0f.
- */
-void LIB_API Engine::setBackGround(const float red, const float green, const float blue)
-{
-    glClearColor(red, green, blue, 1.0f);
-}
-
-/**
- * @brief Imposta il testo da visualizzare sullo schermo.
- *
- * @param newText Il testo da visualizzare sullo schermo.
- */
-void LIB_API Engine::setScreenText(const std::string newText)
-{
-    Engine::screenText = newText;
-}
-
-/**
- * @brief Imposta la scena da renderizzare.
- *
- * @param newScene Puntatore condiviso alla nuova scena da impostare.
- *
- * @note La camera attiva viene impostata su `nullptr`, il che significa che
- *       la nuova scena non avr    una camera attiva fino a quando non verr
- *       impostata tramite `setActiveCamera`.
- */
-void LIB_API Engine::setScene(const std::shared_ptr<Node> newScene)
-{
-    Engine::scene = newScene;
-    Engine::activeCamera = nullptr;
-}
-
-/**
- * @brief Imposta la camera attiva per il rendering della scena.
- *
- * @param newActiveCamera Puntatore condiviso alla nuova camera da impostare.
- */
-void LIB_API Engine::setActiveCamera(const std::shared_ptr<Camera> newActiveCamera)
-{
-    if (Engine::activeCamera != nullptr)
-    {
-        // Disabilia la vecchia camera
-        Engine::activeCamera->setActive(false);
-    }
-
-    // imposta le dimensioni della finestra della nuova camera
-    newActiveCamera->setWindowSize(Engine::windowWidth, Engine::windowHeight);
-    newActiveCamera->setActive(true);
-
-    Engine::activeCamera = newActiveCamera;
-}
-
-///// Set Callback
-
-/**
- * @brief Imposta un callback personalizzato per la gestione della pressione dei tasti.
- *
- * @param
- *      - newKeyboardCallback Puntatore alla funzione di callback che gestir    gli eventi di pressione dei tasti.
- *      - key     il codice del tasto premuto.
- *      - mouseX e mouseY sono le coordinate del mouse al momento della pressione (non usate).
- */
-void LIB_API Engine::setKeyboardCallback(void (*newKeyboardCallback) (const unsigned char key, const int mouseX, const int mouseY))
-{
-    // Quale funzione deve essere chiamata ogni volta che l'utente preme un tasto sulla tastiera.
-    glutKeyboardFunc(newKeyboardCallback);
-}
-
-/**
- * @brief Imposta un callback per gestire il lampeggiamento.
- *
- * @param callback Puntatore alla funzione di callback da chiamare per aggiornare
- * il lampeggiamento.
- */
-void LIB_API Engine::setBlinkingCallback(void (*callback)()) {
-    Engine::blinkingCallback = callback;
-}
-
-/**
- * @brief Imposta un callback per gestire gli eventi del mouse.
- *
- * @param fnct Puntatore alla funzione di callback per gestire gli eventi del mouse.
- *             La funzione callback deve accettare quattro parametri:
- *             - `int button`: Il pulsante del mouse che ha generato l'evento.
- *             - `int state`: Lo stato del pulsante del mouse (premuto o rilasciato).
- *             - `int mouseX`: La coordinata X del mouse al momento dell'evento.
- *             - `int mouseY`: La coordinata Y del mouse al momento dell'evento.
- */
-void LIB_API Engine::setMouseCallback(void(*newMouseCallback)(int button, int state, int mouseX, int mouseY)) {
-    glutMouseFunc(newMouseCallback);
-}
-
-/**
- * @brief Imposta una funzione di callback per gestire le pressioni di tasti speciali.
- *
- * Questa funzione registra un callback che viene chiamato ogni volta che un tasto speciale
- * (come le frecce direzionali) viene premuto.
- *
- * @param
-         - newSpecialCallback Puntatore alla funzione di callback.
- *       - key codice del tasto speciale premuto.
- *       - mouseX e mouseY sono le coordinate del mouse al momento della pressione.
- */
-void LIB_API Engine::setMethodSpecialCallback(void(*newSpecialCallback) (int key, int mouseX, int mouseY)) {
-    glutSpecialFunc(newSpecialCallback);
-}
-
-/**
- * @brief Renderizza la scena corrente.
- *
- * Questa funzione gestisce il rendering dell'intera scena, inclusi gli oggetti 3D, le ombre,
- * e il testo visualizzato sullo schermo.
- *
- * Se la scena o la telecamera non sono impostate, la funzione non esegue alcun rendering.
- */
-void LIB_API Engine::render()
-{
-    // Se non ce la scena o la telecamera esce
-    if (Engine::scene == nullptr || Engine::activeCamera == nullptr)
-        return;
-
-    Engine::activeCamera->setWindowSize(Engine::windowWidth, Engine::windowHeight);
-
-    int maxNrOfLights;
-    // Ottiene il numero massimo di luci che OpenGL pu    gestire.
-    glGetIntegerv(GL_MAX_LIGHTS, &maxNrOfLights);
-
-    // Disabilita tutte le luci.
-    for (int i = 0; i < maxNrOfLights; i++)
-        glDisable(GL_LIGHT0 + i);
-
-    // metodo ricorsivo --> Analizza tutti i nodi figli del nodo che lo invoca
-    // invocare pass sul root --> aggiunge il contenuto del grafo alla lista
-    std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> render = List::pass(Engine::scene, glm::mat4(1.0f));
-
-    List renderList;
-    renderList.setListRendering(render);
-
-    // Riordina la lista
-    renderList.sortListRendering();
-
-    // Ottiene l'inversa della camera matrix
-    const glm::mat4 inverseCameraMatrix = Engine::activeCamera->getInverseMatrix();
-
-    // Renderizza tutta la lista
-    renderList.render(inverseCameraMatrix);
-
-    // Fake shadow -> Rendering delle ombre
-
-    // Modifica la funzione di confronto del buffer di profondit    per permettere la scrittura anche per i pixel con la stessa profondit   .
-    glDepthFunc(GL_LEQUAL);
-
-    // Crea una matrice per ridurre l'altezza delle ombre.
-    const glm::mat4 shadowModelScaleMatrix = glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 0.05f, 1.0f));
-
-    for (const auto& node : renderList.getListRendering())
-    {
-        std::shared_ptr<Mesh> mesh = std::dynamic_pointer_cast<Mesh>(node.first);
-
-        // se     un Mesh e pu    proiettare ombre  
-        if (mesh != nullptr && mesh->getShadows())
-        {
-            // salva il materiale originale
-            const std::shared_ptr<Material> originalMaterial = mesh->getMaterial();
-
-            // Cambia temporaneamente il materiale della mesh con quello dell'ombra.
-            mesh->setMaterial(Engine::shadowMaterial);
-            const glm::mat4 shadow_matrix = shadowModelScaleMatrix * node.second;
-
-            // Si renderizza l'ombra.
-            mesh->render(inverseCameraMatrix * shadow_matrix);
-
-            // Si rimette il materiale originale della mesh.
-            mesh->setMaterial(originalMaterial);
-        }
-    }
-
-    // Ripristina la funzione di confronto del buffer di profondit    originale.
-    glDepthFunc(GL_LESS);
-
-    // Pulisce il buffer di profondit   , assicurando che il testo renderizzato appaia sopra la scena 3D.
-    glClear(GL_DEPTH_BUFFER_BIT); // Cos    la victory screen appare avanti
-
-
-    glMatrixMode(GL_PROJECTION);
-    glLoadMatrixf(glm::value_ptr(glm::ortho(0.0f, (float)Engine::windowWidth, 0.0f, (float)Engine::windowHeight, -1.0f, 1.0f)));
-    glMatrixMode(GL_MODELVIEW);
-    glLoadMatrixf(glm::value_ptr(glm::mat4(1.0f)));
-
-    // Disabilita l'illuminazione per il rendering del testo
-    glDisable(GL_LIGHTING);
-
-    // Imposta il colore del testo su bianco.
-    glColor3f(1.0f, 1.0f, 1.0f);
-
-    // Imposta la posizione del testo da renderizzare.
-    glRasterPos2f(16.0f, 5.0f);
-
-    std::string fps = "FPS: " + std::to_string((int)Engine::fps);
-
-    // Disegna il testo "FPS" e il testo della schermata.
-    glutBitmapString(GLUT_BITMAP_8_BY_13, (unsigned char*)fps.c_str());
-
-    // Imposta il punto di partenza per il rendering del testo
-    glRasterPos2f(16.0f, Engine::windowHeight - 32.0f);
-
-    // Disegna il testo specificato nella posizione impostata.
-    glutBitmapString(GLUT_BITMAP_8_BY_13, (unsigned char*)Engine::screenText.c_str());
-
-    // Riattiva l'illuminazione.
-    glEnable(GL_LIGHTING);
-
-    // Incrementa il conteggio dei frame: 
-    Engine::frames++;
-}
-
-/**
- * @brief Callback del tempo (timer)
- *
- * Questa funzione viene chiamata periodicamente tramite `glutTimerFunc` per aggiornare
- * il conteggio dei frames e calcolare il tempo trascorso per il blinking.
- *
- * @param value Il parametro utilizzato da `glutTimerFunc()`. Non     utilizzato nella funzione.
- */
-void LIB_API Engine::timerCallback(int value)
-{
-    timeCallback++; // ogni 50 ms
-
-    // Ogni secondo aggiorna il framerate
-    if (timeCallback == 20) {
-        Engine::fps = Engine::frames;
-        Engine::frames = 0;
-        std::cout << "fps: " << Engine::fps << std::endl;
-        timeCallback = 0;
-    }
-
-    // Esegui il callback per il lampeggiamento se definito
-    if (Engine::blinkingCallback != nullptr) {
-        Engine::blinkingCallback();
-    }
-
-    // Richiamata dopo 50 ms
-    glutTimerFunc(50, timerCallback, 0);
-}
-
-/**
- * @brief Vengono eseguite le callback.
- *
- * Questa funzione chiama `glutMainLoopEvent` per elaborare eventi come input da tastiera, mouse
- * o eventi di ridimensionamento della finestra. Serve a garantire che tutte le callback registrate
- * per questi eventi siano eseguite.
- *
- */
-void LIB_API Engine::update()
-{
-    // Chiamandola vengono gestite le callback
-    glutMainLoopEvent();
-}
-
-/**
- * @brief Pulisce il contenuto della finestra di rendering.
- *
- * @details
- * - `GL_COLOR_BUFFER_BIT` specifica che il buffer del colore deve essere azzerato.
- * - `GL_DEPTH_BUFFER_BIT` specifica che il buffer di profondit    deve essere azzerato.
- */
-void LIB_API Engine::clearScreen()
-{
-    // Preparare la finestra per un nuovo frame di rendering.
-    // Se no i valori del z buffer non vengono aggiornarti.
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-}
-
-/**
- * @brief Scambia i buffer back e front.
- *
- * Questa funzione utilizza `glutSwapBuffers` per scambiare il buffer anteriore con quello posteriore
- * in un'applicazione che utilizza il doppio buffering. Il buffer front contiene il frame attualmente
- * visualizzato, mentre il buffer back contiene il prossimo frame da visualizzare.
- */
-void LIB_API Engine::swapBuffers()
-{
-    glutSwapBuffers();
-}
-
-/**
- * @brief Invia una direttiva di arresto all'engine.
- */
-void LIB_API Engine::stop()
-{
-    Engine::isRunningFlag = false;
-}
-
-/**
- * @brief De-inizializza l'engine.
- *
- * Questa funzione libera le risorse utilizzate dall'engine e chiude il ciclo principale di GLUT.
- * Dovrebbe essere chiamata solo una volta alla fine dell'uso dell'engine e nessun'altra funzione dell'engine
- * dovrebbe essere chiamata dopo questa.
- */
-void LIB_API Engine::quit()
-{
-    // Utilizzata per liberare le risorse e fare la pulizia finale quando si termina l'uso della libreria FreeImage.
-    FreeImage_DeInitialise();
-
-    // Uscire dal ciclo principale di GLUT
-    glutLeaveMainLoop();
-}
-
-/**
- * @brief Restituisce lo stato del flag di esecuzione.
- *
- * @return `true` se l'engine     ancora in esecuzione, `false` se     stato fermato.
- */
-bool LIB_API Engine::isRunning()
-{
-    return Engine::isRunningFlag;
-}
-
-/**
- * @brief Gestisce il ridimensionamento della finestra.
- *
- * Questa funzione viene chiamata automaticamente da GLUT quando la finestra viene ridimensionata.
- *
- * @param width La nuova larghezza della finestra.
- * @param height La nuova altezza della finestra.
- */
-void LIB_API Engine::resizeCallback(const int width, const int height)
-{
-    // Larghezza attuale della finestra dopo il ridimensionamento.
-    Engine::windowWidth = width;
-    // Altezza attuale della finestra dopo il ridimensionamento.
-    Engine::windowHeight = height;
-
-    std::cout << "width: " << Engine::windowWidth << std::endl;
-    std::cout << "height: " << Engine::windowHeight << std::endl;
-
-    // Se esiste una camera attiva 
-    if (Engine::activeCamera != nullptr)
-        Engine::activeCamera->setWindowSize(Engine::windowWidth, Engine::windowHeight);
-
-    // Viewport: definisce l'area della finestra in cui disegnare.
-    // Copre l'intera finestra, partendo dall'angolo in basso a sinistra (0,0) fino alle nuove dimensioni.
-    glViewport(0, 0, width, height);
-}
-
-/**
- * @brief Trova un oggetto nella scena corrente per nome.
- *
- * @param nameToFind Il nome dell'oggetto da trovare.
- * @return Un puntatore condiviso all'oggetto trovato, oppure nullptr se nessun oggetto con il nome specificato     stato trovato.
- */
-std::shared_ptr<Node> LIB_API Engine::findObjectByName(const std::string nameToFind)
-{
-    const auto object = findObjectByName(nameToFind, Engine::scene);
-
-    // Se l'oggetto con il nome specificato non     stato trovato.
-    if (object == nullptr)
-        WARNING("Could not find object with name \"" << nameToFind << "\".");
-
-    return object;
-}
-
-/**
- * @brief Trova un oggetto nella scena corrente per nome.
- *
- * Questa funzione cerca ricorsivamente un oggetto nella scena corrente a partire dal nodo radice specificato.
- *
- * @param nameToFind Il nome dell'oggetto da trovare.
- * @param root Il nodo radice da cui iniziare la ricerca.
- * @return Un puntatore condiviso all'oggetto trovato, oppure nullptr se nessun oggetto con il nome specificato     stato trovato.
- */
-std::shared_ptr<Node> LIB_API Engine::findObjectByName(const std::string nameToFind, const std::shared_ptr<Node> root)
-{
-    // Itera su tutti i figli del nodo root.
-    for (const auto& child : root->getChildren())
-    {
-        // Verifica se il nome del nodo figlio corrisponde al nome cercato.
-        if (child->getName() == nameToFind)
-            return child;
-
-        // Continua la ricerca ricorsiva nei figli del nodo corrente.
-        const auto found = Engine::findObjectByName(nameToFind, child);
-
-        if (found != nullptr)
-            return found;
-    }
-
-    return nullptr;
-}
-
-/**
- * @brief Recupera un nodo selezionato cliccando con il mouse.
- *
- * Questa funzione esegue il rendering della scena in modalit    color picking per determinare quale
- * oggetto     stato selezionato con un clic del mouse. Utilizza la lettura del colore del pixel sotto
- * il cursore per identificare l'oggetto.
- *
- * @param mouseX La coordinata X del clic del mouse nella finestra.
- * @param mouseY La coordinata Y del clic del mouse nella finestra.
- *
- * @return Un puntatore condiviso al nodo selezionato, oppure `nullptr` se nessun nodo corrisponde
- *         al clic del mouse.
- *
- * @note La modalit    di color picking viene abilitata durante il rendering per associare un colore
- *       unico a ciascun oggetto. Dopo il rendering, viene letto il colore del pixel sotto il cursore
- *       per determinare l'ID dell'oggetto. La modalit    di color picking viene disabilitata una volta
- *       completata l'operazione.
- */
-std::shared_ptr<Node> LIB_API Engine::getNodeByClick(int mouseX, int mouseY)
-{
-    // Abilita il color picking
-    Mesh::isColorPickingMode = true;
-
-    // Esegui il rendering in modalit    color picking
-    Engine::render();
-
-    // Legge il colore del pixel sotto il cursore
-    unsigned char pixel[4];
-    glReadPixels(mouseX, Engine::windowHeight - mouseY, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
-
-    // Disabilita il color picking
-    Mesh::isColorPickingMode = false;
-
-    // Usa l'id per trovare l'oggetto selezionato.
-    int id = pixel[0];
-    std::shared_ptr<Node> selectedObject = Engine::findObjectByID(id);
-
-    return selectedObject;
-}
-
-/**
- * @brief Trova un oggetto nella scena corrente per ID.
- *
- * @param idToFind L'ID dell'oggetto da trovare.
- * @return Un puntatore condiviso all'oggetto trovato, oppure nullptr se nessun oggetto con l'ID specificato     stato trovato.
- */
-std::shared_ptr<Node> LIB_API Engine::findObjectByID(int idToFind)
-{
-    const auto object = findObjectByID(idToFind, Engine::scene);
-
-    // Se l'oggetto con l'ID specificato non     stato trovato.
-    if (object == nullptr)
-        WARNING("Could not find object with ID \"" << idToFind << "\".");
-
-    return object;
-}
-
-/**
- * @brief Trova un oggetto nella scena corrente per ID.
- *
- * Questa funzione cerca ricorsivamente un oggetto nella scena corrente a partire dal nodo radice specificato.
- *
- * @param idToFind L'ID dell'oggetto da trovare.
- * @param root Il nodo radice da cui iniziare la ricerca.
- * @return Un puntatore condiviso all'oggetto trovato, oppure nullptr se nessun oggetto con l'ID specificato     stato trovato.
- */
-std::shared_ptr<Node> LIB_API Engine::findObjectByID(int idToFind, const std::shared_ptr<Node> root)
-{
-    // Verifica se il nodo corrente ha l'ID che cerchiamo.
-    if (root->getId() == idToFind)
-        return root;
-
-    // Itera su tutti i figli del nodo root.
-    for (const auto& child : root->getChildren())
-    {
-        // Continua la ricerca ricorsiva nei figli del nodo corrente.
-        const auto found = Engine::findObjectByID(idToFind, child);
-
-        if (found != nullptr)
-            return found;
-    }
-
-    return nullptr;
-}
-
-bool LIB_API Engine::removeObject(const std::shared_ptr<Node>& nodeToRemove)
-{
-    if (!scene)
-    {
-        std::cerr << "Error: Scene is not set. Cannot remove object." << std::endl;
-        return false;
-    }
-
-    // Chiama la versione con due parametri, usando `scene` come radice
-    return removeObject(nodeToRemove, scene);
-}
-
-bool LIB_API Engine::removeObject(const std::shared_ptr<Node>& nodeToRemove, const std::shared_ptr<Node>& root)
-{
-
-    auto& children = root->getChildren(); // Ottieni i figli del nodo corrente
-
-    // Itera sui figli del nodo radice
-    for (auto it = children.begin(); it != children.end(); ++it)
-    {
-        if (*it == nodeToRemove)
-        {
-            // Nodo trovato, rimuovilo dal vettore dei figli
-            children.erase(it);
-            std::cout << "Removed node: " << nodeToRemove->getName() << std::endl;
-            return true;
-        }
-
-        // Ricorsione per cercare nei figli
-        if (removeObject(nodeToRemove, *it))
-        {
-            return true;
-        }
-    }
-
-    return false; // Nodo non trovato
-}
-
-/**
- * @brief Rimuove tutti i nodi figli dalla scena corrente.
- */
-void LIB_API Engine::removeAllObjects() {
-    if (!scene) {
-        std::cerr << "Error: Scene is not set. Cannot remove objects." << std::endl;
-        return;
-    }
-
-    // Rimuove tutti i figli della scena
-    scene->removeAllChildren();
-    std::cout << "All objects have been removed from the scene." << std::endl;
-}
-
-
-
-/**
- * @brief Restituisce la matrice di trasformazione globale di un nodo.
- *
- * Calcola ricorsivamente la trasformazione globale combinata di un nodo
- * sommando le trasformazioni di tutti i suoi genitori nella gerarchia della scena.
- *
- * @param node Il nodo di cui calcolare la matrice globale.
- * @return La matrice di trasformazione globale.
- */
-glm::mat4 Engine::getGlobalTransform(const std::shared_ptr<Node>& node) {
-    if (!node) {
-        std::cerr << "Error: Node is null. Cannot compute global transform." << std::endl;
-        return glm::mat4(1.0f);
-    }
-    if (!node->getParent()) {
-        return node->getTransform();
-    }
-    return getGlobalTransform(node->getParent()) * node->getTransform();
-}
-
-glm::vec3 Engine::getGlobalPosition(const std::shared_ptr<Node>& node) {
-    glm::mat4 globalTransform = getGlobalTransform(node);
-    return glm::vec3(globalTransform[3][0], globalTransform[3][1], globalTransform[3][2]);
-}
-
+#include "engine.h"
+#include "AllocationTracker.h"
+#include "GLExtensions.h"
+#include "Light.h"
+#include "LightManager.h"
+#include "PerspectiveCamera.h"
+#include "TextureManager.h"
+
+#ifdef _linux
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <GL/freeglut.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <FreeImage.h>
+
+bool Engine::isInitializedFlag = false;
+bool Engine::isRunningFlag = false;
+int Engine::windowId = 0;
+
+// scena caricata
+std::shared_ptr<Node> Engine::scene;
+
+std::shared_ptr<Camera> Engine::activeCamera;
+std::atomic<int> Engine::windowWidth{ 0 };
+std::atomic<int> Engine::windowHeight{ 0 };
+std::string Engine::screenText;
+
+// Materiale per le ombre
+std::shared_ptr<Material> Engine::shadowMaterial = std::make_shared<Material>();
+
+// Coda di rendering e statistiche sui cambi di stato
+RenderQueue Engine::renderQueue;
+TransformSystem Engine::transformSystem;
+size_t Engine::lastRenderListSize = 0;
+
+// Thread di simulazione e istantanee della scena
+SnapshotBuffer Engine::snapshots;
+std::thread Engine::simulationThread;
+std::atomic<bool> Engine::simulationRunning{ false };
+std::mutex Engine::simulationMutex;
+std::mutex Engine::commandMutex;
+std::vector<std::function<void()>> Engine::simulationCommands;
+
+// Sotto questa soglia di nodi la visita seriale costa meno della distribuzione dei task.
+static constexpr size_t PARALLEL_PASS_THRESHOLD = 2048;
+bool Engine::transformSystemEnabled = false;
+unsigned int Engine::avoidedStateChanges = 0;
+unsigned int Engine::submittedTriangles = 0;
+
+// Occlusion culling: la larghezza del depth buffer e' fissa, l'altezza segue la finestra.
+static constexpr int OCCLUSION_BUFFER_WIDTH = 256;
+OcclusionCuller Engine::occlusionCuller;
+bool Engine::occlusionCullingEnabled = true;
+unsigned int Engine::culledObjects = 0;
+
+// Risoluzione dinamica della scena 3D.
+DynamicResolution Engine::dynamicResolution;
+bool Engine::dynamicResolutionEnabled = true;
+
+// Blocchi di testo del motore (-1: non ancora creati).
+int Engine::statsTextBlock = -1;
+int Engine::screenTextBlock = -1;
+std::string Engine::statsText;
+
+// Lista dei nodi del frame, riutilizzata per non allocare a ogni frame.
+std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> Engine::renderList;
+
+// Tempo per frame dedicato alle risorse OpenGL dei caricamenti asincroni.
+static constexpr double SCENE_LOAD_BUDGET_MS = 2.0;
+
+// Istante dell'ultimo aggiornamento delle animazioni (-1: nessun aggiornamento).
+int Engine::lastUpdateTime = -1;
+
+// Frames:
+int Engine::frames = 0;
+float Engine::fps = 0.0f;
+void (*Engine::blinkingCallback)() = nullptr;
+
+// Conta quanto tempo     passato
+int timeCallback = 0;
+
+
+// se il simbolo _WINDOWS     definito.
+#ifdef _WINDOWS
+#include <Windows.h>
+
+// Questa funzione viene chiamata automaticamente dal sistema operativo quando un processo carica o scarica una DLL.
+
+// HANDLE instDLL: Un handle alla DLL che viene caricato o scaricato.
+// DWORD reason: Un codice che indica il motivo per cui la funzione DllMain     stata chiamata. 
+int APIENTRY DllMain(HANDLE instDLL, DWORD reason, LPVOID _reserved)
+{
+    switch (reason)
+    {
+        // Un processo sta caricando la DLL. 
+    case DLL_PROCESS_ATTACH:
+        break;
+
+        // Un processo sta scaricando la DLL.
+    case DLL_PROCESS_DETACH:
+        break;
+    }
+
+    return true;
+}
+#endif
+
+/**
+ * @brief Inizializza il motore grafico e crea una finestra con le specifiche fornite.
+ *
+ * Questa funzione configura e inizializza il motore grafico, inclusi i parametri della finestra,
+ * il sistema di rendering OpenGL, e la libreria FreeImage per la manipolazione delle immagini.
+ * Verifica anche se l'engine     gi    stato inizializzato per evitare inizializzazioni multiple.
+ *
+ * @param windowTitle Il titolo da assegnare alla finestra creata.
+ * @param windowWidth La larghezza della finestra in pixel.
+ * @param windowHeight L'altezza della finestra in pixel.
+ *
+ * @note Se l'engine     gi    stato inizializzato, questa funzione emette un errore e termina senza fare nulla.
+ *
+ * @warning Assicurati di chiamare questa funzione prima di qualsiasi altro metodo dell'engine.
+ */
+void LIB_API Engine::init(const std::string windowTitle, const int windowWidth, const int windowHeight)
+{
+    // Verifica se l'engine     gi    stato inizializzato
+    if (Engine::isInitializedFlag)
+    {
+        ERROR("Engine has already been initialized.");
+        return;
+    }
+
+    int argc = 0;
+
+    // Inizializza la libreria FreeGLUT. 
+    glutInit(&argc, NULL);
+
+    // Abilita il doppio buffer e il depth buffer.
+    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA | GLUT_DEPTH);
+
+    // Il ciclo principale di FreeLUT ritorna quando la finestra viene chiusa.
+    glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_GLUTMAINLOOP_RETURNS);
+
+    // Crea una finestra con il titolo specificato e inizializza il contesto
+    // !! Importante si pu    usare OpenGL solo dopo la sua invocazione
+    Engine::windowId = glutCreateWindow(windowTitle.c_str());
+
+    // Imposta la dimensione della finestra appena creata.
+    glutReshapeWindow(windowWidth, windowHeight);
+
+    // Come la superficie dei triangoli deve essere renderizzata.
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    // Setup callbacks
+
+    // Questa funzione verr    chiamata da FreeLUT ogni volta che     necessario ridisegnare la finestra.
+    glutDisplayFunc(render);
+
+    // Per la gestione del ridimensionamento della finestra.
+    glutReshapeFunc(resizeCallback);
+
+    // Imposta un callback timer che chiama timerCallback ogni 50 millisecondi 
+    glutTimerFunc(50, timerCallback, 0);
+
+    // Configura OpenGL
+    // Abilita il test di profondit    per gestire la visibilit    degli oggetti.
+    glEnable(GL_DEPTH_TEST);
+    // Abilita la normalizzazione dei vettori per garantire che le normali siano sempre normalizzate.
+    // Le normali devono essere nomalizzate se ci sono scaling nella GL_MODELVIEW matrix.
+    glEnable(GL_NORMALIZE);
+    // Abilita l'illuminazione per il rendering.
+    glEnable(GL_LIGHTING);
+    // Abilita il cull face.
+    glEnable(GL_CULL_FACE);
+    // Abilita il supporto per il mapping delle texture 2D.
+    glEnable(GL_TEXTURE_2D);
+
+    // Configura la global light -> colore grigio scuro
+    // Verr    moltiplicato per il termine ambientale di ogni sorgente luminosa della scena
+    const glm::vec4 ambient(0.2f, 0.2f, 0.2f, 1.0f);
+    glLightModelfv(GL_LIGHT_MODEL_AMBIENT, glm::value_ptr(ambient));
+    // Riflessi speculari pi    accurati.
+    glLightModelf(GL_LIGHT_MODEL_LOCAL_VIEWER, 1.0f);
+
+    // Carica le funzioni OpenGL successive alla 1.1 e prepara l'illuminazione via shader.
+    GLExtensions::load();
+    LightManager::init();
+
+    // Atlante dei glifi e blocchi di testo del motore: statistiche in basso, testo della schermata in alto.
+    TextRenderer::init();
+    Engine::statsTextBlock = TextRenderer::add("", glm::vec2(16.0f, 5.0f));
+    Engine::screenTextBlock = TextRenderer::add("", glm::vec2(16.0f, windowHeight - 32.0f));
+
+    // Inizializza FreeImage
+    FreeImage_Initialise();
+
+    // Imposta il viewport iniziale per coprire l'intera finestra.
+    glViewport(0, 0, windowWidth, windowHeight);
+
+    // Configura il materiale per le ombre
+    // Colore ambientale del materiale per le ombre a nero.
+    Engine::shadowMaterial->setAmbientColor(glm::vec3(0.0f, 0.0f, 0.0f));
+    // Colore diffuso del materiale per le ombre a nero.
+    Engine::shadowMaterial->setDiffuseColor(glm::vec3(0.0f, 0.0f, 0.0f));
+    // Colore speculare del materiale per le ombre a nero.
+    Engine::shadowMaterial->setSpecularColor(glm::vec3(0.0f, 0.0f, 0.0f));
+    Engine::shadowMaterial->setShininess(0.0f);
+
+    // Avvia l'engine
+    Engine::isInitializedFlag = true;
+    Engine::isRunningFlag = true;
+}
+
+///// Getter
+
+/**
+ * @brief Restituisce l'oggetto root della scena corrente.
+ *
+ * @return Un puntatore condiviso all'oggetto root della scena corrente.
+ */
+std::shared_ptr<Node> LIB_API Engine::getScene()
+{
+    return Engine::scene;
+}
+
+/**
+ * @brief Restituisce il puntatore alla telecamera attiva.
+ *
+ * @return Un puntatore condiviso alla telecamera attiva.
+ */
+std::shared_ptr<Camera> LIB_API Engine::getActiveCamera() {
+    return activeCamera;
+}
+
+
+///// Setter
+
+/**
+ * @brief Imposta il colore di sfondo della scena.
+ *
+ * @param red La quantit    di rosso nel colore di sfondo, compresa tra 0.0f e 1.0f.
+ * @param green La quantit    di verde nel colore di sfondo, compresa tra 0.0f e 1.0f.
+ * @param blue La quantit    di blu nel colore di sfondo, compresa tra 0.0f e 1.0f.
+ */
+void LIB_API Engine::setBackGround(const float red, const float green, const float blue)
+{
+    glClearColor(red, green, blue, 1.0f);
+}
+
+/**
+ * @brief Imposta il testo da visualizzare sullo schermo.
+ *
+ * @param newText Il testo da visualizzare sullo schermo.
+ */
+void LIB_API Engine::setScreenText(const std::string newText)
+{
+    Engine::screenText = newText;
+}
+
+/**
+ * @brief Imposta la scena da renderizzare.
+ *
+ * @param newScene Puntatore condiviso alla nuova scena da impostare.
+ *
+ * @note La camera attiva viene impostata su `nullptr`, il che significa che
+ *       la nuova scena non avr    una camera attiva fino a quando non verr
+ *       impostata tramite `setActiveCamera`.
+ */
+void LIB_API Engine::setScene(const std::shared_ptr<Node> newScene)
+{
+    Engine::scene = newScene;
+    Engine::activeCamera = nullptr;
+}
+
+/**
+ * @brief Imposta la camera attiva per il rendering della scena.
+ *
+ * @param newActiveCamera Puntatore condiviso alla nuova camera da impostare.
+ */
+void LIB_API Engine::setActiveCamera(const std::shared_ptr<Camera> newActiveCamera)
+{
+    if (Engine::activeCamera != nullptr)
+    {
+        // Disabilia la vecchia camera
+        Engine::activeCamera->setActive(false);
+    }
+
+    // imposta le dimensioni della finestra della nuova camera
+    newActiveCamera->setWindowSize(Engine::windowWidth, Engine::windowHeight);
+    newActiveCamera->setActive(true);
+
+    Engine::activeCamera = newActiveCamera;
+}
+
+///// Set Callback
+
+/**
+ * @brief Imposta un callback personalizzato per la gestione della pressione dei tasti.
+ *
+ * @param
+ *      - newKeyboardCallback Puntatore alla funzione di callback che gestir    gli eventi di pressione dei tasti.
+ *      - key     il codice del tasto premuto.
+ *      - mouseX e mouseY sono le coordinate del mouse al momento della pressione (non usate).
+ */
+void LIB_API Engine::setKeyboardCallback(void (*newKeyboardCallback) (const unsigned char key, const int mouseX, const int mouseY))
+{
+    // Quale funzione deve essere chiamata ogni volta che l'utente preme un tasto sulla tastiera.
+    glutKeyboardFunc(newKeyboardCallback);
+}
+
+/**
+ * @brief Imposta un callback per gestire il lampeggiamento.
+ *
+ * @param callback Puntatore alla funzione di callback da chiamare per aggiornare
+ * il lampeggiamento.
+ */
+void LIB_API Engine::setBlinkingCallback(void (*callback)()) {
+    Engine::blinkingCallback = callback;
+}
+
+/**
+ * @brief Imposta un callback per gestire gli eventi del mouse.
+ *
+ * @param fnct Puntatore alla funzione di callback per gestire gli eventi del mouse.
+ *             La funzione callback deve accettare quattro parametri:
+ *             - `int button`: Il pulsante del mouse che ha generato l'evento.
+ *             - `int state`: Lo stato del pulsante del mouse (premuto o rilasciato).
+ *             - `int mouseX`: La coordinata X del mouse al momento dell'evento.
+ *             - `int mouseY`: La coordinata Y del mouse al momento dell'evento.
+ */
+void LIB_API Engine::setMouseCallback(void(*newMouseCallback)(int button, int state, int mouseX, int mouseY)) {
+    glutMouseFunc(newMouseCallback);
+}
+
+/**
+ * @brief Imposta una funzione di callback per gestire le pressioni di tasti speciali.
+ *
+ * Questa funzione registra un callback che viene chiamato ogni volta che un tasto speciale
+ * (come le frecce direzionali) viene premuto.
+ *
+ * @param
+         - newSpecialCallback Puntatore alla funzione di callback.
+ *       - key codice del tasto speciale premuto.
+ *       - mouseX e mouseY sono le coordinate del mouse al momento della pressione.
+ */
+void LIB_API Engine::setMethodSpecialCallback(void(*newSpecialCallback) (int key, int mouseX, int mouseY)) {
+    glutSpecialFunc(newSpecialCallback);
+}
+
+/**
+ * @brief Renderizza la scena corrente.
+ *
+ * Questa funzione gestisce il rendering dell'intera scena, inclusi gli oggetti 3D, le ombre,
+ * e il testo visualizzato sullo schermo.
+ *
+ * Se la scena o la telecamera non sono impostate, la funzione non esegue alcun rendering.
+ */
+void LIB_API Engine::render()
+{
+    // Risorse OpenGL rilasciate dal thread di simulazione.
+    GLExtensions::flushReleases();
+
+    // Con la simulazione attiva si disegna solo l'ultima istantanea pubblicata.
+    const SceneSnapshot* snapshot = nullptr;
+    std::shared_ptr<Camera> camera;
+
+    // Parametri della camera: copiati nell'istantanea o letti dalla camera attiva.
+    bool perspective;
+    float fov;
+    float nearClipping;
+    float farClipping;
+
+    if (Engine::isSimulationRunning())
+    {
+        // La camera attiva appartiene al thread di simulazione: non viene letta ne' modificata.
+        snapshot = Engine::snapshots.acquire();
+
+        if (snapshot == nullptr || snapshot->camera == nullptr)
+            return;
+
+        perspective = snapshot->perspective;
+        fov = snapshot->fov;
+        nearClipping = snapshot->nearClipping;
+        farClipping = snapshot->farClipping;
+    }
+    else
+    {
+        camera = Engine::activeCamera;
+
+        // Se non ce la scena o la telecamera esce
+        if (Engine::scene == nullptr || camera == nullptr)
+            return;
+
+        camera->setWindowSize(Engine::windowWidth, Engine::windowHeight);
+
+        perspective = std::dynamic_pointer_cast<PerspectiveCamera>(camera) != nullptr;
+        fov = camera->getFov();
+        nearClipping = camera->getNearClipping();
+        farClipping = camera->getFarClipping();
+    }
+
+    // La scena 3D va nel framebuffer ridotto; il color picking legge i pixel della finestra e ne resta fuori.
+    const bool scaled = Engine::dynamicResolutionEnabled && !Mesh::isColorPickingMode &&
+        Engine::dynamicResolution.begin(Engine::windowWidth, Engine::windowHeight);
+    const int viewportWidth = scaled ? Engine::dynamicResolution.getRenderWidth(Engine::windowWidth) : Engine::windowWidth.load();
+    const int viewportHeight = scaled ? Engine::dynamicResolution.getRenderHeight(Engine::windowHeight) : Engine::windowHeight.load();
+
+    // Spegne solo gli slot delle luci usati nel frame precedente.
+    LightManager::beginFrame();
+
+    // La griglia dei cluster delle luci segue la proiezione della camera prospettica.
+    if (perspective && Engine::windowHeight > 0)
+        LightManager::setProjection(fov, (float)Engine::windowWidth / (float)Engine::windowHeight,
+            nearClipping, farClipping, viewportWidth, viewportHeight);
+    else
+        LightManager::setProjection(0.0f, 0.0f, 0.0f, 0.0f, 0, 0);
+
+    // I livelli di dettaglio delle mesh dipendono dalla dimensione proiettata sullo schermo.
+    if (perspective)
+        Mesh::setLodProjection(fov, viewportHeight);
+    else
+        Mesh::setLodProjection(0.0f, 0);
+    Mesh::resetSubmittedTriangles();
+
+    // Lo stato OpenGL potrebbe essere stato modificato fuori dai materiali.
+    Material::invalidateStateCache();
+    Material::resetAvoidedStateChanges();
+
+    glm::mat4 inverseCameraMatrix;
+
+    if (snapshot != nullptr)
+    {
+        // Matrici e materiali sono gia' stati letti dal thread di simulazione.
+        inverseCameraMatrix = snapshot->inverseCameraMatrix;
+        Engine::renderQueue.build(*snapshot);
+
+        // Le camere non sono nell'istantanea: la proiezione viene impostata qui.
+        if (perspective && Engine::windowHeight > 0)
+        {
+            const glm::mat4 projection = glm::perspective(glm::radians(fov), (float)Engine::windowWidth / (float)Engine::windowHeight, nearClipping, farClipping);
+
+            glMatrixMode(GL_PROJECTION);
+            glLoadMatrixf(glm::value_ptr(projection));
+        }
+    }
+    else
+    {
+        // La lista mantiene vivi i nodi della coda fino alla fine del frame.
+        Engine::buildRenderList(Engine::renderList);
+
+        // Ottiene l'inversa della camera matrix
+        inverseCameraMatrix = camera->getInverseMatrix();
+
+        Engine::renderQueue.build(Engine::renderList, inverseCameraMatrix);
+    }
+
+    // Ordina per passo (camere, luci, mesh), texture, materiale e profondita'.
+    Engine::renderQueue.sort();
+
+    // Le mesh nascoste dagli occlusori non vengono disegnate, ma ne restano le ombre.
+    Engine::culledObjects = 0;
+    if (Engine::occlusionCullingEnabled && perspective && Engine::windowWidth > 0 && Engine::windowHeight > 0)
+    {
+        const float aspectRatio = (float)Engine::windowWidth / (float)Engine::windowHeight;
+        const glm::mat4 projection = glm::perspective(glm::radians(fov), aspectRatio, nearClipping, farClipping);
+
+        Engine::occlusionCuller.setResolution(OCCLUSION_BUFFER_WIDTH, (int)(OCCLUSION_BUFFER_WIDTH / aspectRatio));
+        Engine::culledObjects = (unsigned int)Engine::occlusionCuller.cull(Engine::renderQueue, projection, inverseCameraMatrix);
+    }
+
+    // Il color picking usa colori piatti: il programma di illuminazione resta disattivo.
+    if (!Mesh::isColorPickingMode)
+        LightManager::bind();
+
+    // Renderizza tutta la coda
+    Engine::renderQueue.render(inverseCameraMatrix);
+
+    // Ombre e testo usano la pipeline fissa.
+    LightManager::unbind();
+
+    // Fake shadow -> Rendering delle ombre
+
+    // Modifica la funzione di confronto del buffer di profondit    per permettere la scrittura anche per i pixel con la stessa profondit   .
+    glDepthFunc(GL_LEQUAL);
+
+    // Crea una matrice per ridurre l'altezza delle ombre.
+    const glm::mat4 shadowModelScaleMatrix = glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 0.05f, 1.0f));
+
+    // Tutte le ombre usano lo stesso materiale: la cache evita di riapplicarlo.
+    const MaterialState& shadowState = Engine::shadowMaterial->getState();
+
+    // Anche le mesh trasparenti e quelle nascoste dagli occlusori proiettano l'ombra.
+    for (const std::vector<RenderItem>* items : { &Engine::renderQueue.getItems(), &Engine::renderQueue.getCulledItems(), &Engine::renderQueue.getTransparentItems() })
+    {
+        for (const auto& item : *items)
+        {
+            // Solo le mesh hanno un materiale nella coda.
+            const Mesh* mesh = item.material != nullptr ? static_cast<const Mesh*>(item.node) : nullptr;
+
+            // se     un Mesh e pu    proiettare ombre  
+            if (mesh != nullptr && mesh->getShadows())
+            {
+                const glm::mat4 shadow_matrix = shadowModelScaleMatrix * item.worldMatrix;
+
+                // Si renderizza l'ombra con il materiale dell'ombra, senza modificare la mesh
+                // ne' il livello di dettaglio scelto dalla sua distanza reale.
+                mesh->render(inverseCameraMatrix * shadow_matrix, shadowState, nullptr, false);
+            }
+        }
+    }
+
+    // Ripristina la funzione di confronto del buffer di profondit    originale.
+    glDepthFunc(GL_LESS);
+
+    // Le mesh trasparenti vengono disegnate per ultime, dopo tutta la geometria opaca e le ombre.
+    if (!Engine::renderQueue.getTransparentItems().empty())
+    {
+        if (!Mesh::isColorPickingMode)
+            LightManager::bind();
+
+        Engine::renderQueue.renderTransparent(inverseCameraMatrix);
+        LightManager::unbind();
+    }
+
+    // La scena viene ingrandita nella finestra; il testo resta alla risoluzione nativa.
+    if (scaled)
+        Engine::dynamicResolution.end();
+
+    Engine::avoidedStateChanges = Material::getAvoidedStateChanges();
+    Engine::submittedTriangles = Mesh::getSubmittedTriangles();
+
+    // Pulisce il buffer di profondit   , assicurando che il testo renderizzato appaia sopra la scena 3D.
+    glClear(GL_DEPTH_BUFFER_BIT); // Cos    la victory screen appare avanti
+
+
+    // Le statistiche vengono scritte in un buffer sullo stack e copiate in una stringa riutilizzata.
+    char stats[256];
+    std::snprintf(stats, sizeof(stats), "FPS: %d  State changes avoided: %u  Triangles: %u  Culled: %u  Streaming: %zu (%zu KB)  Scale: %d%%  Allocs: %zu (%zu B)",
+        (int)Engine::fps, Engine::avoidedStateChanges, Engine::submittedTriangles, Engine::culledObjects,
+        TextureStreamer::getQueueDepth(), TextureStreamer::getBytesStreamedLastFrame() / 1024,
+        (int)std::lround(Engine::getRenderScale() * 100.0f),
+        AllocationTracker::getFrameAllocations(), AllocationTracker::getFrameBytes());
+    Engine::statsText.assign(stats);
+
+    // I quadrati dei blocchi vengono ricalcolati solo se il testo e' cambiato.
+    const std::string& text = snapshot != nullptr ? snapshot->screenText : Engine::screenText;
+    TextRenderer::setText(Engine::statsTextBlock, Engine::statsText);
+    TextRenderer::setText(Engine::screenTextBlock, text);
+    TextRenderer::setPosition(Engine::screenTextBlock, glm::vec2(16.0f, Engine::windowHeight - 32.0f));
+
+    // Il testo e tutti i blocchi aggiunti dall'applicazione, alla risoluzione della finestra.
+    TextRenderer::render(Engine::windowWidth, Engine::windowHeight);
+
+    // Rilascia i nodi del frame: la lista conserva la memoria per il prossimo.
+    Engine::renderList.clear();
+
+    // Allocazioni del thread di rendering in questo frame (mostrate nel frame successivo).
+    AllocationTracker::markFrame();
+
+    // Incrementa il conteggio dei frame: 
+    Engine::frames++;
+}
+
+/**
+ * @brief Calcola la lista dei nodi da renderizzare con le rispettive matrici globali.
+ *
+ * @param renderList La lista da riempire.
+ */
+void Engine::buildRenderList(std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& renderList)
+{
+    renderList.clear();
+
+    if (Engine::transformSystemEnabled)
+    {
+        // Gli array vengono ricostruiti solo quando la gerarchia cambia.
+        if (Engine::transformSystem.isStale(Engine::scene))
+            Engine::transformSystem.build(Engine::scene);
+
+        Engine::transformSystem.update();
+        Engine::transformSystem.fillRenderList(renderList);
+    }
+    else if (Engine::lastRenderListSize >= PARALLEL_PASS_THRESHOLD)
+    {
+        // Scene grandi: i sottoalberi vengono visitati in parallelo dal pool del motore
+        // (le liste dei sottoalberi vengono allocate a ogni frame).
+        renderList = List::pass(Engine::scene, glm::mat4(1.0f), TaskPool::getShared());
+    }
+    else
+    {
+        // metodo ricorsivo --> Analizza tutti i nodi figli del nodo che lo invoca
+        // invocare pass sul root --> aggiunge il contenuto del grafo alla lista
+        List::pass(Engine::scene, glm::mat4(1.0f), renderList);
+    }
+    Engine::lastRenderListSize = renderList.size();
+}
+
+/**
+ * @brief Callback del tempo (timer)
+ *
+ * Questa funzione viene chiamata periodicamente tramite `glutTimerFunc` per aggiornare
+ * il conteggio dei frames e calcolare il tempo trascorso per il blinking.
+ *
+ * @param value Il parametro utilizzato da `glutTimerFunc()`. Non     utilizzato nella funzione.
+ */
+void LIB_API Engine::timerCallback(int value)
+{
+    timeCallback++; // ogni 50 ms
+
+    // Ogni secondo aggiorna il framerate
+    if (timeCallback == 20) {
+        Engine::fps = Engine::frames;
+        Engine::frames = 0;
+        DEBUG("fps: " << Engine::fps);
+        timeCallback = 0;
+    }
+
+    // Esegui il callback per il lampeggiamento se definito (modifica la scena: va alla simulazione)
+    if (Engine::blinkingCallback != nullptr) {
+        Engine::postToSimulation(Engine::blinkingCallback);
+    }
+
+    // Richiamata dopo 50 ms
+    glutTimerFunc(50, timerCallback, 0);
+}
+
+/**
+ * @brief Vengono eseguite le callback e avanzate le animazioni.
+ *
+ * Questa funzione chiama `glutMainLoopEvent` per elaborare eventi come input da tastiera, mouse
+ * o eventi di ridimensionamento della finestra. Serve a garantire che tutte le callback registrate
+ * per questi eventi siano eseguite. Successivamente avanza tutte le animazioni attive
+ * dell'`Animator` in base al tempo reale trascorso dall'ultima chiamata.
+ *
+ */
+void LIB_API Engine::update()
+{
+    // Chiamandola vengono gestite le callback
+    glutMainLoopEvent();
+
+    // Tempo trascorso dall'ultimo frame, indipendente dal framerate.
+    const int now = glutGet(GLUT_ELAPSED_TIME);
+    const float deltaTime = Engine::lastUpdateTime < 0 ? 0.0f : (now - Engine::lastUpdateTime) / 1000.0f;
+    Engine::lastUpdateTime = now;
+
+    // Con la simulazione attiva le animazioni avanzano sul suo thread.
+    if (!Engine::isSimulationRunning())
+        Animator::update(deltaTime);
+
+    // Caricamenti asincroni: poche risorse OpenGL per frame, poi i sottoalberi pronti entrano nella scena.
+    if (SceneLoader::hasPendingWork())
+    {
+        SceneLoader::upload(SCENE_LOAD_BUDGET_MS);
+
+        std::unique_lock<std::mutex> simulationLock;
+        if (Engine::isSimulationRunning())
+            simulationLock = Engine::lockSimulation();
+
+        SceneLoader::attachReady();
+    }
+
+    // Texture decodificate in background: al massimo il budget di byte del frame.
+    TextureStreamer::update();
+}
+
+/**
+ * @brief Pulisce il contenuto della finestra di rendering.
+ *
+ * @details
+ * - `GL_COLOR_BUFFER_BIT` specifica che il buffer del colore deve essere azzerato.
+ * - `GL_DEPTH_BUFFER_BIT` specifica che il buffer di profondit    deve essere azzerato.
+ */
+void LIB_API Engine::clearScreen()
+{
+    // Preparare la finestra per un nuovo frame di rendering.
+    // Se no i valori del z buffer non vengono aggiornarti.
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+/**
+ * @brief Scambia i buffer back e front.
+ *
+ * Questa funzione utilizza `glutSwapBuffers` per scambiare il buffer anteriore con quello posteriore
+ * in un'applicazione che utilizza il doppio buffering. Il buffer front contiene il frame attualmente
+ * visualizzato, mentre il buffer back contiene il prossimo frame da visualizzare.
+ */
+void LIB_API Engine::swapBuffers()
+{
+    glutSwapBuffers();
+}
+
+/**
+ * @brief Invia una direttiva di arresto all'engine.
+ */
+void LIB_API Engine::stop()
+{
+    Engine::isRunningFlag = false;
+}
+
+/**
+ * @brief De-inizializza l'engine.
+ *
+ * Questa funzione libera le risorse utilizzate dall'engine e chiude il ciclo principale di GLUT.
+ * Dovrebbe essere chiamata solo una volta alla fine dell'uso dell'engine e nessun'altra funzione dell'engine
+ * dovrebbe essere chiamata dopo questa.
+ */
+void LIB_API Engine::quit()
+{
+    // La simulazione non deve toccare la scena durante la pulizia.
+    Engine::stopSimulation();
+    SceneLoader::cancelAll();
+    TextureStreamer::quit();
+    Engine::dynamicResolution.release();
+    TextRenderer::quit();
+
+    // Libera il programma di illuminazione e l'uniform buffer delle luci.
+    LightManager::quit();
+
+    // Le texture ancora in uso vengono liberate con i materiali che le usano.
+    TextureManager::clear();
+    Engine::transformSystem.clear();
+
+    // Utilizzata per liberare le risorse e fare la pulizia finale quando si termina l'uso della libreria FreeImage.
+    FreeImage_DeInitialise();
+
+    // Scrive i messaggi ancora in coda e ferma il thread del registro.
+    Logger::quit();
+
+    // Uscire dal ciclo principale di GLUT
+    glutLeaveMainLoop();
+}
+
+/**
+ * @brief Restituisce lo stato del flag di esecuzione.
+ *
+ * @return `true` se l'engine     ancora in esecuzione, `false` se     stato fermato.
+ */
+bool LIB_API Engine::isRunning()
+{
+    return Engine::isRunningFlag;
+}
+
+/**
+ * @brief Gestisce il ridimensionamento della finestra.
+ *
+ * Questa funzione viene chiamata automaticamente da GLUT quando la finestra viene ridimensionata.
+ *
+ * @param width La nuova larghezza della finestra.
+ * @param height La nuova altezza della finestra.
+ */
+void LIB_API Engine::resizeCallback(const int width, const int height)
+{
+    // Larghezza attuale della finestra dopo il ridimensionamento.
+    Engine::windowWidth = width;
+    // Altezza attuale della finestra dopo il ridimensionamento.
+    Engine::windowHeight = height;
+
+    DEBUG("width: " << Engine::windowWidth);
+    DEBUG("height: " << Engine::windowHeight);
+
+    // La camera attiva appartiene al thread di simulazione, se attivo: riceve le dimensioni come comando.
+    Engine::postToSimulation([width, height]() {
+        if (Engine::activeCamera != nullptr)
+            Engine::activeCamera->setWindowSize(width, height);
+    });
+
+    // Viewport: definisce l'area della finestra in cui disegnare.
+    // Copre l'intera finestra, partendo dall'angolo in basso a sinistra (0,0) fino alle nuove dimensioni.
+    glViewport(0, 0, width, height);
+}
+
+/**
+ * @brief Trova un oggetto nella scena corrente per nome.
+ *
+ * @param nameToFind Il nome dell'oggetto da trovare.
+ * @return Un puntatore condiviso all'oggetto trovato, oppure nullptr se nessun oggetto con il nome specificato     stato trovato.
+ */
+std::shared_ptr<Node> LIB_API Engine::findObjectByName(const std::string nameToFind)
+{
+    const auto object = findObjectByName(nameToFind, Engine::scene);
+
+    // Se l'oggetto con il nome specificato non     stato trovato.
+    if (object == nullptr)
+        WARNING("Could not find object with name \"" << nameToFind << "\".");
+
+    return object;
+}
+
+/**
+ * @brief Trova un oggetto nella scena corrente per nome.
+ *
+ * Questa funzione cerca ricorsivamente un oggetto nella scena corrente a partire dal nodo radice specificato.
+ *
+ * @param nameToFind Il nome dell'oggetto da trovare.
+ * @param root Il nodo radice da cui iniziare la ricerca.
+ * @return Un puntatore condiviso all'oggetto trovato, oppure nullptr se nessun oggetto con il nome specificato     stato trovato.
+ */
+std::shared_ptr<Node> LIB_API Engine::findObjectByName(const std::string nameToFind, const std::shared_ptr<Node> root)
+{
+    // Itera su tutti i figli del nodo root.
+    for (const auto& child : root->getChildren())
+    {
+        // Verifica se il nome del nodo figlio corrisponde al nome cercato.
+        if (child->getName() == nameToFind)
+            return child;
+
+        // Continua la ricerca ricorsiva nei figli del nodo corrente.
+        const auto found = Engine::findObjectByName(nameToFind, child);
+
+        if (found != nullptr)
+            return found;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Recupera un nodo selezionato cliccando con il mouse.
+ *
+ * Questa funzione esegue il rendering della scena in modalit    color picking per determinare quale
+ * oggetto     stato selezionato con un clic del mouse. Utilizza la lettura del colore del pixel sotto
+ * il cursore per identificare l'oggetto.
+ *
+ * @param mouseX La coordinata X del clic del mouse nella finestra.
+ * @param mouseY La coordinata Y del clic del mouse nella finestra.
+ *
+ * @return Un puntatore condiviso al nodo selezionato, oppure `nullptr` se nessun nodo corrisponde
+ *         al clic del mouse.
+ *
+ * @note La modalit    di color picking viene abilitata durante il rendering per associare un colore
+ *       unico a ciascun oggetto. Dopo il rendering, viene letto il colore del pixel sotto il cursore
+ *       per determinare l'ID dell'oggetto. La modalit    di color picking viene disabilitata una volta
+ *       completata l'operazione.
+ */
+std::shared_ptr<Node> LIB_API Engine::getNodeByClick(int mouseX, int mouseY)
+{
+    // Abilita il color picking
+    Mesh::isColorPickingMode = true;
+
+    // Esegui il rendering in modalit    color picking
+    Engine::render();
+
+    // Legge il colore del pixel sotto il cursore
+    unsigned char pixel[4];
+    glReadPixels(mouseX, Engine::windowHeight - mouseY, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+
+    // Disabilita il color picking
+    Mesh::isColorPickingMode = false;
+
+    // La risoluzione legge la gerarchia della scena: la simulazione resta ferma fino alla fine.
+    std::unique_lock<std::mutex> simulationLock;
+    if (Engine::isSimulationRunning())
+        simulationLock = Engine::lockSimulation();
+
+    // Il colore contiene l'indice dello slot dell'ID: l'oggetto che lo occupa e' quello disegnato.
+    const uint32_t slot = (uint32_t)pixel[0] | ((uint32_t)pixel[1] << 8) | ((uint32_t)pixel[2] << 16);
+    const Object* pickedObject = Object::findBySlot(slot);
+
+    if (pickedObject == nullptr)
+        return nullptr;
+
+    std::shared_ptr<Node> selectedObject = Engine::findObjectByID(pickedObject->getId());
+
+    return selectedObject;
+}
+
+/**
+ * @brief Trova un oggetto nella scena corrente per ID.
+ *
+ * L'ID viene risolto con la tabella degli handle di `Object`, senza visitare la scena.
+ *
+ * @param idToFind L'ID dell'oggetto da trovare.
+ * @return Un puntatore condiviso all'oggetto trovato, oppure nullptr se nessun oggetto con l'ID specificato     stato trovato.
+ */
+std::shared_ptr<Node> LIB_API Engine::findObjectByID(int idToFind)
+{
+    std::shared_ptr<Node> object;
+
+    // Risolve l'ID in tempo costante, poi verifica che il nodo appartenga alla scena corrente.
+    Node* node = dynamic_cast<Node*>(Object::findById(idToFind));
+
+    if (node != nullptr)
+    {
+        object = node->weak_from_this().lock();
+
+        std::shared_ptr<Node> root = object;
+        while (root != nullptr && root != Engine::scene)
+            root = root->getParent();
+
+        if (root == nullptr)
+            object = nullptr;
+    }
+
+    // Se l'oggetto con l'ID specificato non     stato trovato.
+    if (object == nullptr)
+        WARNING("Could not find object with ID \"" << idToFind << "\".");
+
+    return object;
+}
+
+/**
+ * @brief Trova un oggetto nella scena corrente per ID.
+ *
+ * Questa funzione cerca ricorsivamente un oggetto nella scena corrente a partire dal nodo radice specificato.
+ *
+ * @param idToFind L'ID dell'oggetto da trovare.
+ * @param root Il nodo radice da cui iniziare la ricerca.
+ * @return Un puntatore condiviso all'oggetto trovato, oppure nullptr se nessun oggetto con l'ID specificato     stato trovato.
+ */
+std::shared_ptr<Node> LIB_API Engine::findObjectByID(int idToFind, const std::shared_ptr<Node> root)
+{
+    // Verifica se il nodo corrente ha l'ID che cerchiamo.
+    if (root->getId() == idToFind)
+        return root;
+
+    // Itera su tutti i figli del nodo root.
+    for (const auto& child : root->getChildren())
+    {
+        // Continua la ricerca ricorsiva nei figli del nodo corrente.
+        const auto found = Engine::findObjectByID(idToFind, child);
+
+        if (found != nullptr)
+            return found;
+    }
+
+    return nullptr;
+}
+
+bool LIB_API Engine::removeObject(const std::shared_ptr<Node>& nodeToRemove)
+{
+    if (!scene)
+    {
+        ERROR("Scene is not set. Cannot remove object.");
+        return false;
+    }
+
+    // Chiama la versione con due parametri, usando `scene` come radice
+    return removeObject(nodeToRemove, scene);
+}
+
+bool LIB_API Engine::removeObject(const std::shared_ptr<Node>& nodeToRemove, const std::shared_ptr<Node>& root)
+{
+
+    auto& children = root->getChildren(); // Ottieni i figli del nodo corrente
+
+    // Itera sui figli del nodo radice
+    for (auto it = children.begin(); it != children.end(); ++it)
+    {
+        if (*it == nodeToRemove)
+        {
+            // Nodo trovato, rimuovilo dal vettore dei figli
+            children.erase(it);
+            Node::markHierarchyChanged();
+            DEBUG("Removed node: " << nodeToRemove->getName());
+            return true;
+        }
+
+        // Ricorsione per cercare nei figli
+        if (removeObject(nodeToRemove, *it))
+        {
+            return true;
+        }
+    }
+
+    return false; // Nodo non trovato
+}
+
+/**
+ * @brief Restituisce il numero di chiamate OpenGL evitate nell'ultimo frame.
+ *
+ * @return Il numero di cambi di stato evitati dalla cache dei materiali.
+ */
+unsigned int LIB_API Engine::getAvoidedStateChanges()
+{
+    return Engine::avoidedStateChanges;
+}
+
+/**
+ * @brief Restituisce il numero di triangoli inviati nell'ultimo frame.
+ *
+ * @return I triangoli delle mesh, ombre e color picking inclusi, con i livelli di dettaglio scelti.
+ */
+unsigned int LIB_API Engine::getSubmittedTriangles()
+{
+    return Engine::submittedTriangles;
+}
+
+/**
+ * @brief Abilita o disabilita l'occlusion culling software.
+ */
+void LIB_API Engine::setOcclusionCullingEnabled(const bool enabled)
+{
+    Engine::occlusionCullingEnabled = enabled;
+}
+
+bool LIB_API Engine::isOcclusionCullingEnabled()
+{
+    return Engine::occlusionCullingEnabled;
+}
+
+unsigned int LIB_API Engine::getCulledObjects()
+{
+    return Engine::culledObjects;
+}
+
+/**
+ * @brief Abilita o disabilita la risoluzione dinamica.
+ *
+ * Disabilitandola il framebuffer ridotto viene liberato e la scena torna a essere disegnata nella finestra.
+ */
+void LIB_API Engine::setDynamicResolutionEnabled(const bool enabled)
+{
+    Engine::dynamicResolutionEnabled = enabled;
+
+    if (!enabled)
+        Engine::dynamicResolution.release();
+}
+
+bool LIB_API Engine::isDynamicResolutionEnabled()
+{
+    return Engine::dynamicResolutionEnabled;
+}
+
+void LIB_API Engine::setFrameTimeBudget(const float milliseconds)
+{
+    Engine::dynamicResolution.setTargetFrameTime(milliseconds);
+}
+
+void LIB_API Engine::setRenderScaleRange(const float minScale, const float maxScale)
+{
+    Engine::dynamicResolution.setScaleRange(minScale, maxScale);
+}
+
+/**
+ * @brief Restituisce la scala della risoluzione della scena.
+ *
+ * @return La scala corrente, 1 se la risoluzione dinamica e' disabilitata o non disponibile.
+ */
+float LIB_API Engine::getRenderScale()
+{
+    if (!Engine::dynamicResolutionEnabled || !GLExtensions::isFramebufferSupported())
+        return 1.0f;
+
+    return Engine::dynamicResolution.getScale();
+}
+
+/**
+ * @brief Abilita o disabilita il calcolo delle matrici del mondo con `TransformSystem`.
+ *
+ * @param enabled `true` per usare `TransformSystem`, `false` per la visita ricorsiva di `List::pass`.
+ */
+void LIB_API Engine::setTransformSystemEnabled(const bool enabled)
+{
+    Engine::transformSystemEnabled = enabled;
+
+    if (!enabled)
+        Engine::transformSystem.clear();
+}
+
+/**
+ * @brief Verifica se le matrici del mondo vengono calcolate con `TransformSystem`.
+ *
+ * @return `true` se il sistema e' attivo.
+ */
+bool LIB_API Engine::isTransformSystemEnabled()
+{
+    return Engine::transformSystemEnabled;
+}
+
+///// Thread di simulazione
+
+/**
+ * @brief Avvia il thread di simulazione.
+ *
+ * Il thread chiamante diventa il proprietario del contesto OpenGL: le risorse rilasciate
+ * dalla simulazione vengono eliminate da `render`.
+ */
+void LIB_API Engine::startSimulation(void (*step)(const float deltaTime), const int ticksPerSecond)
+{
+    if (Engine::simulationRunning.load() || ticksPerSecond <= 0)
+        return;
+
+    GLExtensions::setContextThread();
+    Engine::snapshots.reset();
+
+    Engine::simulationRunning.store(true);
+    Engine::simulationThread = std::thread(Engine::simulationLoop, step, ticksPerSecond);
+}
+
+void LIB_API Engine::stopSimulation()
+{
+    if (!Engine::simulationRunning.exchange(false))
+        return;
+
+    if (Engine::simulationThread.joinable())
+        Engine::simulationThread.join();
+
+    {
+        std::lock_guard<std::mutex> lock(Engine::commandMutex);
+        Engine::simulationCommands.clear();
+    }
+
+    // I nodi delle istantanee vengono rilasciati qui, sul thread del contesto.
+    Engine::snapshots.reset();
+    GLExtensions::flushReleases();
+}
+
+bool LIB_API Engine::isSimulationRunning()
+{
+    return Engine::simulationRunning.load();
+}
+
+void LIB_API Engine::postToSimulation(std::function<void()> command)
+{
+    if (!Engine::isSimulationRunning())
+    {
+        command();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(Engine::commandMutex);
+    Engine::simulationCommands.push_back(std::move(command));
+}
+
+std::unique_lock<std::mutex> LIB_API Engine::lockSimulation()
+{
+    return std::unique_lock<std::mutex>(Engine::simulationMutex);
+}
+
+/**
+ * @brief Ciclo del thread di simulazione: un tick a frequenza fissa, indipendente dal rendering.
+ *
+ * Se un tick dura piu' del previsto il successivo parte subito, senza accumulare ritardo.
+ */
+void Engine::simulationLoop(void (*step)(const float deltaTime), const int ticksPerSecond)
+{
+    const std::chrono::steady_clock::duration tick = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / ticksPerSecond));
+    std::chrono::steady_clock::time_point lastTick = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point nextTick = lastTick;
+    std::vector<std::function<void()>> commands;
+
+    while (Engine::simulationRunning.load())
+    {
+        {
+            std::lock_guard<std::mutex> simulationLock(Engine::simulationMutex);
+
+            {
+                std::lock_guard<std::mutex> commandLock(Engine::commandMutex);
+                commands.swap(Engine::simulationCommands);
+            }
+
+            // Input in ordine di arrivo, prima della logica del tick.
+            for (const std::function<void()>& command : commands)
+                command();
+            commands.clear();
+
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            const float deltaTime = std::chrono::duration<float>(now - lastTick).count();
+            lastTick = now;
+
+            if (step != nullptr)
+                step(deltaTime);
+
+            Animator::update(deltaTime);
+            Engine::publishSnapshot();
+        }
+
+        nextTick += tick;
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (nextTick < now)
+            nextTick = now;
+
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+/**
+ * @brief Copia nella prossima istantanea tutto cio' che il rendering legge dalla scena.
+ */
+void Engine::publishSnapshot()
+{
+    SceneSnapshot& snapshot = Engine::snapshots.beginWrite();
+
+    if (Engine::scene != nullptr && Engine::activeCamera != nullptr)
+    {
+        // Riutilizzata tra i tick del thread di simulazione.
+        static thread_local std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> renderList;
+        Engine::buildRenderList(renderList);
+
+        snapshot.items.reserve(renderList.size());
+
+        for (auto& entry : renderList)
+        {
+            // Le camere restano fuori: il rendering imposta la proiezione con i parametri copiati.
+            if (dynamic_cast<const Camera*>(entry.first.get()) != nullptr)
+                continue;
+
+            const Mesh* mesh = dynamic_cast<const Mesh*>(entry.first.get());
+            const Light* light = mesh == nullptr ? dynamic_cast<const Light*>(entry.first.get()) : nullptr;
+            const bool hasMaterial = mesh != nullptr && mesh->getMaterial() != nullptr;
+
+            snapshot.items.push_back({ std::move(entry.first), entry.second, hasMaterial,
+                hasMaterial ? mesh->getMaterial()->getState() : MaterialState(),
+                hasMaterial ? mesh->getMaterialOverride() : MaterialOverride(),
+                light != nullptr, light != nullptr ? light->getLightData() : LightData() });
+        }
+
+        snapshot.camera = Engine::activeCamera;
+        snapshot.inverseCameraMatrix = Engine::activeCamera->getInverseMatrix();
+        snapshot.perspective = std::dynamic_pointer_cast<PerspectiveCamera>(Engine::activeCamera) != nullptr;
+        snapshot.fov = Engine::activeCamera->getFov();
+        snapshot.nearClipping = Engine::activeCamera->getNearClipping();
+        snapshot.farClipping = Engine::activeCamera->getFarClipping();
+    }
+
+    snapshot.screenText = Engine::screenText;
+    Engine::snapshots.publish();
+}
+
+/**
+ * @brief Rimuove tutti i nodi figli dalla scena corrente.
+ */
+void LIB_API Engine::removeAllObjects() {
+    if (!scene) {
+        ERROR("Scene is not set. Cannot remove objects.");
+        return;
+    }
+
+    // Rimuove tutti i figli della scena
+    scene->removeAllChildren();
+    INFO("All objects have been removed from the scene.");
+}
+
+
+
+/**
+ * @brief Restituisce la matrice di trasformazione globale di un nodo.
+ *
+ * Calcola ricorsivamente la trasformazione globale combinata di un nodo
+ * sommando le trasformazioni di tutti i suoi genitori nella gerarchia della scena.
+ *
+ * @param node Il nodo di cui calcolare la matrice globale.
+ * @return La matrice di trasformazione globale.
+ */
+glm::mat4 Engine::getGlobalTransform(const std::shared_ptr<Node>& node) {
+    if (!node) {
+        ERROR("Node is null. Cannot compute global transform.");
+        return glm::mat4(1.0f);
+    }
+    if (!node->getParent()) {
+        return node->getTransform();
+    }
+    return getGlobalTransform(node->getParent()) * node->getTransform();
+}
+
+glm::vec3 Engine::getGlobalPosition(const std::shared_ptr<Node>& node) {
+    glm::mat4 globalTransform = getGlobalTransform(node);
+    return glm::vec3(globalTransform[3][0], globalTransform[3][1], globalTransform[3][2]);
+}
+
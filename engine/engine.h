@@ -1,220 +1,399 @@
-#pragma once
-
-#define LIB_NAME      "Engine"
-#define LIB_VERSION   10
-
-#include <sstream>
-
-#include "Camera.h"
-#include "Common.h"
-#include "Material.h"
-#include "List.h"
-#include "Mesh.h"
-
-/**
- * @class Engine
- * @brief La classe principale del motore grafico.
- *
- * Gestisce l'inizializzazione del motore, la gestione delle finestre, il rendering,
- * e la gestione della scena e delle camere.
- * Necessita di una chiamata a `init` per inizializzare il motore prima dell'uso
- * e `quit` per liberare le risorse al termine.
- */
-class LIB_API Engine
-{
-public:
-
-    /**
-     * @brief Inizializza il motore grafico.
-     * @param windowTitle Titolo della finestra.
-     * @param windowWidth Larghezza della finestra.
-     * @param windowHeight Altezza della finestra.
-     */
-    static void init(const std::string windowTitle, const int windowWidth, const int windowHeight);
-
-    // Getter
-
-    /**
-     * @brief Restituisce la telecamera attiva.
-     * @return Puntatore condiviso alla telecamera attiva.
-     */
-    static std::shared_ptr<Camera> getActiveCamera();
-
-    /**
-     * @brief Restituisce la scena attuale.
-     * @return Puntatore condiviso alla scena.
-     */
-    static std::shared_ptr<Node> getScene();
-
-    // Setter
-
-    /**
-     * @brief Imposta il colore di sfondo.
-     * @param red Componente rossa (0.0 - 1.0).
-     * @param green Componente verde (0.0 - 1.0).
-     * @param blue Componente blu (0.0 - 1.0).
-     */
-    static void setBackGround(const float red, const float green, const float blue);
-
-    /**
-     * @brief Imposta la scena corrente.
-     * @param newScene Puntatore condiviso alla nuova scena.
-     */
-    static void setScene(const std::shared_ptr<Node> newScene);
-
-    /**
-     * @brief Imposta la telecamera attiva.
-     * @param newActiveCamera Puntatore condiviso alla nuova telecamera attiva.
-     */
-    static void setActiveCamera(const std::shared_ptr<Camera> newActiveCamera);
-
-    /**
-     * @brief Imposta il testo da visualizzare sullo schermo.
-     * @param newText Testo da visualizzare.
-     */
-    static void setScreenText(const std::string newText);
-
-    // Set Callback
-
-    /**
-     * @brief Imposta la funzione di callback per la tastiera.
-     * @param newKeyboardCallback Funzione di callback per la tastiera.
-     */
-    static void setKeyboardCallback(void (*newKeyboardCallback) (const unsigned char key, const int mouseX, const int mouseY));
-
-    /**
-     * @brief Imposta la funzione di callback per il lampeggiamento.
-     * @param callback Funzione di callback per il lampeggiamento.
-     */
-    static void setBlinkingCallback(void (*callback)());
-
-    /**
-     * @brief Imposta la funzione di callback per il mouse.
-     * @param newMouseCallback Funzione di callback per il mouse.
-     */
-    static void setMouseCallback(void(*newMouseCallback)(int button, int state, int mouseX, int mouseY));
-
-    /**
-     * @brief Imposta la funzione di callback per i tasti speciali.
-     * @param newSpecialCallback Funzione di callback per i tasti speciali.
-     */
-    static void setMethodSpecialCallback(void(*newSpecialCallback) (int key, int mouseX, int mouseY));
-
-    // Funzioni di stato e rendering
-
-    /**
-     * @brief Verifica se il motore e' in esecuzione.
-     * @return `true` se il motore e' in esecuzione, altrimenti `false`.
-     */
-    static bool isRunning();
-
-    /**
-     * @brief Esegue il rendering della scena.
-     */
-    static void render();
-
-    /**
-     * @brief Funzione di callback per il timer.
-     * @param value Valore associato al timer.
-     */
-    static void timerCallback(int value);
-
-    /**
-     * @brief Aggiorna lo stato del motore.
-     */
-    static void update();
-
-    /**
-     * @brief Pulisce lo schermo.
-     */
-    static void clearScreen();
-
-    /**
-     * @brief Scambia i buffer per il rendering.
-     */
-    static void swapBuffers();
-
-    /**
-     * @brief Ferma l'esecuzione del motore.
-     */
-    static void stop();
-
-    /**
-     * @brief Termina l'esecuzione del motore e libera le risorse.
-     */
-    static void quit();
-
-    // Funzioni per la gestione degli oggetti
-
-    /**
-     * @brief Trova un oggetto nella scena tramite il nome.
-     * @param nameToFind Nome dell'oggetto da cercare.
-     * @return Puntatore condiviso all'oggetto trovato, o `nullptr` se non trovato.
-     */
-    static std::shared_ptr<Node> findObjectByName(const std::string nameToFind);
-
-    /**
-     * @brief Trova un oggetto nella scena tramite l'ID.
-     * @param idToFind ID dell'oggetto da cercare.
-     * @return Puntatore condiviso all'oggetto trovato, o `nullptr` se non trovato.
-     */
-    static std::shared_ptr<Node> findObjectByID(int idToFind);
-
-    /**
-     * @brief Ottiene il nodo selezionato tramite un click.
-     * @param mouseX Coordinata X del mouse.
-     * @param mouseY Coordinata Y del mouse.
-     * @return Puntatore condiviso al nodo selezionato.
-     */
-    static std::shared_ptr<Node> getNodeByClick(int mouseX, int mouseY);
-
-    /**
-     * @brief Rimuove un oggetto dalla scena.
-     * @param nodeToRemove Puntatore condiviso all'oggetto da rimuovere.
-     * @param root Radice della scena.
-     * @return `true` se l'oggetto e' stato rimosso, altrimenti `false`.
-     */
-    static bool removeObject(const std::shared_ptr<Node>& nodeToRemove, const std::shared_ptr<Node>& root);
-
-    /**
-     * @brief Rimuove un oggetto dalla scena.
-     * @param nodeToRemove Puntatore condiviso all'oggetto da rimuovere.
-     * @return `true` se l'oggetto e' stato rimosso, altrimenti `false`.
-     */
-    static bool removeObject(const std::shared_ptr<Node>& nodeToRemove);
-
-    /**
-     * @brief Rimuove tutti gli oggetti dalla scena.
-     */
-    static void removeAllObjects();
-    static glm::mat4 getGlobalTransform(const std::shared_ptr<Node>& node);
-    static glm::vec3 getGlobalPosition(const std::shared_ptr<Node>& node);
-
-private:
-
-    /**
-     * @brief Funzione di callback per il ridimensionamento della finestra.
-     * @param width Nuova larghezza della finestra.
-     * @param height Nuova altezza della finestra.
-     */
-    static void resizeCallback(const int width, const int height);
-
-    static void (*blinkingCallback)(); ///< Funzione di callback per il lampeggiamento.
-
-    static std::shared_ptr<Node> findObjectByName(const std::string nameToFind, const std::shared_ptr<Node> root);
-    static std::shared_ptr<Node> findObjectByID(int idToFind, const std::shared_ptr<Node> root);
-
-    static bool isInitializedFlag; ///< Flag che indica se il motore e' stato inizializzato.
-    static bool isRunningFlag; ///< Flag che indica se il motore e' in esecuzione.
-    static int windowId;  ///< ID della finestra.
-
-    static int windowWidth; ///< Larghezza della finestra.
-    static int windowHeight; ///< Altezza della finestra.
-
-    static std::shared_ptr<Node> scene; ///< Puntatore alla scena.
-    static std::shared_ptr<Camera> activeCamera;  ///< Puntatore alla telecamera attiva.
-    static std::shared_ptr<Material> shadowMaterial; ///< Puntatore al materiale per le ombre.
-    static std::string screenText; ///< Testo da visualizzare sullo schermo.
-    static int frames; ///< Contatore di frames
-    static float fps; ///< Frames al secondo
-};
+#pragma once
+
+#define LIB_NAME      "Engine"
+#define LIB_VERSION   10
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Camera.h"
+#include "Common.h"
+#include "Material.h"
+#include "List.h"
+#include "Mesh.h"
+#include "Animator.h"
+#include "DynamicResolution.h"
+#include "OcclusionCuller.h"
+#include "RenderQueue.h"
+#include "SceneLoader.h"
+#include "SceneSnapshot.h"
+#include "TextRenderer.h"
+#include "TextureStreamer.h"
+#include "TransformSystem.h"
+
+/**
+ * @class Engine
+ * @brief La classe principale del motore grafico.
+ *
+ * Gestisce l'inizializzazione del motore, la gestione delle finestre, il rendering,
+ * e la gestione della scena e delle camere.
+ * Necessita di una chiamata a `init` per inizializzare il motore prima dell'uso
+ * e `quit` per liberare le risorse al termine.
+ */
+class LIB_API Engine
+{
+public:
+
+    /**
+     * @brief Inizializza il motore grafico.
+     * @param windowTitle Titolo della finestra.
+     * @param windowWidth Larghezza della finestra.
+     * @param windowHeight Altezza della finestra.
+     */
+    static void init(const std::string windowTitle, const int windowWidth, const int windowHeight);
+
+    // Getter
+
+    /**
+     * @brief Restituisce la telecamera attiva.
+     * @return Puntatore condiviso alla telecamera attiva.
+     */
+    static std::shared_ptr<Camera> getActiveCamera();
+
+    /**
+     * @brief Restituisce la scena attuale.
+     * @return Puntatore condiviso alla scena.
+     */
+    static std::shared_ptr<Node> getScene();
+
+    // Setter
+
+    /**
+     * @brief Imposta il colore di sfondo.
+     * @param red Componente rossa (0.0 - 1.0).
+     * @param green Componente verde (0.0 - 1.0).
+     * @param blue Componente blu (0.0 - 1.0).
+     */
+    static void setBackGround(const float red, const float green, const float blue);
+
+    /**
+     * @brief Imposta la scena corrente.
+     * @param newScene Puntatore condiviso alla nuova scena.
+     */
+    static void setScene(const std::shared_ptr<Node> newScene);
+
+    /**
+     * @brief Imposta la telecamera attiva.
+     * @param newActiveCamera Puntatore condiviso alla nuova telecamera attiva.
+     */
+    static void setActiveCamera(const std::shared_ptr<Camera> newActiveCamera);
+
+    /**
+     * @brief Imposta il testo da visualizzare sullo schermo.
+     * @param newText Testo da visualizzare.
+     */
+    static void setScreenText(const std::string newText);
+
+    // Set Callback
+
+    /**
+     * @brief Imposta la funzione di callback per la tastiera.
+     * @param newKeyboardCallback Funzione di callback per la tastiera.
+     */
+    static void setKeyboardCallback(void (*newKeyboardCallback) (const unsigned char key, const int mouseX, const int mouseY));
+
+    /**
+     * @brief Imposta la funzione di callback per il lampeggiamento.
+     * @param callback Funzione di callback per il lampeggiamento.
+     */
+    static void setBlinkingCallback(void (*callback)());
+
+    /**
+     * @brief Imposta la funzione di callback per il mouse.
+     * @param newMouseCallback Funzione di callback per il mouse.
+     */
+    static void setMouseCallback(void(*newMouseCallback)(int button, int state, int mouseX, int mouseY));
+
+    /**
+     * @brief Imposta la funzione di callback per i tasti speciali.
+     * @param newSpecialCallback Funzione di callback per i tasti speciali.
+     */
+    static void setMethodSpecialCallback(void(*newSpecialCallback) (int key, int mouseX, int mouseY));
+
+    // Funzioni di stato e rendering
+
+    /**
+     * @brief Verifica se il motore e' in esecuzione.
+     * @return `true` se il motore e' in esecuzione, altrimenti `false`.
+     */
+    static bool isRunning();
+
+    /**
+     * @brief Esegue il rendering della scena.
+     */
+    static void render();
+
+    /**
+     * @brief Funzione di callback per il timer.
+     * @param value Valore associato al timer.
+     */
+    static void timerCallback(int value);
+
+    /**
+     * @brief Aggiorna lo stato del motore.
+     *
+     * Gestisce gli eventi, avanza le animazioni e porta avanti i caricamenti asincroni
+     * (`OVOParser::loadAsync`): crea per circa 2 ms le loro risorse OpenGL e aggiunge
+     * alla scena i sottoalberi pronti. Carica inoltre sulla GPU una parte delle texture
+     * in streaming (`TextureStreamer`).
+     */
+    static void update();
+
+    /**
+     * @brief Pulisce lo schermo.
+     */
+    static void clearScreen();
+
+    /**
+     * @brief Scambia i buffer per il rendering.
+     */
+    static void swapBuffers();
+
+    /**
+     * @brief Ferma l'esecuzione del motore.
+     */
+    static void stop();
+
+    /**
+     * @brief Termina l'esecuzione del motore e libera le risorse.
+     */
+    static void quit();
+
+    // Funzioni per la gestione degli oggetti
+
+    /**
+     * @brief Trova un oggetto nella scena tramite il nome.
+     * @param nameToFind Nome dell'oggetto da cercare.
+     * @return Puntatore condiviso all'oggetto trovato, o `nullptr` se non trovato.
+     */
+    static std::shared_ptr<Node> findObjectByName(const std::string nameToFind);
+
+    /**
+     * @brief Trova un oggetto nella scena tramite l'ID.
+     * @param idToFind ID dell'oggetto da cercare.
+     * @return Puntatore condiviso all'oggetto trovato, o `nullptr` se non trovato.
+     */
+    static std::shared_ptr<Node> findObjectByID(int idToFind);
+
+    /**
+     * @brief Ottiene il nodo selezionato tramite un click.
+     * @param mouseX Coordinata X del mouse.
+     * @param mouseY Coordinata Y del mouse.
+     * @return Puntatore condiviso al nodo selezionato.
+     */
+    static std::shared_ptr<Node> getNodeByClick(int mouseX, int mouseY);
+
+    /**
+     * @brief Rimuove un oggetto dalla scena.
+     * @param nodeToRemove Puntatore condiviso all'oggetto da rimuovere.
+     * @param root Radice della scena.
+     * @return `true` se l'oggetto e' stato rimosso, altrimenti `false`.
+     */
+    static bool removeObject(const std::shared_ptr<Node>& nodeToRemove, const std::shared_ptr<Node>& root);
+
+    /**
+     * @brief Rimuove un oggetto dalla scena.
+     * @param nodeToRemove Puntatore condiviso all'oggetto da rimuovere.
+     * @return `true` se l'oggetto e' stato rimosso, altrimenti `false`.
+     */
+    static bool removeObject(const std::shared_ptr<Node>& nodeToRemove);
+
+    /**
+     * @brief Rimuove tutti gli oggetti dalla scena.
+     */
+    static void removeAllObjects();
+
+    /**
+     * @brief Restituisce il numero di chiamate OpenGL evitate nell'ultimo frame grazie all'ordinamento per stato.
+     * @return Il numero di cambi di stato evitati.
+     */
+    static unsigned int getAvoidedStateChanges();
+
+    /**
+     * @brief Restituisce il numero di triangoli inviati nell'ultimo frame.
+     * @return I triangoli delle mesh con i livelli di dettaglio scelti.
+     */
+    static unsigned int getSubmittedTriangles();
+
+    /**
+     * @brief Abilita o disabilita l'occlusion culling software.
+     *
+     * Con una camera prospettica, le mesh designate con `Mesh::setOccluder` vengono rasterizzate
+     * sulla CPU e le mesh che nascondono completamente non vengono disegnate.
+     *
+     * @param enabled `true` per abilitare l'occlusion culling.
+     */
+    static void setOcclusionCullingEnabled(const bool enabled);
+
+    /**
+     * @brief Verifica se l'occlusion culling e' abilitato.
+     * @return `true` se abilitato.
+     */
+    static bool isOcclusionCullingEnabled();
+
+    /**
+     * @brief Restituisce il numero di mesh scartate dall'occlusion culling nell'ultimo frame.
+     * @return Le mesh non disegnate perche' nascoste dagli occlusori.
+     */
+    static unsigned int getCulledObjects();
+
+    /**
+     * @brief Abilita o disabilita la risoluzione dinamica della scena 3D.
+     *
+     * La scena viene disegnata in un framebuffer ridotto e ingrandita nella finestra, con una
+     * scala corretta a ogni frame per rispettare `setFrameTimeBudget`. Il testo sovrapposto
+     * resta alla risoluzione della finestra. Senza framebuffer object non ha effetto.
+     *
+     * @param enabled `true` per abilitare la risoluzione dinamica.
+     */
+    static void setDynamicResolutionEnabled(const bool enabled);
+
+    /**
+     * @brief Verifica se la risoluzione dinamica e' abilitata.
+     * @return `true` se abilitata.
+     */
+    static bool isDynamicResolutionEnabled();
+
+    /**
+     * @brief Imposta il budget di tempo per frame della risoluzione dinamica.
+     * @param milliseconds Il budget in millisecondi (default 16.6).
+     */
+    static void setFrameTimeBudget(const float milliseconds);
+
+    /**
+     * @brief Imposta l'intervallo della scala della risoluzione dinamica.
+     * @param minScale La scala minima (default 0.5).
+     * @param maxScale La scala massima (default 1).
+     */
+    static void setRenderScaleRange(const float minScale, const float maxScale);
+
+    /**
+     * @brief Restituisce la scala della risoluzione della scena 3D.
+     * @return La frazione della risoluzione della finestra, per lato.
+     */
+    static float getRenderScale();
+
+    /**
+     * @brief Abilita o disabilita il calcolo delle matrici del mondo con `TransformSystem`.
+     *
+     * Con il sistema attivo le trasformazioni della scena vengono aggiornate con una passata
+     * lineare su array contigui invece che con la visita ricorsiva di `List::pass`.
+     *
+     * @param enabled `true` per usare `TransformSystem`.
+     */
+    static void setTransformSystemEnabled(const bool enabled);
+
+    /**
+     * @brief Verifica se le matrici del mondo vengono calcolate con `TransformSystem`.
+     * @return `true` se il sistema e' attivo.
+     */
+    static bool isTransformSystemEnabled();
+
+    // Thread di simulazione
+
+    /**
+     * @brief Avvia il thread di simulazione.
+     *
+     * A ogni tick il thread esegue i comandi inviati con `postToSimulation`, chiama `step`,
+     * avanza le animazioni e pubblica un'istantanea della scena (nodi, matrici globali,
+     * parametri dei materiali, camera e testo). Da quel momento `render` disegna solo le
+     * istantanee e la scena va modificata dal thread di simulazione o con `lockSimulation`.
+     * Va chiamata dal thread del contesto OpenGL, dopo `init`.
+     *
+     * @param step La logica da eseguire a ogni tick (puo' essere `nullptr`), con il tempo trascorso in secondi.
+     * @param ticksPerSecond La frequenza della simulazione.
+     */
+    static void startSimulation(void (*step)(const float deltaTime), const int ticksPerSecond = 60);
+
+    /**
+     * @brief Ferma il thread di simulazione e ne attende la fine.
+     *
+     * I comandi non ancora eseguiti vengono scartati e le istantanee svuotate.
+     */
+    static void stopSimulation();
+
+    /**
+     * @brief Verifica se il thread di simulazione e' attivo.
+     * @return `true` tra `startSimulation` e `stopSimulation`.
+     */
+    static bool isSimulationRunning();
+
+    /**
+     * @brief Esegue un comando sul thread di simulazione, all'inizio del prossimo tick.
+     *
+     * Senza simulazione attiva il comando viene eseguito subito dal chiamante.
+     *
+     * @param command Il comando, tipicamente la gestione di un evento di input.
+     */
+    static void postToSimulation(std::function<void()> command);
+
+    /**
+     * @brief Blocca la simulazione tra due tick.
+     *
+     * Per le operazioni del thread OpenGL che modificano la scena e devono essere eseguite
+     * subito (es. caricamento di una nuova scena). Non va chiamata dai comandi di simulazione.
+     *
+     * @return Il lock, che sblocca la simulazione quando viene distrutto.
+     */
+    static std::unique_lock<std::mutex> lockSimulation();
+    static glm::mat4 getGlobalTransform(const std::shared_ptr<Node>& node);
+    static glm::vec3 getGlobalPosition(const std::shared_ptr<Node>& node);
+
+private:
+
+    /**
+     * @brief Funzione di callback per il ridimensionamento della finestra.
+     * @param width Nuova larghezza della finestra.
+     * @param height Nuova altezza della finestra.
+     */
+    static void resizeCallback(const int width, const int height);
+
+    static void (*blinkingCallback)(); ///< Funzione di callback per il lampeggiamento.
+
+    static std::shared_ptr<Node> findObjectByName(const std::string nameToFind, const std::shared_ptr<Node> root);
+    static std::shared_ptr<Node> findObjectByID(int idToFind, const std::shared_ptr<Node> root);
+
+    static void buildRenderList(std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>>& renderList);
+    static void simulationLoop(void (*step)(const float deltaTime), const int ticksPerSecond);
+    static void publishSnapshot();
+
+    static bool isInitializedFlag; ///< Flag che indica se il motore e' stato inizializzato.
+    static bool isRunningFlag; ///< Flag che indica se il motore e' in esecuzione.
+    static int windowId;  ///< ID della finestra.
+
+    static std::atomic<int> windowWidth; ///< Larghezza della finestra (letta anche dal thread di simulazione).
+    static std::atomic<int> windowHeight; ///< Altezza della finestra (letta anche dal thread di simulazione).
+
+    static std::shared_ptr<Node> scene; ///< Puntatore alla scena.
+    static std::shared_ptr<Camera> activeCamera;  ///< Puntatore alla telecamera attiva.
+    static std::shared_ptr<Material> shadowMaterial; ///< Puntatore al materiale per le ombre.
+    static std::string screenText; ///< Testo da visualizzare sullo schermo.
+    static RenderQueue renderQueue; ///< Coda di rendering ordinata per stato, riutilizzata tra i frame.
+    static TransformSystem transformSystem; ///< Trasformazioni della scena in array contigui.
+    static bool transformSystemEnabled; ///< Indica se le matrici del mondo vengono calcolate da `transformSystem`.
+    static size_t lastRenderListSize; ///< Nodi della lista di rendering dell'ultimo frame.
+    static SnapshotBuffer snapshots; ///< Istantanee pubblicate dal thread di simulazione.
+    static std::thread simulationThread; ///< Thread di simulazione.
+    static std::atomic<bool> simulationRunning; ///< Indica se il thread di simulazione e' attivo.
+    static std::mutex simulationMutex; ///< Tenuto dal thread di simulazione durante ogni tick.
+    static std::mutex commandMutex; ///< Protegge la coda dei comandi.
+    static std::vector<std::function<void()>> simulationCommands; ///< Comandi da eseguire al prossimo tick.
+    static unsigned int avoidedStateChanges; ///< Chiamate OpenGL evitate nell'ultimo frame.
+    static unsigned int submittedTriangles; ///< Triangoli inviati nell'ultimo frame.
+    static OcclusionCuller occlusionCuller; ///< Depth buffer software degli occlusori.
+    static bool occlusionCullingEnabled; ///< Indica se l'occlusion culling e' abilitato.
+    static unsigned int culledObjects; ///< Mesh scartate dall'occlusion culling nell'ultimo frame.
+    static DynamicResolution dynamicResolution; ///< Framebuffer ridotto e controllo della scala.
+    static bool dynamicResolutionEnabled; ///< Indica se la risoluzione dinamica e' abilitata.
+    static int statsTextBlock; ///< Blocco di `TextRenderer` con le statistiche del frame.
+    static int screenTextBlock; ///< Blocco di `TextRenderer` con il testo di `setScreenText`.
+    static std::string statsText; ///< Testo delle statistiche, riutilizzato tra i frame.
+    static std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> renderList; ///< Nodi del frame, riutilizzati tra i frame.
+    static int lastUpdateTime; ///< Istante (ms) dell'ultimo aggiornamento delle animazioni.
+    static int frames; ///< Contatore di frames
+    static float fps; ///< Frames al secondo
+};
@@ -1,246 +1,1152 @@
-#include <assert.h>
-#include <cmath>
-#include <iostream>
-
-#include <glm/glm.hpp>
-
-#include "Camera.h"
-#include "Light.h"
-#include "engine.h"
-#include "Node.h"
-#include "Object.h"
-#include "OvoParser.h"
-#include "PerspectiveCamera.h"
-
-int main()
-{
-	///// Object
-	std::cout << "Testing Object " << std::endl;
-	std::shared_ptr<Object> object = std::make_shared<Node>("NodeType");
-
-	// Test per il nome dell'oggetto
-	object->setName("camera001");
-	assert(object->getName() == "camera001");
-
-	// Test per l'id dell'oggetto
-	assert(object->getId() == 1);
-
-	// Creiamo un altro oggetto per verificare che l'ID venga incrementato
-	std::shared_ptr<Object> anotherObject = std::make_shared<Node>("AnotherNodeType");
-	assert(anotherObject->getId() == 2);
-
-	// Test per il tipo dell'oggetto
-	assert(object->getType() == "NodeType");
-
-	// Modifica il tipo
-	object->setType("NewNodeType");
-	assert(object->getType() == "NewNodeType");
-
-	// Test del reset del generatore di ID
-	Object::resetIdGenerator();
-	std::shared_ptr<Object> resetObject = std::make_shared<Node>("ResetNodeType");
-	assert(resetObject->getId() == 0);
-
-	Object::resetIdGenerator();
-
-	///// Node
-	std::cout << "Testing Node " << std::endl;
-	std::shared_ptr<Node> node = std::make_shared<Node>();
-
-	// Test delle proprieta iniziali del nodo
-	assert(node->getPosition() == glm::vec3(0.0f, 0.0f, 0.0f));
-	assert(node->getRotation() == glm::vec3(0.0f, 0.0f, 0.0f));
-	assert(node->getScale() == glm::vec3(1.0f, 1.0f, 1.0f));
-	assert(node->getPriority() == 0);
-	assert(node->getLocalMatrix() == glm::mat4(1.0f));
-
-	// Modifica delle proprieta e verifica
-	node->setPosition(glm::vec3(10.0f, 5.0f, 0.0f));
-	assert(node->getPosition() == glm::vec3(10.0f, 5.0f, 0.0f));
-
-	node->setRotation(glm::vec3(45.0f, 0.0f, 90.0f));
-	assert(node->getRotation() == glm::vec3(45.0f, 0.0f, 90.0f));
-
-	node->setScale(glm::vec3(2.0f, 2.0f, 2.0f));
-	assert(node->getScale() == glm::vec3(2.0f, 2.0f, 2.0f));
-
-	node->setPriority(5);
-	assert(node->getPriority() == 5);
-
-	// Verifica della matrice locale dopo aver impostato posizione, rotazione e scala
-	glm::mat4 localMatrix = node->getLocalMatrix();
-	assert(localMatrix != glm::mat4(1.0f));  // Dopo le trasformazioni, non dovrebbe essere la matrice di identita
-
-	// Aggiunta e verifica dei figli
-	std::shared_ptr<Node> childNode1 = std::make_shared<Node>();
-	std::shared_ptr<Node> childNode2 = std::make_shared<Node>();
-	node->addChild(childNode1);
-	node->addChild(childNode2);
-
-	auto children = node->getChildren();
-	assert(children.size() == 2);
-	assert(children[0] == childNode1);
-	assert(children[1] == childNode2);
-
-	///// Camera
-	std::cout << "Testing Camera " << std::endl;
-	std::shared_ptr<Camera> camera = std::make_shared<Camera>("CameraType");
-
-	// Test dei valori di default
-	assert(camera->getPosition() == glm::vec3(0.0f, 0.0f, 0.0f));
-	assert(camera->getRotation() == glm::vec3(0.0f, 0.0f, 0.0f));
-	assert(camera->getScale() == glm::vec3(1.0f, 1.0f, 1.0f));
-	assert(camera->getPriority() == 2);  // Priorit di default impostata nel costruttore
-	assert(camera->getInverseMatrix() == glm::inverse(camera->getLocalMatrix()));
-
-	///// PerspectiveCamera
-	std::cout << "Testing PerspectiveCamera " << std::endl;
-	std::shared_ptr<PerspectiveCamera> cameraPersp = std::make_shared<PerspectiveCamera>();
-
-	// Test dei valori di default ereditati da Camera
-	assert(cameraPersp->getPosition() == glm::vec3(0.0f, 0.0f, 0.0f));
-	assert(cameraPersp->getRotation() == glm::vec3(0.0f, 0.0f, 0.0f));
-	assert(cameraPersp->getScale() == glm::vec3(1.0f, 1.0f, 1.0f));
-	assert(cameraPersp->getPriority() == 2);
-
-	///// Light
-	std::cout << "Testing Light " << std::endl;
-
-	// Resetta l'ID delle luci per assicurarsi che parta da 0
-	Light::resetNextLightId();
-
-	std::shared_ptr<Light> light1 = std::make_shared<Light>("PointLight");
-
-	// Test dei valori di default
-	assert(light1->getPosition() == glm::vec3(0.0f, 0.0f, 0.0f));
-	assert(light1->getRotation() == glm::vec3(0.0f, 0.0f, 0.0f));
-	assert(light1->getScale() == glm::vec3(1.0f, 1.0f, 1.0f));
-	assert(light1->getPriority() == 1);  // Priorit predefinita impostata nel costruttore
-
-	///// PointLight
-	std::cout << "Testing PointLight " << std::endl;
-
-	Light::resetNextLightId();
-	std::shared_ptr<PointLight> pointLight = std::make_shared<PointLight>();
-	assert(pointLight->getType() == "PointLight");
-
-	///// DirectionalLight
-	std::cout << "Testing DirectionalLight " << std::endl;
-
-	Light::resetNextLightId();
-	std::shared_ptr<DirectionalLight> directionalLight = std::make_shared<DirectionalLight>();
-	assert(directionalLight->getType() == "DirectionalLight");
-
-	///// SpotLight
-	std::cout << "Testing SpotLight " << std::endl;
-
-	Light::resetNextLightId();
-	std::shared_ptr<SpotLight> spotLight = std::make_shared<SpotLight>();
-	assert(spotLight->getType() == "SpotLight");
-
-	Light::resetNextLightId();
-
-	///// Material
-	std::cout << "Testing Material " << std::endl;
-
-	// Creazione di un oggetto Material
-	std::shared_ptr<Material> material = std::make_shared<Material>();
-	assert(material->getEmissionColor() == glm::vec3(0.0f, 0.0f, 0.0f));  // Nero
-
-	///// Mesh
-	std::cout << "Testing Mesh " << std::endl;
-	std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>();
-
-	// Test del materiale di default
-	std::shared_ptr<Material> defaultMaterial = mesh->getMaterial();
-	assert(defaultMaterial != nullptr);
-	// Verifica che le ombre siano abilitate per default
-	assert(mesh->getShadows() == true);
-
-	// Creazione di un nuovo materiale e assegnazione alla mesh
-	std::shared_ptr<Material> newMaterial = std::make_shared<Material>();
-	newMaterial->setDiffuseColor(glm::vec3(1.0f, 0.0f, 0.0f));  // Imposta il colore diffuso a rosso
-	mesh->setMaterial(newMaterial);
-	assert(mesh->getMaterial() == newMaterial);
-
-	// Verifica che le ombre siano disabilitate
-	mesh->setShadows(false);
-	assert(mesh->getShadows() == false);
-
-	///// MeshData
-	std::cout << "Testing MeshData " << std::endl;
-
-	MeshData meshData;
-
-	// Dati di esempio
-	std::vector<glm::vec3> vertices = {
-		{0.0f, 0.0f, 0.0f},
-		{1.0f, 0.0f, 0.0f},
-		{0.0f, 1.0f, 0.0f}
-	};
-
-	std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> faces = {
-		{0, 1, 2}
-	};
-
-	std::vector<glm::vec3> normals = {
-		{0.0f, 0.0f, 1.0f}
-	};
-
-	std::vector<glm::vec2> uvs = {
-		{0.0f, 0.0f},
-		{1.0f, 0.0f},
-		{0.0f, 1.0f}
-	};
-
-	// Impostazione dei dati della mesh
-	meshData.set_mesh_data(vertices, faces, normals, uvs);
-
-	// Verifica che i dati siano stati correttamente impostati
-	assert(meshData.getVertices().size() == 3);  // Dovrebbe contenere 3 vertici
-	assert(meshData.getVertices()[0] == glm::vec3(0.0f, 0.0f, 0.0f));
-	assert(meshData.getVertices()[1] == glm::vec3(1.0f, 0.0f, 0.0f));
-	assert(meshData.getVertices()[2] == glm::vec3(0.0f, 1.0f, 0.0f));
-
-	assert(meshData.getFaces().size() == 1);  // Dovrebbe contenere 1 faccia
-	assert(meshData.getFaces()[0] == std::make_tuple(0, 1, 2));
-
-	assert(meshData.getNormals().size() == 1);  // Dovrebbe contenere 1 normale
-	assert(meshData.getNormals()[0] == glm::vec3(0.0f, 0.0f, 1.0f));
-
-	assert(meshData.getUVs().size() == 3);  // Dovrebbe contenere 3 coordinate UV
-	assert(meshData.getUVs()[0] == glm::vec2(0.0f, 0.0f));
-	assert(meshData.getUVs()[1] == glm::vec2(1.0f, 0.0f));
-	assert(meshData.getUVs()[2] == glm::vec2(0.0f, 1.0f));
-
-	///// List
-	std::cout << "Testing List " << std::endl;
-
-	// Creazione di un oggetto List
-	List list;
-
-	// Creazione di alcuni nodi di test
-	std::shared_ptr<Node> node1 = std::make_shared<Node>("Camera");
-	std::shared_ptr<Node> node2 = std::make_shared<Node>("Light");
-	std::shared_ptr<Node> node3 = std::make_shared<Node>("Mesh");
-
-	// Creazione di una lista di rendering
-	std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> testListRendering = {
-		{node1, glm::mat4(1.0f)},
-		{node2, glm::mat4(1.0f)},
-		{node3, glm::mat4(1.0f)}
-	};
-
-	// Impostazione della lista di rendering nella classe List
-	list.setListRendering(testListRendering);
-
-	// Verifica che la lista sia stata impostata correttamente
-	assert(list.getListRendering().size() == 3);
-	assert(list.getListRendering()[0].first->getType() == "Camera");
-	assert(list.getListRendering()[1].first->getType() == "Light");
-	assert(list.getListRendering()[2].first->getType() == "Mesh");
-
-	std::cout << "All tests passed!" << std::endl;
-
-	return 0;
-}
+#include <assert.h>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Camera.h"
+#include "ChunkCompressor.h"
+#include "Light.h"
+#include "LightManager.h"
+#include "LightClusterGrid.h"
+#include "Logger.h"
+#include "engine.h"
+#include "Node.h"
+#include "Object.h"
+#include "OvoParser.h"
+#include "OvoWriter.h"
+#include "PerspectiveCamera.h"
+#include "AllocationTracker.h"
+#include "Animator.h"
+#include "DdsImage.h"
+#include "DynamicResolution.h"
+#include "MeshOptimizer.h"
+#include "OcclusionCuller.h"
+#include "RenderQueue.h"
+#include "SceneArena.h"
+#include "SceneGenerator.h"
+#include "SceneLoader.h"
+#include "SceneSnapshot.h"
+#include "TextRenderer.h"
+#include "TextureManager.h"
+#include "TextureStreamer.h"
+#include "TransformSystem.h"
+
+int main()
+{
+	///// Object
+	std::cout << "Testing Object " << std::endl;
+	std::shared_ptr<Object> object = std::make_shared<Node>("NodeType");
+
+	// Test per il nome dell'oggetto
+	object->setName("camera001");
+	assert(object->getName() == "camera001");
+
+	// Test per l'id dell'oggetto
+	assert(object->getId() == 1);
+
+	// Creiamo un altro oggetto per verificare che l'ID venga incrementato
+	std::shared_ptr<Object> anotherObject = std::make_shared<Node>("AnotherNodeType");
+	assert(anotherObject->getId() == 2);
+
+	// Test per il tipo dell'oggetto
+	assert(object->getType() == "NodeType");
+
+	// Modifica il tipo
+	object->setType("NewNodeType");
+	assert(object->getType() == "NewNodeType");
+
+	// Gli ID sono risolti in tempo costante
+	assert(Object::findById(anotherObject->getId()) == anotherObject.get());
+
+	// Lo slot di un oggetto distrutto viene riusato con un ID diverso
+	const int releasedId = anotherObject->getId();
+	anotherObject.reset();
+	assert(Object::findById(releasedId) == nullptr);
+	std::shared_ptr<Object> reusedObject = std::make_shared<Node>("ReusedNodeType");
+	assert(HandleAllocator::getIndex(reusedObject->getId()) == HandleAllocator::getIndex(releasedId));
+	assert(reusedObject->getId() != releasedId);
+	assert(reusedObject->getId() != object->getId());
+	assert(Object::findBySlot(HandleAllocator::getIndex(releasedId)) == reusedObject.get());
+
+	// Una copia riceve un nuovo ID
+	Node copiedNode = *std::static_pointer_cast<Node>(object);
+	assert(copiedNode.getId() != object->getId());
+	assert(copiedNode.getName() == object->getName());
+
+	///// Node
+	std::cout << "Testing Node " << std::endl;
+	std::shared_ptr<Node> node = std::make_shared<Node>();
+
+	// Test delle proprieta iniziali del nodo
+	assert(node->getPosition() == glm::vec3(0.0f, 0.0f, 0.0f));
+	assert(node->getRotation() == glm::vec3(0.0f, 0.0f, 0.0f));
+	assert(node->getScale() == glm::vec3(1.0f, 1.0f, 1.0f));
+	assert(node->getPriority() == 0);
+	assert(node->getLocalMatrix() == glm::mat4(1.0f));
+
+	// Modifica delle proprieta e verifica
+	node->setPosition(glm::vec3(10.0f, 5.0f, 0.0f));
+	assert(node->getPosition() == glm::vec3(10.0f, 5.0f, 0.0f));
+
+	node->setRotation(glm::vec3(45.0f, 0.0f, 90.0f));
+	assert(node->getRotation() == glm::vec3(45.0f, 0.0f, 90.0f));
+
+	node->setScale(glm::vec3(2.0f, 2.0f, 2.0f));
+	assert(node->getScale() == glm::vec3(2.0f, 2.0f, 2.0f));
+
+	node->setPriority(5);
+	assert(node->getPriority() == 5);
+
+	// Verifica della matrice locale dopo aver impostato posizione, rotazione e scala
+	glm::mat4 localMatrix = node->getLocalMatrix();
+	assert(localMatrix != glm::mat4(1.0f));  // Dopo le trasformazioni, non dovrebbe essere la matrice di identita
+
+	// Aggiunta e verifica dei figli
+	std::shared_ptr<Node> childNode1 = std::make_shared<Node>();
+	std::shared_ptr<Node> childNode2 = std::make_shared<Node>();
+	node->addChild(childNode1);
+	node->addChild(childNode2);
+
+	auto children = node->getChildren();
+	assert(children.size() == 2);
+	assert(children[0] == childNode1);
+	assert(children[1] == childNode2);
+
+	///// Camera
+	std::cout << "Testing Camera " << std::endl;
+	std::shared_ptr<Camera> camera = std::make_shared<Camera>("CameraType");
+
+	// Test dei valori di default
+	assert(camera->getPosition() == glm::vec3(0.0f, 0.0f, 0.0f));
+	assert(camera->getRotation() == glm::vec3(0.0f, 0.0f, 0.0f));
+	assert(camera->getScale() == glm::vec3(1.0f, 1.0f, 1.0f));
+	assert(camera->getPriority() == 2);  // Priorit di default impostata nel costruttore
+	assert(camera->getInverseMatrix() == glm::inverse(camera->getLocalMatrix()));
+
+	///// PerspectiveCamera
+	std::cout << "Testing PerspectiveCamera " << std::endl;
+	std::shared_ptr<PerspectiveCamera> cameraPersp = std::make_shared<PerspectiveCamera>();
+
+	// Test dei valori di default ereditati da Camera
+	assert(cameraPersp->getPosition() == glm::vec3(0.0f, 0.0f, 0.0f));
+	assert(cameraPersp->getRotation() == glm::vec3(0.0f, 0.0f, 0.0f));
+	assert(cameraPersp->getScale() == glm::vec3(1.0f, 1.0f, 1.0f));
+	assert(cameraPersp->getPriority() == 2);
+
+	///// Light
+	std::cout << "Testing Light " << std::endl;
+
+	std::shared_ptr<Light> light1 = std::make_shared<Light>("PointLight");
+
+	// Test dei valori di default
+	assert(light1->getPosition() == glm::vec3(0.0f, 0.0f, 0.0f));
+	assert(light1->getRotation() == glm::vec3(0.0f, 0.0f, 0.0f));
+	assert(light1->getScale() == glm::vec3(1.0f, 1.0f, 1.0f));
+	assert(light1->getPriority() == 1);  // Priorit predefinita impostata nel costruttore
+
+	///// PointLight
+	std::cout << "Testing PointLight " << std::endl;
+
+	std::shared_ptr<PointLight> pointLight = std::make_shared<PointLight>();
+	assert(pointLight->getType() == "PointLight");
+
+	// Raggio di influenza: la distanza del file OVO da cui deriva il raggio
+	pointLight->setRadius(2.0f);
+	assert(pointLight->getRange() == 2.0f * PointLight::RADIUS_SCALE);
+	assert(pointLight->getLightData().constantAttenuation == 0.5f);
+
+	///// DirectionalLight
+	std::cout << "Testing DirectionalLight " << std::endl;
+
+	std::shared_ptr<DirectionalLight> directionalLight = std::make_shared<DirectionalLight>();
+	assert(directionalLight->getType() == "DirectionalLight");
+
+	///// SpotLight
+	std::cout << "Testing SpotLight " << std::endl;
+
+	std::shared_ptr<SpotLight> spotLight = std::make_shared<SpotLight>();
+	assert(spotLight->getType() == "SpotLight");
+
+	// Raggio di influenza: il raggio della spot, illimitato per le luci direzionali
+	spotLight->setRadius(200.0f);
+	assert(spotLight->getRange() == 200.0f);
+	assert(directionalLight->getRange() == 0.0f);
+	assert(LightManager::isInRange(glm::vec3(0.0f), 0.0f, glm::vec3(1000.0f), 1.0f));
+	assert(LightManager::isInRange(glm::vec3(0.0f), 5.0f, glm::vec3(5.5f, 0.0f, 0.0f), 1.0f));
+	assert(!LightManager::isInRange(glm::vec3(0.0f), 5.0f, glm::vec3(7.0f, 0.0f, 0.0f), 1.0f));
+
+	///// LightClusterGrid
+	std::cout << "Testing LightClusterGrid " << std::endl;
+
+	LightClusterGrid clusterGrid;
+	clusterGrid.configure(45.0f, 16.0f / 9.0f, 1.0f, 100.0f);
+	assert(clusterGrid.isConfigured());
+	assert(clusterGrid.getSlice(0.5f) == 0);
+	assert(clusterGrid.getSlice(1000.0f) == LightClusterGrid::SLICES - 1);
+
+	// Una luce al centro dello schermo a 10 unita' raggiunge solo i cluster vicini
+	LightData clusterLight = {};
+	clusterLight.position = glm::vec4(0.0f, 0.0f, -10.0f, 1.0f);
+	clusterLight.spotCutoff = 180.0f;
+	clusterLight.range = 1.0f;
+	LightData globalLight = clusterLight;
+	globalLight.range = 0.0f;
+	clusterGrid.assign({ globalLight, clusterLight });
+
+	const int centerSlice = clusterGrid.getSlice(10.0f);
+	const int centerCluster = LightClusterGrid::getClusterIndex(LightClusterGrid::TILES_X / 2, LightClusterGrid::TILES_Y / 2, centerSlice);
+	assert(clusterGrid.getClusters()[2 * centerCluster + 1] == 1);
+	assert(clusterGrid.getIndices()[clusterGrid.getClusters()[2 * centerCluster]] == 1);
+	const int cornerCluster = LightClusterGrid::getClusterIndex(0, 0, centerSlice);
+	assert(clusterGrid.getClusters()[2 * cornerCluster + 1] == 0);
+	assert(clusterGrid.getIndices().size() < 64);
+
+	// Luci lette da un file OVO: i limiti derivano da raggio e cutoff, senza impostarli a mano
+	{
+		OVOWriter lightWriter;
+		assert(lightWriter.open("cluster_lights_test.ovo"));
+		lightWriter.writeNode("[root]", glm::mat4(1.0f), 2);
+		OVOLightDesc pointDescription;
+		pointDescription.name = "cluster_point";
+		pointDescription.matrix = glm::translate(glm::mat4(1.0f), glm::vec3(2.0f, 0.0f, -10.0f));
+		pointDescription.radius = 2.0f;
+		lightWriter.writeLight(pointDescription);
+		OVOLightDesc spotDescription;
+		spotDescription.name = "cluster_spot";
+		spotDescription.subtype = 2;
+		spotDescription.direction = glm::vec3(-2.0f, 0.0f, -10.0f);
+		spotDescription.radius = 3.0f;
+		spotDescription.cutoff = 20.0f;
+		lightWriter.writeLight(spotDescription);
+		assert(lightWriter.close());
+
+		std::shared_ptr<Node> lightScene = OVOParser::fromFile("cluster_lights_test.ovo");
+		remove("cluster_lights_test.ovo");
+		assert(lightScene != nullptr);
+
+		// Vista identita': le luci sono gia' nello spazio vista
+		std::vector<LightData> fileLights;
+		for (const std::shared_ptr<Node>& node : lightScene->getChildren()[0]->getChildren())
+		{
+			std::shared_ptr<Light> fileLight = std::dynamic_pointer_cast<Light>(node);
+			assert(fileLight != nullptr && fileLight->getRange() > 0.0f);
+			LightData data = fileLight->getLightData();
+			data.position = fileLight->getLocalMatrix() * data.position;
+			fileLights.push_back(data);
+		}
+		assert(fileLights.size() == 2 && fileLights[0].range == 2.0f && fileLights[1].spotCutoff == 20.0f);
+
+		// Ognuna raggiunge almeno un cluster, ma solo una piccola parte della griglia
+		for (const LightData& fileLight : fileLights)
+		{
+			clusterGrid.assign({ fileLight });
+			int litClusters = 0;
+			for (int c = 0; c < LightClusterGrid::CLUSTER_COUNT; c++)
+				litClusters += clusterGrid.getClusters()[2 * c + 1] > 0 ? 1 : 0;
+			assert(litClusters > 0 && litClusters < LightClusterGrid::CLUSTER_COUNT / 10);
+		}
+	}
+
+
+	///// DdsImage
+	std::cout << "Testing DdsImage " << std::endl;
+
+	// DDS DXT1 8x8 con 4 livelli di mipmap: 32 + 8 + 8 + 8 byte
+	std::vector<uint8_t> dds(128 + 56, 0);
+	const uint32_t ddsHeader[] = { 0x20534444, 124, 0x21007, 8, 8, 0, 0, 4 };
+	memcpy(dds.data(), ddsHeader, sizeof(ddsHeader));
+	const uint32_t ddsPixelFormat[] = { 32, 0x4, 0x31545844 };
+	memcpy(dds.data() + 76, ddsPixelFormat, sizeof(ddsPixelFormat));
+	for (int row = 0; row < 4; row++)
+		dds[128 + 4 + row] = (uint8_t)row;
+
+	DdsImage ddsImage;
+	assert(ddsImage.parse(dds.data(), dds.size()));
+	assert(ddsImage.getBlockSize() == 8);
+	assert(ddsImage.getLevels().size() == 4);
+	assert(ddsImage.getLevels()[1].width == 4 && ddsImage.getLevels()[1].offset == 32);
+	assert(ddsImage.getDataSize() == 56);
+
+	// Il capovolgimento inverte le righe di blocchi e le righe dentro ogni blocco
+	ddsImage.flipVertically();
+	assert(ddsImage.getData()[16 + 4] == 3 && ddsImage.getData()[16 + 7] == 0);
+
+	// Una catena troncata conserva solo i livelli completi
+	assert(ddsImage.parse(dds.data(), dds.size() - 1));
+	assert(ddsImage.getLevels().size() == 3);
+	assert(!ddsImage.parse(dds.data(), 64));
+
+	///// Material
+	std::cout << "Testing Material " << std::endl;
+
+	// Creazione di un oggetto Material
+	std::shared_ptr<Material> material = std::make_shared<Material>();
+	assert(material->getEmissionColor() == glm::vec3(0.0f, 0.0f, 0.0f));  // Nero
+
+	///// Mesh
+	std::cout << "Testing Mesh " << std::endl;
+	std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>();
+
+	// Test del materiale di default
+	std::shared_ptr<Material> defaultMaterial = mesh->getMaterial();
+	assert(defaultMaterial != nullptr);
+	// Verifica che le ombre siano abilitate per default
+	assert(mesh->getShadows() == true);
+
+	// Creazione di un nuovo materiale e assegnazione alla mesh
+	std::shared_ptr<Material> newMaterial = std::make_shared<Material>();
+	newMaterial->setDiffuseColor(glm::vec3(1.0f, 0.0f, 0.0f));  // Imposta il colore diffuso a rosso
+	mesh->setMaterial(newMaterial);
+	assert(mesh->getMaterial() == newMaterial);
+
+	// Verifica che le ombre siano disabilitate
+	mesh->setShadows(false);
+	assert(mesh->getShadows() == false);
+
+	// Livelli di dettaglio: si scende sotto la soglia ridotta e si risale solo sopra quella allargata
+	assert(mesh->getLodCount() == 1);
+	mesh->addLod(MeshData());
+	mesh->addLod(MeshData());
+	assert(mesh->getLodCount() == 3);
+	const float lodThreshold = Mesh::getLodThreshold();
+	assert(mesh->selectLod(lodThreshold * 2.0f) == 0);
+	assert(mesh->selectLod(lodThreshold * 0.95f) == 0);
+	assert(mesh->selectLod(lodThreshold * 0.85f) == 1);
+	assert(mesh->selectLod(lodThreshold * 1.05f) == 1);
+	assert(mesh->selectLod(lodThreshold * 1.15f) == 0);
+	assert(mesh->selectLod(1.0f) == 2);
+
+	// Le ombre riusano il livello scelto: una mesh vuota a ogni distanza scenderebbe al livello 2
+	assert(mesh->selectLod(lodThreshold * 2.0f) == 0);
+	Mesh::setLodProjection(45.0f, 600);
+	mesh->render(glm::mat4(1.0f), MaterialState(), nullptr, false);
+	assert(mesh->getCurrentLod() == 0);
+	mesh->render(glm::mat4(1.0f), MaterialState());
+	assert(mesh->getCurrentLod() == 2);
+	Mesh::setLodProjection(45.0f, 0);
+	mesh->setMeshData(MeshData());
+	assert(mesh->getLodCount() == 1 && mesh->getCurrentLod() == 0);
+
+	///// MeshData
+	std::cout << "Testing MeshData " << std::endl;
+
+	MeshData meshData;
+
+	// Dati di esempio
+	std::vector<glm::vec3> vertices = {
+		{0.0f, 0.0f, 0.0f},
+		{1.0f, 0.0f, 0.0f},
+		{0.0f, 1.0f, 0.0f}
+	};
+
+	std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> faces = {
+		{0, 1, 2}
+	};
+
+	std::vector<glm::vec3> normals = {
+		{0.0f, 0.0f, 1.0f},
+		{0.0f, 0.0f, 1.0f},
+		{0.0f, 0.0f, 1.0f}
+	};
+
+	std::vector<glm::vec2> uvs = {
+		{0.0f, 0.0f},
+		{1.0f, 0.0f},
+		{0.0f, 1.0f}
+	};
+
+	// Impostazione dei dati della mesh
+	meshData.set_mesh_data(vertices, faces, normals, uvs);
+
+	// Verifica che i dati siano stati correttamente impostati
+	assert(meshData.getVertexCount() == 3);  // Dovrebbe contenere 3 vertici
+	assert(meshData.getPosition(0) == glm::vec3(0.0f, 0.0f, 0.0f));
+	assert(meshData.getPosition(1) == glm::vec3(1.0f, 0.0f, 0.0f));
+	assert(meshData.getPosition(2) == glm::vec3(0.0f, 1.0f, 0.0f));
+
+	assert(meshData.getFaceCount() == 1);  // Dovrebbe contenere 1 faccia
+	assert(meshData.getFace(0) == glm::uvec3(0, 1, 2));
+
+	// Normali e coordinate UV sono compresse: si confrontano con una tolleranza
+	assert(glm::length(meshData.getNormal(0) - glm::vec3(0.0f, 0.0f, 1.0f)) < 0.01f);
+	assert(meshData.getUV(0) == glm::vec2(0.0f, 0.0f));
+	assert(meshData.getUV(1) == glm::vec2(1.0f, 0.0f));
+	assert(meshData.getUV(2) == glm::vec2(0.0f, 1.0f));
+
+	// Formato compatto: 20 byte per vertice e indici a 16 bit
+	assert(sizeof(PackedVertex) == 20);
+	assert(meshData.hasShortIndices());
+	assert(meshData.getMemorySize() == 3 * 20 + 3 * 2);
+
+	///// MeshOptimizer
+	std::cout << "Testing MeshOptimizer " << std::endl;
+
+	// Griglia 8x8 di quadrati con tre vertici propri per triangolo, disegnati a colonne alterne
+	const int gridSize = 8;
+	std::vector<PackedVertex> gridVertices;
+	std::vector<uint32_t> gridIndices;
+	for (int x = 0; x < gridSize; x++)
+		for (int y = 0; y < gridSize; y++)
+		{
+			const int column = (x * 5) % gridSize;
+			const glm::vec3 corners[6] = {
+				{column, y, 0}, {column + 1, y, 0}, {column + 1, y + 1, 0},
+				{column, y, 0}, {column + 1, y + 1, 0}, {column, y + 1, 0}
+			};
+			for (const glm::vec3& corner : corners)
+			{
+				gridIndices.push_back((uint32_t)gridVertices.size());
+				gridVertices.push_back({ corner, 0x00007F00u, 0 });
+			}
+		}
+
+	const MeshOptimizationReport report = MeshOptimizer::optimize(gridVertices, gridIndices, MeshOptimizationOptions());
+	assert(report.verticesBefore == gridSize * gridSize * 6);
+	assert(report.verticesAfter == (gridSize + 1) * (gridSize + 1));  // Vertici duplicati uniti
+	assert(gridVertices.size() == report.verticesAfter);
+	assert(gridIndices.size() == gridSize * gridSize * 6);
+	assert(report.acmrBefore == 3.0f);
+	assert(report.acmrAfter < 1.0f);
+	assert(report.atvrBefore == 1.0f && report.atvrAfter < 1.5f);
+
+	// Ordine di primo utilizzo: ogni nuovo indice e' il successivo di quelli gia' visti
+	uint32_t nextVertex = 0;
+	for (const uint32_t index : gridIndices)
+	{
+		assert(index <= nextVertex);
+		if (index == nextVertex)
+			nextVertex++;
+	}
+
+	// Un triangolo isolato trasforma sempre tre vertici
+	assert(MeshOptimizer::computeAcmr({ 0, 1, 2 }, 16) == 3.0f);
+
+	///// TransformSystem
+	std::cout << "Testing TransformSystem " << std::endl;
+
+	std::shared_ptr<Node> transformRoot = std::make_shared<Node>();
+	std::shared_ptr<Node> transformChild = std::make_shared<Node>();
+	std::shared_ptr<Node> transformGrandChild = std::make_shared<Node>();
+	transformRoot->addChild(transformChild);
+	transformChild->addChild(transformGrandChild);
+	transformRoot->setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+	transformChild->setRotation(glm::vec3(30.0f, 45.0f, 60.0f));
+	transformChild->setScale(glm::vec3(2.0f, 1.0f, 0.5f));
+	transformGrandChild->setBaseMatrix(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+	TransformSystem transformSystem;
+	transformSystem.build(transformRoot);
+	assert(transformSystem.getSize() == 3);
+	assert(transformSystem.getParent(transformGrandChild->getTransformIndex()) == transformChild->getTransformIndex());
+	assert(!transformSystem.isStale(transformRoot));
+
+	// Le matrici coincidono con quelle della visita ricorsiva, anche dopo una modifica
+	const auto matchesListPass = [&]()
+	{
+		transformSystem.update();
+		for (const auto& [node, worldMatrix] : List::pass(transformRoot, glm::mat4(1.0f)))
+			for (int column = 0; column < 4; column++)
+				assert(glm::length(transformSystem.getWorldMatrix(node->getTransformIndex())[column] - worldMatrix[column]) < 1e-4f);
+	};
+	matchesListPass();
+	transformRoot->setRotation(glm::vec3(0.0f, 90.0f, 0.0f));
+	matchesListPass();
+
+	// Una modifica della gerarchia richiede una ricostruzione
+	transformGrandChild->addChild(std::make_shared<Node>());
+	assert(transformSystem.isStale(transformRoot));
+
+	///// SceneArena
+	std::cout << "Testing SceneArena " << std::endl;
+
+	std::shared_ptr<SceneArena> sceneArena = std::make_shared<SceneArena>();
+	std::shared_ptr<Node> arenaRoot = SceneArena::make<Node>(sceneArena);
+	std::shared_ptr<Mesh> arenaMesh = SceneArena::make<Mesh>(sceneArena);
+	arenaRoot->addChild(arenaMesh);
+	assert(arenaMesh->getParent() == arenaRoot);  // shared_from_this funziona anche nell'arena
+	assert(sceneArena->getChunkCount() == 1);
+	assert(sceneArena->getUsedBytes() >= sizeof(Node) + sizeof(Mesh));
+
+	// L'arena sopravvive finche' esiste un suo oggetto
+	std::weak_ptr<SceneArena> weakArena = sceneArena;
+	sceneArena.reset();
+	assert(!weakArena.expired());
+	arenaRoot.reset();
+	arenaMesh.reset();
+	assert(weakArena.expired());
+
+	// Senza arena si ricade su std::make_shared
+	assert(SceneArena::make<Node>(nullptr) != nullptr);
+
+	///// TaskPool
+	std::cout << "Testing TaskPool " << std::endl;
+
+	TaskPool taskPool(3);
+	std::atomic<int> taskSum{ 0 };
+	TaskPool::Group taskGroup;
+	for (int i = 1; i <= 100; i++)
+		taskPool.submit(taskGroup, [&taskSum, &taskPool, &taskGroup, i]()
+			{
+				// Anche i task possono creare altri task dello stesso gruppo
+				if (i % 10 == 0)
+					taskPool.submit(taskGroup, [&taskSum]() { taskSum += 1000; });
+				taskSum += i;
+			});
+	taskPool.wait(taskGroup);
+	assert(taskSum == 5050 + 10 * 1000);
+
+	// La lista di rendering parallela coincide con quella seriale
+	std::shared_ptr<Node> parallelRoot = std::make_shared<Node>();
+	std::vector<std::shared_ptr<Node>> parallelNodes = { parallelRoot };
+	for (int i = 1; i < 500; i++)
+	{
+		std::shared_ptr<Node> parallelNode = std::make_shared<Node>();
+		parallelNode->setPosition(glm::vec3((float)i, 0.0f, 0.0f));
+		parallelNodes[(i * 7) % parallelNodes.size()]->addChild(parallelNode);
+		parallelNodes.push_back(parallelNode);
+	}
+	const auto serialList = List::pass(parallelRoot, glm::mat4(1.0f));
+	const auto parallelList = List::pass(parallelRoot, glm::mat4(1.0f), taskPool);
+	assert(serialList.size() == parallelNodes.size());
+	assert(serialList == parallelList);
+
+	///// SceneSnapshot
+	std::cout << "Testing SceneSnapshot " << std::endl;
+
+	SnapshotBuffer snapshotBuffer;
+	assert(snapshotBuffer.acquire() == nullptr);
+
+	// Il lettore vede sempre l'ultima istantanea pubblicata, anche se ne ha saltate alcune
+	std::shared_ptr<Node> snapshotNode = std::make_shared<Node>();
+	for (int i = 1; i <= 3; i++)
+	{
+		SceneSnapshot& written = snapshotBuffer.beginWrite();
+		assert(written.items.empty());
+		written.items.push_back({ snapshotNode, glm::translate(glm::mat4(1.0f), glm::vec3((float)i, 0.0f, 0.0f)), false, MaterialState(), MaterialOverride(), false, LightData() });
+		snapshotBuffer.publish();
+	}
+
+	const SceneSnapshot* readSnapshot = snapshotBuffer.acquire();
+	assert(readSnapshot != nullptr && readSnapshot->sequence == 3);
+	assert(readSnapshot->items.size() == 1 && readSnapshot->items[0].worldMatrix[3].x == 3.0f);
+
+	// Senza nuove pubblicazioni resta la stessa; le scritture successive non la toccano
+	snapshotBuffer.beginWrite().items.clear();
+	assert(snapshotBuffer.acquire() == readSnapshot && readSnapshot->items.size() == 1);
+	snapshotBuffer.publish();
+	assert(snapshotBuffer.acquire()->sequence == 4);
+
+	// Le luci dell'istantanea vengono disegnate con la copia dei parametri, non con quelli del nodo
+	std::shared_ptr<PointLight> snapshotLight = std::make_shared<PointLight>();
+	SceneSnapshot lightSnapshot;
+	lightSnapshot.items.push_back({ snapshotLight, glm::mat4(1.0f), false, MaterialState(), MaterialOverride(), true, snapshotLight->getLightData() });
+	snapshotLight->setRadius(0.0f);
+
+	RenderQueue snapshotQueue;
+	snapshotQueue.build(lightSnapshot);
+	assert(snapshotQueue.getItems().size() == 1 && snapshotQueue.getItems()[0].light == &lightSnapshot.items[0].light);
+	assert(snapshotQueue.getItems()[0].light->range == 5.0f * PointLight::RADIUS_SCALE && snapshotLight->getRange() == 0.0f);
+
+	snapshotBuffer.reset();
+	assert(snapshotBuffer.getCurrent() == nullptr && snapshotNode.use_count() == 1);
+
+	// Senza thread di simulazione i comandi vengono eseguiti subito
+	bool commandExecuted = false;
+	Engine::postToSimulation([&commandExecuted]() { commandExecuted = true; });
+	assert(!Engine::isSimulationRunning() && commandExecuted);
+
+	///// OcclusionCuller
+	std::cout << "Testing OcclusionCuller " << std::endl;
+
+	// Un quadrato grande a z = -5 davanti alla camera nasconde la mesh a z = -20 ma non quella a z = -3
+	MeshData quadData;
+	quadData.set_mesh_data({ { -50.0f, -50.0f, 0.0f }, { 50.0f, -50.0f, 0.0f }, { 50.0f, 50.0f, 0.0f }, { -50.0f, 50.0f, 0.0f } },
+		{ { 0, 1, 2 }, { 0, 2, 3 } }, {}, {});
+	MeshData smallData;
+	smallData.set_mesh_data({ { -0.5f, -0.5f, 0.0f }, { 0.5f, -0.5f, 0.0f }, { 0.0f, 0.5f, 0.0f } }, { { 0, 1, 2 } }, {}, {});
+
+	std::shared_ptr<Mesh> occluderMesh = std::make_shared<Mesh>();
+	std::shared_ptr<Mesh> hiddenMesh = std::make_shared<Mesh>();
+	std::shared_ptr<Mesh> frontMesh = std::make_shared<Mesh>();
+	occluderMesh->setMeshData(quadData);
+	hiddenMesh->setMeshData(smallData);
+	frontMesh->setMeshData(smallData);
+
+	std::shared_ptr<Node> occlusionRoot = std::make_shared<Node>();
+	occlusionRoot->addChild(occluderMesh);
+	occlusionRoot->addChild(hiddenMesh);
+	occlusionRoot->addChild(frontMesh);
+	assert(OcclusionCuller::markLargestOccluders(occlusionRoot, 1) == 1);
+	assert(occluderMesh->isOccluder() && !hiddenMesh->isOccluder());
+
+	std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> occlusionList = {
+		{ occluderMesh, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f)) },
+		{ hiddenMesh, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -20.0f)) },
+		{ frontMesh, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -3.0f)) }
+	};
+
+	RenderQueue occlusionQueue;
+	occlusionQueue.build(occlusionList, glm::mat4(1.0f));
+	occlusionQueue.sort();
+
+	OcclusionCuller culler(64, 32);
+	assert(culler.getWidth() % 4 == 0);
+	assert(culler.cull(occlusionQueue, glm::perspective(glm::radians(45.0f), 2.0f, 1.0f, 100.0f), glm::mat4(1.0f)) == 1);
+	assert(culler.getOccluderCount() == 1 && occlusionQueue.getItems().size() == 2);
+	for (const RenderItem& item : occlusionQueue.getItems())
+		assert(item.node != hiddenMesh.get());
+
+	// La mesh nascosta resta disponibile per le ombre fino alla coda successiva
+	assert(occlusionQueue.getCulledItems().size() == 1 && occlusionQueue.getCulledItems()[0].node == hiddenMesh.get());
+	occlusionQueue.build(occlusionList, glm::mat4(1.0f));
+	assert(occlusionQueue.getCulledItems().empty());
+
+	// Il pixel attraversato dal bordo dell'occlusore resta vuoto, quello coperto ha la sua profondita'
+	MeshData edgeData;
+	edgeData.set_mesh_data({ { -1.0f, -1.0f, 0.5f }, { 0.2f, -1.0f, 0.5f }, { 0.2f, 1.0f, 0.5f }, { -1.0f, 1.0f, 0.5f } },
+		{ { 0, 1, 2 }, { 0, 2, 3 } }, {}, {});
+	std::shared_ptr<Mesh> edgeMesh = std::make_shared<Mesh>();
+	edgeMesh->setMeshData(edgeData);
+
+	OcclusionCuller edgeCuller(8, 4);
+	edgeCuller.begin(glm::mat4(1.0f));
+	edgeCuller.drawOccluder(*edgeMesh, glm::mat4(1.0f));
+	const std::vector<float>& edgeDepth = edgeCuller.getDepthBuffer();
+	assert(std::fabs(edgeDepth[8 + 3] - 0.5f) < 1e-5f && edgeDepth[8 + 4] == 1.0f);
+
+	///// SceneLoader
+	std::cout << "Testing SceneLoader " << std::endl;
+
+	// File OVO minimo: il nodo radice con due figli, il primo con un figlio a sua volta
+	{
+		FILE* ovoFile = fopen("scene_loader_test.ovo", "wb");
+		assert(ovoFile != nullptr);
+
+		const auto writeNode = [ovoFile](const char* name, const uint32_t children)
+		{
+			const uint32_t type = 1;
+			const uint32_t size = (uint32_t)(strlen(name) + 1 + sizeof(glm::mat4) + sizeof(uint32_t));
+			const glm::mat4 matrix(1.0f);
+			fwrite(&type, sizeof(uint32_t), 1, ovoFile);
+			fwrite(&size, sizeof(uint32_t), 1, ovoFile);
+			fwrite(name, 1, strlen(name) + 1, ovoFile);
+			fwrite(&matrix, sizeof(glm::mat4), 1, ovoFile);
+			fwrite(&children, sizeof(uint32_t), 1, ovoFile);
+		};
+
+		writeNode("[root]", 2);
+		writeNode("first", 1);
+		writeNode("firstChild", 0);
+		writeNode("second", 0);
+		fclose(ovoFile);
+	}
+
+	std::shared_ptr<SceneLoader> sceneLoad = OVOParser::loadAsync("scene_loader_test.ovo");
+	assert(sceneLoad->getRoot() != nullptr);
+	for (int i = 0; i < 1000 && !sceneLoad->isDone(); i++)
+	{
+		SceneLoader::upload(1.0);
+		SceneLoader::attachReady();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	assert(sceneLoad->getState() == SceneLoader::State::Completed);
+	assert(sceneLoad->getProgress() == 1.0f && sceneLoad->getAttachedCount() == 3);
+	assert(sceneLoad->getRoot()->getChildren().size() == 1);
+	std::shared_ptr<Node> loadedRoot = sceneLoad->getRoot()->getChildren()[0];
+	assert(loadedRoot->getName() == "[root]" && loadedRoot->getChildren().size() == 2);
+	assert(loadedRoot->getChildren()[0]->getName() == "first" && loadedRoot->getChildren()[0]->getChildren().size() == 1);
+	assert(!SceneLoader::hasPendingWork());
+	remove("scene_loader_test.ovo");
+
+	// Un file mancante fallisce senza bloccare il chiamante
+	std::shared_ptr<SceneLoader> missingLoad = OVOParser::loadAsync("missing.ovo");
+	for (int i = 0; i < 1000 && SceneLoader::hasPendingWork(); i++)
+	{
+		SceneLoader::attachReady();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	assert(missingLoad->getState() == SceneLoader::State::Failed && !missingLoad->getError().empty());
+	assert(missingLoad->getRoot()->getChildren().empty());
+
+	///// TextureStreamer
+	std::cout << "Testing TextureStreamer " << std::endl;
+
+	// La texture e' disponibile subito, condivisa per percorso, e resta vuota se il file non esiste
+	std::shared_ptr<Texture> streamed = TextureStreamer::request("missing_texture.png");
+	assert(streamed != nullptr && TextureStreamer::request("missing_texture.png") == streamed);
+	assert(TextureManager::find("missing_texture.png") == streamed);
+	for (int i = 0; i < 1000 && streamed->isStreaming(); i++)
+	{
+		TextureStreamer::update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	assert(!streamed->isStreaming() && !streamed->isLoaded());
+	assert(TextureStreamer::getQueueDepth() == 0 && TextureStreamer::getBytesStreamedLastFrame() == 0);
+	TextureStreamer::setFrameBudget(512 * 1024);
+	assert(TextureStreamer::getFrameBudget() == 512 * 1024);
+	TextureStreamer::quit();
+
+	///// MaterialOverride
+	std::cout << "Testing MaterialOverride " << std::endl;
+
+	MaterialOverride materialOverride;
+	assert(!materialOverride.isActive());
+	materialOverride.alpha = 0.5f;
+	assert(materialOverride.isActive());
+
+	std::shared_ptr<Material> highlightMaterial = std::make_shared<Material>();
+	highlightMaterial->setEmissionColor(glm::vec3(0.0f));
+	std::shared_ptr<Mesh> highlightMesh = std::make_shared<Mesh>();
+	std::shared_ptr<Mesh> plainMesh = std::make_shared<Mesh>();
+	highlightMesh->setMaterial(highlightMaterial);
+	plainMesh->setMaterial(highlightMaterial);
+
+	// L'animazione dell'emissione modifica solo l'override della mesh, non il materiale condiviso
+	Animator::play(highlightMesh, AnimationChannel::Emission, {
+		{ 0.0f, glm::vec3(0.0f), Easing::Linear },
+		{ 1.0f, glm::vec3(1.0f, 0.5f, 0.0f), Easing::Linear }
+		});
+	Animator::update(1.0f);
+	assert(highlightMesh->getMaterialOverride().emission == glm::vec3(1.0f, 0.5f, 0.0f));
+	assert(highlightMaterial->getEmissionColor() == glm::vec3(0.0f));
+	assert(!plainMesh->getMaterialOverride().isActive());
+
+	// Solo la mesh evidenziata porta l'override nella coda di rendering
+	std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> overrideList = {
+		{ highlightMesh, glm::mat4(1.0f) },
+		{ plainMesh, glm::mat4(1.0f) }
+	};
+	RenderQueue overrideQueue;
+	overrideQueue.build(overrideList, glm::mat4(1.0f));
+	for (const RenderItem& item : overrideQueue.getItems())
+		assert((item.override != nullptr) == (item.node == highlightMesh.get()));
+
+	highlightMesh->resetMaterialOverride();
+	assert(!highlightMesh->getMaterialOverride().isActive());
+
+	///// DynamicResolution
+	std::cout << "Testing DynamicResolution " << std::endl;
+
+	DynamicResolution resolution(10.0f, 0.5f, 1.0f);
+	assert(resolution.getScale() == 1.0f);
+	assert(resolution.getRenderWidth(1000) == 1000 && resolution.getRenderHeight(800) == 800);
+
+	// Sopra il budget la scala scende a passi limitati, fino al minimo
+	assert(resolution.update(40.0f) < 1.0f && resolution.getScale() >= 0.95f);
+	for (int i = 0; i < 200; i++)
+		resolution.update(40.0f);
+	assert(resolution.getScale() == 0.5f);
+	assert(resolution.getRenderWidth(1000) == 500 && resolution.getRenderHeight(800) == 400);
+
+	// Dentro la banda del budget la scala non cambia
+	DynamicResolution steady(10.0f);
+	for (int i = 0; i < 50; i++)
+		steady.update(10.0f);
+	assert(steady.getScale() == 1.0f && std::abs(steady.getAverageFrameTime() - 10.0f) < 0.001f);
+
+	// Sotto il budget la scala risale fino al massimo
+	for (int i = 0; i < 500; i++)
+		resolution.update(2.0f);
+	assert(resolution.getScale() == 1.0f);
+
+	resolution.setScaleRange(0.25f, 0.75f);
+	assert(resolution.getScale() == 0.75f);
+	assert(Engine::getRenderScale() == 1.0f);
+
+	///// TextRenderer
+	std::cout << "Testing TextRenderer " << std::endl;
+
+	// Un quadrato per carattere visibile: spazi e a capo fanno solo avanzare la penna
+	const int textBlock = TextRenderer::add("Ab c\nd", glm::vec2(16.0f, 5.0f), glm::vec4(1.0f, 1.0f, 0.0f, 1.0f));
+	assert(TextRenderer::getQuadCount(textBlock) == 4);
+	TextRenderer::setText(textBlock, "Move: e2-e4");
+	assert(TextRenderer::getQuadCount(textBlock) == 10);
+	TextRenderer::setPosition(textBlock, glm::vec2(100.0f, 200.0f));
+	TextRenderer::setColor(textBlock, glm::vec4(1.0f));
+	assert(TextRenderer::getQuadCount(textBlock) == 10);
+	assert(TextRenderer::getLineHeight() > 0);
+
+	const int otherBlock = TextRenderer::add("12:00", glm::vec2(0.0f));
+	assert(otherBlock != textBlock && TextRenderer::getQuadCount(otherBlock) == 5);
+	TextRenderer::remove(textBlock);
+	assert(TextRenderer::getQuadCount(textBlock) == 0 && TextRenderer::getQuadCount(otherBlock) == 5);
+	TextRenderer::remove(otherBlock);
+
+	///// AllocationTracker
+	std::cout << "Testing AllocationTracker " << std::endl;
+
+	// La lista riempita da List::pass conserva la memoria: il secondo passaggio non alloca
+	std::shared_ptr<Node> allocationRoot = std::make_shared<Node>("Root");
+	allocationRoot->addChild(std::make_shared<Node>("Child"));
+	std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> allocationList;
+	List::pass(allocationRoot, glm::mat4(1.0f), allocationList);
+	assert(allocationList.size() == 2);
+
+	const size_t allocationCapacity = allocationList.capacity();
+	const size_t allocationsBefore = AllocationTracker::getThreadAllocations();
+	List::pass(allocationRoot, glm::mat4(1.0f), allocationList);
+	assert(allocationList.size() == 2 && allocationList.capacity() == allocationCapacity);
+	assert(AllocationTracker::getThreadAllocations() == allocationsBefore);
+
+	// Il frame conta solo le allocazioni successive alla chiamata precedente di markFrame
+	AllocationTracker::markFrame();
+	int* allocated = new int(1);
+	AllocationTracker::markFrame();
+	delete allocated;
+	if (AllocationTracker::isEnabled())
+		assert(AllocationTracker::getFrameAllocations() == 1 && AllocationTracker::getFrameBytes() == sizeof(int));
+	else
+		assert(AllocationTracker::getFrameAllocations() == 0 && AllocationTracker::getThreadAllocations() == 0);
+	AllocationTracker::markFrame();
+	assert(AllocationTracker::getFrameAllocations() == 0);
+
+	// I totali contano anche le allocazioni degli altri thread
+	const size_t totalBytesBefore = AllocationTracker::getTotalBytes();
+	std::thread([]() { delete new int(1); }).join();
+	if (AllocationTracker::isEnabled())
+		assert(AllocationTracker::getTotalBytes() >= totalBytesBefore + sizeof(int));
+	else
+		assert(AllocationTracker::getTotalAllocations() == 0 && AllocationTracker::getTotalBytes() == 0);
+
+	///// Logger
+	std::cout << "Testing Logger " << std::endl;
+
+	// Il livello minimo filtra i messaggi prima della formattazione
+	const LogLevel previousLevel = Logger::getLevel();
+	Logger::setLevel(LogLevel::Warning);
+	assert(!Logger::isEnabled(LogLevel::Info) && Logger::isEnabled(LogLevel::Warning) && Logger::isEnabled(LogLevel::Error));
+
+	const size_t writtenBefore = Logger::getWrittenMessages() + Logger::getDroppedMessages();
+	INFO("Filtered message");
+	WARNING("Logger test " << 1);
+	assert(Logger::write(LogLevel::Warning, std::string(2 * Logger::MESSAGE_SIZE, 'x')));
+	Logger::flush();
+	assert(Logger::getWrittenMessages() + Logger::getDroppedMessages() == writtenBefore + 2);
+
+	// Il thread di scrittura si ferma e riparte al messaggio successivo
+	Logger::quit();
+	WARNING("Logger restarted");
+	Logger::flush();
+	assert(Logger::getWrittenMessages() + Logger::getDroppedMessages() == writtenBefore + 3);
+	Logger::setLevel(LogLevel::None);
+	assert(!Logger::isEnabled(LogLevel::Error));
+	Logger::setLevel(previousLevel);
+
+	///// SceneGenerator
+	std::cout << "Testing SceneGenerator " << std::endl;
+
+	// 5 scacchiere in gruppi da al massimo 2: [root] -> 2 luci + 2 gruppi, il primo con altri 2 gruppi
+	SceneGeneratorOptions generatorOptions;
+	generatorOptions.boards = 5;
+	generatorOptions.piecesPerBoard = 4;
+	generatorOptions.groupFanout = 2;
+	generatorOptions.meshResolution = 4;
+	generatorOptions.lods = 2;
+	generatorOptions.materials = 2;
+	generatorOptions.lights = 2;
+	SceneGeneratorReport generatorReport;
+	assert(SceneGenerator::generate("scene_generator_test.ovo", generatorOptions, &generatorReport));
+	assert(generatorReport.meshes == 25 && generatorReport.lights == 2 && generatorReport.materials == 2);
+	assert(generatorReport.nodes == 1 + 2 + 4 + 25 && generatorReport.bytes > 0);
+
+	// Il parser ricostruisce la stessa gerarchia
+	std::shared_ptr<Node> generatedScene = OVOParser::fromFile("scene_generator_test.ovo");
+	remove("scene_generator_test.ovo");
+	assert(generatedScene != nullptr && generatedScene->getChildren().size() == 1);
+	std::shared_ptr<Node> generatedRoot = generatedScene->getChildren()[0];
+	assert(generatedRoot->getName() == "[root]" && generatedRoot->getChildren().size() == 4);
+	assert(std::dynamic_pointer_cast<DirectionalLight>(generatedRoot->getChildren()[0]) != nullptr);
+	assert(std::dynamic_pointer_cast<PointLight>(generatedRoot->getChildren()[1]) != nullptr);
+
+	uint32_t generatedNodes = 0;
+	const std::function<void(const std::shared_ptr<Node>&)> countNodes = [&](const std::shared_ptr<Node>& node)
+	{
+		generatedNodes++;
+		for (const std::shared_ptr<Node>& child : node->getChildren())
+			countNodes(child);
+	};
+	countNodes(generatedRoot);
+	assert(generatedNodes == generatorReport.nodes);
+
+	// Scacchiera con i suoi pezzi, materiale e livelli di dettaglio
+	std::shared_ptr<Node> group = generatedRoot->getChildren()[2];
+	while (std::dynamic_pointer_cast<Mesh>(group->getChildren()[0]) == nullptr)
+		group = group->getChildren()[0];
+	std::shared_ptr<Mesh> generatedBoard = std::dynamic_pointer_cast<Mesh>(group->getChildren()[0]);
+	assert(generatedBoard->getName() == "board_0" && generatedBoard->getChildren().size() == 4);
+	assert(generatedBoard->getMaterial() != nullptr && generatedBoard->getMaterial()->getName() == "material_0");
+	assert(generatedBoard->getLodCount() == 2 && generatedBoard->getMeshData().getFaceCount() == 4 * 4 * 2);
+	assert(generatedBoard->getChildren()[0]->getName() == "board_0_piece_0");
+
+	///// ChunkCompressor
+	std::cout << "Testing ChunkCompressor " << std::endl;
+
+	// Dati ripetitivi, casuali e troppo corti per una ripetizione tornano identici
+	std::vector<uint8_t> repetitive(10000);
+	for (size_t i = 0; i < repetitive.size(); i++)
+		repetitive[i] = (uint8_t)(i % 7);
+	std::vector<uint8_t> noise(10000);
+	uint32_t noiseState = 12345;
+	for (uint8_t& byte : noise)
+	{
+		noiseState = noiseState * 1664525u + 1013904223u;
+		byte = (uint8_t)(noiseState >> 24);
+	}
+	std::vector<uint8_t> tiny = { 1, 2, 3, 1, 2, 3 };
+
+	std::vector<uint8_t> compressed;
+	std::vector<uint8_t> decompressed;
+	for (const std::vector<uint8_t>* input : { &repetitive, &noise, &tiny })
+	{
+		ChunkCompressor::compress(input->data(), input->size(), compressed);
+		assert(compressed.size() <= ChunkCompressor::getMaxCompressedSize(input->size()));
+		decompressed.assign(input->size(), 0);
+		assert(ChunkCompressor::decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size()));
+		assert(decompressed == *input);
+	}
+
+	// Dati troncati, di dimensione diversa o con una distanza oltre l'inizio vengono rifiutati
+	ChunkCompressor::compress(repetitive.data(), repetitive.size(), compressed);
+	assert(compressed.size() < repetitive.size() / 20);
+	assert(repetitive.size() <= ChunkCompressor::getMaxDecompressedSize(compressed.size()));
+	decompressed.assign(repetitive.size(), 0);
+	assert(!ChunkCompressor::decompress(compressed.data(), compressed.size() - 1, decompressed.data(), decompressed.size()));
+	assert(!ChunkCompressor::decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size() - 1));
+	const uint8_t badOffset[] = { 0x10, 'a', 0x05, 0x00, 0x00 };
+	assert(!ChunkCompressor::decompress(badOffset, sizeof(badOffset), decompressed.data(), decompressed.size()));
+
+	// Byte raggruppati per posizione nell'elemento
+	const uint32_t words[3] = { 0x11223344, 0x55667788, 0x99AABBCC };
+	uint8_t shuffled[sizeof(words)];
+	uint32_t unshuffled[3];
+	ChunkCompressor::shuffle((const uint8_t*)words, 3, sizeof(uint32_t), shuffled);
+	assert(shuffled[0] == 0x44 && shuffled[1] == 0x88 && shuffled[2] == 0xCC && shuffled[9] == 0x11);
+	ChunkCompressor::unshuffle(shuffled, 3, sizeof(uint32_t), (uint8_t*)unshuffled);
+	assert(memcmp(words, unshuffled, sizeof(words)) == 0);
+
+	///// OVOWriter
+	std::cout << "Testing OVOWriter " << std::endl;
+
+	// La scena generata e letta viene riscritta con i chunk originali e con le mesh compresse
+	uint64_t exportedBytes[2] = { 0, 0 };
+	for (int compress = 0; compress < 2; compress++)
+	{
+		OVOWriter writer;
+		writer.setMeshCompression(compress == 1);
+		assert(writer.open("ovo_writer_test.ovo"));
+		assert(writer.writeScene(generatedRoot));
+		exportedBytes[compress] = writer.getBytesWritten();
+		assert(writer.close());
+
+		std::shared_ptr<Node> exportedScene = OVOParser::fromFile("ovo_writer_test.ovo");
+		remove("ovo_writer_test.ovo");
+		assert(exportedScene != nullptr && exportedScene->getChildren().size() == 1);
+
+		// Stessa gerarchia, stessi tipi, matrici, materiali e geometria
+		const std::function<void(const std::shared_ptr<Node>&, const std::shared_ptr<Node>&)> compareNodes =
+			[&](const std::shared_ptr<Node>& original, const std::shared_ptr<Node>& exported)
+		{
+			assert(original->getName() == exported->getName() && original->getType() == exported->getType());
+			assert(original->getLocalMatrix() == exported->getLocalMatrix());
+			assert(original->getChildren().size() == exported->getChildren().size());
+
+			if (std::shared_ptr<Mesh> originalMesh = std::dynamic_pointer_cast<Mesh>(original))
+			{
+				std::shared_ptr<Mesh> exportedMesh = std::dynamic_pointer_cast<Mesh>(exported);
+				assert(exportedMesh->getMaterial()->getName() == originalMesh->getMaterial()->getName());
+				assert(exportedMesh->getLodCount() == originalMesh->getLodCount());
+				for (int l = 0; l < originalMesh->getLodCount(); l++)
+				{
+					assert(exportedMesh->getMeshData(l).getFaceCount() == originalMesh->getMeshData(l).getFaceCount());
+					assert(exportedMesh->getMeshData(l).getVertexCount() == originalMesh->getMeshData(l).getVertexCount());
+				}
+			}
+			else if (std::shared_ptr<PointLight> originalLight = std::dynamic_pointer_cast<PointLight>(original))
+				assert(std::fabs(std::dynamic_pointer_cast<PointLight>(exported)->getRadius() - originalLight->getRadius()) < 1e-6f);
+
+			for (size_t i = 0; i < original->getChildren().size(); i++)
+				compareNodes(original->getChildren()[i], exported->getChildren()[i]);
+		};
+		compareNodes(generatedRoot, exportedScene->getChildren()[0]);
+	}
+	assert(exportedBytes[1] > 0 && exportedBytes[1] < exportedBytes[0]);
+
+	// Un file non aperto non viene scritto
+	OVOWriter closedWriter;
+	assert(!closedWriter.writeScene(generatedRoot));
+
+	// Una dimensione decompressa corrotta lascia la mesh senza geometria, senza allocare i byte dichiarati
+	{
+		OVOMeshDesc corruptDescription;
+		corruptDescription.name = "corrupt_mesh";
+		corruptDescription.lods.resize(1);
+		for (uint32_t i = 0; i < 512; i++)
+			corruptDescription.lods[0].positions.push_back(glm::vec3((float)i, 0.0f, 0.0f));
+		for (uint32_t i = 0; i + 2 < 512; i++)
+			corruptDescription.lods[0].indices.insert(corruptDescription.lods[0].indices.end(), { i, i + 1, i + 2 });
+
+		OVOWriter corruptWriter;
+		corruptWriter.setMeshCompression(true);
+		assert(corruptWriter.open("corrupt_mesh_test.ovo"));
+		corruptWriter.writeMesh(corruptDescription);
+		assert(corruptWriter.close());
+
+		FILE* corruptFile = fopen("corrupt_mesh_test.ovo", "rb");
+		std::vector<uint8_t> fileBytes;
+		uint8_t fileByte;
+		while (fread(&fileByte, 1, 1, corruptFile) == 1)
+			fileBytes.push_back(fileByte);
+		fclose(corruptFile);
+
+		const auto readField = [&fileBytes](const size_t offset) {
+			uint32_t value;
+			memcpy(&value, fileBytes.data() + offset, sizeof(uint32_t));
+			return value;
+		};
+
+		// Il chunk compresso finisce con i dati, preceduti dalla loro dimensione e da quella decompressa
+		size_t chunk = 0;
+		while (readField(chunk) != OVOWriter::COMPRESSED_MESH_CHUNK)
+			chunk += 2 * sizeof(uint32_t) + readField(chunk + sizeof(uint32_t));
+		const size_t chunkEnd = chunk + 2 * sizeof(uint32_t) + readField(chunk + sizeof(uint32_t));
+		size_t dataSizeField = chunk + 2 * sizeof(uint32_t);
+		while (readField(dataSizeField) != chunkEnd - dataSizeField - sizeof(uint32_t))
+			dataSizeField++;
+		const size_t rawSizeField = dataSizeField - sizeof(uint32_t);
+		assert((fileBytes[rawSizeField - 1] & OVOWriter::COMPRESSED_MESH_STORED) == 0);
+
+		for (const uint32_t rawSize : { 0xFFFFFFF0u, readField(rawSizeField) + 1 })
+		{
+			memcpy(fileBytes.data() + rawSizeField, &rawSize, sizeof(uint32_t));
+			corruptFile = fopen("corrupt_mesh_test.ovo", "wb");
+			fwrite(fileBytes.data(), 1, fileBytes.size(), corruptFile);
+			fclose(corruptFile);
+
+			std::shared_ptr<Node> corruptScene = OVOParser::fromFile("corrupt_mesh_test.ovo");
+			assert(corruptScene != nullptr && corruptScene->getChildren().size() == 1);
+			std::shared_ptr<Mesh> corruptMesh = std::dynamic_pointer_cast<Mesh>(corruptScene->getChildren()[0]);
+			assert(corruptMesh != nullptr && corruptMesh->getLodCount() == 1 && corruptMesh->getMeshData(0).getFaceCount() == 0);
+		}
+		remove("corrupt_mesh_test.ovo");
+	}
+
+	///// List
+	std::cout << "Testing List " << std::endl;
+
+	// Creazione di un oggetto List
+	List list;
+
+	// Creazione di alcuni nodi di test
+	std::shared_ptr<Node> node1 = std::make_shared<Node>("Camera");
+	std::shared_ptr<Node> node2 = std::make_shared<Node>("Light");
+	std::shared_ptr<Node> node3 = std::make_shared<Node>("Mesh");
+
+	// Creazione di una lista di rendering
+	std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> testListRendering = {
+		{node1, glm::mat4(1.0f)},
+		{node2, glm::mat4(1.0f)},
+		{node3, glm::mat4(1.0f)}
+	};
+
+	// Impostazione della lista di rendering nella classe List
+	list.setListRendering(testListRendering);
+
+	// Verifica che la lista sia stata impostata correttamente
+	assert(list.getListRendering().size() == 3);
+	assert(list.getListRendering()[0].first->getType() == "Camera");
+	assert(list.getListRendering()[1].first->getType() == "Light");
+	assert(list.getListRendering()[2].first->getType() == "Mesh");
+
+	///// Animator
+	std::cout << "Testing Animator " << std::endl;
+
+	std::shared_ptr<Node> animatedNode = std::make_shared<Node>();
+	Animator::moveTo(animatedNode, glm::vec3(10.0f, 0.0f, 0.0f), 1.0f, Easing::Linear);
+	assert(Animator::isAnimating(animatedNode));
+
+	// A meta' animazione il nodo e' a meta' strada ed e' marcato come da ricalcolare
+	Animator::update(0.5f);
+	assert(glm::abs(animatedNode->getPosition().x - 5.0f) < 0.001f);
+	assert(animatedNode->isDirty());
+	animatedNode->getLocalMatrix();
+	assert(!animatedNode->isDirty());
+
+	// Al termine l'animazione viene rimossa
+	Animator::update(0.6f);
+	assert(animatedNode->getPosition() == glm::vec3(10.0f, 0.0f, 0.0f));
+	assert(Animator::getActiveCount() == 0);
+
+	// finish porta subito al valore finale
+	Animator::moveTo(animatedNode, glm::vec3(0.0f, 3.0f, 0.0f), 2.0f);
+	Animator::finish(animatedNode);
+	assert(animatedNode->getPosition() == glm::vec3(0.0f, 3.0f, 0.0f));
+	assert(!Animator::isAnimating(animatedNode));
+
+	///// RenderQueue
+	std::cout << "Testing RenderQueue " << std::endl;
+
+	std::shared_ptr<Material> sharedMaterial = std::make_shared<Material>();
+	std::shared_ptr<Mesh> farMesh = std::make_shared<Mesh>();
+	std::shared_ptr<Mesh> otherMesh = std::make_shared<Mesh>();
+	std::shared_ptr<Mesh> nearMesh = std::make_shared<Mesh>();
+	std::shared_ptr<Light> queueLight = std::make_shared<PointLight>();
+	farMesh->setMaterial(sharedMaterial);
+	nearMesh->setMaterial(sharedMaterial);
+
+	std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> queueList = {
+		{ farMesh, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -20.0f)) },
+		{ otherMesh, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f)) },
+		{ queueLight, glm::mat4(1.0f) },
+		{ nearMesh, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -2.0f)) }
+	};
+
+	// Luci prima delle mesh, mesh con lo stesso materiale consecutive e dalla piu' vicina alla piu' lontana
+	RenderQueue queue;
+	queue.build(queueList, glm::mat4(1.0f));
+	queue.sort();
+	assert(queue.getItems().size() == 4);
+	assert(queue.getItems()[0].node == queueLight.get());
+	assert(queue.getItems()[1].node == nearMesh.get());
+	assert(queue.getItems()[2].node == farMesh.get());
+	assert(queue.getItems()[3].node == otherMesh.get());
+	assert(RenderQueue::quantizeDepth(2.0f) < RenderQueue::quantizeDepth(20.0f));
+	assert(RenderQueue::quantizeDepth(-1.0f) == 0);
+
+	// Le mesh trasparenti vanno nella coda separata, dalla piu' lontana alla piu' vicina
+	std::shared_ptr<Material> glassMaterial = std::make_shared<Material>();
+	glassMaterial->setAlpha(0.5f);
+	std::vector<std::pair<std::shared_ptr<Node>, glm::mat4>> transparentList;
+	for (float z : { -3.0f, -300.0f, 2.0f, -30.0f, -0.5f })
+	{
+		std::shared_ptr<Mesh> glassMesh = std::make_shared<Mesh>();
+		glassMesh->setMaterial(glassMaterial);
+		transparentList.push_back({ glassMesh, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, z)) });
+	}
+	MaterialOverride fadeOverride;
+	fadeOverride.alpha = 0.25f;
+	nearMesh->setMaterialOverride(fadeOverride);
+	transparentList.push_back({ nearMesh, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f)) });
+	transparentList.push_back({ otherMesh, glm::mat4(1.0f) });
+
+	queue.build(transparentList, glm::mat4(1.0f));
+	queue.sort();
+	assert(queue.getItems().size() == 1 && queue.getItems()[0].node == otherMesh.get());
+	assert(queue.getTransparentItems().size() == 6);
+	for (size_t i = 1; i < queue.getTransparentItems().size(); i++)
+		assert(queue.getTransparentItems()[i - 1].worldMatrix[3].z < queue.getTransparentItems()[i].worldMatrix[3].z);
+	assert(queue.getTransparentItems()[2].node == nearMesh.get());
+	assert(RenderQueue::backToFrontKey(10.0f) < RenderQueue::backToFrontKey(1.0f));
+	assert(RenderQueue::backToFrontKey(0.0f) < RenderQueue::backToFrontKey(-1.0f));
+	nearMesh->resetMaterialOverride();
+
+	std::cout << "All tests passed!" << std::endl;
+
+	return 0;
+}